@@ -0,0 +1,139 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef ADAPTIVE_WALL_CLOCK_SYNCHRONIZER_H
+#define ADAPTIVE_WALL_CLOCK_SYNCHRONIZER_H
+
+#include "synchronizer.h"
+#include "system-condition.h"
+#include "nstime.h"
+
+/**
+ * @file
+ * @ingroup realtime
+ * ns3::AdaptiveWallClockSynchronizer declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * @ingroup realtime
+ * @brief Synchronizer sleeping until shortly before each event and
+ * spinning for a calibrated tail
+ *
+ * WallClockSynchronizer sleeps in whole jiffies and spins for a fixed
+ * three jiffies before each event, which wastes the CPU when the timers
+ * are precise and misses the deadlines when they are not.  This
+ * synchronizer measures how late the sleeps actually wake up, and sleeps
+ * until the spin tail before the event, where the spin tail is the mean
+ * oversleep plus four times its mean deviation, bounded by the MinSpin
+ * and MaxSpin attributes.  It is calibrated by a few short sleeps when
+ * the simulation starts, and updated after each sleep.
+ *
+ * On Linux, the sleeps wait on a @c timerfd armed with the absolute
+ * wake-up time of the monotonic clock, and are interrupted by an
+ * @c eventfd written by Signal; elsewhere they wait on a
+ * SystemCondition.
+ *
+ * When the next event is due within the BatchWindow, the synchronizer
+ * does not wait at all, so that the events close to each other are
+ * processed in one wake-up, up to BatchWindow early.
+ *
+ * The synchronizer is used by RealtimeSimulatorImpl when its
+ * SynchronizerType attribute is set to
+ * ns3::AdaptiveWallClockSynchronizer.
+ */
+class AdaptiveWallClockSynchronizer : public Synchronizer
+{
+public:
+  /**
+   * Get the registered TypeId for this class.
+   * @returns The TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor. */
+  AdaptiveWallClockSynchronizer ();
+  /** Destructor. */
+  virtual ~AdaptiveWallClockSynchronizer ();
+
+  /**
+   * Get the current spin tail.
+   * @returns The time spent spinning before each event.
+   */
+  Time GetSpinTail (void) const;
+
+protected:
+  // Inherited from Synchronizer
+  virtual void DoSetOrigin (uint64_t ns);
+  virtual bool DoRealtime (void);
+  virtual uint64_t DoGetCurrentRealtime (void);
+  virtual bool DoSynchronize (uint64_t nsCurrent, uint64_t nsDelay);
+  virtual void DoSignal (void);
+  virtual void DoSetCondition (bool cond);
+  virtual int64_t DoGetDrift (uint64_t ns);
+  virtual void DoEventStart (void);
+  virtual uint64_t DoEventEnd (void);
+
+private:
+  /**
+   * Get the time of the monotonic clock.
+   * @returns The time, in ns.
+   */
+  uint64_t GetRealtime (void) const;
+  /**
+   * Get the time of the monotonic clock since the origin.
+   * @returns The normalized time, in ns.
+   */
+  uint64_t GetNormalizedRealtime (void) const;
+  /**
+   * Sleep until a normalized time, or until Signal.
+   * @param [in] ns The normalized time to wake up at.
+   * @returns @c true if the sleep was not interrupted by Signal.
+   */
+  bool SleepUntil (uint64_t ns);
+  /**
+   * Spin until a normalized time, or until the condition is set.
+   * @param [in] ns The normalized time to return at.
+   * @returns @c true if the spin was not interrupted by the condition.
+   */
+  bool SpinUntil (uint64_t ns);
+  /**
+   * Update the spin tail with the lateness of a sleep.
+   * @param [in] ns The time the sleep woke up after the requested time.
+   */
+  void Calibrate (uint64_t ns);
+  /** Measure the lateness of a few short sleeps. */
+  void InitialCalibration (void);
+
+  Time m_minSpin;        //!< Minimum spin tail
+  Time m_maxSpin;        //!< Maximum spin tail
+  Time m_batchWindow;    //!< Events processed without waiting
+
+  double m_oversleep;    //!< Mean lateness of the sleeps, in ns
+  double m_deviation;    //!< Mean deviation of the lateness, in ns
+  uint64_t m_spinTail;   //!< Time spent spinning before each event, in ns
+  uint64_t m_nsEventStart;  //!< Time recorded by DoEventStart
+
+  /** Condition set by Signal. */
+  SystemCondition m_condition;
+  int m_timerFd;         //!< Timer of the sleeps, or -1
+  int m_eventFd;         //!< Event written by Signal, or -1
+};
+
+} // namespace ns3
+
+#endif /* ADAPTIVE_WALL_CLOCK_SYNCHRONIZER_H */
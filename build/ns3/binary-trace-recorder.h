@@ -0,0 +1,250 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef BINARY_TRACE_RECORDER_H
+#define BINARY_TRACE_RECORDER_H
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include <stdint.h>
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/packet.h"
+#include "ns3/object.h"
+#include "ns3/config.h"
+#include "ns3/callback.h"
+#include "ns3/abort.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup network
+ *
+ * \brief Record packet trace events as fixed-size binary records
+ *
+ * Formatting trace events as text (e.g., with Packet::Print, as the ascii
+ * trace helpers do) usually costs much more than the events themselves.
+ * This class instead records each event as a fixed-size record holding the
+ * time of the event, the trace source which fired it, the uid and size of
+ * the packet, and the leading bytes of the packet (i.e., its outermost
+ * serialized headers, from which fields such as addresses and ports can be
+ * decoded).  The records are stored into a memory-mapped file used as a
+ * ring buffer: when it is full, the oldest records are overwritten, so that
+ * the file keeps the most recent events and its size is bounded.
+ *
+ * Trace sources are connected with Config paths, as with Config::Connect:
+ * \code
+ *   Ptr<BinaryTraceRecorder> recorder = Create<BinaryTraceRecorder> ();
+ *   recorder->Open ("trace.bin");
+ *   recorder->Connect ("/NodeList/0/DeviceList/1/$ns3::PointToPointNetDevice/MacTx");
+ *   recorder->Connect<QueueDiscItem> ("/NodeList/0/$ns3::TrafficControlLayer/RootQueueDiscList/1/Drop");
+ * \endcode
+ * Paths may contain wildcards, and each trace source matched by a path is identified in the records by a
+ * context, whose name is the context string Config::Connect would pass to
+ * the sink.  The names of the connected paths and of the contexts are
+ * written at the end of the file when it is closed, and the file can then
+ * be converted to text or CSV offline, with the binary-trace-convert
+ * program (see Convert).
+ *
+ * The recorder is kept alive by the trace sources connected to it, and the
+ * file is closed when the last reference is released (or by Close).
+ */
+class BinaryTraceRecorder : public SimpleRefCount<BinaryTraceRecorder>
+{
+public:
+  static const uint32_t HEADER_BYTES = 32;          /**< Number of leading packet bytes in a record */
+  static const uint64_t CAPACITY_DEFAULT = 1 << 20; /**< Default number of records of the ring */
+
+  /**
+   * \brief A record of the file
+   */
+  struct TraceRecord
+  {
+    int64_t time;                  //!< Time of the event, in nanoseconds
+    uint64_t uid;                  //!< Uid of the packet
+    uint32_t context;              //!< Identifier of the context (trace source)
+    uint32_t size;                 //!< Size of the packet, in bytes
+    uint16_t trace;                //!< Identifier of the connected path
+    uint16_t headerLen;            //!< Number of valid bytes in header
+    uint32_t reserved;             //!< Padding, set to zero
+    uint8_t header[HEADER_BYTES];  //!< Leading bytes of the packet
+  };
+
+  BinaryTraceRecorder ();
+  ~BinaryTraceRecorder ();
+
+  /**
+   * Create a new file (or truncate an existing one) and map its records in
+   * memory.
+   *
+   * \param filename the name of the file
+   * \param capacity the number of records of the ring
+   * \return true if the file could be created, false otherwise
+   */
+  bool Open (std::string const &filename, uint64_t capacity = CAPACITY_DEFAULT);
+
+  /**
+   * Write the names of the connected paths and of the contexts to the file,
+   * and close it.  Events fired afterwards are ignored.
+   */
+  void Close (void);
+
+  /**
+   * \brief Connect the trace sources matching a Config path
+   *
+   * The trace sources must have the signature
+   * <tt>void (Ptr<const T>)</tt>, where T is Packet or a class with a
+   * GetPacket method, such as QueueItem or QueueDiscItem.
+   *
+   * \tparam T the type of the object passed to the sinks
+   * \param path the Config path of the trace sources
+   * \return the identifier of the path in the records
+   */
+  template <typename T = Packet>
+  uint16_t Connect (std::string path);
+
+  /**
+   * \brief Record an event
+   *
+   * This method can be called from user-defined sinks, to record trace
+   * sources whose signature is not supported by Connect.
+   *
+   * \param trace the identifier of the path, as returned by AddTrace
+   * \param context the identifier of the context, as returned by AddContext
+   * \param p the packet
+   */
+  void Record (uint16_t trace, uint32_t context, Ptr<const Packet> p);
+
+  /**
+   * \param name the name of a trace (e.g., a Config path)
+   * \return the identifier of the trace in the records
+   */
+  uint16_t AddTrace (std::string const &name);
+
+  /**
+   * \param name the name of a context (e.g., the path of a trace source)
+   * \return the identifier of the context in the records
+   */
+  uint32_t AddContext (std::string const &name);
+
+  /**
+   * \return the number of events recorded so far (including those which
+   * were overwritten)
+   */
+  uint64_t GetNRecords (void) const;
+
+  /**
+   * \brief Convert a file to text
+   *
+   * The records still in the ring are printed in chronological order, one
+   * per line, either as human-readable text or as comma-separated values.
+   * Both give the time (in seconds as text, in nanoseconds as CSV), the
+   * context, the connected path, the uid, the size and the leading bytes
+   * in hexadecimal.
+   *
+   * If the file was not closed (e.g., because the simulation crashed), the
+   * names of the paths and contexts are missing, and their identifiers are
+   * printed instead.
+   *
+   * \param filename the name of the file
+   * \param os the stream to print to
+   * \param csv whether to print comma-separated values
+   * \return true if the file could be read, false otherwise
+   */
+  static bool Convert (std::string const &filename, std::ostream &os, bool csv = false);
+
+private:
+  /**
+   * \brief Trace sink recording the packet of an event
+   * \tparam T the type of the object passed to the sink
+   * \param recorder the recorder
+   * \param trace the identifier of the path
+   * \param context the identifier of the context
+   * \param item the packet (or an object holding it)
+   */
+  template <typename T>
+  static void Sink (Ptr<BinaryTraceRecorder> recorder, uint16_t trace, uint32_t context, Ptr<const T> item);
+
+  /**
+   * \param p a packet
+   * \return the packet
+   */
+  static Ptr<const Packet> GetPacket (Ptr<const Packet> p);
+  /**
+   * \tparam T a class with a GetPacket method
+   * \param item an object holding a packet
+   * \return the packet
+   */
+  template <typename T>
+  static Ptr<const Packet> GetPacket (Ptr<const T> item);
+
+  /**
+   * \brief Look up the objects matching a Config path
+   * \param path the Config path of the trace sources
+   * \param matches [out] the objects holding the trace sources
+   * \param name [out] the name of the trace sources
+   */
+  static void LookupMatches (std::string const &path, Config::MatchContainer &matches, std::string &name);
+
+  std::string m_filename;               //!< File name
+  int m_fd;                             //!< File descriptor, or -1 if closed
+  uint8_t *m_map;                       //!< Mapped header and records
+  std::size_t m_mapSize;                //!< Size of the mapping
+  TraceRecord *m_records;               //!< The ring of records
+  uint64_t m_next;                      //!< Index of the next record in the ring
+  uint64_t m_capacity;                  //!< Number of records of the ring
+  uint64_t m_count;                     //!< Number of events recorded
+  std::vector<std::string> m_traces;    //!< Names of the connected paths
+  std::vector<std::string> m_contexts;  //!< Names of the contexts
+};
+
+template <typename T>
+uint16_t
+BinaryTraceRecorder::Connect (std::string path)
+{
+  Config::MatchContainer matches;
+  std::string name;
+  LookupMatches (path, matches, name);
+  uint16_t trace = AddTrace (path);
+  bool ok = false;
+  for (std::size_t i = 0; i < matches.GetN (); ++i)
+    {
+      uint32_t context = AddContext (matches.GetMatchedPath (i) + name);
+      ok |= matches.Get (i)->TraceConnectWithoutContext (name, MakeBoundCallback (&BinaryTraceRecorder::Sink<T>,
+                                                                                  Ptr<BinaryTraceRecorder> (this), trace, context));
+    }
+  NS_ABORT_MSG_UNLESS (ok, "Could not connect callback to " << path);
+  return trace;
+}
+
+template <typename T>
+void
+BinaryTraceRecorder::Sink (Ptr<BinaryTraceRecorder> recorder, uint16_t trace, uint32_t context, Ptr<const T> item)
+{
+  recorder->Record (trace, context, GetPacket (item));
+}
+
+template <typename T>
+Ptr<const Packet>
+BinaryTraceRecorder::GetPacket (Ptr<const T> item)
+{
+  return item->GetPacket ();
+}
+
+} // namespace ns3
+
+#endif /* BINARY_TRACE_RECORDER_H */
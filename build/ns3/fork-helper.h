@@ -0,0 +1,174 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef FORK_HELPER_H
+#define FORK_HELPER_H
+
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include "ns3/callback.h"
+#include "ns3/nstime.h"
+
+/**
+ * \file
+ * \ingroup core-helpers
+ * ns3::ForkHelper declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup core-helpers
+ *
+ * \brief Run several variants of a simulation after a common warm-up phase
+ *
+ * At the time given to ForkAt, the simulation process is forked (see
+ * Simulator::Fork) into a number of child processes, which continue the
+ * simulation from the state reached so far.  Each child process can use a
+ * different run number for the random variables (see SetFirstRun) and
+ * change the configuration in the callback set with SetChildCallback.
+ * The simulation of the parent process stops at the fork, and
+ * Simulator::Run returns in the parent process once all the child
+ * processes have exited.
+ *
+ * The child processes report their results with Report, and the parent
+ * process gets them with GetResult:
+ *
+ * \code
+ *   ForkHelper sweep (4);
+ *   sweep.SetFirstRun (10);
+ *   sweep.SetChildCallback (MakeCallback (&ConfigureVariant));
+ *   sweep.ForkAt (Seconds (30));
+ *   Simulator::Stop (Seconds (60));
+ *   Simulator::Run ();
+ *   if (sweep.IsChild ())
+ *     {
+ *       sweep.Report ("rx", sink->GetTotalRx ());
+ *       Simulator::Destroy ();
+ *       return 0;
+ *     }
+ *   for (uint32_t i = 1; i <= sweep.GetNChildren (); ++i)
+ *     {
+ *       std::cout << i << " " << sweep.GetResult (i, "rx") << std::endl;
+ *     }
+ *   Simulator::Destroy ();
+ * \endcode
+ */
+class ForkHelper
+{
+public:
+  /**
+   * \brief Constructor
+   * \param [in] n The number of child processes.
+   */
+  ForkHelper (uint32_t n);
+  ~ForkHelper ();
+
+  /**
+   * \brief Use a different run number in each child process
+   *
+   * Child process \c i (from 1 to n) sets the run number of the random
+   * variables to <tt>run + i - 1</tt> and restarts the random variables
+   * created before the fork (see RandomVariableStream::ResetStreams).
+   * Otherwise, the child processes draw the same random values as the
+   * parent process would have drawn.
+   *
+   * \param [in] run The run number of the first child process.
+   */
+  void SetFirstRun (uint64_t run);
+
+  /**
+   * \brief Set the callback invoked in each child process after the fork
+   * \param [in] callback The callback, which is passed the index of the
+   *             child process (from 1 to n).
+   */
+  void SetChildCallback (Callback<void, uint32_t> callback);
+
+  /**
+   * \brief Schedule the fork
+   * \param [in] time The absolute simulation time of the fork.
+   */
+  void ForkAt (const Time &time);
+
+  /**
+   * \return The number of child processes.
+   */
+  uint32_t GetNChildren (void) const;
+
+  /**
+   * \return true in the child processes, once the fork is done.
+   */
+  bool IsChild (void) const;
+
+  /**
+   * \return The index of the child process (from 1 to n), or 0 in the
+   *         parent process.
+   */
+  uint32_t GetChildIndex (void) const;
+
+  /**
+   * \brief Report a result of a child process to the parent process
+   *
+   * The result is written at once, so that the results reported by a
+   * child process are available even if it does not exit normally.
+   *
+   * \param [in] name The name of the result.
+   * \param [in] value The value of the result.
+   */
+  void Report (std::string name, double value);
+
+  /**
+   * \param [in] child The index of the child process (from 1 to n).
+   * \param [in] name The name of the result.
+   * \return true if the child process reported a result with this name.
+   */
+  bool HasResult (uint32_t child, std::string name) const;
+
+  /**
+   * \param [in] child The index of the child process (from 1 to n).
+   * \param [in] name The name of the result.
+   * \return The last value of the result reported by the child process.
+   */
+  double GetResult (uint32_t child, std::string name) const;
+
+private:
+  /// Fork the simulation process, from the event scheduled by ForkAt
+  void Fork (void);
+  /**
+   * \param [in] child The index of the child process (from 1 to n).
+   * \return The name of the file of the results of the child process.
+   */
+  std::string GetResultFileName (uint32_t child) const;
+
+  /// The results reported by a child process, indexed by name
+  typedef std::map<std::string, double> Results;
+
+  uint32_t m_n;                               //!< Number of child processes
+  bool m_setRun;                              //!< Whether to change the run number
+  uint64_t m_firstRun;                        //!< Run number of the first child process
+  Callback<void, uint32_t> m_childCallback;   //!< Callback invoked in the child processes
+  uint32_t m_index;                           //!< Index of this process
+  std::string m_directory;                    //!< Directory of the result files
+  std::ofstream m_output;                     //!< Result file of this child process
+  std::vector<Results> m_results;             //!< Results of the child processes
+};
+
+} // namespace ns3
+
+#endif /* FORK_HELPER_H */
@@ -0,0 +1,143 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Universita' degli Studi di Napoli Federico II
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef FQ_FLOW_TABLE_H
+#define FQ_FLOW_TABLE_H
+
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup traffic-control
+ *
+ * \brief Flow table shared by the flow queue (FQ) queue discs
+ *
+ * FqCoDelQueueDisc, FqPieQueueDisc and FqCobaltQueueDisc classify the
+ * incoming packets into a fixed number of flow queue slots, which are
+ * served by a deficit round robin (DRR) scheduler using a list of new
+ * flows and a list of old flows. This class holds the state of the slots
+ * in flat arrays indexed by slot:
+ *
+ * - the index of the queue disc class created for the slot (if any);
+ * - the tag used by the set associative hash;
+ * - the link to the next slot in the DRR list the slot belongs to (if any).
+ *
+ * The DRR lists are thus linked through the slots themselves and every
+ * operation (classification, insertion and removal of a flow from the lists)
+ * takes constant time, regardless of the number of flow queues.
+ */
+class FqFlowTable
+{
+public:
+  /// Value returned for slots which have no associated queue disc class
+  static const uint32_t NO_CLASS = 0xffffffff;
+
+  /**
+   * \enum FlowList
+   * \brief The DRR lists of flows
+   */
+  enum FlowList
+    {
+      NEW_FLOWS = 0,
+      OLD_FLOWS = 1
+    };
+
+  FqFlowTable ();
+
+  /**
+   * \brief Allocate the given number of slots and reset the table
+   *
+   * \param nSlots the number of flow queue slots
+   * \param setWays the size of a set of slots used by the set associative
+   *        hash, or zero to map each flow hash directly to a slot
+   */
+  void Initialize (uint32_t nSlots, uint32_t setWays);
+
+  /**
+   * \brief Get the slot for the flow having the given hash
+   *
+   * If the set associative hash is enabled, the first slot of the set which
+   * has not been used yet, is tagged with the given flow hash or is not in
+   * any DRR list is returned. If all the slots of the set are in use, the
+   * first slot of the set is returned.
+   *
+   * \param flowHash the hash of the flow
+   * \return the slot of the flow
+   */
+  uint32_t GetSlot (uint32_t flowHash);
+
+  /**
+   * \param slot the slot
+   * \return the index of the queue disc class of the slot, or NO_CLASS
+   */
+  uint32_t GetClassIndex (uint32_t slot) const;
+  /**
+   * \brief Set the index of the queue disc class of the given slot
+   * \param slot the slot
+   * \param index the index of the queue disc class
+   */
+  void SetClassIndex (uint32_t slot, uint32_t index);
+
+  /**
+   * \param list the DRR list
+   * \return true if the given list is empty
+   */
+  bool IsEmpty (FlowList list) const;
+  /**
+   * \param list the (non empty) DRR list
+   * \return the slot at the head of the given list
+   */
+  uint32_t GetFront (FlowList list) const;
+  /**
+   * \brief Append a slot which is not in any DRR list to the given list
+   * \param list the DRR list
+   * \param slot the slot
+   */
+  void PushBack (FlowList list, uint32_t slot);
+  /**
+   * \brief Remove the slot at the head of the given (non empty) list
+   * \param list the DRR list
+   */
+  void PopFront (FlowList list);
+  /**
+   * \brief Move the slot at the head of a (non empty) list to the tail of a list
+   * \param from the DRR list the slot is removed from
+   * \param to the DRR list the slot is appended to
+   */
+  void MoveFront (FlowList from, FlowList to);
+
+private:
+  /// Marker for the end of a list and for slots not belonging to any list
+  static const uint32_t NONE = 0xffffffff;
+  /// Marker for the last slot of a list
+  static const uint32_t LAST = 0xfffffffe;
+
+  uint32_t m_nSlots;                  //!< Number of slots
+  uint32_t m_setWays;                 //!< Size of a set of slots (0 if set associative hash is disabled)
+  std::vector<uint32_t> m_classIndex; //!< Index of the queue disc class of each slot
+  std::vector<uint32_t> m_tags;       //!< Tags used by set associative hash
+  std::vector<uint32_t> m_next;       //!< Next slot in the DRR list (LAST for the tail, NONE if not in a list)
+  uint32_t m_head[2];                 //!< Head of the DRR lists
+  uint32_t m_tail[2];                 //!< Tail of the DRR lists
+};
+
+} // namespace ns3
+
+#endif /* FQ_FLOW_TABLE_H */
@@ -0,0 +1,388 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NS3_LOG_BINARY_H
+#define NS3_LOG_BINARY_H
+
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <stdint.h>
+
+/**
+ * \file
+ * \ingroup logging
+ * Binary logging: ns3::LogSetBinaryFile and ns3::LogBinaryRecord
+ * declarations.
+ */
+
+namespace ns3 {
+
+class LogComponent;
+template <typename T>
+class Ptr;
+
+/**
+ * \ingroup logging
+ *
+ * Write the log messages to a binary file instead of std::clog.
+ *
+ * The NS_LOG macros (except NS_LOG_UNCOND) then record the identifier
+ * of the strings of the message and the raw values of its arguments
+ * in a buffer of the logging thread, which is written to the file by
+ * a background thread.  The file is converted to the text that would
+ * have been written to std::clog with LogBinaryDecode, or with the
+ * \c log-binary-decode program.
+ *
+ * The binary file can also be set with the NS_LOG_BINARY environment
+ * variable.  In a process forked after the file was opened, the log
+ * messages are written to a file with the process id appended to the
+ * name of the file.
+ *
+ * \param [in] filename The name of the binary file, or an empty string
+ *             to write the log messages to std::clog again.
+ */
+void LogSetBinaryFile (const std::string &filename);
+
+/**
+ * \ingroup logging
+ * \return \c true if the log messages are written to a binary file.
+ */
+bool LogBinaryIsEnabled (void);
+
+/**
+ * \ingroup logging
+ * Write the log messages recorded so far to the binary file.
+ */
+void LogBinaryFlush (void);
+
+/**
+ * \ingroup logging
+ * Convert a binary log file to text.
+ * \param [in] is The binary log file.
+ * \param [in] os The output stream.
+ * \return \c false if the input is not a binary log file.
+ */
+bool LogBinaryDecode (std::istream &is, std::ostream &os);
+
+/**
+ * \ingroup logging
+ *
+ * A message logged to the binary file by the NS_LOG macros.
+ *
+ * The arguments of the message are inserted with operator<<.  The
+ * strings literals, numbers, characters and pointers are recorded as
+ * such; the other types, and the arguments following a stream
+ * manipulator, are formatted with their operator<< and recorded as a
+ * string.  The message is committed to the buffer of the thread when
+ * the LogBinaryRecord is destroyed.
+ */
+class LogBinaryRecord
+{
+public:
+  /**
+   * Start a message.
+   * \param [in] component The log component.
+   * \param [in] level The level of the message.
+   * \param [in] function The name of the function logging the message.
+   * \param [in] parameters \c true for the messages of NS_LOG_FUNCTION,
+   *             whose arguments are the parameters of the function.
+   */
+  LogBinaryRecord (const LogComponent &component, int level,
+                   const char *function, bool parameters);
+  /** Commit the message. */
+  ~LogBinaryRecord ();
+
+  /**
+   * Start capturing the context appended to std::clog by
+   * NS_LOG_APPEND_CONTEXT.
+   */
+  void BeginContext (void);
+  /** Stop capturing the context. */
+  void EndContext (void);
+
+  /**
+   * Append an argument to the message.
+   * \tparam T \deduced The type of the argument.
+   * \param [in] value The argument.
+   * \return This LogBinaryRecord.
+   */
+  template <typename T>
+  LogBinaryRecord & operator << (T &&value);
+  /**
+   * Append a string literal to the message.
+   * \tparam N \deduced The size of the literal.
+   * \param [in] value The literal.
+   * \return This LogBinaryRecord.
+   */
+  template <std::size_t N>
+  LogBinaryRecord & operator << (const char (&value)[N]);
+  /**
+   * Append a character array to the message.
+   * \tparam N \deduced The size of the array.
+   * \param [in] value The array.
+   * \return This LogBinaryRecord.
+   */
+  template <std::size_t N>
+  LogBinaryRecord & operator << (char (&value)[N]);
+  /**
+   * Append the arguments of NS_LOG_FUNCTION given as a vector.
+   * \tparam T \deduced The type of the elements.
+   * \param [in] vector The arguments.
+   * \return This LogBinaryRecord.
+   */
+  template <typename T>
+  LogBinaryRecord & operator << (std::vector<T> vector);
+  /**
+   * Apply a stream manipulator, such as std::endl.
+   * \param [in] manipulator The manipulator.
+   * \return This LogBinaryRecord.
+   */
+  LogBinaryRecord & operator << (std::ostream & (*manipulator)(std::ostream &));
+  /**
+   * \copydoc operator<<(std::ostream&(*)(std::ostream&))
+   */
+  LogBinaryRecord & operator << (std::ios & (*manipulator)(std::ios &));
+  /**
+   * \copydoc operator<<(std::ostream&(*)(std::ostream&))
+   */
+  LogBinaryRecord & operator << (std::ios_base & (*manipulator)(std::ios_base &));
+
+private:
+  /** Copying is not allowed. */
+  LogBinaryRecord (const LogBinaryRecord &);
+  /**
+   * Copying is not allowed.
+   * \return This LogBinaryRecord.
+   */
+  LogBinaryRecord & operator = (const LogBinaryRecord &);
+
+  /** Insert the separator of the parameters of NS_LOG_FUNCTION. */
+  void Separate (void);
+  /**
+   * \return The stream formatting the arguments recorded as a string.
+   */
+  std::ostream & Text (void);
+  /** Record the arguments formatted so far as a string. */
+  void FlushText (void);
+  /**
+   * Append bytes to the message.
+   * \param [in] data The bytes.
+   * \param [in] size The number of bytes.
+   */
+  void Append (const void *data, std::size_t size)
+  {
+    const uint8_t *bytes = static_cast<const uint8_t *> (data);
+    m_buffer->insert (m_buffer->end (), bytes, bytes + size);
+  }
+  /**
+   * Append a tagged value to the message.
+   * \tparam T \deduced The type of the value.
+   * \param [in] tag The tag of the value.
+   * \param [in] value The value.
+   */
+  template <typename T>
+  void AppendValue (uint8_t tag, T value)
+  {
+    m_buffer->push_back (tag);
+    Append (&value, sizeof (value));
+  }
+  /**
+   * Append a string to the message.
+   * \param [in] s The string.
+   * \param [in] size The length of the string.
+   */
+  void AppendString (const char *s, std::size_t size);
+  /**
+   * Append a string literal to the message.
+   * \param [in] s The literal.
+   * \param [in] size The length of the literal.
+   */
+  void AppendLiteral (const char *s, std::size_t size);
+
+  /**
+   * \name Record an argument.
+   * \param [in] value The argument.
+   * @{
+   */
+  void Put (bool value);
+  void Put (char value);
+  void Put (signed char value);
+  void Put (unsigned char value);
+  void Put (short value);
+  void Put (unsigned short value);
+  void Put (int value);
+  void Put (unsigned int value);
+  void Put (long value);
+  void Put (unsigned long value);
+  void Put (long long value);
+  void Put (unsigned long long value);
+  void Put (float value);
+  void Put (double value);
+  void Put (const char *value);
+  void Put (char *value);
+  void Put (const std::string &value);
+  template <typename T>
+  void Put (T *value);
+  template <typename T>
+  void Put (const Ptr<T> &value);
+  /**@}*/
+
+  /**
+   * Whether the arguments of a type are recorded as such, rather than
+   * formatted as a string.
+   * \tparam T The type of the argument.
+   */
+  template <typename T>
+  struct IsRecorded
+  {
+    /** Whether the arguments are recorded as such. */
+    static const bool value =
+      std::is_same<T, bool>::value || std::is_same<T, char>::value
+      || std::is_same<T, signed char>::value || std::is_same<T, unsigned char>::value
+      || std::is_same<T, short>::value || std::is_same<T, unsigned short>::value
+      || std::is_same<T, int>::value || std::is_same<T, unsigned int>::value
+      || std::is_same<T, long>::value || std::is_same<T, unsigned long>::value
+      || std::is_same<T, long long>::value || std::is_same<T, unsigned long long>::value
+      || std::is_same<T, float>::value || std::is_same<T, double>::value
+      || std::is_same<T, std::string>::value || std::is_pointer<T>::value;
+  };
+  /**
+   * The pointers held by Ptr are recorded as such.
+   * \tparam T The type of the object.
+   */
+  template <typename T>
+  struct IsRecorded<Ptr<T> > : std::true_type
+  {};
+
+  /** The buffers of a message being recorded. */
+  struct Level;
+
+  Level *m_level;                  //!< The buffers of the message
+  std::vector<uint8_t> *m_buffer;  //!< The buffer of the message
+  std::ostream *m_text;            //!< The stream formatting the arguments, if any
+  std::streambuf *m_clog;          //!< The buffer of std::clog, while capturing the context
+  bool m_parameters;               //!< Whether the arguments are function parameters
+  bool m_first;                    //!< Whether no parameter was appended yet
+};
+
+
+/*************************************************
+ *  Template implementations
+ ************************************************/
+
+template <typename T>
+LogBinaryRecord &
+LogBinaryRecord::operator << (T &&value)
+{
+  typedef typename std::remove_cv<typename std::remove_reference<T>::type>::type Type;
+  if (m_parameters)
+    {
+      Separate ();
+    }
+  if constexpr (IsRecorded<Type>::value)
+    {
+      if (m_text == 0)
+        {
+          Put (static_cast<const Type &> (value));
+          return *this;
+        }
+    }
+  Text () << value;
+  return *this;
+}
+
+template <std::size_t N>
+LogBinaryRecord &
+LogBinaryRecord::operator << (const char (&value)[N])
+{
+  if (m_parameters)
+    {
+      Separate ();
+      Put (static_cast<const char *> (value));
+    }
+  else if (m_text != 0)
+    {
+      *m_text << value;
+    }
+  else
+    {
+      AppendLiteral (value, strnlen (value, N));
+    }
+  return *this;
+}
+
+template <std::size_t N>
+LogBinaryRecord &
+LogBinaryRecord::operator << (char (&value)[N])
+{
+  if (m_parameters)
+    {
+      Separate ();
+    }
+  if (m_text != 0)
+    {
+      *m_text << value;
+    }
+  else
+    {
+      Put (static_cast<char *> (value));
+    }
+  return *this;
+}
+
+template <typename T>
+LogBinaryRecord &
+LogBinaryRecord::operator << (std::vector<T> vector)
+{
+  for (const auto &i : vector)
+    {
+      *this << i;
+    }
+  return *this;
+}
+
+template <typename T>
+void
+LogBinaryRecord::Put (T *value)
+{
+  // std::ostream prints the character pointers as strings, and the
+  // function and volatile pointers as booleans
+  if constexpr (std::is_function<T>::value || std::is_volatile<T>::value
+                || std::is_same<typename std::remove_cv<T>::type, signed char>::value
+                || std::is_same<typename std::remove_cv<T>::type, unsigned char>::value)
+    {
+      Text () << value;
+    }
+  else
+    {
+      AppendValue ('p', static_cast<const void *> (value));
+    }
+}
+
+template <typename T>
+void
+LogBinaryRecord::Put (const Ptr<T> &value)
+{
+  AppendValue ('p', static_cast<const void *> (PeekPointer (value)));
+}
+
+} // namespace ns3
+
+#endif /* NS3_LOG_BINARY_H */
@@ -0,0 +1,99 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MEMORY_MONITOR_H
+#define MEMORY_MONITOR_H
+
+#include "object.h"
+#include "nstime.h"
+#include "event-id.h"
+#include "traced-callback.h"
+#include "memory-accounting.h"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup debugging
+ * ns3::MemoryMonitor declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup core
+ * \ingroup debugging
+ *
+ * \brief Periodically trace the memory usage accounted by MemoryAccounting
+ *
+ * Once started, the monitor takes a snapshot of the usage of each type
+ * every Interval of simulation time, fires the Snapshot trace source
+ * with it, and writes it to the file named by the FileName attribute,
+ * if any.  Each line of the file holds the simulation time in seconds,
+ * the number of instances, the memory usage in bytes and the name of
+ * a type, separated by tabulations.
+ *
+ * The accounting must be enabled with MemoryAccounting::Enable, or the
+ * MemoryAccounting GlobalValue, before the instances are created.  As
+ * the snapshots are periodic events, the simulation must be stopped
+ * with Simulator::Stop, or the monitor with Stop.
+ */
+class MemoryMonitor : public Object
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  MemoryMonitor ();
+  virtual ~MemoryMonitor ();
+
+  /** Take a snapshot now, and then every Interval. */
+  void Start (void);
+  /** Stop taking snapshots. */
+  void Stop (void);
+
+  /**
+   * TracedCallback signature for the snapshots.
+   *
+   * \param [in] types The usage of each type, by decreasing memory usage.
+   */
+  typedef void (* SnapshotTracedCallback)
+    (const std::vector<MemoryAccounting::Usage> &types);
+
+protected:
+  virtual void DoDispose (void);
+
+private:
+  /** Take a snapshot and schedule the next one. */
+  void Snapshot (void);
+
+  Time m_interval;          //!< Interval between the snapshots
+  std::string m_fileName;   //!< Name of the file of the snapshots
+  std::ofstream m_file;     //!< File of the snapshots
+  EventId m_event;          //!< The next snapshot
+
+  /** The Snapshot trace source. */
+  TracedCallback<const std::vector<MemoryAccounting::Usage> &> m_snapshotTrace;
+};
+
+} // namespace ns3
+
+#endif /* MEMORY_MONITOR_H */
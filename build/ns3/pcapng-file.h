@@ -0,0 +1,213 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PCAPNG_FILE_H
+#define PCAPNG_FILE_H
+
+#include <string>
+#include <fstream>
+#include <vector>
+#include <stdint.h>
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+
+namespace ns3 {
+
+class Packet;
+class Header;
+
+/**
+ * \brief A pcapng file recording the packets of several interfaces
+ *
+ * A pcapng file consists of a Section Header Block followed by an Interface
+ * Description Block for each interface and an Enhanced Packet Block for each
+ * packet, which refers to the interface it was captured on.  Hence a single
+ * pcapng file can hold the traces of all the devices of a simulation, instead
+ * of one pcap file per device.
+ *
+ * The blocks are accumulated into a memory buffer which is written to the
+ * file when full, so that the file is written sequentially, in large chunks.
+ * The file is written in the byte order of the host and timestamps have a
+ * nanosecond resolution.
+ *
+ * Files are write only; objects of this class are reference counted so that
+ * the file can be shared by the PcapFileWrapper objects of the interfaces
+ * it records.  The file is closed when the last reference is released.
+ */
+class PcapNgFile : public SimpleRefCount<PcapNgFile>
+{
+public:
+  static const uint32_t BUFFER_SIZE_DEFAULT = 1024 * 1024; /**< Default size of the write buffer */
+
+  PcapNgFile ();
+  ~PcapNgFile ();
+
+  /**
+   * \return true if the 'fail' bit is set in the underlying iostream, false otherwise.
+   */
+  bool Fail (void) const;
+
+  /**
+   * Create a new pcapng file (or truncate an existing one) and write the
+   * Section Header Block.
+   *
+   * A file whose name ends with ".gz" is written in gzip format, by the
+   * background thread of the PcapAsyncWriter (this requires zlib and thread
+   * support).
+   *
+   * \param filename String containing the name of the file.
+   * \param bufferSize the size of the write buffer, in bytes.
+   */
+  void Open (std::string const &filename, uint32_t bufferSize = BUFFER_SIZE_DEFAULT);
+
+  /**
+   * Write the buffered blocks and close the underlying file.
+   */
+  void Close (void);
+
+  /**
+   * Add an interface to the file, by writing an Interface Description Block.
+   *
+   * \param dataLinkType A data link type as defined in the pcap library.
+   * \param snapLen Maximum length of packet data stored in the records of
+   * this interface.
+   * \param name The name of the interface (if_name option).
+   * \returns the identifier of the interface, to be passed to Write.
+   */
+  uint32_t AddInterface (uint32_t dataLinkType, uint32_t snapLen, std::string const &name);
+
+  /**
+   * \returns the number of interfaces added to the file
+   */
+  uint32_t GetNInterfaces (void) const;
+
+  /**
+   * \returns the byte-order magic of the Section Header Block
+   */
+  uint32_t GetMagic (void) const;
+
+  /**
+   * \returns the major version of the Section Header Block
+   */
+  uint16_t GetVersionMajor (void) const;
+
+  /**
+   * \returns the minor version of the Section Header Block
+   */
+  uint16_t GetVersionMinor (void) const;
+
+  /**
+   * \param interface the identifier of the interface
+   * \returns the snapshot length of the interface
+   */
+  uint32_t GetSnapLen (uint32_t interface) const;
+
+  /**
+   * \param interface the identifier of the interface
+   * \returns the data link type of the interface
+   */
+  uint32_t GetDataLinkType (uint32_t interface) const;
+
+  /**
+   * \brief Write the next packet captured on an interface
+   *
+   * \param interface the identifier of the interface
+   * \param timestamp the capture time, in nanoseconds
+   * \param data Data buffer
+   * \param totalLen Total packet length
+   */
+  void Write (uint32_t interface, uint64_t timestamp, uint8_t const * const data, uint32_t totalLen);
+
+  /**
+   * \brief Write the next packet captured on an interface
+   *
+   * \param interface the identifier of the interface
+   * \param timestamp the capture time, in nanoseconds
+   * \param p Packet to write
+   */
+  void Write (uint32_t interface, uint64_t timestamp, Ptr<const Packet> p);
+
+  /**
+   * \brief Write the next packet captured on an interface
+   *
+   * \param interface the identifier of the interface
+   * \param timestamp the capture time, in nanoseconds
+   * \param header Header to prepend to the packet
+   * \param p Packet to write
+   */
+  void Write (uint32_t interface, uint64_t timestamp, const Header &header, Ptr<const Packet> p);
+
+private:
+  /**
+   * \brief Append room for the given number of bytes to the buffer
+   * \param size the number of bytes
+   * \returns a pointer to the bytes appended to the buffer
+   */
+  uint8_t *Reserve (uint32_t size);
+  /**
+   * \brief Append a 16 bit value to the buffer
+   * \param value the value
+   */
+  void Append16 (uint16_t value);
+  /**
+   * \brief Append a 32 bit value to the buffer
+   * \param value the value
+   */
+  void Append32 (uint32_t value);
+  /**
+   * \brief Append an option to the buffer, padded to 32 bits
+   * \param code the option code
+   * \param value the option value
+   * \param length the length of the option value
+   */
+  void AppendOption (uint16_t code, const void *value, uint16_t length);
+  /**
+   * \brief Append the header of an Enhanced Packet Block to the buffer
+   *
+   * \param interface the identifier of the interface
+   * \param timestamp the capture time, in nanoseconds
+   * \param totalLen total packet length
+   * \returns the length of the packet data to write in the block
+   */
+  uint32_t WritePacketBlockHeader (uint32_t interface, uint64_t timestamp, uint32_t totalLen);
+  /**
+   * \brief Pad the packet data and append the trailer of an Enhanced Packet Block
+   * \param inclLen the length of the packet data written in the block
+   */
+  void WritePacketBlockTrailer (uint32_t inclLen);
+  /**
+   * \brief Write the buffer to the file if it is full
+   */
+  void FlushIfFull (void);
+  /**
+   * \brief Write the buffer to the file
+   */
+  void Flush (void);
+
+  std::string m_filename;            //!< file name
+  std::ofstream m_file;              //!< file stream
+  std::vector<uint8_t> m_buffer;     //!< write buffer
+  uint32_t m_bufferSize;             //!< size of the write buffer
+  std::vector<uint32_t> m_snapLen;   //!< snapshot length of each interface
+  std::vector<uint32_t> m_dataLinkType; //!< data link type of each interface
+  bool m_async;                      //!< whether the file is written by the asynchronous writer
+  bool m_asyncFailed;                //!< whether an asynchronous write failed
+  uint32_t m_asyncId;                //!< identifier of the file in the asynchronous writer
+};
+
+} // namespace ns3
+
+#endif /* PCAPNG_FILE_H */
@@ -0,0 +1,326 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2005,2006,2007 INRIA
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
+ */
+
+#ifndef TRACED_CALLBACK_H
+#define TRACED_CALLBACK_H
+
+#include <vector>
+#include "callback.h"
+#include "ptr.h"
+#include "simple-ref-count.h"
+
+/**
+ * \file
+ * \ingroup tracing
+ * ns3::TracedCallback declaration and template implementation.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup tracing
+ * \brief Forward calls to a chain of Callback
+ *
+ * A TracedCallback has almost exactly the same API as a normal
+ * Callback but instead of forwarding calls to a single function
+ * (as a Callback normally does), it forwards calls to a chain
+ * of Callback.  Connect adds a Callback at the end of the chain
+ * of callbacks.  Disconnect removes a Callback from the chain of callbacks.
+ *
+ * This is a functor: the chain of Callbacks is invoked by
+ * calling the \c operator() form with the appropriate
+ * number of arguments.
+ *
+ * Most trace sources have no sink, or a single one, and many of them are
+ * fired on the packet path.  Hence the chain is held through a single
+ * pointer, null while there is no sink: firing a trace source without
+ * sinks costs a single test, and a TracedCallback without sinks takes
+ * the size of a pointer and allocates nothing.
+ *
+ * The chain is shared by reference counting.  Firing the trace source
+ * invokes a snapshot of the chain: a Callback connected by a sink is
+ * invoked from the next time the trace source is fired, and a Callback
+ * disconnected by a sink is still invoked this time.  Connect and
+ * Disconnect copy the chain rather than modify it while it is invoked,
+ * or shared with a copy of the TracedCallback.
+ *
+ * \tparam Ts \explicit Types of the functor arguments.
+ */
+template<typename... Ts>
+class TracedCallback
+{
+public:
+  /** Constructor. */
+  TracedCallback ();
+  /**
+   * Copy constructor.
+   *
+   * \param [in] o The TracedCallback to copy.
+   */
+  TracedCallback (const TracedCallback & o);
+  /**
+   * Assignment operator.
+   *
+   * \param [in] o The TracedCallback to copy.
+   * \return This TracedCallback.
+   */
+  TracedCallback & operator = (const TracedCallback & o);
+  /** Destructor. */
+  ~TracedCallback ();
+  /**
+   * Append a Callback to the chain (without a context).
+   *
+   * \param [in] callback Callback to add to chain.
+   */
+  void ConnectWithoutContext (const CallbackBase & callback);
+  /**
+   * Append a Callback to the chain with a context.
+   *
+   * The context string will be provided as the first argument
+   * to the Callback.
+   *
+   * \param [in] callback Callback to add to chain.
+   * \param [in] path Context string to provide when invoking the Callback.
+   */
+  void Connect (const CallbackBase & callback, std::string path);
+  /**
+   * Remove from the chain a Callback which was connected without a context.
+   *
+   * \param [in] callback Callback to remove from the chain.
+   */
+  void DisconnectWithoutContext (const CallbackBase & callback);
+  /**
+   * Remove from the chain a Callback which was connected with a context.
+   *
+   * \param [in] callback Callback to remove from the chain.
+   * \param [in] path Context path which was used to connect the Callback.
+   */
+  void Disconnect (const CallbackBase & callback, std::string path);
+  /**
+   * \brief Functor which invokes the chain of Callbacks.
+   * \tparam Ts \deduced Types of the functor arguments.
+   * \param [in] args The arguments to the functor
+   */
+  void operator() (Ts... args) const;
+  /**
+   * \brief Checks if the Callbacks list is empty.
+   * \return true if the Callbacks list is empty.
+   */
+  bool IsEmpty () const;
+
+  /**
+   *  TracedCallback signature for POD.
+   *
+   * \param [in] value Value of the traced variable.
+   * @{
+   */
+  // Uint32Callback appears to be the only one used at the moment.
+  // Feel free to add typedef's for any other POD you need.
+  typedef void (* Uint32Callback)(const uint32_t value);
+  /**@}*/
+
+private:
+  /**
+   * Container type for holding the chain of Callbacks after the first one.
+   *
+   * \tparam Ts \deduced Types of the functor arguments.
+   */
+  typedef std::vector<Callback<void,Ts...> > CallbackList;
+  /**
+   * The chain of Callbacks, shared by reference counting.  The first
+   * Callback is stored inline, to save an indirection when the trace
+   * source has a single sink.
+   */
+  struct Chain : public SimpleRefCount<Chain>
+  {
+    Callback<void,Ts...> first;  //!< The first Callback
+    CallbackList others;         //!< The other Callbacks, in the order they were connected
+  };
+  /**
+   * Get the chain to modify, which is not shared with a snapshot being
+   * invoked or with another TracedCallback.
+   *
+   * \return The chain to modify.
+   */
+  Chain * GetUnsharedChain (void);
+  /**
+   * Append a Callback to the chain.
+   *
+   * \param [in] callback Callback to add to chain.
+   */
+  void Append (const Callback<void,Ts...> & callback);
+  /** The chain of Callbacks, null if the chain is empty. */
+  Ptr<Chain> m_chain;
+};
+
+} // namespace ns3
+
+
+/********************************************************************
+ *  Implementation of the templates declared above.
+ ********************************************************************/
+
+namespace ns3 {
+
+template<typename... Ts>
+TracedCallback<Ts...>::TracedCallback ()
+  : m_chain (0)
+{}
+template<typename... Ts>
+TracedCallback<Ts...>::TracedCallback (const TracedCallback & o)
+  : m_chain (o.m_chain)
+{}
+template<typename... Ts>
+TracedCallback<Ts...> &
+TracedCallback<Ts...>::operator = (const TracedCallback & o)
+{
+  m_chain = o.m_chain;
+  return *this;
+}
+template<typename... Ts>
+TracedCallback<Ts...>::~TracedCallback ()
+{}
+template<typename... Ts>
+typename TracedCallback<Ts...>::Chain *
+TracedCallback<Ts...>::GetUnsharedChain (void)
+{
+  if (m_chain == 0)
+    {
+      m_chain = Create<Chain> ();
+    }
+  else if (m_chain->GetReferenceCount () > 1)
+    {
+      m_chain = Create<Chain> (*m_chain);
+    }
+  return PeekPointer (m_chain);
+}
+template<typename... Ts>
+void
+TracedCallback<Ts...>::Append (const Callback<void,Ts...> & callback)
+{
+  Chain *chain = GetUnsharedChain ();
+  if (chain->first.IsNull ())
+    {
+      chain->first = callback;
+    }
+  else
+    {
+      chain->others.push_back (callback);
+    }
+}
+template<typename... Ts>
+void
+TracedCallback<Ts...>::ConnectWithoutContext (const CallbackBase & callback)
+{
+  Callback<void,Ts...> cb;
+  if (!cb.Assign (callback))
+    {
+      NS_FATAL_ERROR_NO_MSG ();
+    }
+  Append (cb);
+}
+template<typename... Ts>
+void
+TracedCallback<Ts...>::Connect (const CallbackBase & callback, std::string path)
+{
+  Callback<void,std::string,Ts...> cb;
+  if (!cb.Assign (callback))
+    {
+      NS_FATAL_ERROR ("when connecting to " << path);
+    }
+  Callback<void,Ts...> realCb = cb.Bind (path);
+  Append (realCb);
+}
+template<typename... Ts>
+void
+TracedCallback<Ts...>::DisconnectWithoutContext (const CallbackBase & callback)
+{
+  if (m_chain == 0)
+    {
+      return;
+    }
+  Chain *chain = GetUnsharedChain ();
+  for (typename CallbackList::iterator i = chain->others.begin ();
+       i != chain->others.end (); /* empty */)
+    {
+      if ((*i).IsEqual (callback))
+        {
+          i = chain->others.erase (i);
+        }
+      else
+        {
+          i++;
+        }
+    }
+  if (chain->first.IsEqual (callback))
+    {
+      // the next Callback (if any) becomes the first one
+      if (chain->others.empty ())
+        {
+          m_chain = 0;
+        }
+      else
+        {
+          chain->first = chain->others.front ();
+          chain->others.erase (chain->others.begin ());
+        }
+    }
+}
+template<typename... Ts>
+void
+TracedCallback<Ts...>::Disconnect (const CallbackBase & callback, std::string path)
+{
+  Callback<void,std::string,Ts...> cb;
+  if (!cb.Assign (callback))
+    {
+      NS_FATAL_ERROR ("when disconnecting from " << path);
+    }
+  Callback<void,Ts...> realCb = cb.Bind (path);
+  DisconnectWithoutContext (realCb);
+}
+template<typename... Ts>
+void
+TracedCallback<Ts...>::operator() (Ts... args) const
+{
+  if (m_chain == 0)
+    {
+      return;
+    }
+  // the snapshot is not modified by the sinks, which may connect and
+  // disconnect Callbacks
+  Ptr<const Chain> snapshot = m_chain;
+  snapshot->first (args...);
+  for (typename CallbackList::const_iterator i = snapshot->others.begin ();
+       i != snapshot->others.end (); i++)
+    {
+      (*i)(args...);
+    }
+}
+
+template <typename... Ts>
+bool
+TracedCallback<Ts...>::IsEmpty () const
+{
+  return m_chain == 0;
+}
+
+} // namespace ns3
+
+#endif /* TRACED_CALLBACK_H */
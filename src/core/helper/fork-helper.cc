@@ -0,0 +1,182 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cstdio>
+#include <limits>
+#include <sstream>
+#include "ns3/simulator.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/system-path.h"
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/abort.h"
+#include "fork-helper.h"
+
+/**
+ * \file
+ * \ingroup core-helpers
+ * ns3::ForkHelper implementation.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("ForkHelper");
+
+ForkHelper::ForkHelper (uint32_t n)
+  : m_n (n),
+    m_setRun (false),
+    m_firstRun (0),
+    m_index (0)
+{
+  NS_LOG_FUNCTION (this << n);
+}
+
+ForkHelper::~ForkHelper ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+ForkHelper::SetFirstRun (uint64_t run)
+{
+  NS_LOG_FUNCTION (this << run);
+  m_setRun = true;
+  m_firstRun = run;
+}
+
+void
+ForkHelper::SetChildCallback (Callback<void, uint32_t> callback)
+{
+  NS_LOG_FUNCTION (this << &callback);
+  m_childCallback = callback;
+}
+
+void
+ForkHelper::ForkAt (const Time &time)
+{
+  NS_LOG_FUNCTION (this << time);
+  NS_ASSERT_MSG (time >= Simulator::Now (), "Cannot fork in the past");
+  Simulator::Schedule (time - Simulator::Now (), &ForkHelper::Fork, this);
+}
+
+uint32_t
+ForkHelper::GetNChildren (void) const
+{
+  return m_n;
+}
+
+bool
+ForkHelper::IsChild (void) const
+{
+  return m_index != 0;
+}
+
+uint32_t
+ForkHelper::GetChildIndex (void) const
+{
+  return m_index;
+}
+
+std::string
+ForkHelper::GetResultFileName (uint32_t child) const
+{
+  std::ostringstream oss;
+  oss << "child-" << child;
+  return SystemPath::Append (m_directory, oss.str ());
+}
+
+void
+ForkHelper::Fork (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_directory = SystemPath::MakeTemporaryDirectoryName ();
+  SystemPath::MakeDirectories (m_directory);
+
+  m_index = Simulator::Fork (m_n);
+  if (m_index != 0)
+    {
+      std::string filename = GetResultFileName (m_index);
+      m_output.open (filename.c_str ());
+      NS_ABORT_MSG_UNLESS (m_output, "Unable to open " << filename);
+      m_output.precision (std::numeric_limits<double>::max_digits10);
+      if (m_setRun)
+        {
+          RngSeedManager::SetRun (m_firstRun + m_index - 1);
+          RandomVariableStream::ResetStreams ();
+        }
+      if (!m_childCallback.IsNull ())
+        {
+          m_childCallback (m_index);
+        }
+      return;
+    }
+
+  m_results.assign (m_n, Results ());
+  for (uint32_t i = 1; i <= m_n; ++i)
+    {
+      std::string filename = GetResultFileName (i);
+      std::ifstream input (filename.c_str ());
+      std::string line;
+      while (std::getline (input, line))
+        {
+          std::string::size_type tab = line.rfind ('\t');
+          if (tab == std::string::npos)
+            {
+              continue;
+            }
+          std::istringstream iss (line.substr (tab + 1));
+          double value;
+          if (iss >> value)
+            {
+              m_results[i - 1][line.substr (0, tab)] = value;
+            }
+        }
+      input.close ();
+      std::remove (filename.c_str ());
+    }
+  std::remove (m_directory.c_str ());
+  Simulator::Stop ();
+}
+
+void
+ForkHelper::Report (std::string name, double value)
+{
+  NS_LOG_FUNCTION (this << name << value);
+  NS_ASSERT_MSG (IsChild (), "Only child processes report results");
+  m_output << name << '\t' << value << std::endl;
+}
+
+bool
+ForkHelper::HasResult (uint32_t child, std::string name) const
+{
+  NS_LOG_FUNCTION (this << child << name);
+  NS_ASSERT (child >= 1 && child <= m_results.size ());
+  return m_results[child - 1].find (name) != m_results[child - 1].end ();
+}
+
+double
+ForkHelper::GetResult (uint32_t child, std::string name) const
+{
+  NS_LOG_FUNCTION (this << child << name);
+  NS_ASSERT (child >= 1 && child <= m_results.size ());
+  Results::const_iterator it = m_results[child - 1].find (name);
+  NS_ABORT_MSG_IF (it == m_results[child - 1].end (),
+                   "Child " << child << " did not report " << name);
+  return it->second;
+}
+
+} // namespace ns3
@@ -0,0 +1,373 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "adaptive-wall-clock-synchronizer.h"
+#include "log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>     // strerror
+#include <ctime>       // clock_gettime
+
+#ifdef __linux__
+#include <cerrno>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @file
+ * @ingroup realtime
+ * ns3::AdaptiveWallClockSynchronizer implementation.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("AdaptiveWallClockSynchronizer");
+
+NS_OBJECT_ENSURE_REGISTERED (AdaptiveWallClockSynchronizer);
+
+namespace {
+
+/** Conversion constant between ns and s. */
+const uint64_t NS_PER_SEC = 1000000000;
+/** Number of sleeps of the initial calibration. */
+const int CALIBRATION_SLEEPS = 8;
+/** Duration of the sleeps of the initial calibration, in ns. */
+const uint64_t CALIBRATION_SLEEP = 200000;
+
+} // unnamed namespace
+
+TypeId
+AdaptiveWallClockSynchronizer::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::AdaptiveWallClockSynchronizer")
+    .SetParent<Synchronizer> ()
+    .SetGroupName ("Core")
+    .AddConstructor<AdaptiveWallClockSynchronizer> ()
+    .AddAttribute ("MinSpin",
+                   "Minimum time spent spinning before each event.",
+                   TimeValue (MicroSeconds (5)),
+                   MakeTimeAccessor (&AdaptiveWallClockSynchronizer::m_minSpin),
+                   MakeTimeChecker (Time (0)))
+    .AddAttribute ("MaxSpin",
+                   "Maximum time spent spinning before each event.",
+                   TimeValue (MilliSeconds (2)),
+                   MakeTimeAccessor (&AdaptiveWallClockSynchronizer::m_maxSpin),
+                   MakeTimeChecker (Time (0)))
+    .AddAttribute ("BatchWindow",
+                   "The events due within this time are processed without "
+                   "waiting, in the same wake-up.",
+                   TimeValue (Time (0)),
+                   MakeTimeAccessor (&AdaptiveWallClockSynchronizer::m_batchWindow),
+                   MakeTimeChecker (Time (0)))
+  ;
+  return tid;
+}
+
+AdaptiveWallClockSynchronizer::AdaptiveWallClockSynchronizer ()
+  : m_oversleep (0),
+    m_deviation (0),
+    m_spinTail (0),
+    m_nsEventStart (0),
+    m_timerFd (-1),
+    m_eventFd (-1)
+{
+  NS_LOG_FUNCTION (this);
+#ifdef __linux__
+  m_timerFd = timerfd_create (CLOCK_MONOTONIC, TFD_CLOEXEC);
+  m_eventFd = eventfd (0, EFD_CLOEXEC | EFD_NONBLOCK);
+  if (m_timerFd < 0 || m_eventFd < 0)
+    {
+      NS_LOG_WARN ("timerfd or eventfd unavailable, sleeping on a condition");
+      if (m_timerFd >= 0)
+        {
+          close (m_timerFd);
+        }
+      if (m_eventFd >= 0)
+        {
+          close (m_eventFd);
+        }
+      m_timerFd = -1;
+      m_eventFd = -1;
+    }
+#endif
+}
+
+AdaptiveWallClockSynchronizer::~AdaptiveWallClockSynchronizer ()
+{
+  NS_LOG_FUNCTION (this);
+#ifdef __linux__
+  if (m_timerFd >= 0)
+    {
+      close (m_timerFd);
+      close (m_eventFd);
+    }
+#endif
+}
+
+Time
+AdaptiveWallClockSynchronizer::GetSpinTail (void) const
+{
+  return NanoSeconds (m_spinTail);
+}
+
+bool
+AdaptiveWallClockSynchronizer::DoRealtime (void)
+{
+  NS_LOG_FUNCTION (this);
+  return true;
+}
+
+uint64_t
+AdaptiveWallClockSynchronizer::DoGetCurrentRealtime (void)
+{
+  NS_LOG_FUNCTION (this);
+  return GetNormalizedRealtime ();
+}
+
+void
+AdaptiveWallClockSynchronizer::DoSetOrigin (uint64_t ns)
+{
+  NS_LOG_FUNCTION (this << ns);
+  m_realtimeOriginNano = GetRealtime ();
+  InitialCalibration ();
+  // the calibration must not count as simulation time
+  m_realtimeOriginNano = GetRealtime ();
+  NS_LOG_INFO ("origin = " << m_realtimeOriginNano << ", spin tail = " << m_spinTail);
+}
+
+int64_t
+AdaptiveWallClockSynchronizer::DoGetDrift (uint64_t ns)
+{
+  NS_LOG_FUNCTION (this << ns);
+  uint64_t nsNow = GetNormalizedRealtime ();
+  if (nsNow > ns)
+    {
+      return (int64_t)(nsNow - ns);
+    }
+  else
+    {
+      return -(int64_t)(ns - nsNow);
+    }
+}
+
+bool
+AdaptiveWallClockSynchronizer::DoSynchronize (uint64_t nsCurrent, uint64_t nsDelay)
+{
+  NS_LOG_FUNCTION (this << nsCurrent << nsDelay);
+  //
+  // In batch mode, the events due soon enough are processed right away,
+  // without paying for another wake-up.
+  //
+  if (nsDelay <= static_cast<uint64_t> (m_batchWindow.GetNanoSeconds ()))
+    {
+      return true;
+    }
+  //
+  // The wait is for an absolute time, so that any drift accumulated by
+  // the previous events is caught up without further correction.
+  //
+  uint64_t target = nsCurrent + nsDelay;
+  uint64_t now = GetNormalizedRealtime ();
+  if (now >= target)
+    {
+      return true;
+    }
+  if (target - now > m_spinTail)
+    {
+      uint64_t wake = target - m_spinTail;
+      if (!SleepUntil (wake))
+        {
+          NS_LOG_INFO ("sleep interrupted");
+          return false;
+        }
+      now = GetNormalizedRealtime ();
+      Calibrate (now > wake ? now - wake : 0);
+      if (now >= target)
+        {
+          NS_LOG_INFO ("late by " << now - target << " ns after sleeping");
+          return true;
+        }
+    }
+  return SpinUntil (target);
+}
+
+void
+AdaptiveWallClockSynchronizer::DoSignal (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_condition.SetCondition (true);
+  m_condition.Signal ();
+#ifdef __linux__
+  if (m_eventFd >= 0)
+    {
+      uint64_t one = 1;
+      ssize_t written = write (m_eventFd, &one, sizeof (one));
+      NS_UNUSED (written);
+    }
+#endif
+}
+
+void
+AdaptiveWallClockSynchronizer::DoSetCondition (bool cond)
+{
+  NS_LOG_FUNCTION (this << cond);
+  m_condition.SetCondition (cond);
+}
+
+void
+AdaptiveWallClockSynchronizer::DoEventStart (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_nsEventStart = GetNormalizedRealtime ();
+}
+
+uint64_t
+AdaptiveWallClockSynchronizer::DoEventEnd (void)
+{
+  NS_LOG_FUNCTION (this);
+  return GetNormalizedRealtime () - m_nsEventStart;
+}
+
+uint64_t
+AdaptiveWallClockSynchronizer::GetRealtime (void) const
+{
+  struct timespec ts;
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * NS_PER_SEC + ts.tv_nsec;
+}
+
+uint64_t
+AdaptiveWallClockSynchronizer::GetNormalizedRealtime (void) const
+{
+  return GetRealtime () - m_realtimeOriginNano;
+}
+
+bool
+AdaptiveWallClockSynchronizer::SleepUntil (uint64_t ns)
+{
+  NS_LOG_FUNCTION (this << ns);
+#ifdef __linux__
+  if (m_timerFd >= 0)
+    {
+      uint64_t absolute = m_realtimeOriginNano + ns;
+      struct itimerspec spec = {};
+      spec.it_value.tv_sec = absolute / NS_PER_SEC;
+      spec.it_value.tv_nsec = absolute % NS_PER_SEC;
+      timerfd_settime (m_timerFd, TFD_TIMER_ABSTIME, &spec, 0);
+      struct pollfd fds[2] = {{m_timerFd, POLLIN, 0}, {m_eventFd, POLLIN, 0}};
+      for (;;)
+        {
+          if (m_condition.GetCondition ())
+            {
+              return false;
+            }
+          fds[0].revents = 0;
+          fds[1].revents = 0;
+          int rc = poll (fds, 2, -1);
+          if (rc < 0 && errno != EINTR)
+            {
+              NS_FATAL_ERROR ("poll failed: " << std::strerror (errno));
+            }
+          if (fds[1].revents & POLLIN)
+            {
+              // the signals sent before the condition was reset are stale
+              uint64_t count;
+              ssize_t got = read (m_eventFd, &count, sizeof (count));
+              NS_UNUSED (got);
+            }
+          if (fds[0].revents & POLLIN)
+            {
+              uint64_t expirations;
+              ssize_t got = read (m_timerFd, &expirations, sizeof (expirations));
+              NS_UNUSED (got);
+              return !m_condition.GetCondition ();
+            }
+        }
+    }
+#endif
+  uint64_t now = GetNormalizedRealtime ();
+  if (now >= ns)
+    {
+      return !m_condition.GetCondition ();
+    }
+  return m_condition.TimedWait (ns - now);
+}
+
+bool
+AdaptiveWallClockSynchronizer::SpinUntil (uint64_t ns)
+{
+  NS_LOG_FUNCTION (this << ns);
+  for (;;)
+    {
+      if (GetNormalizedRealtime () >= ns)
+        {
+          return true;
+        }
+      if (m_condition.GetCondition ())
+        {
+          return false;
+        }
+    }
+}
+
+void
+AdaptiveWallClockSynchronizer::Calibrate (uint64_t ns)
+{
+  NS_LOG_FUNCTION (this << ns);
+  //
+  // The mean and mean deviation of the lateness are smoothed like the
+  // round trip time estimates of TCP, and the spin tail covers all but
+  // the rare sleeps which wake up very late.
+  //
+  double sample = static_cast<double> (ns);
+  m_deviation += (std::fabs (sample - m_oversleep) - m_deviation) / 4;
+  m_oversleep += (sample - m_oversleep) / 8;
+  double tail = m_oversleep + 4 * m_deviation;
+  tail = std::max (tail, static_cast<double> (m_minSpin.GetNanoSeconds ()));
+  tail = std::min (tail, static_cast<double> (m_maxSpin.GetNanoSeconds ()));
+  m_spinTail = static_cast<uint64_t> (tail);
+}
+
+void
+AdaptiveWallClockSynchronizer::InitialCalibration (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_oversleep = 0;
+  m_deviation = 0;
+  m_spinTail = m_maxSpin.GetNanoSeconds ();
+  for (int i = 0; i < CALIBRATION_SLEEPS; ++i)
+    {
+      uint64_t wake = GetNormalizedRealtime () + CALIBRATION_SLEEP;
+      if (!SleepUntil (wake))
+        {
+          break;
+        }
+      uint64_t now = GetNormalizedRealtime ();
+      uint64_t late = now > wake ? now - wake : 0;
+      if (i == 0)
+        {
+          m_oversleep = static_cast<double> (late);
+          m_deviation = m_oversleep / 2;
+        }
+      Calibrate (late);
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,454 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "arena-allocator.h"
+#include "global-value.h"
+#include "boolean.h"
+#include "log.h"
+#include "ns3/core-config.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <mutex>
+#include <new>
+
+#ifdef HAVE_PTHREAD_H
+#include <pthread.h>  // pthread_atfork
+#endif
+
+/**
+ * \file
+ * \ingroup core
+ * ns3::ArenaAllocator implementation.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("ArenaAllocator");
+
+namespace {
+
+/** Alignment and size increment of the size classes. */
+const std::size_t ALIGNMENT = 16;
+/** Size of the largest size class. */
+const std::size_t MAX_SIZE = 512;
+/** Number of size classes. */
+const std::size_t CLASSES = MAX_SIZE / ALIGNMENT;
+/** Size of the chunks. */
+const std::size_t CHUNK_SIZE = 64 * 1024;
+/** Number of blocks moved at once between a thread cache and the arenas. */
+const uint32_t CACHE_BATCH = 32;
+/** Maximum number of free blocks of a size class in a thread cache. */
+const uint32_t CACHE_MAX = 4 * CACHE_BATCH;
+
+/** A free block, linked to the next free block of its size class. */
+struct FreeBlock
+{
+  FreeBlock *next;  //!< Next free block
+};
+
+/**
+ * \ingroup core
+ * The arenas of the size classes.
+ */
+struct Arenas
+{
+  /** The arena of a size class. */
+  struct Arena
+  {
+    std::vector<void *> chunks;  //!< Chunks of the arena
+    FreeBlock *free = 0;         //!< Free blocks
+    uint64_t freeCount = 0;      //!< Number of free blocks
+    uint64_t blocks = 0;         //!< Number of blocks in the chunks
+    uint64_t peak = 0;           //!< Maximum number of used blocks
+  };
+
+  std::mutex mutex;              //!< Protects the arenas
+  Arena arenas[CLASSES];         //!< Arenas, by size class
+  uint64_t releases = 0;         //!< Number of chunks released
+  std::atomic<uint64_t> large {0};  //!< Instances too large for the arenas
+
+#ifdef HAVE_PTHREAD_H
+  /** Take the lock before a fork, so that the child gets it unlocked. */
+  static void PrepareFork (void);
+  /** Release the lock after a fork. */
+  static void ResumeFork (void);
+#endif
+};
+
+/**
+ * \ingroup core
+ * \return The arenas, created on first use and never destroyed, since
+ *         the instances can be deallocated after the static
+ *         destruction.
+ */
+Arenas *
+GetArenas (void)
+{
+  static Arenas *arenas = new Arenas ();
+#ifdef HAVE_PTHREAD_H
+  static bool forkHandlers = (pthread_atfork (&Arenas::PrepareFork,
+                                              &Arenas::ResumeFork,
+                                              &Arenas::ResumeFork) == 0);
+  NS_UNUSED (forkHandlers);
+#endif
+  return arenas;
+}
+
+#ifdef HAVE_PTHREAD_H
+void
+Arenas::PrepareFork (void)
+{
+  GetArenas ()->mutex.lock ();
+}
+
+void
+Arenas::ResumeFork (void)
+{
+  GetArenas ()->mutex.unlock ();
+}
+#endif
+
+/**
+ * \ingroup core
+ * \param [in] size The size of an instance.
+ * \return The size class of the instance.
+ */
+inline std::size_t
+GetSizeClass (std::size_t size)
+{
+  return size == 0 ? 0 : (size - 1) / ALIGNMENT;
+}
+
+/**
+ * \ingroup core
+ * Take a block from an arena, adding a chunk if it has no free block.
+ * The lock of the arenas must be held.
+ * \param [in] arena The arena.
+ * \param [in] sizeClass The size class of the arena.
+ * \return The block.
+ */
+FreeBlock *
+TakeBlock (Arenas::Arena &arena, std::size_t sizeClass)
+{
+  if (arena.free == 0)
+    {
+      std::size_t blockSize = (sizeClass + 1) * ALIGNMENT;
+      uint8_t *chunk = static_cast<uint8_t *> (::operator new (CHUNK_SIZE));
+      arena.chunks.push_back (chunk);
+      for (std::size_t offset = CHUNK_SIZE - CHUNK_SIZE % blockSize;
+           offset >= blockSize; offset -= blockSize)
+        {
+          FreeBlock *block = reinterpret_cast<FreeBlock *> (chunk + offset - blockSize);
+          block->next = arena.free;
+          arena.free = block;
+          arena.freeCount++;
+          arena.blocks++;
+        }
+    }
+  FreeBlock *block = arena.free;
+  arena.free = block->next;
+  arena.freeCount--;
+  arena.peak = std::max (arena.peak, arena.blocks - arena.freeCount);
+  return block;
+}
+
+/**
+ * \ingroup core
+ * Give a block back to an arena.  The lock of the arenas must be held.
+ * \param [in] arena The arena.
+ * \param [in] block The block.
+ */
+inline void
+GiveBlock (Arenas::Arena &arena, FreeBlock *block)
+{
+  block->next = arena.free;
+  arena.free = block;
+  arena.freeCount++;
+}
+
+/**
+ * \ingroup core
+ * The free blocks cached by a thread.  The cache is trivially
+ * constructible and destructible, so that it can be accessed without
+ * checking its initialization, and remains valid after being flushed
+ * at the exit of the thread.
+ */
+struct ThreadCache
+{
+  FreeBlock *free[CLASSES];   //!< Free blocks, by size class
+  uint32_t count[CLASSES];    //!< Number of free blocks, by size class
+  /** The state of the cache. */
+  enum State
+  {
+    UNUSED = 0,   //!< Never used by the thread
+    OPEN,         //!< Used by the thread
+    CLOSED        //!< Flushed at the exit of the thread
+  } state;        //!< The state of the cache
+
+  /**
+   * Give blocks of a size class back to the arenas.
+   * \param [in] sizeClass The size class.
+   * \param [in] n The number of blocks.
+   */
+  void Drain (std::size_t sizeClass, uint32_t n);
+  /** Give all the blocks back to the arenas. */
+  void Flush (void);
+};
+
+/** The cache of each thread. */
+thread_local ThreadCache g_cache;
+
+/**
+ * \ingroup core
+ * Flush the cache of a thread, and close it, when the thread exits.
+ */
+struct ThreadCacheCloser
+{
+  /** Open the cache. */
+  void Open (void)
+  {
+    g_cache.state = ThreadCache::OPEN;
+  }
+  /** Flush and close the cache. */
+  ~ThreadCacheCloser ()
+  {
+    g_cache.Flush ();
+    g_cache.state = ThreadCache::CLOSED;
+  }
+};
+
+/** Closes the cache of each thread which opened it. */
+thread_local ThreadCacheCloser g_cacheCloser;
+
+void
+ThreadCache::Drain (std::size_t sizeClass, uint32_t n)
+{
+  Arenas *arenas = GetArenas ();
+  std::lock_guard<std::mutex> lock (arenas->mutex);
+  Arenas::Arena &arena = arenas->arenas[sizeClass];
+  for (uint32_t i = 0; i < n && free[sizeClass] != 0; ++i)
+    {
+      FreeBlock *block = free[sizeClass];
+      free[sizeClass] = block->next;
+      count[sizeClass]--;
+      GiveBlock (arena, block);
+    }
+}
+
+void
+ThreadCache::Flush (void)
+{
+  for (std::size_t sizeClass = 0; sizeClass < CLASSES; ++sizeClass)
+    {
+      if (count[sizeClass] != 0)
+        {
+          Drain (sizeClass, count[sizeClass]);
+        }
+    }
+}
+
+/**
+ * \ingroup core
+ * Allocate a block when the cache of the thread has none.
+ * \param [in] sizeClass The size class of the block.
+ * \return The block.
+ */
+void *
+AllocateSlow (std::size_t sizeClass)
+{
+  if (g_cache.state == ThreadCache::UNUSED)
+    {
+      // the closer is constructed, and will close the cache, on first use
+      g_cacheCloser.Open ();
+    }
+  Arenas *arenas = GetArenas ();
+  std::lock_guard<std::mutex> lock (arenas->mutex);
+  Arenas::Arena &arena = arenas->arenas[sizeClass];
+  FreeBlock *block = TakeBlock (arena, sizeClass);
+  if (g_cache.state == ThreadCache::OPEN)
+    {
+      for (uint32_t i = 1; i < CACHE_BATCH; ++i)
+        {
+          FreeBlock *cached = TakeBlock (arena, sizeClass);
+          cached->next = g_cache.free[sizeClass];
+          g_cache.free[sizeClass] = cached;
+          g_cache.count[sizeClass]++;
+        }
+    }
+  return block;
+}
+
+/**
+ * \ingroup core
+ * Whether the arenas are used.  Since the blocks must be deallocated
+ * the way they were allocated, it is read once, at the first
+ * allocation.
+ */
+GlobalValue g_arenaAllocator ("ArenaAllocator",
+                              "Allocate the packets and the other small instances "
+                              "in arenas (read once, from NS_GLOBAL_VALUE)",
+                              BooleanValue (false),
+                              MakeBooleanChecker ());
+
+} // unnamed namespace
+
+
+bool
+ArenaAllocator::IsEnabled (void)
+{
+  static const bool enabled = [] ()
+    {
+      BooleanValue value;
+      g_arenaAllocator.GetValue (value);
+      return value.Get ();
+    } ();
+  return enabled;
+}
+
+void *
+ArenaAllocator::Allocate (std::size_t size)
+{
+  if (size > MAX_SIZE || !IsEnabled ())
+    {
+      if (size > MAX_SIZE)
+        {
+          GetArenas ()->large.fetch_add (1, std::memory_order_relaxed);
+        }
+      return ::operator new (size);
+    }
+  std::size_t sizeClass = GetSizeClass (size);
+  FreeBlock *block = g_cache.free[sizeClass];
+  if (block != 0)
+    {
+      g_cache.free[sizeClass] = block->next;
+      g_cache.count[sizeClass]--;
+      return block;
+    }
+  return AllocateSlow (sizeClass);
+}
+
+void
+ArenaAllocator::Deallocate (void *p, std::size_t size)
+{
+  if (size > MAX_SIZE || !IsEnabled ())
+    {
+      ::operator delete (p);
+      return;
+    }
+  std::size_t sizeClass = GetSizeClass (size);
+  FreeBlock *block = static_cast<FreeBlock *> (p);
+  if (g_cache.state == ThreadCache::UNUSED)
+    {
+      g_cacheCloser.Open ();
+    }
+  else if (g_cache.state == ThreadCache::CLOSED)
+    {
+      Arenas *arenas = GetArenas ();
+      std::lock_guard<std::mutex> lock (arenas->mutex);
+      GiveBlock (arenas->arenas[sizeClass], block);
+      return;
+    }
+  block->next = g_cache.free[sizeClass];
+  g_cache.free[sizeClass] = block;
+  if (++g_cache.count[sizeClass] > CACHE_MAX)
+    {
+      g_cache.Drain (sizeClass, CACHE_MAX - CACHE_BATCH);
+    }
+}
+
+void
+ArenaAllocator::Release (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  if (!IsEnabled ())
+    {
+      return;
+    }
+  g_cache.Flush ();
+  Arenas *arenas = GetArenas ();
+  std::lock_guard<std::mutex> lock (arenas->mutex);
+  for (std::size_t sizeClass = 0; sizeClass < CLASSES; ++sizeClass)
+    {
+      Arenas::Arena &arena = arenas->arenas[sizeClass];
+      if (arena.blocks != 0 && arena.freeCount == arena.blocks)
+        {
+          NS_LOG_LOGIC ("release " << arena.chunks.size () << " chunks of "
+                                   << (sizeClass + 1) * ALIGNMENT << " bytes blocks");
+          for (void *chunk : arena.chunks)
+            {
+              ::operator delete (chunk);
+            }
+          arenas->releases += arena.chunks.size ();
+          arena = Arenas::Arena ();
+        }
+    }
+}
+
+ArenaAllocator::Stats
+ArenaAllocator::GetStats (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  Stats stats;
+  stats.enabled = IsEnabled ();
+  stats.chunks = 0;
+  Arenas *arenas = GetArenas ();
+  std::lock_guard<std::mutex> lock (arenas->mutex);
+  for (std::size_t sizeClass = 0; sizeClass < CLASSES; ++sizeClass)
+    {
+      const Arenas::Arena &arena = arenas->arenas[sizeClass];
+      if (!arena.chunks.empty ())
+        {
+          SizeClass size = {(sizeClass + 1) * ALIGNMENT, arena.chunks.size (), arena.blocks,
+                            arena.blocks - arena.freeCount, arena.peak};
+          stats.sizeClasses.push_back (size);
+          stats.chunks += arena.chunks.size ();
+        }
+    }
+  stats.bytes = stats.chunks * CHUNK_SIZE;
+  stats.releases = arenas->releases;
+  stats.large = arenas->large.load (std::memory_order_relaxed);
+  return stats;
+}
+
+void
+ArenaAllocator::Print (std::ostream &os)
+{
+  NS_LOG_FUNCTION (&os);
+  Stats stats = GetStats ();
+  std::ios::fmtflags flags = os.flags ();
+  os << "Arena allocator: " << (stats.enabled ? "enabled" : "disabled") << ", "
+     << stats.chunks << " chunks, " << stats.bytes << " bytes, "
+     << stats.releases << " chunks released, "
+     << stats.large << " large instances" << std::endl;
+  os << std::setw (8) << "Size"
+     << std::setw (10) << "Chunks"
+     << std::setw (12) << "Blocks"
+     << std::setw (12) << "Used"
+     << std::setw (12) << "Peak" << std::endl;
+  for (const SizeClass &size : stats.sizeClasses)
+    {
+      os << std::setw (8) << size.blockSize
+         << std::setw (10) << size.chunks
+         << std::setw (12) << size.blocks
+         << std::setw (12) << size.used
+         << std::setw (12) << size.peak << std::endl;
+    }
+  os.flags (flags);
+}
+
+} // namespace ns3
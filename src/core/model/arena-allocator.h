@@ -0,0 +1,154 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef ARENA_ALLOCATOR_H
+#define ARENA_ALLOCATOR_H
+
+#include <cstddef>
+#include <ostream>
+#include <vector>
+#include <stdint.h>
+
+/**
+ * \file
+ * \ingroup core
+ * ns3::ArenaAllocator and ns3::ArenaAllocated declarations.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup core
+ *
+ * \brief Allocate the small, frequently created instances in arenas
+ *
+ * The memory is allocated in chunks of 64 KiB, each divided in blocks
+ * of a size class, a multiple of 16 bytes up to 512 bytes, so that the
+ * instances of the same size are packed together instead of being
+ * scattered by the global allocator.  Each thread keeps a cache of free
+ * blocks of each size class, refilled from and returned to the arenas
+ * in batches, so that most allocations and deallocations take no lock.
+ * The larger instances are allocated with the global operator new.
+ *
+ * The chunks of the size classes which have no instance left are
+ * released by Release, which is called by Simulator::Destroy, so that
+ * the arenas are bound to the lifetime of the simulations.
+ *
+ * The arenas are used by the classes deriving from ArenaAllocated, such
+ * as Packet and QueueItem, once they are enabled by setting the
+ * ArenaAllocator GlobalValue to true with the NS_GLOBAL_VALUE
+ * environment variable.  Otherwise, these classes are allocated with the
+ * global operator new.  Since the blocks must be deallocated the way
+ * they were allocated, the GlobalValue is read once, at the first
+ * allocation, and changing it later has no effect.
+ */
+class ArenaAllocator
+{
+public:
+  /** The statistics of a size class. */
+  struct SizeClass
+  {
+    std::size_t blockSize;  //!< Size of the blocks
+    uint64_t chunks;        //!< Number of chunks
+    uint64_t blocks;        //!< Number of blocks in the chunks
+    uint64_t used;          //!< Blocks allocated or in the thread caches
+    uint64_t peak;          //!< Maximum number of used blocks
+  };
+
+  /** The statistics of the arenas. */
+  struct Stats
+  {
+    bool enabled;                      //!< Whether the arenas are used
+    uint64_t chunks;                   //!< Number of chunks
+    uint64_t bytes;                    //!< Memory of the chunks
+    uint64_t releases;                 //!< Number of chunks released
+    uint64_t large;                    //!< Instances too large for the arenas
+    std::vector<SizeClass> sizeClasses;  //!< Size classes with chunks
+  };
+
+  /**
+   * Allocate a block.
+   * \param [in] size The size of the block.
+   * \return The block.
+   */
+  static void * Allocate (std::size_t size);
+  /**
+   * Deallocate a block allocated by Allocate.
+   * \param [in] p The block.
+   * \param [in] size The size of the block.
+   */
+  static void Deallocate (void *p, std::size_t size);
+  /** \return \c true if the blocks are allocated in the arenas. */
+  static bool IsEnabled (void);
+  /**
+   * Return the free blocks cached by the calling thread to the arenas,
+   * and release the chunks of the size classes which have no block in
+   * use.
+   */
+  static void Release (void);
+  /**
+   * \return The statistics of the arenas.  The blocks in the caches of
+   *         the threads are counted as used.
+   */
+  static Stats GetStats (void);
+  /**
+   * Print the statistics of the arenas.
+   * \param [in] os The output stream.
+   */
+  static void Print (std::ostream &os);
+};
+
+/**
+ * \ingroup core
+ *
+ * \brief Base class of the classes allocated by ArenaAllocator
+ *
+ * A class opts in by deriving from ArenaAllocated, for example an
+ * Object subclass created in large numbers:
+ * \code
+ *   class MyHeaderHolder : public Object, public ArenaAllocated
+ * \endcode
+ * The instances of the derived classes are then allocated in the size
+ * class of their dynamic type, as long as the class hierarchy has a
+ * virtual destructor or the instances are deleted through a pointer to
+ * their dynamic type.
+ */
+class ArenaAllocated
+{
+public:
+  /**
+   * Allocate an instance.
+   * \param [in] size The size of the instance.
+   * \return The memory of the instance.
+   */
+  static void * operator new (std::size_t size)
+  {
+    return ArenaAllocator::Allocate (size);
+  }
+  /**
+   * Deallocate an instance.
+   * \param [in] p The memory of the instance.
+   * \param [in] size The size of the instance.
+   */
+  static void operator delete (void *p, std::size_t size)
+  {
+    ArenaAllocator::Deallocate (p, size);
+  }
+};
+
+} // namespace ns3
+
+#endif /* ARENA_ALLOCATOR_H */
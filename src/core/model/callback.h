@@ -28,7 +28,10 @@
 #include "attribute.h"
 #include "attribute-helper.h"
 #include "simple-ref-count.h"
+#include "unused.h"
 #include <typeinfo>
+#include <type_traits>
+#include <new>
 
 /**
  * \file
@@ -122,6 +125,23 @@ public:
    * \return The object type as a string.
    */
   virtual std::string GetTypeid (void) const = 0;
+  /**
+   * Copy this implementation, either into the inline storage of a
+   * Callback or onto the heap.
+   *
+   * Only the implementations which can be stored inline (see
+   * CallbackBase) need to override this method.
+   *
+   * \param [in] buffer The storage to construct the copy into,
+   *             or null to allocate the copy on the heap.
+   * \return The copy
+   */
+  virtual CallbackImplBase * CopyTo (void *buffer) const
+  {
+    NS_UNUSED (buffer);
+    NS_FATAL_ERROR ("This callback implementation cannot be copied");
+    return 0;
+  }
 
 protected:
   /**
@@ -584,6 +604,16 @@ public:
     return true;
   }
 
+  /** \copydoc CallbackImplBase::CopyTo */
+  virtual CallbackImplBase * CopyTo (void *buffer) const
+  {
+    if (buffer == 0)
+      {
+        return new FunctorCallbackImpl (*this);
+      }
+    return new (buffer) FunctorCallbackImpl (*this);
+  }
+
 private:
   T m_functor;                          //!< the functor
 };
@@ -749,6 +779,16 @@ public:
     return true;
   }
 
+  /** \copydoc CallbackImplBase::CopyTo */
+  virtual CallbackImplBase * CopyTo (void *buffer) const
+  {
+    if (buffer == 0)
+      {
+        return new MemPtrCallbackImpl (*this);
+      }
+    return new (buffer) MemPtrCallbackImpl (*this);
+  }
+
 private:
   OBJ_PTR const m_objPtr;               //!< the object pointer
   MEM_PTR m_memPtr;                     //!< the member function pointer
@@ -903,6 +943,16 @@ public:
     return true;
   }
 
+  /** \copydoc CallbackImplBase::CopyTo */
+  virtual CallbackImplBase * CopyTo (void *buffer) const
+  {
+    if (buffer == 0)
+      {
+        return new BoundFunctorCallbackImpl (*this);
+      }
+    return new (buffer) BoundFunctorCallbackImpl (*this);
+  }
+
 private:
   T m_functor;                          //!< The functor
   typename TypeTraits<TX>::ReferencedType m_a;  //!< the bound argument
@@ -1046,6 +1096,16 @@ public:
     return true;
   }
 
+  /** \copydoc CallbackImplBase::CopyTo */
+  virtual CallbackImplBase * CopyTo (void *buffer) const
+  {
+    if (buffer == 0)
+      {
+        return new TwoBoundFunctorCallbackImpl (*this);
+      }
+    return new (buffer) TwoBoundFunctorCallbackImpl (*this);
+  }
+
 private:
   T m_functor;                                    //!< The functor
   typename TypeTraits<TX1>::ReferencedType m_a1;  //!< first bound argument
@@ -1180,6 +1240,16 @@ public:
     return true;
   }
 
+  /** \copydoc CallbackImplBase::CopyTo */
+  virtual CallbackImplBase * CopyTo (void *buffer) const
+  {
+    if (buffer == 0)
+      {
+        return new ThreeBoundFunctorCallbackImpl (*this);
+      }
+    return new (buffer) ThreeBoundFunctorCallbackImpl (*this);
+  }
+
 private:
   T m_functor;                                    //!< The functor
   typename TypeTraits<TX1>::ReferencedType m_a1;  //!< first bound argument
@@ -1187,18 +1257,154 @@ private:
   typename TypeTraits<TX3>::ReferencedType m_a3;  //!< third bound argument
 };
 
+/**
+ * \ingroup callbackimpl
+ * Tag selecting the Callback constructor which constructs its
+ * implementation in place.
+ * \tparam IMPL \explicit The type of the implementation.
+ */
+template <typename IMPL>
+struct CallbackImplTag
+{};
+
+/**
+ * \ingroup callbackimpl
+ * Whether a bound argument can be copied along with the Callback: scalars
+ * and Ptr, unless they are bound to a non-const reference, which the
+ * function could modify.
+ * \tparam TX \explicit The type of the bound argument.
+ */
+template <typename TX>
+struct CallbackArgIsCopyable
+{
+  /** The argument type, without reference and const */
+  typedef typename std::remove_cv<typename TypeTraits<TX>::ReferencedType>::type Type;
+  /** Whether the argument is a Ptr */
+  template <typename U>
+  struct IsPtr : std::false_type
+  {};
+  /** \copydoc IsPtr */
+  template <typename U>
+  struct IsPtr<Ptr<U> > : std::true_type
+  {};
+  /** Whether the argument can be copied */
+  static const bool value = (std::is_scalar<Type>::value || IsPtr<Type>::value)
+    && !(std::is_lvalue_reference<TX>::value
+         && !std::is_const<typename std::remove_reference<TX>::type>::value);
+};
+
+/**
+ * \ingroup callbackimpl
+ * Whether a copy of a callback implementation behaves as the original,
+ * so that it can be stored inline and copied with the Callback rather
+ * than shared by reference counting.  This is the case of the member
+ * function pointers, and of the function pointers with copyable bound
+ * arguments.  Other functors may have a state, which the copies of a
+ * Callback must share.
+ * \tparam IMPL \explicit The type of the implementation.
+ */
+template <typename IMPL>
+struct CallbackImplIsCopyable : std::false_type
+{};
+
+/** \copydoc CallbackImplIsCopyable */
+template <typename OBJ_PTR, typename MEM_PTR, typename... Ts>
+struct CallbackImplIsCopyable<MemPtrCallbackImpl<OBJ_PTR,MEM_PTR,Ts...> > : std::true_type
+{};
+
+/** \copydoc CallbackImplIsCopyable */
+template <typename T, typename... Ts>
+struct CallbackImplIsCopyable<FunctorCallbackImpl<T,Ts...> >
+  : std::integral_constant<bool, std::is_pointer<T>::value>
+{};
+
+/** \copydoc CallbackImplIsCopyable */
+template <typename T, typename R, typename TX, typename... Ts>
+struct CallbackImplIsCopyable<BoundFunctorCallbackImpl<T,R,TX,Ts...> >
+  : std::integral_constant<bool, std::is_pointer<T>::value
+                           && CallbackArgIsCopyable<TX>::value>
+{};
+
+/** \copydoc CallbackImplIsCopyable */
+template <typename T, typename R, typename TX1, typename TX2, typename... Ts>
+struct CallbackImplIsCopyable<TwoBoundFunctorCallbackImpl<T,R,TX1,TX2,Ts...> >
+  : std::integral_constant<bool, std::is_pointer<T>::value
+                           && CallbackArgIsCopyable<TX1>::value
+                           && CallbackArgIsCopyable<TX2>::value>
+{};
+
+/** \copydoc CallbackImplIsCopyable */
+template <typename T, typename R, typename TX1, typename TX2, typename TX3, typename... Ts>
+struct CallbackImplIsCopyable<ThreeBoundFunctorCallbackImpl<T,R,TX1,TX2,TX3,Ts...> >
+  : std::integral_constant<bool, std::is_pointer<T>::value
+                           && CallbackArgIsCopyable<TX1>::value
+                           && CallbackArgIsCopyable<TX2>::value
+                           && CallbackArgIsCopyable<TX3>::value>
+{};
+
 /**
  * \ingroup callbackimpl
  * Base class for Callback class.
  * Provides pimpl abstraction.
+ *
+ * Small implementations whose copies behave as the original (see
+ * CallbackImplIsCopyable), such as those holding a member function and
+ * an object pointer, or a function pointer and a bound argument, are
+ * constructed in storage embedded in the CallbackBase rather than on
+ * the heap, so that making and copying them does not allocate.  Other
+ * implementations, including all the functors which may have a state,
+ * are allocated on the heap and shared, by reference counting, between
+ * the copies of the Callback, as they always were.
  */
 class CallbackBase
 {
 public:
-  CallbackBase () : m_impl ()
+  CallbackBase () : m_impl (0)
   {}
-  /** \return The impl pointer */
+  /**
+   * Copy constructor
+   * \param [in] o The CallbackBase to copy
+   */
+  CallbackBase (const CallbackBase &o) : m_impl (0)
+  {
+    DoCopy (o);
+  }
+  /**
+   * Assignment operator
+   * \param [in] o The CallbackBase to copy
+   * \return This CallbackBase
+   */
+  CallbackBase & operator = (const CallbackBase &o)
+  {
+    if (this != &o)
+      {
+        DoRelease ();
+        DoCopy (o);
+      }
+    return *this;
+  }
+  ~CallbackBase ()
+  {
+    DoRelease ();
+  }
+  /**
+   * \return The impl pointer.  If the implementation is stored inline,
+   *         this is a copy of it allocated on the heap.
+   */
   Ptr<CallbackImplBase> GetImpl (void) const
+  {
+    if (IsInline ())
+      {
+        return Ptr<CallbackImplBase> (m_impl->CopyTo (0), false);
+      }
+    return Ptr<CallbackImplBase> (m_impl);
+  }
+  /**
+   * \return The impl pointer, without copying an inline implementation.
+   *         It is only valid as long as this CallbackBase is not
+   *         modified or destroyed.
+   */
+  CallbackImplBase * PeekImpl (void) const
   {
     return m_impl;
   }
@@ -1208,9 +1414,100 @@ protected:
    * Construct from a pimpl
    * \param [in] impl The CallbackImplBase Ptr
    */
-  CallbackBase (Ptr<CallbackImplBase> impl) : m_impl (impl)
-  {}
-  Ptr<CallbackImplBase> m_impl;         //!< the pimpl
+  CallbackBase (Ptr<CallbackImplBase> impl) : m_impl (PeekPointer (impl))
+  {
+    if (m_impl != 0)
+      {
+        m_impl->Ref ();
+      }
+  }
+  /**
+   * Construct the implementation, inline if it fits in the storage
+   * embedded in this CallbackBase, on the heap otherwise.
+   *
+   * \tparam IMPL \explicit The type of the implementation.
+   * \tparam Args \deduced The types of the arguments of its constructor.
+   * \param [in] args The arguments of its constructor.
+   */
+  template <typename IMPL, typename... Args>
+  void DoCreate (Args const &... args)
+  {
+    DoRelease ();
+    DoConstruct<IMPL> (std::integral_constant<bool, (CallbackImplIsCopyable<IMPL>::value
+                                                     && sizeof (IMPL) <= INLINE_WORDS * sizeof (void *)
+                                                     && alignof (IMPL) <= alignof (void *))> (),
+                       args...);
+  }
+  /** Release the implementation, and set it to null */
+  void DoRelease (void)
+  {
+    if (IsInline ())
+      {
+        m_impl->~CallbackImplBase ();
+      }
+    else if (m_impl != 0)
+      {
+        m_impl->Unref ();
+      }
+    m_impl = 0;
+  }
+
+  CallbackImplBase *m_impl;             //!< the pimpl
+
+private:
+  /**
+   * Copy or share the implementation of another CallbackBase.
+   * The implementation of this CallbackBase must be null.
+   * \param [in] o The CallbackBase to copy
+   */
+  void DoCopy (const CallbackBase &o)
+  {
+    if (o.IsInline ())
+      {
+        m_impl = o.m_impl->CopyTo (m_storage);
+      }
+    else
+      {
+        m_impl = o.m_impl;
+        if (m_impl != 0)
+          {
+            m_impl->Ref ();
+          }
+      }
+  }
+  /**
+   * Construct an implementation inline
+   * \tparam IMPL \explicit The type of the implementation.
+   * \tparam Args \deduced The types of the arguments of its constructor.
+   * \param [in] args The arguments of its constructor.
+   */
+  template <typename IMPL, typename... Args>
+  void DoConstruct (std::true_type, Args const &... args)
+  {
+    m_impl = new (m_storage) IMPL (args...);
+  }
+  /**
+   * Construct an implementation on the heap
+   * \tparam IMPL \explicit The type of the implementation.
+   * \tparam Args \deduced The types of the arguments of its constructor.
+   * \param [in] args The arguments of its constructor.
+   */
+  template <typename IMPL, typename... Args>
+  void DoConstruct (std::false_type, Args const &... args)
+  {
+    m_impl = new IMPL (args...);
+  }
+  /** \return \c true if the implementation is stored inline */
+  bool IsInline (void) const
+  {
+    const void *p = m_impl;
+    return p >= static_cast<const void *> (m_storage)
+           && p < static_cast<const void *> (m_storage + INLINE_WORDS);
+  }
+
+  /** Size of the inline storage, in words: enough for a member function and an object pointer */
+  static const std::size_t INLINE_WORDS = 5;
+  void *m_storage[INLINE_WORDS];        //!< the storage of inline implementations
 };
 
 /**
@@ -1293,8 +1590,9 @@ public:
    */
   template <typename FUNCTOR>
   Callback (FUNCTOR const &functor, bool, bool)
-    : CallbackBase (Create<FunctorCallbackImpl<FUNCTOR,R,T1,T2,T3,T4,T5,T6,T7,T8,T9> > (functor))
-  {}
+  {
+    DoCreate<FunctorCallbackImpl<FUNCTOR,R,T1,T2,T3,T4,T5,T6,T7,T8,T9> > (functor);
+  }
 
   /**
    * Construct a member function pointer call back.
@@ -1306,8 +1604,9 @@ public:
    */
   template <typename OBJ_PTR, typename MEM_PTR>
   Callback (OBJ_PTR const &objPtr, MEM_PTR memPtr)
-    : CallbackBase (Create<MemPtrCallbackImpl<OBJ_PTR,MEM_PTR,R,T1,T2,T3,T4,T5,T6,T7,T8,T9> > (objPtr, memPtr))
-  {}
+  {
+    DoCreate<MemPtrCallbackImpl<OBJ_PTR,MEM_PTR,R,T1,T2,T3,T4,T5,T6,T7,T8,T9> > (objPtr, memPtr);
+  }
 
   /**
    * Construct from a CallbackImpl pointer
@@ -1318,6 +1617,20 @@ public:
     : CallbackBase (impl)
   {}
 
+  /**
+   * Construct the implementation in place, inline if it is small enough
+   *
+   * \tparam IMPL \explicit Type of the implementation, which must derive
+   *         from CallbackImpl<R,T1,T2,T3,T4,T5,T6,T7,T8,T9>.
+   * \tparam Args \deduced Types of the arguments of its constructor.
+   * \param [in] args The arguments of its constructor.
+   */
+  template <typename IMPL, typename... Args>
+  Callback (CallbackImplTag<IMPL>, Args const &... args)
+  {
+    DoCreate<IMPL> (args...);
+  }
+
   /**
    * Bind the first arguments
    *
@@ -1328,12 +1641,10 @@ public:
   template <typename T>
   Callback<R,T2,T3,T4,T5,T6,T7,T8,T9> Bind (T a)
   {
-    Ptr<CallbackImpl<R,T2,T3,T4,T5,T6,T7,T8,T9,empty> > impl =
-      Ptr<CallbackImpl<R,T2,T3,T4,T5,T6,T7,T8,T9,empty> > (
-        new BoundFunctorCallbackImpl<
-          Callback<R,T1,T2,T3,T4,T5,T6,T7,T8,T9>,
-          R,T1,T2,T3,T4,T5,T6,T7,T8,T9> (*this, a), false);
-    return Callback<R,T2,T3,T4,T5,T6,T7,T8,T9> (impl);
+    typedef BoundFunctorCallbackImpl<
+        Callback<R,T1,T2,T3,T4,T5,T6,T7,T8,T9>,
+        R,T1,T2,T3,T4,T5,T6,T7,T8,T9> Impl;
+    return Callback<R,T2,T3,T4,T5,T6,T7,T8,T9> (CallbackImplTag<Impl> (), *this, a);
   }
 
   /**
@@ -1348,12 +1659,10 @@ public:
   template <typename TX1, typename TX2>
   Callback<R,T3,T4,T5,T6,T7,T8,T9> TwoBind (TX1 a1, TX2 a2)
   {
-    Ptr<CallbackImpl<R,T3,T4,T5,T6,T7,T8,T9,empty,empty> > impl =
-      Ptr<CallbackImpl<R,T3,T4,T5,T6,T7,T8,T9,empty,empty> > (
-        new TwoBoundFunctorCallbackImpl<
-          Callback<R,T1,T2,T3,T4,T5,T6,T7,T8,T9>,
-          R,T1,T2,T3,T4,T5,T6,T7,T8,T9> (*this, a1, a2), false);
-    return Callback<R,T3,T4,T5,T6,T7,T8,T9> (impl);
+    typedef TwoBoundFunctorCallbackImpl<
+        Callback<R,T1,T2,T3,T4,T5,T6,T7,T8,T9>,
+        R,T1,T2,T3,T4,T5,T6,T7,T8,T9> Impl;
+    return Callback<R,T3,T4,T5,T6,T7,T8,T9> (CallbackImplTag<Impl> (), *this, a1, a2);
   }
 
   /**
@@ -1370,12 +1679,10 @@ public:
   template <typename TX1, typename TX2, typename TX3>
   Callback<R,T4,T5,T6,T7,T8,T9> ThreeBind (TX1 a1, TX2 a2, TX3 a3)
   {
-    Ptr<CallbackImpl<R,T4,T5,T6,T7,T8,T9,empty,empty,empty> > impl =
-      Ptr<CallbackImpl<R,T4,T5,T6,T7,T8,T9,empty,empty,empty> > (
-        new ThreeBoundFunctorCallbackImpl<
-          Callback<R,T1,T2,T3,T4,T5,T6,T7,T8,T9>,
-          R,T1,T2,T3,T4,T5,T6,T7,T8,T9> (*this, a1, a2, a3), false);
-    return Callback<R,T4,T5,T6,T7,T8,T9> (impl);
+    typedef ThreeBoundFunctorCallbackImpl<
+        Callback<R,T1,T2,T3,T4,T5,T6,T7,T8,T9>,
+        R,T1,T2,T3,T4,T5,T6,T7,T8,T9> Impl;
+    return Callback<R,T4,T5,T6,T7,T8,T9> (CallbackImplTag<Impl> (), *this, a1, a2, a3);
   }
 
   /**
@@ -1390,7 +1697,7 @@ public:
   /** Discard the implementation, set it to null */
   void Nullify (void)
   {
-    m_impl = 0;
+    DoRelease ();
   }
 
   /**
@@ -1520,7 +1827,7 @@ public:
    */
   bool IsEqual (const CallbackBase &other) const
   {
-    return m_impl->IsEqual (other.GetImpl ());
+    return m_impl->IsEqual (Ptr<const CallbackImplBase> (other.PeekImpl ()));
   }
 
   /**
@@ -1531,7 +1838,7 @@ public:
    */
   bool CheckType (const CallbackBase & other) const
   {
-    return DoCheckType (other.GetImpl ());
+    return DoCheckType (other.PeekImpl ());
   }
   /**
    * Adopt the other's implementation, if type compatible
@@ -1541,14 +1848,14 @@ public:
    */
   bool Assign (const CallbackBase &other)
   {
-    return DoAssign (other.GetImpl ());
+    return DoAssign (other);
   }
 
 private:
   /** \return The pimpl pointer */
   CallbackImpl<R,T1,T2,T3,T4,T5,T6,T7,T8,T9> * DoPeekImpl (void) const
   {
-    return static_cast<CallbackImpl<R,T1,T2,T3,T4,T5,T6,T7,T8,T9> *> (PeekPointer (m_impl));
+    return static_cast<CallbackImpl<R,T1,T2,T3,T4,T5,T6,T7,T8,T9> *> (m_impl);
   }
   /**
    * Check for compatible types
@@ -1556,10 +1863,10 @@ private:
    * \param [in] other Callback Ptr
    * \return \c true if other can be dynamic_cast to my type
    */
-  bool DoCheckType (Ptr<const CallbackImplBase> other) const
+  bool DoCheckType (const CallbackImplBase *other) const
   {
     if (other != 0
-        && dynamic_cast<const CallbackImpl<R,T1,T2,T3,T4,T5,T6,T7,T8,T9> *> (PeekPointer (other)) != 0)
+        && dynamic_cast<const CallbackImpl<R,T1,T2,T3,T4,T5,T6,T7,T8,T9> *> (other) != 0)
       {
         return true;
       }
@@ -1573,18 +1880,18 @@ private:
       }
   }
   /** \copydoc Assign */
-  bool DoAssign (Ptr<const CallbackImplBase> other)
+  bool DoAssign (const CallbackBase &other)
   {
-    if (!DoCheckType (other))
+    if (!DoCheckType (other.PeekImpl ()))
       {
-        std::string othTid = other->GetTypeid ();
+        std::string othTid = other.PeekImpl ()->GetTypeid ();
         std::string myTid = CallbackImpl<R,T1,T2,T3,T4,T5,T6,T7,T8,T9>::DoGetTypeid ();
         NS_FATAL_ERROR_CONT ("Incompatible types. (feed to \"c++filt -t\" if needed)" << std::endl <<
                              "got=" << othTid << std::endl <<
                              "expected=" << myTid);
         return false;
       }
-    m_impl = const_cast<CallbackImplBase *> (PeekPointer (other));
+    CallbackBase::operator = (other);
     return true;
   }
 };
@@ -1702,73 +2009,55 @@ Callback<R,Ts...> MakeNullCallback (void)
 template <typename R, typename TX, typename ARG>
 Callback<R> MakeBoundCallback (R (*fnPtr)(TX), ARG a1)
 {
-  Ptr<CallbackImpl<R,empty,empty,empty,empty,empty,empty,empty,empty,empty> > impl =
-    Create<BoundFunctorCallbackImpl<R (*)(TX),R,TX,empty,empty,empty,empty,empty,empty,empty,empty> > (fnPtr, a1);
-  return Callback<R> (impl);
+  return Callback<R> (CallbackImplTag<BoundFunctorCallbackImpl<R (*)(TX),R,TX,empty,empty,empty,empty,empty,empty,empty,empty> > (), fnPtr, a1);
 }
 template <typename R, typename TX, typename ARG,
           typename T1>
 Callback<R,T1> MakeBoundCallback (R (*fnPtr)(TX,T1), ARG a1)
 {
-  Ptr<CallbackImpl<R,T1,empty,empty,empty,empty,empty,empty,empty,empty> > impl =
-    Create<BoundFunctorCallbackImpl<R (*)(TX,T1),R,TX,T1,empty,empty,empty,empty,empty,empty,empty> > (fnPtr, a1);
-  return Callback<R,T1> (impl);
+  return Callback<R,T1> (CallbackImplTag<BoundFunctorCallbackImpl<R (*)(TX,T1),R,TX,T1,empty,empty,empty,empty,empty,empty,empty> > (), fnPtr, a1);
 }
 template <typename R, typename TX, typename ARG,
           typename T1, typename T2>
 Callback<R,T1,T2> MakeBoundCallback (R (*fnPtr)(TX,T1,T2), ARG a1)
 {
-  Ptr<CallbackImpl<R,T1,T2,empty,empty,empty,empty,empty,empty,empty> > impl =
-    Create<BoundFunctorCallbackImpl<R (*)(TX,T1,T2),R,TX,T1,T2,empty,empty,empty,empty,empty,empty> > (fnPtr, a1);
-  return Callback<R,T1,T2> (impl);
+  return Callback<R,T1,T2> (CallbackImplTag<BoundFunctorCallbackImpl<R (*)(TX,T1,T2),R,TX,T1,T2,empty,empty,empty,empty,empty,empty> > (), fnPtr, a1);
 }
 template <typename R, typename TX, typename ARG,
           typename T1, typename T2,typename T3>
 Callback<R,T1,T2,T3> MakeBoundCallback (R (*fnPtr)(TX,T1,T2,T3), ARG a1)
 {
-  Ptr<CallbackImpl<R,T1,T2,T3,empty,empty,empty,empty,empty,empty> > impl =
-    Create<BoundFunctorCallbackImpl<R (*)(TX,T1,T2,T3),R,TX,T1,T2,T3,empty,empty,empty,empty,empty> > (fnPtr, a1);
-  return Callback<R,T1,T2,T3> (impl);
+  return Callback<R,T1,T2,T3> (CallbackImplTag<BoundFunctorCallbackImpl<R (*)(TX,T1,T2,T3),R,TX,T1,T2,T3,empty,empty,empty,empty,empty> > (), fnPtr, a1);
 }
 template <typename R, typename TX, typename ARG,
           typename T1, typename T2,typename T3,typename T4>
 Callback<R,T1,T2,T3,T4> MakeBoundCallback (R (*fnPtr)(TX,T1,T2,T3,T4), ARG a1)
 {
-  Ptr<CallbackImpl<R,T1,T2,T3,T4,empty,empty,empty,empty,empty> > impl =
-    Create<BoundFunctorCallbackImpl<R (*)(TX,T1,T2,T3,T4),R,TX,T1,T2,T3,T4,empty,empty,empty,empty> > (fnPtr, a1);
-  return Callback<R,T1,T2,T3,T4> (impl);
+  return Callback<R,T1,T2,T3,T4> (CallbackImplTag<BoundFunctorCallbackImpl<R (*)(TX,T1,T2,T3,T4),R,TX,T1,T2,T3,T4,empty,empty,empty,empty> > (), fnPtr, a1);
 }
 template <typename R, typename TX, typename ARG,
           typename T1, typename T2,typename T3,typename T4,typename T5>
 Callback<R,T1,T2,T3,T4,T5> MakeBoundCallback (R (*fnPtr)(TX,T1,T2,T3,T4,T5), ARG a1)
 {
-  Ptr<CallbackImpl<R,T1,T2,T3,T4,T5,empty,empty,empty,empty> > impl =
-    Create<BoundFunctorCallbackImpl<R (*)(TX,T1,T2,T3,T4,T5),R,TX,T1,T2,T3,T4,T5,empty,empty,empty> > (fnPtr, a1);
-  return Callback<R,T1,T2,T3,T4,T5> (impl);
+  return Callback<R,T1,T2,T3,T4,T5> (CallbackImplTag<BoundFunctorCallbackImpl<R (*)(TX,T1,T2,T3,T4,T5),R,TX,T1,T2,T3,T4,T5,empty,empty,empty> > (), fnPtr, a1);
 }
 template <typename R, typename TX, typename ARG,
           typename T1, typename T2,typename T3,typename T4,typename T5, typename T6>
 Callback<R,T1,T2,T3,T4,T5,T6> MakeBoundCallback (R (*fnPtr)(TX,T1,T2,T3,T4,T5,T6), ARG a1)
 {
-  Ptr<CallbackImpl<R,T1,T2,T3,T4,T5,T6,empty,empty,empty> > impl =
-    Create<BoundFunctorCallbackImpl<R (*)(TX,T1,T2,T3,T4,T5,T6),R,TX,T1,T2,T3,T4,T5,T6,empty,empty> > (fnPtr, a1);
-  return Callback<R,T1,T2,T3,T4,T5,T6> (impl);
+  return Callback<R,T1,T2,T3,T4,T5,T6> (CallbackImplTag<BoundFunctorCallbackImpl<R (*)(TX,T1,T2,T3,T4,T5,T6),R,TX,T1,T2,T3,T4,T5,T6,empty,empty> > (), fnPtr, a1);
 }
 template <typename R, typename TX, typename ARG,
           typename T1, typename T2,typename T3,typename T4,typename T5, typename T6, typename T7>
 Callback<R,T1,T2,T3,T4,T5,T6,T7> MakeBoundCallback (R (*fnPtr)(TX,T1,T2,T3,T4,T5,T6,T7), ARG a1)
 {
-  Ptr<CallbackImpl<R,T1,T2,T3,T4,T5,T6,T7,empty,empty> > impl =
-    Create<BoundFunctorCallbackImpl<R (*)(TX,T1,T2,T3,T4,T5,T6,T7),R,TX,T1,T2,T3,T4,T5,T6,T7,empty> > (fnPtr, a1);
-  return Callback<R,T1,T2,T3,T4,T5,T6,T7> (impl);
+  return Callback<R,T1,T2,T3,T4,T5,T6,T7> (CallbackImplTag<BoundFunctorCallbackImpl<R (*)(TX,T1,T2,T3,T4,T5,T6,T7),R,TX,T1,T2,T3,T4,T5,T6,T7,empty> > (), fnPtr, a1);
 }
 template <typename R, typename TX, typename ARG,
           typename T1, typename T2,typename T3,typename T4,typename T5, typename T6, typename T7, typename T8>
 Callback<R,T1,T2,T3,T4,T5,T6,T7,T8> MakeBoundCallback (R (*fnPtr)(TX,T1,T2,T3,T4,T5,T6,T7,T8), ARG a1)
 {
-  Ptr<CallbackImpl<R,T1,T2,T3,T4,T5,T6,T7,T8,empty> > impl =
-    Create<BoundFunctorCallbackImpl<R (*)(TX,T1,T2,T3,T4,T5,T6,T7,T8),R,TX,T1,T2,T3,T4,T5,T6,T7,T8> > (fnPtr, a1);
-  return Callback<R,T1,T2,T3,T4,T5,T6,T7,T8> (impl);
+  return Callback<R,T1,T2,T3,T4,T5,T6,T7,T8> (CallbackImplTag<BoundFunctorCallbackImpl<R (*)(TX,T1,T2,T3,T4,T5,T6,T7,T8),R,TX,T1,T2,T3,T4,T5,T6,T7,T8> > (), fnPtr, a1);
 }
 /**@}*/
 
@@ -1791,65 +2080,49 @@ Callback<R,T1,T2,T3,T4,T5,T6,T7,T8> MakeBoundCallback (R (*fnPtr)(TX,T1,T2,T3,T4
 template <typename R, typename TX1, typename TX2, typename ARG1, typename ARG2>
 Callback<R> MakeBoundCallback (R (*fnPtr)(TX1,TX2), ARG1 a1, ARG2 a2)
 {
-  Ptr<CallbackImpl<R,empty,empty,empty,empty,empty,empty,empty,empty,empty> > impl =
-    Create<TwoBoundFunctorCallbackImpl<R (*)(TX1,TX2),R,TX1,TX2,empty,empty,empty,empty,empty,empty,empty> > (fnPtr, a1, a2);
-  return Callback<R> (impl);
+  return Callback<R> (CallbackImplTag<TwoBoundFunctorCallbackImpl<R (*)(TX1,TX2),R,TX1,TX2,empty,empty,empty,empty,empty,empty,empty> > (), fnPtr, a1, a2);
 }
 template <typename R, typename TX1, typename TX2, typename ARG1, typename ARG2,
           typename T1>
 Callback<R,T1> MakeBoundCallback (R (*fnPtr)(TX1,TX2,T1), ARG1 a1, ARG2 a2)
 {
-  Ptr<CallbackImpl<R,T1,empty,empty,empty,empty,empty,empty,empty,empty> > impl =
-    Create<TwoBoundFunctorCallbackImpl<R (*)(TX1,TX2,T1),R,TX1,TX2,T1,empty,empty,empty,empty,empty,empty> > (fnPtr, a1, a2);
-  return Callback<R,T1> (impl);
+  return Callback<R,T1> (CallbackImplTag<TwoBoundFunctorCallbackImpl<R (*)(TX1,TX2,T1),R,TX1,TX2,T1,empty,empty,empty,empty,empty,empty> > (), fnPtr, a1, a2);
 }
 template <typename R, typename TX1, typename TX2, typename ARG1, typename ARG2,
           typename T1, typename T2>
 Callback<R,T1,T2> MakeBoundCallback (R (*fnPtr)(TX1,TX2,T1,T2), ARG1 a1, ARG2 a2)
 {
-  Ptr<CallbackImpl<R,T1,T2,empty,empty,empty,empty,empty,empty,empty> > impl =
-    Create<TwoBoundFunctorCallbackImpl<R (*)(TX1,TX2,T1,T2),R,TX1,TX2,T1,T2,empty,empty,empty,empty,empty> > (fnPtr, a1, a2);
-  return Callback<R,T1,T2> (impl);
+  return Callback<R,T1,T2> (CallbackImplTag<TwoBoundFunctorCallbackImpl<R (*)(TX1,TX2,T1,T2),R,TX1,TX2,T1,T2,empty,empty,empty,empty,empty> > (), fnPtr, a1, a2);
 }
 template <typename R, typename TX1, typename TX2, typename ARG1, typename ARG2,
           typename T1, typename T2,typename T3>
 Callback<R,T1,T2,T3> MakeBoundCallback (R (*fnPtr)(TX1,TX2,T1,T2,T3), ARG1 a1, ARG2 a2)
 {
-  Ptr<CallbackImpl<R,T1,T2,T3,empty,empty,empty,empty,empty,empty> > impl =
-    Create<TwoBoundFunctorCallbackImpl<R (*)(TX1,TX2,T1,T2,T3),R,TX1,TX2,T1,T2,T3,empty,empty,empty,empty> > (fnPtr, a1, a2);
-  return Callback<R,T1,T2,T3> (impl);
+  return Callback<R,T1,T2,T3> (CallbackImplTag<TwoBoundFunctorCallbackImpl<R (*)(TX1,TX2,T1,T2,T3),R,TX1,TX2,T1,T2,T3,empty,empty,empty,empty> > (), fnPtr, a1, a2);
 }
 template <typename R, typename TX1, typename TX2, typename ARG1, typename ARG2,
           typename T1, typename T2,typename T3,typename T4>
 Callback<R,T1,T2,T3,T4> MakeBoundCallback (R (*fnPtr)(TX1,TX2,T1,T2,T3,T4), ARG1 a1, ARG2 a2)
 {
-  Ptr<CallbackImpl<R,T1,T2,T3,T4,empty,empty,empty,empty,empty> > impl =
-    Create<TwoBoundFunctorCallbackImpl<R (*)(TX1,TX2,T1,T2,T3,T4),R,TX1,TX2,T1,T2,T3,T4,empty,empty,empty> > (fnPtr, a1, a2);
-  return Callback<R,T1,T2,T3,T4> (impl);
+  return Callback<R,T1,T2,T3,T4> (CallbackImplTag<TwoBoundFunctorCallbackImpl<R (*)(TX1,TX2,T1,T2,T3,T4),R,TX1,TX2,T1,T2,T3,T4,empty,empty,empty> > (), fnPtr, a1, a2);
 }
 template <typename R, typename TX1, typename TX2, typename ARG1, typename ARG2,
           typename T1, typename T2,typename T3,typename T4,typename T5>
 Callback<R,T1,T2,T3,T4,T5> MakeBoundCallback (R (*fnPtr)(TX1,TX2,T1,T2,T3,T4,T5), ARG1 a1, ARG2 a2)
 {
-  Ptr<CallbackImpl<R,T1,T2,T3,T4,T5,empty,empty,empty,empty> > impl =
-    Create<TwoBoundFunctorCallbackImpl<R (*)(TX1,TX2,T1,T2,T3,T4,T5),R,TX1,TX2,T1,T2,T3,T4,T5,empty,empty> > (fnPtr, a1, a2);
-  return Callback<R,T1,T2,T3,T4,T5> (impl);
+  return Callback<R,T1,T2,T3,T4,T5> (CallbackImplTag<TwoBoundFunctorCallbackImpl<R (*)(TX1,TX2,T1,T2,T3,T4,T5),R,TX1,TX2,T1,T2,T3,T4,T5,empty,empty> > (), fnPtr, a1, a2);
 }
 template <typename R, typename TX1, typename TX2, typename ARG1, typename ARG2,
           typename T1, typename T2,typename T3,typename T4,typename T5, typename T6>
 Callback<R,T1,T2,T3,T4,T5,T6> MakeBoundCallback (R (*fnPtr)(TX1,TX2,T1,T2,T3,T4,T5,T6), ARG1 a1, ARG2 a2)
 {
-  Ptr<CallbackImpl<R,T1,T2,T3,T4,T5,T6,empty,empty,empty> > impl =
-    Create<TwoBoundFunctorCallbackImpl<R (*)(TX1,TX2,T1,T2,T3,T4,T5,T6),R,TX1,TX2,T1,T2,T3,T4,T5,T6,empty> > (fnPtr, a1, a2);
-  return Callback<R,T1,T2,T3,T4,T5,T6> (impl);
+  return Callback<R,T1,T2,T3,T4,T5,T6> (CallbackImplTag<TwoBoundFunctorCallbackImpl<R (*)(TX1,TX2,T1,T2,T3,T4,T5,T6),R,TX1,TX2,T1,T2,T3,T4,T5,T6,empty> > (), fnPtr, a1, a2);
 }
 template <typename R, typename TX1, typename TX2, typename ARG1, typename ARG2,
           typename T1, typename T2,typename T3,typename T4,typename T5, typename T6, typename T7>
 Callback<R,T1,T2,T3,T4,T5,T6,T7> MakeBoundCallback (R (*fnPtr)(TX1,TX2,T1,T2,T3,T4,T5,T6,T7), ARG1 a1, ARG2 a2)
 {
-  Ptr<CallbackImpl<R,T1,T2,T3,T4,T5,T6,T7,empty,empty> > impl =
-    Create<TwoBoundFunctorCallbackImpl<R (*)(TX1,TX2,T1,T2,T3,T4,T5,T6,T7),R,TX1,TX2,T1,T2,T3,T4,T5,T6,T7> > (fnPtr, a1, a2);
-  return Callback<R,T1,T2,T3,T4,T5,T6,T7> (impl);
+  return Callback<R,T1,T2,T3,T4,T5,T6,T7> (CallbackImplTag<TwoBoundFunctorCallbackImpl<R (*)(TX1,TX2,T1,T2,T3,T4,T5,T6,T7),R,TX1,TX2,T1,T2,T3,T4,T5,T6,T7> > (), fnPtr, a1, a2);
 }
 /**@}*/
 
@@ -1875,57 +2148,43 @@ Callback<R,T1,T2,T3,T4,T5,T6,T7> MakeBoundCallback (R (*fnPtr)(TX1,TX2,T1,T2,T3,
 template <typename R, typename TX1, typename TX2, typename TX3, typename ARG1, typename ARG2, typename ARG3>
 Callback<R> MakeBoundCallback (R (*fnPtr)(TX1,TX2,TX3), ARG1 a1, ARG2 a2, ARG3 a3)
 {
-  Ptr<CallbackImpl<R,empty,empty,empty,empty,empty,empty,empty,empty,empty> > impl =
-    Create<ThreeBoundFunctorCallbackImpl<R (*)(TX1,TX2,TX3),R,TX1,TX2,TX3,empty,empty,empty,empty,empty,empty> > (fnPtr, a1, a2, a3);
-  return Callback<R> (impl);
+  return Callback<R> (CallbackImplTag<ThreeBoundFunctorCallbackImpl<R (*)(TX1,TX2,TX3),R,TX1,TX2,TX3,empty,empty,empty,empty,empty,empty> > (), fnPtr, a1, a2, a3);
 }
 template <typename R, typename TX1, typename TX2, typename TX3, typename ARG1, typename ARG2, typename ARG3,
           typename T1>
 Callback<R,T1> MakeBoundCallback (R (*fnPtr)(TX1,TX2,TX3,T1), ARG1 a1, ARG2 a2, ARG3 a3)
 {
-  Ptr<CallbackImpl<R,T1,empty,empty,empty,empty,empty,empty,empty,empty> > impl =
-    Create<ThreeBoundFunctorCallbackImpl<R (*)(TX1,TX2,TX3,T1),R,TX1,TX2,TX3,T1,empty,empty,empty,empty,empty> > (fnPtr, a1, a2, a3);
-  return Callback<R,T1> (impl);
+  return Callback<R,T1> (CallbackImplTag<ThreeBoundFunctorCallbackImpl<R (*)(TX1,TX2,TX3,T1),R,TX1,TX2,TX3,T1,empty,empty,empty,empty,empty> > (), fnPtr, a1, a2, a3);
 }
 template <typename R, typename TX1, typename TX2, typename TX3, typename ARG1, typename ARG2, typename ARG3,
           typename T1, typename T2>
 Callback<R,T1,T2> MakeBoundCallback (R (*fnPtr)(TX1,TX2,TX3,T1,T2), ARG1 a1, ARG2 a2, ARG3 a3)
 {
-  Ptr<CallbackImpl<R,T1,T2,empty,empty,empty,empty,empty,empty,empty> > impl =
-    Create<ThreeBoundFunctorCallbackImpl<R (*)(TX1,TX2,TX3,T1,T2),R,TX1,TX2,TX3,T1,T2,empty,empty,empty,empty> > (fnPtr, a1, a2, a3);
-  return Callback<R,T1,T2> (impl);
+  return Callback<R,T1,T2> (CallbackImplTag<ThreeBoundFunctorCallbackImpl<R (*)(TX1,TX2,TX3,T1,T2),R,TX1,TX2,TX3,T1,T2,empty,empty,empty,empty> > (), fnPtr, a1, a2, a3);
 }
 template <typename R, typename TX1, typename TX2, typename TX3, typename ARG1, typename ARG2, typename ARG3,
           typename T1, typename T2,typename T3>
 Callback<R,T1,T2,T3> MakeBoundCallback (R (*fnPtr)(TX1,TX2,TX3,T1,T2,T3), ARG1 a1, ARG2 a2, ARG3 a3)
 {
-  Ptr<CallbackImpl<R,T1,T2,T3,empty,empty,empty,empty,empty,empty> > impl =
-    Create<ThreeBoundFunctorCallbackImpl<R (*)(TX1,TX2,TX3,T1,T2,T3),R,TX1,TX2,TX3,T1,T2,T3,empty,empty,empty> > (fnPtr, a1, a2, a3);
-  return Callback<R,T1,T2,T3> (impl);
+  return Callback<R,T1,T2,T3> (CallbackImplTag<ThreeBoundFunctorCallbackImpl<R (*)(TX1,TX2,TX3,T1,T2,T3),R,TX1,TX2,TX3,T1,T2,T3,empty,empty,empty> > (), fnPtr, a1, a2, a3);
 }
 template <typename R, typename TX1, typename TX2, typename TX3, typename ARG1, typename ARG2, typename ARG3,
           typename T1, typename T2,typename T3,typename T4>
 Callback<R,T1,T2,T3,T4> MakeBoundCallback (R (*fnPtr)(TX1,TX2,TX3,T1,T2,T3,T4), ARG1 a1, ARG2 a2, ARG3 a3)
 {
-  Ptr<CallbackImpl<R,T1,T2,T3,T4,empty,empty,empty,empty,empty> > impl =
-    Create<ThreeBoundFunctorCallbackImpl<R (*)(TX1,TX2,TX3,T1,T2,T3,T4),R,TX1,TX2,TX3,T1,T2,T3,T4,empty,empty> > (fnPtr, a1, a2, a3);
-  return Callback<R,T1,T2,T3,T4> (impl);
+  return Callback<R,T1,T2,T3,T4> (CallbackImplTag<ThreeBoundFunctorCallbackImpl<R (*)(TX1,TX2,TX3,T1,T2,T3,T4),R,TX1,TX2,TX3,T1,T2,T3,T4,empty,empty> > (), fnPtr, a1, a2, a3);
 }
 template <typename R, typename TX1, typename TX2, typename TX3, typename ARG1, typename ARG2, typename ARG3,
           typename T1, typename T2,typename T3,typename T4,typename T5>
 Callback<R,T1,T2,T3,T4,T5> MakeBoundCallback (R (*fnPtr)(TX1,TX2,TX3,T1,T2,T3,T4,T5), ARG1 a1, ARG2 a2, ARG3 a3)
 {
-  Ptr<CallbackImpl<R,T1,T2,T3,T4,T5,empty,empty,empty,empty> > impl =
-    Create<ThreeBoundFunctorCallbackImpl<R (*)(TX1,TX2,TX3,T1,T2,T3,T4,T5),R,TX1,TX2,TX3,T1,T2,T3,T4,T5,empty> > (fnPtr, a1, a2, a3);
-  return Callback<R,T1,T2,T3,T4,T5> (impl);
+  return Callback<R,T1,T2,T3,T4,T5> (CallbackImplTag<ThreeBoundFunctorCallbackImpl<R (*)(TX1,TX2,TX3,T1,T2,T3,T4,T5),R,TX1,TX2,TX3,T1,T2,T3,T4,T5,empty> > (), fnPtr, a1, a2, a3);
 }
 template <typename R, typename TX1, typename TX2, typename TX3, typename ARG1, typename ARG2, typename ARG3,
           typename T1, typename T2,typename T3,typename T4,typename T5, typename T6>
 Callback<R,T1,T2,T3,T4,T5,T6> MakeBoundCallback (R (*fnPtr)(TX1,TX2,TX3,T1,T2,T3,T4,T5,T6), ARG1 a1, ARG2 a2, ARG3 a3)
 {
-  Ptr<CallbackImpl<R,T1,T2,T3,T4,T5,T6,empty,empty,empty> > impl =
-    Create<ThreeBoundFunctorCallbackImpl<R (*)(TX1,TX2,TX3,T1,T2,T3,T4,T5,T6),R,TX1,TX2,TX3,T1,T2,T3,T4,T5,T6> > (fnPtr, a1, a2, a3);
-  return Callback<R,T1,T2,T3,T4,T5,T6> (impl);
+  return Callback<R,T1,T2,T3,T4,T5,T6> (CallbackImplTag<ThreeBoundFunctorCallbackImpl<R (*)(TX1,TX2,TX3,T1,T2,T3,T4,T5,T6),R,TX1,TX2,TX3,T1,T2,T3,T4,T5,T6> > (), fnPtr, a1, a2, a3);
 }
 /**@}*/
 
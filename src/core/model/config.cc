@@ -26,6 +26,7 @@
 #include "pointer.h"
 #include "log.h"
 
+#include <map>
 #include <sstream>
 
 /**
@@ -182,6 +183,9 @@ MatchContainer::DisconnectWithoutContext (std::string name, const CallbackBase &
 /**
  * \ingroup config-impl
  * Helper to test if an array entry matches a config path specification.
+ *
+ * The specification is parsed once, at construction, into a list of
+ * ranges of indices.
  */
 class ArrayMatcher
 {
@@ -199,8 +203,23 @@ public:
    * \returns \c true if the index matches the Config Path.
    */
   bool Matches (std::size_t i) const;
+  /**
+   * Get the indices matching the Config path, if there are not too many.
+   *
+   * \param [in] max The maximum number of indices.
+   * \param [out] indices The matching indices, in no particular order.
+   * \returns \c true if the number of matching indices is less than or
+   *          equal to \pname{max}.
+   */
+  bool GetIndices (std::size_t max, std::vector<std::size_t> &indices) const;
 
 private:
+  /**
+   * Parse a Config path specification.
+   *
+   * \param [in] element The Config path specification.
+   */
+  void Parse (std::string element);
   /**
    * Convert a string to an \c uint32_t.
    *
@@ -211,77 +230,109 @@ private:
   bool StringToUint32 (std::string str, uint32_t *value) const;
   /** The Config path element. */
   std::string m_element;
+  /** Whether the Config path element matches all indices. */
+  bool m_all;
+  /** The ranges of matching indices (bounds included). */
+  std::vector<std::pair<uint32_t, uint32_t> > m_ranges;
 
 };  // class ArrayMatcher
 
 
 ArrayMatcher::ArrayMatcher (std::string element)
-  : m_element (element)
+  : m_element (element),
+    m_all (false)
 {
   NS_LOG_FUNCTION (this << element);
+  Parse (element);
 }
-bool
-ArrayMatcher::Matches (std::size_t i) const
+void
+ArrayMatcher::Parse (std::string element)
 {
-  NS_LOG_FUNCTION (this << i);
-  if (m_element == "*")
+  NS_LOG_FUNCTION (this << element);
+  if (element == "*")
     {
-      NS_LOG_DEBUG ("Array " << i << " matches *");
-      return true;
+      m_all = true;
+      return;
     }
   std::string::size_type tmp;
-  tmp = m_element.find ("|");
+  tmp = element.find ("|");
   if (tmp != std::string::npos)
     {
-      std::string left = m_element.substr (0, tmp - 0);
-      std::string right = m_element.substr (tmp + 1, m_element.size () - (tmp + 1));
-      ArrayMatcher matcher = ArrayMatcher (left);
-      if (matcher.Matches (i))
-        {
-          NS_LOG_DEBUG ("Array " << i << " matches " << left);
-          return true;
-        }
-      matcher = ArrayMatcher (right);
-      if (matcher.Matches (i))
-        {
-          NS_LOG_DEBUG ("Array " << i << " matches " << right);
-          return true;
-        }
-      NS_LOG_DEBUG ("Array " << i << " does not match " << m_element);
-      return false;
+      std::string left = element.substr (0, tmp - 0);
+      std::string right = element.substr (tmp + 1, element.size () - (tmp + 1));
+      Parse (left);
+      Parse (right);
+      return;
     }
-  std::string::size_type leftBracket = m_element.find ("[");
-  std::string::size_type rightBracket = m_element.find ("]");
-  std::string::size_type dash = m_element.find ("-");
-  if (leftBracket == 0 && rightBracket == m_element.size () - 1
+  std::string::size_type leftBracket = element.find ("[");
+  std::string::size_type rightBracket = element.find ("]");
+  std::string::size_type dash = element.find ("-");
+  if (leftBracket == 0 && rightBracket == element.size () - 1
       && dash > leftBracket && dash < rightBracket)
     {
-      std::string lowerBound = m_element.substr (leftBracket + 1, dash - (leftBracket + 1));
-      std::string upperBound = m_element.substr (dash + 1, rightBracket - (dash + 1));
+      std::string lowerBound = element.substr (leftBracket + 1, dash - (leftBracket + 1));
+      std::string upperBound = element.substr (dash + 1, rightBracket - (dash + 1));
       uint32_t min;
       uint32_t max;
       if (StringToUint32 (lowerBound, &min)
           && StringToUint32 (upperBound, &max)
-          && i >= min && i <= max)
+          && min <= max)
+        {
+          m_ranges.push_back (std::make_pair (min, max));
+        }
+      return;
+    }
+  uint32_t value;
+  if (StringToUint32 (element, &value))
+    {
+      m_ranges.push_back (std::make_pair (value, value));
+    }
+}
+bool
+ArrayMatcher::Matches (std::size_t i) const
+{
+  NS_LOG_FUNCTION (this << i);
+  if (m_all)
+    {
+      NS_LOG_DEBUG ("Array " << i << " matches *");
+      return true;
+    }
+  for (std::vector<std::pair<uint32_t, uint32_t> >::const_iterator j = m_ranges.begin (); j != m_ranges.end (); ++j)
+    {
+      if (i >= j->first && i <= j->second)
         {
           NS_LOG_DEBUG ("Array " << i << " matches " << m_element);
           return true;
         }
-      else
+    }
+  NS_LOG_DEBUG ("Array " << i << " does not match " << m_element);
+  return false;
+}
+bool
+ArrayMatcher::GetIndices (std::size_t max, std::vector<std::size_t> &indices) const
+{
+  NS_LOG_FUNCTION (this << max);
+  if (m_all)
+    {
+      return false;
+    }
+  std::size_t n = 0;
+  for (std::vector<std::pair<uint32_t, uint32_t> >::const_iterator j = m_ranges.begin (); j != m_ranges.end (); ++j)
+    {
+      n += static_cast<std::size_t> (j->second - j->first) + 1;
+      if (n > max)
         {
-          NS_LOG_DEBUG ("Array " << i << " does not " << m_element);
           return false;
         }
     }
-  uint32_t value;
-  if (StringToUint32 (m_element, &value)
-      && i == value)
+  for (std::vector<std::pair<uint32_t, uint32_t> >::const_iterator j = m_ranges.begin (); j != m_ranges.end (); ++j)
     {
-      NS_LOG_DEBUG ("Array " << i << " matches " << m_element);
-      return true;
+      for (std::size_t i = j->first; i <= j->second; i++)
+        {
+          indices.push_back (i);
+        }
     }
-  NS_LOG_DEBUG ("Array " << i << " does not match " << m_element);
-  return false;
+  return true;
 }
 
 bool
@@ -296,22 +347,32 @@ ArrayMatcher::StringToUint32 (std::string str, uint32_t *value) const
 
 /**
  * \ingroup config-impl
- * Abstract class to parse Config paths into object references.
+ * Parse Config paths into object references.
+ *
+ * Several Config paths can be resolved together: the object tree is then
+ * walked once, and the objects and containers found along the walk are
+ * shared by all the paths whose leading segments are the same.
  */
 class Resolver
 {
 public:
   /**
-   * Construct from a base Config path.
+   * Add a Config path to resolve.
    *
    * \param [in] path The Config path.
+   * \returns The index of the Config path.
    */
-  Resolver (std::string path);
-  /** Destructor. */
-  virtual ~Resolver ();
+  std::size_t AddPath (std::string path);
+  /**
+   * Add a Config path to resolve, already split into segments.
+   *
+   * \param [in] segments The segments of the Config path.
+   * \returns The index of the Config path.
+   */
+  std::size_t AddPath (const std::vector<std::string> &segments);
 
   /**
-   * Parse the stored Config path into an object reference,
+   * Parse the stored Config paths into object references,
    * beginning at the indicated root object.
    *
    * \param [in] root The object corresponding to the current position in
@@ -319,79 +380,142 @@ public:
    */
   void Resolve (Ptr<Object> root);
 
+  /**
+   * Get the objects matching a Config path.
+   *
+   * \param [in] i The index of the Config path.
+   * \param [in] path The path stored in the MatchContainer.
+   * \returns The objects matching the Config path.
+   */
+  MatchContainer GetMatches (std::size_t i, std::string path) const;
+
+  /**
+   * Split a Config path into its segments.
+   *
+   * \param [in] path The Config path.
+   * \returns The segments, i.e., the items between slashes.
+   */
+  static std::vector<std::string> Split (std::string path);
+
 private:
-  /** Ensure the Config path starts and ends with a '/'. */
-  void Canonicalize (void);
+  /** The indices of a set of Config paths. */
+  typedef std::vector<std::size_t> Paths;
+
   /**
-   * Parse the next element in the Config path.
+   * Parse the next segment of a set of Config paths.
    *
-   * \param [in] path The remaining portion of the Config path.
    * \param [in] root The object corresponding to the current position
-   *                  in the Config path.
+   *                  in the Config paths.
+   * \param [in] depth The number of segments already parsed.
+   * \param [in] paths The Config paths.
    */
-  void DoResolve (std::string path, Ptr<Object> root);
+  void DoResolve (Ptr<Object> root, std::size_t depth, const Paths &paths);
   /**
-   * Parse an index on the Config path.
+   * Parse the next segment, which is the same, of a set of Config paths.
    *
-   * \param [in] path The remaining Config path.
-   * \param [in,out] vector The resulting list of matching objects.
+   * \param [in] root The object corresponding to the current position
+   *                  in the Config paths.
+   * \param [in] depth The number of segments already parsed.
+   * \param [in] item The next segment.
+   * \param [in] paths The Config paths.
    */
-  void DoArrayResolve (std::string path, const ObjectPtrContainerValue &vector);
+  void DoResolveItem (Ptr<Object> root, std::size_t depth, std::string item, const Paths &paths);
   /**
-   * Handle one object found on the path.
+   * Parse an index on a set of Config paths.
    *
-   * \param [in] object The current object on the Config path.
+   * \param [in] root The object holding the container.
+   * \param [in] info The container attribute.
+   * \param [in] depth The number of segments already parsed.
+   * \param [in] paths The Config paths.
    */
-  void DoResolveOne (Ptr<Object> object);
+  void DoArrayResolve (Ptr<Object> root, const struct TypeId::AttributeInformation &info,
+                       std::size_t depth, const Paths &paths);
   /**
-   * Get the current Config path.
+   * Resolve the objects of a container found at the given indices,
+   * without getting the whole container.
    *
-   * \returns The current Config path.
+   * \param [in] root The object holding the container.
+   * \param [in] info The container attribute.
+   * \param [in] depth The number of segments already parsed.
+   * \param [in] indices The Config paths matching each index.
+   * \returns \c false if the accessor of the container cannot get single
+   *          objects, in which case nothing was resolved.
    */
-  std::string GetResolvedPath (void) const;
+  bool DoIndexResolve (Ptr<Object> root, const struct TypeId::AttributeInformation &info,
+                       std::size_t depth, const std::map<std::size_t, Paths> &indices);
+  /**
+   * Resolve one object of a container.
+   *
+   * \param [in] index The index of the object in the container.
+   * \param [in] object The object.
+   * \param [in] depth The number of segments already parsed.
+   * \param [in] paths The Config paths.
+   */
+  void DoResolveIndex (std::size_t index, Ptr<Object> object, std::size_t depth, const Paths &paths);
   /**
-   * Handle one found object.
+   * Get the current Config path.
    *
-   * \param [in] object The found object.
-   * \param [in] path The matching Config path context.
+   * \returns The current Config path.
    */
-  virtual void DoOne (Ptr<Object> object, std::string path) = 0;
+  std::string GetResolvedPath (void) const;
 
   /** Current list of path tokens. */
   std::vector<std::string> m_workStack;
-  /** The Config path. */
-  std::string m_path;
+  /** The segments of each Config path. */
+  std::vector<std::vector<std::string> > m_paths;
+  /** The objects matching each Config path. */
+  std::vector<std::vector<Ptr<Object> > > m_objects;
+  /** The contexts of the objects matching each Config path. */
+  std::vector<std::vector<std::string> > m_contexts;
 
 };  // class Resolver
 
-Resolver::Resolver (std::string path)
-  : m_path (path)
-{
-  NS_LOG_FUNCTION (this << path);
-  Canonicalize ();
-}
-Resolver::~Resolver ()
-{
-  NS_LOG_FUNCTION (this);
-}
-void
-Resolver::Canonicalize (void)
+std::vector<std::string>
+Resolver::Split (std::string path)
 {
-  NS_LOG_FUNCTION (this);
+  NS_LOG_FUNCTION (path);
 
   // ensure that we start and end with a '/'
-  std::string::size_type tmp = m_path.find ("/");
+  std::string::size_type tmp = path.find ("/");
   if (tmp != 0)
     {
       // no slash at start
-      m_path = "/" + m_path;
+      path = "/" + path;
     }
-  tmp = m_path.find_last_of ("/");
-  if (tmp != (m_path.size () - 1))
+  tmp = path.find_last_of ("/");
+  if (tmp != (path.size () - 1))
     {
       // no slash at end
-      m_path = m_path + "/";
+      path = path + "/";
     }
+
+  std::vector<std::string> segments;
+  std::string::size_type cur = 0;
+  std::string::size_type next = path.find ("/", 1);
+  while (next != std::string::npos)
+    {
+      segments.push_back (path.substr (cur + 1, next - (cur + 1)));
+      cur = next;
+      next = path.find ("/", cur + 1);
+    }
+  return segments;
+}
+
+std::size_t
+Resolver::AddPath (std::string path)
+{
+  NS_LOG_FUNCTION (this << path);
+  return AddPath (Split (path));
+}
+
+std::size_t
+Resolver::AddPath (const std::vector<std::string> &segments)
+{
+  NS_LOG_FUNCTION (this << &segments);
+  m_paths.push_back (segments);
+  m_objects.push_back (std::vector<Ptr<Object> > ());
+  m_contexts.push_back (std::vector<std::string> ());
+  return m_paths.size () - 1;
 }
 
 void
@@ -399,7 +523,19 @@ Resolver::Resolve (Ptr<Object> root)
 {
   NS_LOG_FUNCTION (this << root);
 
-  DoResolve (m_path, root);
+  Paths paths;
+  for (std::size_t i = 0; i < m_paths.size (); i++)
+    {
+      paths.push_back (i);
+    }
+  DoResolve (root, 0, paths);
+}
+
+MatchContainer
+Resolver::GetMatches (std::size_t i, std::string path) const
+{
+  NS_LOG_FUNCTION (this << i << path);
+  return MatchContainer (m_objects[i], m_contexts[i], path);
 }
 
 std::string
@@ -416,23 +552,21 @@ Resolver::GetResolvedPath (void) const
 }
 
 void
-Resolver::DoResolveOne (Ptr<Object> object)
+Resolver::DoResolve (Ptr<Object> root, std::size_t depth, const Paths &paths)
 {
-  NS_LOG_FUNCTION (this << object);
+  NS_LOG_FUNCTION (this << root << depth << paths.size ());
 
-  NS_LOG_DEBUG ("resolved=" << GetResolvedPath ());
-  DoOne (object, GetResolvedPath ());
-}
-
-void
-Resolver::DoResolve (std::string path, Ptr<Object> root)
-{
-  NS_LOG_FUNCTION (this << path << root);
-  NS_ASSERT ((path.find ("/")) == 0);
-  std::string::size_type next = path.find ("/", 1);
-
-  if (next == std::string::npos)
+  //
+  // The paths which end here match root, the others are grouped by their
+  // next segment, which is resolved once for all the paths of a group.
+  //
+  std::map<std::string, Paths> items;
+  for (Paths::const_iterator i = paths.begin (); i != paths.end (); i++)
     {
+      if (depth < m_paths[*i].size ())
+        {
+          items[m_paths[*i][depth]].push_back (*i);
+        }
       //
       // If root is zero, we're beginning to see if we can use the object name
       // service to resolve this path.  It is impossible to have a object name
@@ -441,14 +575,23 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
       // namespace and it will have been found already since the name service
       // is always consulted last.
       //
-      if (root)
+      else if (root)
         {
-          DoResolveOne (root);
+          NS_LOG_DEBUG ("resolved=" << GetResolvedPath ());
+          m_objects[*i].push_back (root);
+          m_contexts[*i].push_back (GetResolvedPath ());
         }
-      return;
     }
-  std::string item = path.substr (1, next - 1);
-  std::string pathLeft = path.substr (next, path.size () - next);
+  for (std::map<std::string, Paths>::const_iterator i = items.begin (); i != items.end (); i++)
+    {
+      DoResolveItem (root, depth, i->first, i->second);
+    }
+}
+
+void
+Resolver::DoResolveItem (Ptr<Object> root, std::size_t depth, std::string item, const Paths &paths)
+{
+  NS_LOG_FUNCTION (this << root << depth << item << paths.size ());
 
   //
   // If root is zero, we're beginning to see if we can use the object name
@@ -459,11 +602,11 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
   //
   if (root == 0)
     {
-      std::string::size_type offset = path.find ("/Names");
+      std::string::size_type offset = item.find ("Names");
       if (offset == 0)
         {
           m_workStack.push_back (item);
-          DoResolve (pathLeft, root);
+          DoResolve (root, depth + 1, paths);
           m_workStack.pop_back ();
           return;
         }
@@ -480,7 +623,7 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
     {
       NS_LOG_DEBUG ("Name system resolved item = " << item << " to " << namedObject);
       m_workStack.push_back (item);
-      DoResolve (pathLeft, namedObject);
+      DoResolve (namedObject, depth + 1, paths);
       m_workStack.pop_back ();
       return;
     }
@@ -510,7 +653,7 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
           return;
         }
       m_workStack.push_back (item);
-      DoResolve (pathLeft, object);
+      DoResolve (object, depth + 1, paths);
       m_workStack.pop_back ();
     }
   else
@@ -549,7 +692,7 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
                     }
                   foundMatch = true;
                   m_workStack.push_back (info.name);
-                  DoResolve (pathLeft, object);
+                  DoResolve (object, depth + 1, paths);
                   m_workStack.pop_back ();
                 }
               // attempt to cast to an object vector.
@@ -557,12 +700,10 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
                 dynamic_cast<const ObjectPtrContainerChecker *> (PeekPointer (info.checker));
               if (vectorChecker != 0)
                 {
-                  NS_LOG_DEBUG ("GetAttribute(vector)=" << info.name << " on path=" << GetResolvedPath () << pathLeft);
+                  NS_LOG_DEBUG ("GetAttribute(vector)=" << info.name << " on path=" << GetResolvedPath ());
                   foundMatch = true;
-                  ObjectPtrContainerValue vector;
-                  root->GetAttribute (info.name, vector);
                   m_workStack.push_back (info.name);
-                  DoArrayResolve (pathLeft, vector);
+                  DoArrayResolve (root, info, depth + 1, paths);
                   m_workStack.pop_back ();
                 }
               // this could be anything else and we don't know what to do with it.
@@ -582,34 +723,133 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
 }
 
 void
-Resolver::DoArrayResolve (std::string path, const ObjectPtrContainerValue &container)
+Resolver::DoArrayResolve (Ptr<Object> root, const struct TypeId::AttributeInformation &info,
+                          std::size_t depth, const Paths &paths)
 {
-  NS_LOG_FUNCTION (this << path << &container);
-  NS_ASSERT (path != "");
-  NS_ASSERT ((path.find ("/")) == 0);
-  std::string::size_type next = path.find ("/", 1);
-  if (next == std::string::npos)
+  NS_LOG_FUNCTION (this << root << info.name << depth << paths.size ());
+
+  //
+  // The paths which end with the container match nothing.  The indices
+  // matched by each of the other paths are listed if there are fewer of them
+  // than objects in the container: these objects can be looked up one by one
+  // rather than by copying the whole container.
+  //
+  std::size_t n = 0;
+  const ObjectPtrContainerAccessor *accessor =
+    dynamic_cast<const ObjectPtrContainerAccessor *> (PeekPointer (info.accessor));
+  bool lookup = accessor != 0 && accessor->GetN (PeekPointer (root), &n);
+
+  std::vector<ArrayMatcher> matchers;
+  Paths remaining;
+  std::map<std::size_t, Paths> indices;
+  std::vector<std::size_t> tmp;
+  for (Paths::const_iterator i = paths.begin (); i != paths.end (); i++)
+    {
+      if (depth >= m_paths[*i].size ())
+        {
+          continue;
+        }
+      ArrayMatcher matcher = ArrayMatcher (m_paths[*i][depth]);
+      tmp.clear ();
+      if (matcher.GetIndices (n, tmp))
+        {
+          for (std::vector<std::size_t>::const_iterator j = tmp.begin (); j != tmp.end (); j++)
+            {
+              indices[*j].push_back (*i);
+            }
+        }
+      else
+        {
+          matchers.push_back (matcher);
+          remaining.push_back (*i);
+        }
+    }
+  if (indices.empty () && remaining.empty ())
+    {
+      return;
+    }
+
+  if (remaining.empty () && lookup && indices.size () <= n
+      && DoIndexResolve (root, info, depth, indices))
     {
       return;
     }
-  std::string item = path.substr (1, next - 1);
-  std::string pathLeft = path.substr (next, path.size () - next);
 
-  ArrayMatcher matcher = ArrayMatcher (item);
-  ObjectPtrContainerValue::Iterator it;
-  for (it = container.Begin (); it != container.End (); ++it)
+  ObjectPtrContainerValue container;
+  root->GetAttribute (info.name, container);
+  for (ObjectPtrContainerValue::Iterator it = container.Begin (); it != container.End (); ++it)
     {
-      if (matcher.Matches ((*it).first))
+      Paths matching;
+      std::map<std::size_t, Paths>::const_iterator found = indices.find ((*it).first);
+      if (found != indices.end ())
         {
-          std::ostringstream oss;
-          oss << (*it).first;
-          m_workStack.push_back (oss.str ());
-          DoResolve (pathLeft, (*it).second);
-          m_workStack.pop_back ();
+          matching = found->second;
+        }
+      for (std::size_t j = 0; j < matchers.size (); j++)
+        {
+          if (matchers[j].Matches ((*it).first))
+            {
+              matching.push_back (remaining[j]);
+            }
+        }
+      if (!matching.empty ())
+        {
+          DoResolveIndex ((*it).first, (*it).second, depth, matching);
         }
     }
 }
 
+bool
+Resolver::DoIndexResolve (Ptr<Object> root, const struct TypeId::AttributeInformation &info,
+                          std::size_t depth, const std::map<std::size_t, Paths> &indices)
+{
+  NS_LOG_FUNCTION (this << root << info.name << depth << indices.size ());
+
+  //
+  // Containers whose objects are not stored at the position given by their
+  // index (e.g., maps) need to be copied, as the indices in the Config paths
+  // refer to the latter.
+  //
+  const ObjectPtrContainerAccessor *accessor =
+    dynamic_cast<const ObjectPtrContainerAccessor *> (PeekPointer (info.accessor));
+  std::size_t n;
+  if (!accessor->GetN (PeekPointer (root), &n))
+    {
+      return false;
+    }
+  std::vector<Ptr<Object> > objects;
+  for (std::map<std::size_t, Paths>::const_iterator i = indices.begin (); i != indices.end (); i++)
+    {
+      std::size_t index;
+      if (i->first >= n)
+        {
+          return false;
+        }
+      objects.push_back (accessor->Get (PeekPointer (root), i->first, &index));
+      if (index != i->first)
+        {
+          return false;
+        }
+    }
+  std::vector<Ptr<Object> >::const_iterator object = objects.begin ();
+  for (std::map<std::size_t, Paths>::const_iterator i = indices.begin (); i != indices.end (); i++, object++)
+    {
+      DoResolveIndex (i->first, *object, depth, i->second);
+    }
+  return true;
+}
+
+void
+Resolver::DoResolveIndex (std::size_t index, Ptr<Object> object, std::size_t depth, const Paths &paths)
+{
+  NS_LOG_FUNCTION (this << index << object << depth << paths.size ());
+  std::ostringstream oss;
+  oss << index;
+  m_workStack.push_back (oss.str ());
+  DoResolve (object, depth + 1, paths);
+  m_workStack.pop_back ();
+}
+
 /**
  * \ingroup config-impl
  * Config system implementation class.
@@ -633,6 +873,12 @@ public:
   void Disconnect (std::string path, const CallbackBase &cb);
   /** \copydoc Config::LookupMatches() */
   MatchContainer LookupMatches (std::string path);
+  /**
+   * Resolve Config paths from each of the roots, and from the root of the
+   * "/Names" name space.
+   * \param [in,out] resolver The resolver holding the Config paths.
+   */
+  void Resolve (Resolver &resolver) const;
 
   /** \copydoc Config::RegisterRootNamespaceObject() */
   void RegisterRootNamespaceObject (Ptr<Object> obj);
@@ -751,21 +997,16 @@ MatchContainer
 ConfigImpl::LookupMatches (std::string path)
 {
   NS_LOG_FUNCTION (this << path);
-  class LookupMatchesResolver : public Resolver
-  {
-public:
-    LookupMatchesResolver (std::string path)
-      : Resolver (path)
-    {
-    }
-    virtual void DoOne (Ptr<Object> object, std::string path)
-    {
-      m_objects.push_back (object);
-      m_contexts.push_back (path);
-    }
-    std::vector<Ptr<Object> > m_objects;
-    std::vector<std::string> m_contexts;
-  } resolver = LookupMatchesResolver (path);
+  Resolver resolver;
+  std::size_t i = resolver.AddPath (path);
+  Resolve (resolver);
+  return resolver.GetMatches (i, path);
+}
+
+void
+ConfigImpl::Resolve (Resolver &resolver) const
+{
+  NS_LOG_FUNCTION (this << &resolver);
   for (Roots::const_iterator i = m_roots.begin (); i != m_roots.end (); i++)
     {
       resolver.Resolve (*i);
@@ -777,8 +1018,6 @@ public:
   // looking at the root of the "/Names" namespace during this go.
   //
   resolver.Resolve (0);
-
-  return MatchContainer (resolver.m_objects, resolver.m_contexts, path);
 }
 
 void
@@ -943,6 +1182,139 @@ MatchContainer LookupMatches (std::string path)
   return ConfigImpl::Get ()->LookupMatches (path);
 }
 
+CompiledPath::CompiledPath (std::string path)
+  : m_path (path),
+    m_segments (Resolver::Split (path)),
+    m_resolved (false)
+{
+  NS_LOG_FUNCTION (this << path);
+}
+
+std::string
+CompiledPath::GetPath (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_path;
+}
+
+const MatchContainer &
+CompiledPath::LookupMatches (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (!m_resolved)
+    {
+      Resolver resolver;
+      std::size_t i = resolver.AddPath (m_segments);
+      ConfigImpl::Get ()->Resolve (resolver);
+      m_matches = resolver.GetMatches (i, m_path);
+      m_resolved = true;
+    }
+  return m_matches;
+}
+
+void
+CompiledPath::Invalidate (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_resolved = false;
+  m_matches = MatchContainer ();
+}
+
+void
+Batch::Set (std::string path, const AttributeValue &value)
+{
+  NS_LOG_FUNCTION (this << path << &value);
+  Operation op;
+  op.type = SET;
+  op.path = path;
+  op.value = value.Copy ();
+  m_operations.push_back (op);
+}
+
+void
+Batch::Connect (std::string path, const CallbackBase &cb)
+{
+  NS_LOG_FUNCTION (this << path << &cb);
+  Operation op;
+  op.type = CONNECT;
+  op.path = path;
+  op.cb = cb;
+  m_operations.push_back (op);
+}
+
+void
+Batch::ConnectWithoutContext (std::string path, const CallbackBase &cb)
+{
+  NS_LOG_FUNCTION (this << path << &cb);
+  Operation op;
+  op.type = CONNECT_WITHOUT_CONTEXT;
+  op.path = path;
+  op.cb = cb;
+  m_operations.push_back (op);
+}
+
+std::size_t
+Batch::GetN (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_operations.size ();
+}
+
+void
+Batch::Apply (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  //
+  // Operations on the same objects (i.e., whose paths differ only by their
+  // last item) share the same path in the resolver.
+  //
+  Resolver resolver;
+  std::map<std::string, std::size_t> roots;
+  std::vector<std::size_t> indices;
+  for (std::vector<Operation>::const_iterator i = m_operations.begin (); i != m_operations.end (); i++)
+    {
+      std::string::size_type slash = i->path.find_last_of ("/");
+      NS_ASSERT (slash != std::string::npos);
+      std::string root = i->path.substr (0, slash);
+      std::map<std::string, std::size_t>::const_iterator found = roots.find (root);
+      if (found == roots.end ())
+        {
+          found = roots.insert (std::make_pair (root, resolver.AddPath (root))).first;
+        }
+      indices.push_back (found->second);
+    }
+  ConfigImpl::Get ()->Resolve (resolver);
+
+  std::vector<Operation> operations;
+  operations.swap (m_operations);
+  for (std::size_t i = 0; i < operations.size (); i++)
+    {
+      const Operation &op = operations[i];
+      std::string::size_type slash = op.path.find_last_of ("/");
+      std::string leaf = op.path.substr (slash + 1, op.path.size () - (slash + 1));
+      MatchContainer container = resolver.GetMatches (indices[i], op.path.substr (0, slash));
+      switch (op.type)
+        {
+        case SET:
+          container.Set (leaf, *op.value);
+          break;
+        case CONNECT:
+          if (!container.ConnectFailSafe (leaf, op.cb))
+            {
+              NS_FATAL_ERROR ("Could not connect callback to " << op.path);
+            }
+          break;
+        case CONNECT_WITHOUT_CONTEXT:
+          if (!container.ConnectWithoutContextFailSafe (leaf, op.cb))
+            {
+              NS_FATAL_ERROR ("Could not connect callback to " << op.path);
+            }
+          break;
+        }
+    }
+}
+
 void RegisterRootNamespaceObject (Ptr<Object> obj)
 {
   NS_LOG_FUNCTION (obj);
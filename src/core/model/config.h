@@ -21,6 +21,7 @@
 #define CONFIG_H
 
 #include "ptr.h"
+#include "callback.h"
 #include <string>
 #include <vector>
 
@@ -34,7 +35,6 @@ namespace ns3 {
 
 class AttributeValue;
 class Object;
-class CallbackBase;
 
 /**
  * \ingroup core
@@ -314,6 +314,141 @@ private:
  */
 MatchContainer LookupMatches (std::string path);
 
+/**
+ * \ingroup config
+ * \brief A Config path which is parsed once, and whose matching objects
+ * are looked up once.
+ *
+ * Config::LookupMatches parses its path and walks the object tree each
+ * time it is called.  A CompiledPath splits its path into segments when
+ * it is constructed, and keeps the objects matching it after they have
+ * been looked up, so that they can be configured or connected to many
+ * times at the cost of a single walk:
+ * \code
+ *   Config::CompiledPath phys ("/NodeList/[0-99]/DeviceList/0/$ns3::WifiNetDevice/Phy");
+ *   phys.LookupMatches ().Connect ("PhyTxBegin", MakeCallback (&PhyTxBegin));
+ *   phys.LookupMatches ().Connect ("PhyRxEnd", MakeCallback (&PhyRxEnd));
+ * \endcode
+ *
+ * The objects are not looked up again when objects are added to or
+ * removed from the tree: Invalidate must then be called.
+ */
+class CompiledPath
+{
+public:
+  /**
+   * \param [in] path The path to perform a match against
+   */
+  CompiledPath (std::string path);
+
+  /**
+   * \returns The path to perform a match against
+   */
+  std::string GetPath (void) const;
+
+  /**
+   * Look up the objects which match the path, unless they have already
+   * been looked up since the last call to Invalidate.
+   *
+   * \returns A container which contains all the objects which match the
+   *          path.
+   */
+  const MatchContainer & LookupMatches (void);
+
+  /**
+   * Forget the objects which match the path, so that the next call to
+   * LookupMatches looks them up again.
+   */
+  void Invalidate (void);
+
+private:
+  std::string m_path;                     //!< The path
+  std::vector<std::string> m_segments;    //!< The items of the path
+  bool m_resolved;                        //!< Whether m_matches is up to date
+  MatchContainer m_matches;               //!< The objects which match the path
+};
+
+/**
+ * \ingroup config
+ * \brief A set of configuration operations applied with a single walk of
+ * the object tree.
+ *
+ * Each call to Config::Set or Config::Connect walks the object tree to
+ * find the objects which match its path, e.g., the whole NodeList when the
+ * path starts with "/NodeList/" followed by the index of a node.  The
+ * operations added to a Batch are instead applied by Apply, which resolves
+ * all their paths together, walking each container of the tree at most
+ * once (and getting only the objects at the indices in the paths when
+ * there are few of them):
+ * \code
+ *   Config::Batch batch;
+ *   for (uint32_t i = 0; i < nodes.GetN (); ++i)
+ *     {
+ *       std::ostringstream oss;
+ *       oss << "/NodeList/" << i << "/$ns3::Ipv4L3Protocol/Tx";
+ *       batch.Connect (oss.str (), MakeBoundCallback (&Ipv4Tx, i));
+ *     }
+ *   batch.Apply ();
+ * \endcode
+ *
+ * The paths of all the operations are resolved before any of them is
+ * applied: an operation does not see the objects that an operation added
+ * before it (e.g., a Set of a Pointer attribute) makes reachable.
+ * The operations are then applied in the order in which they were added,
+ * with the same semantics as the Config function of the same name.
+ */
+class Batch
+{
+public:
+  /**
+   * \param [in] path A path to match attributes.
+   * \param [in] value The value to set in all matching attributes.
+   *
+   * \sa Config::Set
+   */
+  void Set (std::string path, const AttributeValue &value);
+  /**
+   * \param [in] path A path to match trace sources.
+   * \param [in] cb The callback to connect to the matching trace sources.
+   *
+   * \sa Config::Connect
+   */
+  void Connect (std::string path, const CallbackBase &cb);
+  /**
+   * \param [in] path A path to match trace sources.
+   * \param [in] cb The callback to connect to the matching trace sources.
+   *
+   * \sa Config::ConnectWithoutContext
+   */
+  void ConnectWithoutContext (std::string path, const CallbackBase &cb);
+  /**
+   * \returns The number of operations which have not been applied yet.
+   */
+  std::size_t GetN (void) const;
+  /**
+   * Apply the operations added since the last call, and forget them.
+   */
+  void Apply (void);
+
+private:
+  /** The kinds of operations */
+  enum Type
+  {
+    SET,                      //!< Config::Set
+    CONNECT,                  //!< Config::Connect
+    CONNECT_WITHOUT_CONTEXT   //!< Config::ConnectWithoutContext
+  };
+  /** An operation */
+  struct Operation
+  {
+    Type type;                          //!< The kind of operation
+    std::string path;                   //!< The path
+    Ptr<const AttributeValue> value;    //!< The value to set
+    CallbackBase cb;                    //!< The callback to connect
+  };
+  std::vector<Operation> m_operations;  //!< The operations not applied yet
+};
+
 /**
  * \ingroup config
  * \param [in] obj A new root object
@@ -25,10 +25,12 @@
 
 #include "ptr.h"
 #include "pointer.h"
+#include "string.h"
 #include "assert.h"
 #include "log.h"
 
 #include <cmath>
+#include <fstream>
 
 
 /**
@@ -53,6 +55,15 @@ DefaultSimulatorImpl::GetTypeId (void)
     .SetParent<SimulatorImpl> ()
     .SetGroupName ("Core")
     .AddConstructor<DefaultSimulatorImpl> ()
+    .AddAttribute ("ProfileFileName",
+                   "If not empty, measure the wall clock time spent in the "
+                   "events, and write at Simulator::Destroy the profile of "
+                   "the functions and contexts of the events to this file, "
+                   "and the profile in the folded format of flame graphs to "
+                   "this file with the .folded extension.",
+                   StringValue (""),
+                   MakeStringAccessor (&DefaultSimulatorImpl::m_profileFileName),
+                   MakeStringChecker ())
   ;
   return tid;
 }
@@ -74,11 +85,13 @@ DefaultSimulatorImpl::DefaultSimulatorImpl ()
   m_eventCount = 0;
   m_eventsWithContextEmpty = true;
   m_main = SystemThread::Self ();
+  m_profiler = 0;
 }
 
 DefaultSimulatorImpl::~DefaultSimulatorImpl ()
 {
   NS_LOG_FUNCTION (this);
+  delete m_profiler;
 }
 
 void
@@ -109,6 +122,27 @@ DefaultSimulatorImpl::Destroy ()
           ev->Invoke ();
         }
     }
+  WriteProfile ();
+}
+
+void
+DefaultSimulatorImpl::WriteProfile (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_profiler == 0)
+    {
+      return;
+    }
+  std::ofstream report (m_profileFileName.c_str ());
+  m_profiler->PrintReport (report);
+  std::string folded = m_profileFileName + ".folded";
+  std::ofstream flame (folded.c_str ());
+  m_profiler->PrintFolded (flame);
+  if (!report || !flame)
+    {
+      NS_LOG_WARN ("Unable to write the event profile to " << m_profileFileName);
+    }
+  m_profiler->Clear ();
 }
 
 void
@@ -148,7 +182,14 @@ DefaultSimulatorImpl::ProcessOneEvent (void)
   m_currentTs = next.key.m_ts;
   m_currentContext = next.key.m_context;
   m_currentUid = next.key.m_uid;
-  next.impl->Invoke ();
+  if (m_profiler == 0)
+    {
+      next.impl->Invoke ();
+    }
+  else
+    {
+      m_profiler->Invoke (next.impl, m_currentContext);
+    }
   next.impl->Unref ();
 
   ProcessEventsWithContext ();
@@ -198,6 +239,10 @@ DefaultSimulatorImpl::Run (void)
   m_main = SystemThread::Self ();
   ProcessEventsWithContext ();
   m_stop = false;
+  if (m_profiler == 0 && !m_profileFileName.empty ())
+    {
+      m_profiler = new EventProfiler ();
+    }
 
   while (!m_events->IsEmpty () && !m_stop)
     {
@@ -24,6 +24,7 @@
 #include "simulator-impl.h"
 #include "scheduler.h"
 #include "event-impl.h"
+#include "event-profiler.h"
 #include "system-thread.h"
 #include "system-mutex.h"
 
@@ -86,6 +87,8 @@ private:
   void ProcessOneEvent (void);
   /** Move events from a different context into the main event queue. */
   void ProcessEventsWithContext (void);
+  /** Write the event profile, if the events are profiled. */
+  void WriteProfile (void);
 
   /** Wrap an event with its execution context. */
   struct EventWithContext
@@ -136,6 +139,11 @@ private:
 
   /** Main execution thread. */
   SystemThread::ThreadId m_main;
+
+  /** The file name of the event profile, or empty to not profile the events. */
+  std::string m_profileFileName;
+  /** The event profiler, if the events are profiled. */
+  EventProfiler *m_profiler;
 };
 
 } // namespace ns3
@@ -66,4 +66,10 @@ EventImpl::IsCancelled (void)
   return m_cancel;
 }
 
+const void *
+EventImpl::PeekFunction (void) const
+{
+  return 0;
+}
+
 } // namespace ns3
@@ -65,6 +65,14 @@ public:
    * Checked by the simulation engine before calling Invoke().
    */
   bool IsCancelled (void);
+  /**
+   * \returns the address of the function or method invoked by this
+   * event, or 0 if it is not known.
+   *
+   * Used by the EventProfiler to attribute the execution time of the
+   * events to the functions they invoke.
+   */
+  virtual const void * PeekFunction (void) const;
 
 protected:
   /**
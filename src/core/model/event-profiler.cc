@@ -0,0 +1,325 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "event-profiler.h"
+#include "event-impl.h"
+#include "simulator.h"
+#include "log.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <vector>
+
+#if (__GNUC__ >= 3)
+#include <cxxabi.h>
+#endif
+
+// dladdr is part of the C library since glibc 2.34, and on macOS
+#if defined (__APPLE__) || (defined (__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 34)))
+#define NS3_EVENT_PROFILER_DLADDR
+#include <dlfcn.h>
+#endif
+
+/**
+ * \file
+ * \ingroup events
+ * ns3::EventProfiler implementation.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("EventProfiler");
+
+namespace {
+
+/**
+ * \ingroup events
+ * Demangle a C++ symbol name.
+ * \param [in] mangled The mangled name.
+ * \return The demangled name, or the mangled name if demangling fails.
+ */
+std::string
+Demangle (const char *mangled)
+{
+  std::string ret = mangled;
+#if (__GNUC__ >= 3)
+  int status;
+  char *demangled = abi::__cxa_demangle (mangled, NULL, NULL, &status);
+  if (status == 0)
+    {
+      ret = demangled;
+    }
+  std::free (demangled);
+#endif
+  return ret;
+}
+
+/**
+ * \ingroup events
+ * Print an event context.
+ * \param [in] os The output stream.
+ * \param [in] context The context.
+ */
+void
+PrintContext (std::ostream &os, uint32_t context)
+{
+  if (context == Simulator::NO_CONTEXT)
+    {
+      os << "no context";
+    }
+  else
+    {
+      os << "node " << context;
+    }
+}
+
+/** The number of events, their execution time and their name. */
+struct Line
+{
+  uint64_t count = 0;  //!< Number of events
+  uint64_t time = 0;   //!< Execution time in nanoseconds
+  std::string name;    //!< Name of the function or context
+  /**
+   * \param [in] o The other line.
+   * \return true if this line comes first in the report.
+   */
+  bool operator < (const Line &o) const
+  {
+    return time > o.time || (time == o.time && name < o.name);
+  }
+};
+
+/**
+ * \ingroup events
+ * Print a table of the report.
+ * \param [in] os The output stream.
+ * \param [in] lines The lines of the table.
+ * \param [in] total The total execution time in nanoseconds.
+ * \param [in] title The title of the last column.
+ */
+void
+PrintTable (std::ostream &os, std::vector<Line> lines, uint64_t total, std::string title)
+{
+  std::sort (lines.begin (), lines.end ());
+  std::ios::fmtflags flags = os.flags ();
+  std::streamsize precision = os.precision ();
+  os << std::setw (12) << "Time (s)"
+     << std::setw (9) << "Share"
+     << std::setw (12) << "Events"
+     << std::setw (12) << "Mean (us)"
+     << "  " << title << std::endl;
+  for (const Line &line : lines)
+    {
+      os << std::fixed
+         << std::setw (12) << std::setprecision (6) << line.time / 1e9
+         << std::setw (7) << std::setprecision (1)
+         << (total == 0 ? 0.0 : 100.0 * line.time / total) << " %"
+         << std::setw (12) << line.count
+         << std::setw (12) << std::setprecision (3) << line.time / 1e3 / line.count
+         << "  " << line.name << std::endl;
+    }
+  os.flags (flags);
+  os.precision (precision);
+}
+
+} // unnamed namespace
+
+EventProfiler::EventProfiler ()
+  : m_count (0),
+    m_time (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+EventProfiler::~EventProfiler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+EventProfiler::Key
+EventProfiler::GetKey (const EventImpl *event, uint32_t context)
+{
+  Key key;
+  key.function = event->PeekFunction ();
+  key.type = key.function == 0 ? &typeid (*event) : 0;
+  key.context = context;
+  return key;
+}
+
+void
+EventProfiler::Invoke (EventImpl *event, uint32_t context)
+{
+  // the key is found before the invocation, which can delete the
+  // object of the event
+  Key key = GetKey (event, context);
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now ();
+  event->Invoke ();
+  std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now () - start;
+  uint64_t time = std::chrono::duration_cast<std::chrono::nanoseconds> (elapsed).count ();
+
+  Stats &stats = m_profile[key];
+  stats.count++;
+  stats.time += time;
+  m_count++;
+  m_time += time;
+}
+
+uint64_t
+EventProfiler::GetEventCount (void) const
+{
+  return m_count;
+}
+
+uint64_t
+EventProfiler::GetTime (void) const
+{
+  return m_time;
+}
+
+void
+EventProfiler::Clear (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_profile.clear ();
+  m_count = 0;
+  m_time = 0;
+}
+
+std::string
+EventProfiler::GetName (const EventImpl *event)
+{
+  return GetName (GetKey (event, 0));
+}
+
+std::string
+EventProfiler::GetName (const Key &key)
+{
+  if (key.function == 0)
+    {
+      return Demangle (key.type->name ());
+    }
+  std::ostringstream oss;
+#ifdef NS3_EVENT_PROFILER_DLADDR
+  Dl_info info;
+  if (dladdr (key.function, &info) != 0)
+    {
+      if (info.dli_sname != 0 && info.dli_saddr == key.function)
+        {
+          // methods of secondary base classes are invoked through thunks
+          std::string name = Demangle (info.dli_sname);
+          const std::string prefixes[] = {"non-virtual thunk to ", "virtual thunk to "};
+          for (const std::string &prefix : prefixes)
+            {
+              if (name.compare (0, prefix.size (), prefix) == 0)
+                {
+                  name = name.substr (prefix.size ());
+                }
+            }
+          return name;
+        }
+      if (info.dli_fname != 0)
+        {
+          std::string file = info.dli_fname;
+          std::string::size_type slash = file.rfind ('/');
+          if (slash != std::string::npos)
+            {
+              file = file.substr (slash + 1);
+            }
+          oss << file << "+0x" << std::hex
+              << (static_cast<const char *> (key.function)
+              - static_cast<const char *> (info.dli_fbase));
+          return oss.str ();
+        }
+    }
+#endif
+  oss << key.function;
+  return oss.str ();
+}
+
+void
+EventProfiler::PrintReport (std::ostream &os) const
+{
+  NS_LOG_FUNCTION (this << &os);
+  // the names are resolved once per function
+  std::map<std::pair<const void *, const std::type_info *>, Line> functions;
+  std::map<uint32_t, Line> contexts;
+  for (const Profile::value_type &entry : m_profile)
+    {
+      Line &function = functions[std::make_pair (entry.first.function, entry.first.type)];
+      if (function.name.empty ())
+        {
+          function.name = GetName (entry.first);
+        }
+      function.count += entry.second.count;
+      function.time += entry.second.time;
+
+      Line &context = contexts[entry.first.context];
+      context.count += entry.second.count;
+      context.time += entry.second.time;
+    }
+
+  std::vector<Line> lines;
+  for (const auto &function : functions)
+    {
+      lines.push_back (function.second);
+    }
+  os << "Event profile: " << m_count << " events, "
+     << m_time / 1e9 << " s" << std::endl << std::endl;
+  PrintTable (os, lines, m_time, "Function");
+
+  lines.clear ();
+  for (const auto &context : contexts)
+    {
+      std::ostringstream oss;
+      PrintContext (oss, context.first);
+      lines.push_back (context.second);
+      lines.back ().name = oss.str ();
+    }
+  os << std::endl;
+  PrintTable (os, lines, m_time, "Context");
+}
+
+void
+EventProfiler::PrintFolded (std::ostream &os) const
+{
+  NS_LOG_FUNCTION (this << &os);
+  std::map<std::pair<const void *, const std::type_info *>, std::string> names;
+  std::map<std::string, uint64_t> stacks;
+  for (const Profile::value_type &entry : m_profile)
+    {
+      std::string &name = names[std::make_pair (entry.first.function, entry.first.type)];
+      if (name.empty ())
+        {
+          // semicolons separate the frames
+          name = GetName (entry.first);
+          std::replace (name.begin (), name.end (), ';', ',');
+        }
+      std::ostringstream oss;
+      PrintContext (oss, entry.first.context);
+      oss << ';' << name;
+      stacks[oss.str ()] += entry.second.time;
+    }
+  for (const auto &stack : stacks)
+    {
+      os << stack.first << ' ' << stack.second << std::endl;
+    }
+}
+
+} // namespace ns3
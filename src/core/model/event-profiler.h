@@ -0,0 +1,166 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EVENT_PROFILER_H
+#define EVENT_PROFILER_H
+
+#include <functional>
+#include <ostream>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+#include <stdint.h>
+
+/**
+ * \file
+ * \ingroup events
+ * ns3::EventProfiler declaration.
+ */
+
+namespace ns3 {
+
+class EventImpl;
+
+/**
+ * \ingroup events
+ *
+ * \brief Measure the wall clock time spent in the simulation events
+ *
+ * The events invoked through Invoke are timed, and their number and
+ * execution time are accumulated for each function invoked by the
+ * events (see EventImpl::PeekFunction) and each event context.  Events
+ * whose function is not known are accounted to the class of the event.
+ *
+ * The function names are resolved when the profile is printed, from
+ * the symbols exported by the libraries and the executable.  Functions
+ * without an exported symbol, such as static functions, are printed as
+ * the name of the library or executable and an offset.
+ *
+ * DefaultSimulatorImpl profiles the events when its ProfileFileName
+ * attribute is set.
+ */
+class EventProfiler
+{
+public:
+  /** Constructor. */
+  EventProfiler ();
+  /** Destructor. */
+  ~EventProfiler ();
+
+  /**
+   * \brief Invoke and time an event
+   * \param [in] event The event.
+   * \param [in] context The context of the event.
+   */
+  void Invoke (EventImpl *event, uint32_t context);
+
+  /** \return The number of events invoked. */
+  uint64_t GetEventCount (void) const;
+  /** \return The wall clock time spent in the events, in nanoseconds. */
+  uint64_t GetTime (void) const;
+  /** Forget the events invoked so far. */
+  void Clear (void);
+
+  /**
+   * \brief Print the profile, sorted by decreasing execution time
+   *
+   * The first table gives the number of events and the execution time
+   * of each function, and the second table those of each context.
+   *
+   * \param [in] os The output stream.
+   */
+  void PrintReport (std::ostream &os) const;
+
+  /**
+   * \brief Print the profile in the folded format of flame graphs
+   *
+   * Each line is made of the context and function of the events,
+   * separated by a semicolon, and of their execution time in
+   * nanoseconds, for example
+   * \verbatim
+  node 1;ns3::PointToPointNetDevice::TransmitComplete() 182734 \endverbatim
+   * which can be rendered with \c flamegraph.pl.
+   *
+   * \param [in] os The output stream.
+   */
+  void PrintFolded (std::ostream &os) const;
+
+  /**
+   * \param [in] event The event.
+   * \return The name of the function invoked by the event, or of the
+   *         class of the event if the function is not known.
+   */
+  static std::string GetName (const EventImpl *event);
+
+private:
+  /** The events accounted together. */
+  struct Key
+  {
+    const void *function;        //!< Function invoked by the events, or 0
+    const std::type_info *type;  //!< Class of the events, if the function is not known
+    uint32_t context;            //!< Context of the events
+    /**
+     * \param [in] o The other key.
+     * \return true if both keys are equal.
+     */
+    bool operator == (const Key &o) const
+    {
+      return function == o.function && type == o.type && context == o.context;
+    }
+  };
+  /** Hash function of the keys. */
+  struct KeyHash
+  {
+    /**
+     * \param [in] key The key.
+     * \return The hash of the key.
+     */
+    std::size_t operator () (const Key &key) const
+    {
+      std::size_t h = std::hash<const void *> () (key.function);
+      h ^= std::hash<const void *> () (key.type) + 0x9e3779b9 + (h << 6) + (h >> 2);
+      return h ^ (key.context + 0x9e3779b9 + (h << 6) + (h >> 2));
+    }
+  };
+  /** The number of events and their execution time. */
+  struct Stats
+  {
+    uint64_t count;  //!< Number of events
+    uint64_t time;   //!< Execution time in nanoseconds
+  };
+  /** The statistics of the events, indexed by function and context. */
+  typedef std::unordered_map<Key, Stats, KeyHash> Profile;
+
+  /**
+   * \param [in] key The key.
+   * \return The name of the function or class of the key.
+   */
+  static std::string GetName (const Key &key);
+  /**
+   * \param [in] event The event.
+   * \param [in] context The context of the event.
+   * \return The key of the event.
+   */
+  static Key GetKey (const EventImpl *event, uint32_t context);
+
+  Profile m_profile;   //!< Statistics of the events
+  uint64_t m_count;    //!< Total number of events
+  uint64_t m_time;     //!< Total execution time in nanoseconds
+};
+
+} // namespace ns3
+
+#endif /* EVENT_PROFILER_H */
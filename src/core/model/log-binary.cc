@@ -0,0 +1,1351 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "log-binary.h"
+#include "log.h"
+#include "simulator.h"
+#include "nstime.h"
+#include "fatal-error.h"
+#include "fatal-impl.h"
+#include "ns3/core-config.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <unordered_map>
+
+#ifdef HAVE_PTHREAD_H
+#include <chrono>
+#include <condition_variable>
+#include <thread>
+#include <pthread.h>  // pthread_atfork
+#include <unistd.h>   // getpid
+#endif /* HAVE_PTHREAD_H */
+
+/**
+ * \file
+ * \ingroup logging
+ * Binary logging: ns3::LogSetBinaryFile and ns3::LogBinaryRecord
+ * implementations.
+ */
+
+namespace ns3 {
+
+// Logging is not used in this file, which implements it.
+
+/**
+ * \ingroup logging
+ * Unnamed namespace for the implementation of the binary logging.
+ */
+namespace {
+
+/** The first bytes of a binary log file. */
+const char MAGIC[] = "ns-3 binary log";
+/** The version of the binary log format. */
+const uint32_t VERSION = 1;
+
+/** The definition of a string, in a binary log file. */
+const uint8_t FILE_STRING = 'S';
+/** A block of messages of a thread, in a binary log file. */
+const uint8_t FILE_BLOCK = 'B';
+
+/** The message is prefixed with the simulation time. */
+const uint8_t PREFIX_TIME = 0x01;
+/** The simulation time is formatted by a time printer. */
+const uint8_t PREFIX_TIME_TEXT = 0x02;
+/** The message is prefixed with the node id. */
+const uint8_t PREFIX_NODE = 0x04;
+/** The node id is formatted by a node printer. */
+const uint8_t PREFIX_NODE_TEXT = 0x08;
+/** The message is prefixed with the component and function names. */
+const uint8_t PREFIX_FUNC = 0x10;
+/** The message is prefixed with its level. */
+const uint8_t PREFIX_LEVEL = 0x20;
+/** The message lists the parameters of a function. */
+const uint8_t PARAMETERS = 0x40;
+/** The message is prefixed with the context of NS_LOG_APPEND_CONTEXT. */
+const uint8_t CONTEXT = 0x80;
+
+/**
+ * \name Tags of the arguments of a message.
+ * @{
+ */
+const uint8_t ARG_END = 0;            //!< End of the message
+const uint8_t ARG_BOOL = 'b';         //!< bool
+const uint8_t ARG_CHAR = 'c';         //!< Character
+const uint8_t ARG_INT = 'i';          //!< Signed integer
+const uint8_t ARG_UINT = 'u';         //!< Unsigned integer
+const uint8_t ARG_DOUBLE = 'd';       //!< Floating point number
+const uint8_t ARG_POINTER = 'p';      //!< Pointer
+const uint8_t ARG_LITERAL = 'l';      //!< Identifier of a string literal
+const uint8_t ARG_STRING = 's';       //!< String
+const uint8_t ARG_SEPARATOR = ',';    //!< Separator of the function parameters
+/**@}*/
+
+/** The size of the buffer of each thread, in bytes. */
+const std::size_t RING_SIZE = 1 << 20;
+
+
+/**
+ * \ingroup logging
+ * A stream buffer appending to a string, to capture the output of
+ * NS_LOG_APPEND_CONTEXT.
+ */
+class CaptureBuf : public std::streambuf
+{
+public:
+  std::string m_data;  //!< The captured output
+
+protected:
+  virtual int_type overflow (int_type c)
+  {
+    if (c != traits_type::eof ())
+      {
+        m_data.push_back (traits_type::to_char_type (c));
+      }
+    return traits_type::not_eof (c);
+  }
+  virtual std::streamsize xsputn (const char *s, std::streamsize n)
+  {
+    m_data.append (s, n);
+    return n;
+  }
+};
+
+/**
+ * \ingroup logging
+ * The buffer of the messages of a thread.
+ *
+ * The thread appends messages at the head, and the background thread
+ * writes them to the file from the tail.
+ */
+struct Ring
+{
+  /**
+   * Constructor.
+   * \param [in] index The index of the thread.
+   */
+  Ring (uint32_t index)
+    : index (index),
+      data (RING_SIZE),
+      head (0),
+      tail (0)
+  {}
+  uint32_t index;                 //!< Index of the thread
+  std::vector<uint8_t> data;      //!< Buffer
+  std::atomic<uint64_t> head;     //!< Number of bytes written by the thread
+  std::atomic<uint64_t> tail;     //!< Number of bytes written to the file
+};
+
+/**
+ * \ingroup logging
+ * The state of the binary logging shared by all threads.
+ */
+class Sink
+{
+public:
+  Sink ();
+  /**
+   * Open the binary log file and start the background thread.
+   * \param [in] filename The name of the file.
+   */
+  void Open (const std::string &filename);
+  /** Write the pending messages, stop the background thread and close the file. */
+  void Close (void);
+  /**
+   * \return The identifier of a string.
+   * \param [in] s The string.
+   */
+  uint32_t Intern (const std::string &s);
+  /**
+   * \return A new buffer for the messages of a thread.
+   */
+  Ring * CreateRing (void);
+  /**
+   * Write a message to the buffer of a thread.
+   * \param [in] ring The buffer.
+   * \param [in] data The message.
+   * \param [in] size The size of the message.
+   */
+  void Commit (Ring *ring, const uint8_t *data, std::size_t size);
+  /** Write the pending messages to the file. */
+  void Drain (void);
+
+  /** Stop the background thread before the process is forked. */
+  static void PrepareFork (void);
+  /** Restart the background thread in the parent process after a fork. */
+  static void ResumeParent (void);
+  /** Write to a new file in a child process after a fork. */
+  static void ResumeChild (void);
+
+private:
+  /** Write the header of the file. */
+  void WriteHeader (void);
+  /** Start the background thread. */
+  void StartThread (void);
+  /** Stop the background thread. */
+  void StopThread (void);
+  /** The loop of the background thread. */
+  void Run (void);
+
+  std::mutex m_mutex;                                  //!< Protects the strings and buffers
+  std::unordered_map<std::string, uint32_t> m_ids;     //!< Identifiers of the strings
+  std::vector<std::string> m_strings;                  //!< Strings, by identifier
+  std::vector<Ring *> m_rings;                         //!< Buffers of the threads
+
+  std::mutex m_fileMutex;                              //!< Protects the file
+  std::ofstream m_file;                                //!< The binary log file
+  std::string m_filename;                              //!< The name of the file
+  uint32_t m_written;                                  //!< Number of strings written to the file
+
+  /** Flushes the messages on fatal errors. */
+  class FlushBuf : public std::streambuf
+  {
+  protected:
+    virtual int sync (void)
+    {
+      LogBinaryFlush ();
+      return 0;
+    }
+  } m_flushBuf;                                        //!< Flushes the messages on fatal errors
+  std::ostream m_flushStream;                          //!< Registered with FatalImpl
+
+#ifdef HAVE_PTHREAD_H
+public:
+  /** Wake up the background thread. */
+  void Wake (void)
+  {
+    m_wake.notify_one ();
+  }
+private:
+  std::thread m_thread;                                //!< The background thread
+  std::mutex m_wakeMutex;                              //!< Protects m_stop
+  std::condition_variable m_wake;                      //!< Wakes up the background thread
+  bool m_stop;                                         //!< Whether the background thread stops
+#endif /* HAVE_PTHREAD_H */
+};
+
+/** Whether the log messages are written to the binary file. */
+std::atomic<bool> g_enabled (false);
+
+/**
+ * \ingroup logging
+ * \return The binary logging state, created on first use and never
+ *         destroyed, so that it can be used until the process exits.
+ */
+Sink *
+GetSink (void)
+{
+  static Sink *sink = new Sink ();
+  return sink;
+}
+
+/** Close the binary log file when the process exits. */
+void
+CloseAtExit (void)
+{
+  GetSink ()->Close ();
+}
+
+Sink::Sink ()
+  : m_written (0),
+    m_flushStream (&m_flushBuf)
+{
+#ifdef HAVE_PTHREAD_H
+  m_stop = false;
+  pthread_atfork (&Sink::PrepareFork, &Sink::ResumeParent, &Sink::ResumeChild);
+#endif /* HAVE_PTHREAD_H */
+  std::atexit (&CloseAtExit);
+}
+
+void
+Sink::Open (const std::string &filename)
+{
+  {
+    std::lock_guard<std::mutex> lock (m_fileMutex);
+    m_file.open (filename.c_str (), std::ios::binary | std::ios::trunc);
+    if (!m_file)
+      {
+        NS_FATAL_ERROR ("Unable to open the binary log file " << filename);
+      }
+    m_filename = filename;
+    WriteHeader ();
+  }
+  FatalImpl::RegisterStream (&m_flushStream);
+  StartThread ();
+  g_enabled = true;
+}
+
+void
+Sink::Close (void)
+{
+  if (!m_file.is_open ())
+    {
+      return;
+    }
+  g_enabled = false;
+  StopThread ();
+  Drain ();
+  FatalImpl::UnregisterStream (&m_flushStream);
+  std::lock_guard<std::mutex> lock (m_fileMutex);
+  m_file.close ();
+}
+
+void
+Sink::WriteHeader (void)
+{
+  m_file.write (MAGIC, sizeof (MAGIC));
+  m_file.write (reinterpret_cast<const char *> (&VERSION), sizeof (VERSION));
+  m_written = 0;
+}
+
+uint32_t
+Sink::Intern (const std::string &s)
+{
+  std::lock_guard<std::mutex> lock (m_mutex);
+  std::unordered_map<std::string, uint32_t>::iterator it = m_ids.find (s);
+  if (it != m_ids.end ())
+    {
+      return it->second;
+    }
+  uint32_t id = static_cast<uint32_t> (m_strings.size ());
+  m_strings.push_back (s);
+  m_ids[s] = id;
+  return id;
+}
+
+Ring *
+Sink::CreateRing (void)
+{
+  std::lock_guard<std::mutex> lock (m_mutex);
+  Ring *ring = new Ring (static_cast<uint32_t> (m_rings.size ()));
+  m_rings.push_back (ring);
+  return ring;
+}
+
+void
+Sink::Commit (Ring *ring, const uint8_t *data, std::size_t size)
+{
+  uint64_t head = ring->head.load (std::memory_order_relaxed);
+  if (size > RING_SIZE)
+    {
+      // the message does not fit in the buffer: write it at once
+      Drain ();
+      std::lock_guard<std::mutex> lock (m_fileMutex);
+      uint32_t length = static_cast<uint32_t> (size);
+      m_file.put (FILE_BLOCK);
+      m_file.write (reinterpret_cast<const char *> (&ring->index), sizeof (ring->index));
+      m_file.write (reinterpret_cast<const char *> (&length), sizeof (length));
+      m_file.write (reinterpret_cast<const char *> (data), size);
+      return;
+    }
+  while (head + size - ring->tail.load (std::memory_order_acquire) > RING_SIZE)
+    {
+      // the buffer is full
+      if (!LogBinaryIsEnabled ())
+        {
+          // the file was closed while the message was recorded
+          return;
+        }
+#ifdef HAVE_PTHREAD_H
+      Wake ();
+      std::this_thread::yield ();
+#else
+      Drain ();
+#endif /* HAVE_PTHREAD_H */
+    }
+  std::size_t offset = head % RING_SIZE;
+  std::size_t first = std::min (size, RING_SIZE - offset);
+  std::memcpy (&ring->data[offset], data, first);
+  std::memcpy (&ring->data[0], data + first, size - first);
+  ring->head.store (head + size, std::memory_order_release);
+#ifdef HAVE_PTHREAD_H
+  if (head + size - ring->tail.load (std::memory_order_relaxed) > RING_SIZE / 2)
+    {
+      Wake ();
+    }
+#endif /* HAVE_PTHREAD_H */
+}
+
+void
+Sink::Drain (void)
+{
+  std::lock_guard<std::mutex> fileLock (m_fileMutex);
+  if (!m_file.is_open ())
+    {
+      return;
+    }
+  std::vector<Ring *> rings;
+  {
+    std::lock_guard<std::mutex> lock (m_mutex);
+    rings = m_rings;
+  }
+  // The heads are read before the strings, so that the strings used
+  // by the messages written are written before them.
+  std::vector<uint64_t> heads;
+  for (Ring *ring : rings)
+    {
+      heads.push_back (ring->head.load (std::memory_order_acquire));
+    }
+  std::vector<std::string> strings;
+  {
+    std::lock_guard<std::mutex> lock (m_mutex);
+    strings.assign (m_strings.begin () + m_written, m_strings.end ());
+  }
+  for (const std::string &s : strings)
+    {
+      uint32_t length = static_cast<uint32_t> (s.size ());
+      m_file.put (FILE_STRING);
+      m_file.write (reinterpret_cast<const char *> (&m_written), sizeof (m_written));
+      m_file.write (reinterpret_cast<const char *> (&length), sizeof (length));
+      m_file.write (s.data (), length);
+      m_written++;
+    }
+  for (std::size_t i = 0; i < rings.size (); ++i)
+    {
+      Ring *ring = rings[i];
+      uint64_t tail = ring->tail.load (std::memory_order_relaxed);
+      if (heads[i] == tail)
+        {
+          continue;
+        }
+      uint32_t length = static_cast<uint32_t> (heads[i] - tail);
+      m_file.put (FILE_BLOCK);
+      m_file.write (reinterpret_cast<const char *> (&ring->index), sizeof (ring->index));
+      m_file.write (reinterpret_cast<const char *> (&length), sizeof (length));
+      std::size_t offset = tail % RING_SIZE;
+      std::size_t first = std::min<std::size_t> (length, RING_SIZE - offset);
+      m_file.write (reinterpret_cast<const char *> (&ring->data[offset]), first);
+      m_file.write (reinterpret_cast<const char *> (&ring->data[0]), length - first);
+      ring->tail.store (heads[i], std::memory_order_release);
+    }
+  m_file.flush ();
+}
+
+#ifdef HAVE_PTHREAD_H
+
+void
+Sink::StartThread (void)
+{
+  m_stop = false;
+  m_thread = std::thread (&Sink::Run, this);
+}
+
+void
+Sink::StopThread (void)
+{
+  if (!m_thread.joinable ())
+    {
+      return;
+    }
+  {
+    std::lock_guard<std::mutex> lock (m_wakeMutex);
+    m_stop = true;
+  }
+  m_wake.notify_one ();
+  m_thread.join ();
+}
+
+void
+Sink::Run (void)
+{
+  std::unique_lock<std::mutex> lock (m_wakeMutex);
+  while (!m_stop)
+    {
+      m_wake.wait_for (lock, std::chrono::milliseconds (10));
+      lock.unlock ();
+      Drain ();
+      lock.lock ();
+    }
+}
+
+void
+Sink::PrepareFork (void)
+{
+  Sink *sink = GetSink ();
+  if (sink->m_file.is_open ())
+    {
+      sink->StopThread ();
+      sink->Drain ();
+    }
+}
+
+void
+Sink::ResumeParent (void)
+{
+  Sink *sink = GetSink ();
+  if (sink->m_file.is_open ())
+    {
+      sink->StartThread ();
+    }
+}
+
+void
+Sink::ResumeChild (void)
+{
+  Sink *sink = GetSink ();
+  if (sink->m_file.is_open ())
+    {
+      // the file of the parent process was flushed before the fork
+      sink->m_file.close ();
+      std::ostringstream oss;
+      oss << sink->m_filename << "." << getpid ();
+      sink->m_file.open (oss.str ().c_str (), std::ios::binary | std::ios::trunc);
+      if (sink->m_file)
+        {
+          sink->WriteHeader ();
+          sink->StartThread ();
+        }
+      else
+        {
+          g_enabled = false;
+        }
+    }
+}
+
+#else /* HAVE_PTHREAD_H */
+
+void
+Sink::StartThread (void)
+{}
+
+void
+Sink::StopThread (void)
+{}
+
+#endif /* HAVE_PTHREAD_H */
+
+
+/**
+ * \ingroup logging
+ * The state of the binary logging of a thread.
+ */
+struct ThreadState
+{
+  ThreadState ()
+    : ring (GetSink ()->CreateRing ()),
+      depth (0)
+  {}
+  /** A string identifier cached by the address of the string. */
+  struct Cached
+  {
+    uint32_t id;       //!< Identifier
+    std::string text;  //!< Text of the string
+  };
+  Ring *ring;                                           //!< Buffer of the messages
+  std::unordered_map<const void *, Cached> strings;     //!< Identifiers of the strings
+  std::vector<void *> levels;                           //!< Buffers of the nested messages
+  std::size_t depth;                                    //!< Number of messages being recorded
+};
+
+/**
+ * \ingroup logging
+ * The state of the binary logging of this thread.
+ *
+ * The state is allocated on first use and never freed, so that it
+ * remains valid while static objects are destroyed.
+ */
+thread_local ThreadState *t_state = 0;
+
+/**
+ * \ingroup logging
+ * \return The state of the binary logging of this thread.
+ */
+ThreadState *
+GetThreadState (void)
+{
+  if (t_state == 0)
+    {
+      t_state = new ThreadState ();
+    }
+  return t_state;
+}
+
+/**
+ * \ingroup logging
+ * Get the identifier of a string with a static address.
+ * \param [in] state The state of the thread.
+ * \param [in] address The address identifying the string.
+ * \param [in] s The string.
+ * \return The identifier of the string.
+ */
+uint32_t
+GetStaticId (ThreadState *state, const void *address, const char *s)
+{
+  std::unordered_map<const void *, ThreadState::Cached>::iterator it = state->strings.find (address);
+  if (it != state->strings.end ())
+    {
+      return it->second.id;
+    }
+  ThreadState::Cached &cached = state->strings[address];
+  cached.text = s;
+  cached.id = GetSink ()->Intern (cached.text);
+  return cached.id;
+}
+
+/**
+ * \ingroup logging
+ * Handler for the NS_LOG_BINARY environment variable.
+ */
+class EnvironmentFile
+{
+public:
+  /** Constructor, opens the binary log file. */
+  EnvironmentFile ()
+  {
+    const char *envVar = std::getenv ("NS_LOG_BINARY");
+    if (envVar != 0 && std::strlen (envVar) != 0)
+      {
+        LogSetBinaryFile (envVar);
+      }
+  }
+};
+
+/** Opens the binary log file named by NS_LOG_BINARY. */
+EnvironmentFile g_environmentFile;
+
+} // unnamed namespace
+
+
+/** The buffers of a message being recorded. */
+struct LogBinaryRecord::Level
+{
+  std::vector<uint8_t> buffer;  //!< The message
+  std::ostringstream text;      //!< The arguments formatted as a string
+  CaptureBuf context;           //!< The output of NS_LOG_APPEND_CONTEXT
+};
+
+LogBinaryRecord::LogBinaryRecord (const LogComponent &component, int level,
+                                  const char *function, bool parameters)
+  : m_text (0),
+    m_clog (0),
+    m_parameters (parameters),
+    m_first (true)
+{
+  ThreadState *state = GetThreadState ();
+  if (state->depth == state->levels.size ())
+    {
+      state->levels.push_back (new Level ());
+    }
+  m_level = static_cast<Level *> (state->levels[state->depth++]);
+  m_buffer = &m_level->buffer;
+  m_buffer->clear ();
+
+  uint8_t flags = 0;
+  TimePrinter timePrinter = LogGetTimePrinter ();
+  if (timePrinter != 0 && component.IsEnabled (LOG_PREFIX_TIME))
+    {
+      flags |= timePrinter == &DefaultTimePrinter ? PREFIX_TIME : PREFIX_TIME_TEXT;
+    }
+  NodePrinter nodePrinter = LogGetNodePrinter ();
+  if (nodePrinter != 0 && component.IsEnabled (LOG_PREFIX_NODE))
+    {
+      flags |= nodePrinter == &DefaultNodePrinter ? PREFIX_NODE : PREFIX_NODE_TEXT;
+    }
+  if (parameters)
+    {
+      flags |= PARAMETERS;
+    }
+  else
+    {
+      if (component.IsEnabled (LOG_PREFIX_FUNC))
+        {
+          flags |= PREFIX_FUNC;
+        }
+      if (component.IsEnabled (LOG_PREFIX_LEVEL))
+        {
+          flags |= PREFIX_LEVEL;
+        }
+    }
+  m_buffer->push_back (flags);
+  uint32_t value = static_cast<uint32_t> (level);
+  Append (&value, sizeof (value));
+  value = GetStaticId (state, &component, component.Name ());
+  Append (&value, sizeof (value));
+  value = GetStaticId (state, function, function);
+  Append (&value, sizeof (value));
+
+  if (flags & PREFIX_TIME)
+    {
+      int64_t step = Simulator::Now ().GetTimeStep ();
+      Append (&step, sizeof (step));
+      m_buffer->push_back (static_cast<uint8_t> (Time::GetResolution ()));
+    }
+  else if (flags & PREFIX_TIME_TEXT)
+    {
+      std::ostringstream oss;
+      (*timePrinter)(oss);
+      AppendString (oss.str ().data (), oss.str ().size ());
+    }
+  if (flags & PREFIX_NODE)
+    {
+      uint32_t context = Simulator::GetContext ();
+      Append (&context, sizeof (context));
+    }
+  else if (flags & PREFIX_NODE_TEXT)
+    {
+      std::ostringstream oss;
+      (*nodePrinter)(oss);
+      AppendString (oss.str ().data (), oss.str ().size ());
+    }
+}
+
+LogBinaryRecord::~LogBinaryRecord ()
+{
+  FlushText ();
+  m_buffer->push_back (ARG_END);
+  ThreadState *state = GetThreadState ();
+  GetSink ()->Commit (state->ring, m_buffer->data (), m_buffer->size ());
+  state->depth--;
+}
+
+void
+LogBinaryRecord::BeginContext (void)
+{
+  m_level->context.m_data.clear ();
+  m_clog = std::clog.rdbuf (&m_level->context);
+}
+
+void
+LogBinaryRecord::EndContext (void)
+{
+  std::clog.rdbuf (m_clog);
+  if (!m_level->context.m_data.empty ())
+    {
+      (*m_buffer)[0] |= CONTEXT;
+      AppendString (m_level->context.m_data.data (), m_level->context.m_data.size ());
+    }
+}
+
+void
+LogBinaryRecord::Separate (void)
+{
+  FlushText ();
+  if (m_first)
+    {
+      m_first = false;
+    }
+  else
+    {
+      m_buffer->push_back (ARG_SEPARATOR);
+    }
+}
+
+std::ostream &
+LogBinaryRecord::Text (void)
+{
+  if (m_text == 0)
+    {
+      m_text = &m_level->text;
+      m_level->text.str ("");
+      m_level->text.clear ();
+      m_level->text.flags (std::clog.flags ());
+      m_level->text.precision (std::clog.precision ());
+      m_level->text.fill (std::clog.fill ());
+    }
+  return *m_text;
+}
+
+void
+LogBinaryRecord::FlushText (void)
+{
+  if (m_text == 0)
+    {
+      return;
+    }
+  std::string text = m_level->text.str ();
+  if (!text.empty ())
+    {
+      AppendString (text.data (), text.size ());
+    }
+  m_text = 0;
+}
+
+void
+LogBinaryRecord::AppendString (const char *s, std::size_t size)
+{
+  uint32_t length = static_cast<uint32_t> (size);
+  m_buffer->push_back (ARG_STRING);
+  Append (&length, sizeof (length));
+  Append (s, size);
+}
+
+void
+LogBinaryRecord::AppendLiteral (const char *s, std::size_t size)
+{
+  ThreadState *state = GetThreadState ();
+  std::unordered_map<const void *, ThreadState::Cached>::iterator it = state->strings.find (s);
+  if (it == state->strings.end ())
+    {
+      ThreadState::Cached &cached = state->strings[s];
+      cached.text.assign (s, size);
+      cached.id = GetSink ()->Intern (cached.text);
+      AppendValue (ARG_LITERAL, cached.id);
+    }
+  else if (it->second.text.size () == size && std::memcmp (it->second.text.data (), s, size) == 0)
+    {
+      AppendValue (ARG_LITERAL, it->second.id);
+    }
+  else
+    {
+      // an array whose content changed since it was first logged
+      AppendString (s, size);
+    }
+}
+
+LogBinaryRecord &
+LogBinaryRecord::operator << (std::ostream & (*manipulator)(std::ostream &))
+{
+  if (m_parameters)
+    {
+      Separate ();
+    }
+  Text () << manipulator;
+  return *this;
+}
+
+LogBinaryRecord &
+LogBinaryRecord::operator << (std::ios & (*manipulator)(std::ios &))
+{
+  if (m_parameters)
+    {
+      Separate ();
+    }
+  Text () << manipulator;
+  return *this;
+}
+
+LogBinaryRecord &
+LogBinaryRecord::operator << (std::ios_base & (*manipulator)(std::ios_base &))
+{
+  if (m_parameters)
+    {
+      Separate ();
+    }
+  Text () << manipulator;
+  return *this;
+}
+
+void
+LogBinaryRecord::Put (bool value)
+{
+  AppendValue (ARG_BOOL, static_cast<uint8_t> (value));
+}
+
+void
+LogBinaryRecord::Put (char value)
+{
+  AppendValue (ARG_CHAR, value);
+}
+
+void
+LogBinaryRecord::Put (signed char value)
+{
+  if (m_parameters)
+    {
+      // int8_t parameters are printed as numbers, as by ParameterLogger
+      AppendValue (ARG_INT, static_cast<int64_t> (value));
+    }
+  else
+    {
+      AppendValue (ARG_CHAR, static_cast<char> (value));
+    }
+}
+
+void
+LogBinaryRecord::Put (unsigned char value)
+{
+  if (m_parameters)
+    {
+      AppendValue (ARG_UINT, static_cast<uint64_t> (value));
+    }
+  else
+    {
+      AppendValue (ARG_CHAR, static_cast<char> (value));
+    }
+}
+
+void
+LogBinaryRecord::Put (short value)
+{
+  AppendValue (ARG_INT, static_cast<int64_t> (value));
+}
+
+void
+LogBinaryRecord::Put (unsigned short value)
+{
+  AppendValue (ARG_UINT, static_cast<uint64_t> (value));
+}
+
+void
+LogBinaryRecord::Put (int value)
+{
+  AppendValue (ARG_INT, static_cast<int64_t> (value));
+}
+
+void
+LogBinaryRecord::Put (unsigned int value)
+{
+  AppendValue (ARG_UINT, static_cast<uint64_t> (value));
+}
+
+void
+LogBinaryRecord::Put (long value)
+{
+  AppendValue (ARG_INT, static_cast<int64_t> (value));
+}
+
+void
+LogBinaryRecord::Put (unsigned long value)
+{
+  AppendValue (ARG_UINT, static_cast<uint64_t> (value));
+}
+
+void
+LogBinaryRecord::Put (long long value)
+{
+  AppendValue (ARG_INT, static_cast<int64_t> (value));
+}
+
+void
+LogBinaryRecord::Put (unsigned long long value)
+{
+  AppendValue (ARG_UINT, static_cast<uint64_t> (value));
+}
+
+void
+LogBinaryRecord::Put (float value)
+{
+  AppendValue (ARG_DOUBLE, static_cast<double> (value));
+}
+
+void
+LogBinaryRecord::Put (double value)
+{
+  AppendValue (ARG_DOUBLE, value);
+}
+
+void
+LogBinaryRecord::Put (const char *value)
+{
+  if (m_parameters)
+    {
+      // string parameters are quoted, as by ParameterLogger
+      Text () << '"' << value << '"';
+    }
+  else
+    {
+      AppendString (value, std::strlen (value));
+    }
+}
+
+void
+LogBinaryRecord::Put (char *value)
+{
+  if (m_parameters)
+    {
+      // only constant strings are quoted by ParameterLogger
+      Text () << value;
+    }
+  else
+    {
+      AppendString (value, std::strlen (value));
+    }
+}
+
+void
+LogBinaryRecord::Put (const std::string &value)
+{
+  if (m_parameters)
+    {
+      Text () << '"' << value << '"';
+    }
+  else
+    {
+      AppendString (value.data (), value.size ());
+    }
+}
+
+
+void
+LogSetBinaryFile (const std::string &filename)
+{
+  Sink *sink = GetSink ();
+  sink->Close ();
+  if (!filename.empty ())
+    {
+      sink->Open (filename);
+    }
+}
+
+bool
+LogBinaryIsEnabled (void)
+{
+  return g_enabled.load (std::memory_order_relaxed);
+}
+
+void
+LogBinaryFlush (void)
+{
+  GetSink ()->Drain ();
+}
+
+
+/**
+ * \ingroup logging
+ * Unnamed namespace for the decoder of the binary log files.
+ */
+namespace {
+
+/**
+ * \ingroup logging
+ * Read a value from a binary log file.
+ * \tparam T \deduced The type of the value.
+ * \param [in] is The input stream.
+ * \param [out] value The value.
+ * \return \c true if the value was read.
+ */
+template <typename T>
+bool
+Read (std::istream &is, T &value)
+{
+  return static_cast<bool> (is.read (reinterpret_cast<char *> (&value), sizeof (value)));
+}
+
+/**
+ * \ingroup logging
+ * Read a string from a binary log file.
+ * \param [in] is The input stream.
+ * \param [out] s The string.
+ * \return \c true if the string was read.
+ */
+bool
+ReadString (std::istream &is, std::string &s)
+{
+  uint32_t length;
+  if (!Read (is, length))
+    {
+      return false;
+    }
+  s.resize (length);
+  return length == 0 || static_cast<bool> (is.read (&s[0], length));
+}
+
+/**
+ * \ingroup logging
+ * Print the simulation time as DefaultTimePrinter does.
+ * \param [in] os The output stream.
+ * \param [in] step The simulation time in units of the resolution.
+ * \param [in] resolution The time resolution.
+ */
+void
+PrintTime (std::ostream &os, int64_t step, Time::Unit resolution)
+{
+  int precision = 5;
+  switch (resolution)
+    {
+      // *NS_CHECK_STYLE_OFF*
+    case Time::US :    precision = 6;   break;
+    case Time::NS :    precision = 9;   break;
+    case Time::PS :    precision = 12;  break;
+    case Time::FS :    precision = 15;  break;
+      // *NS_CHECK_STYLE_ON*
+    default:
+      break;
+    }
+  if (resolution < Time::S)
+    {
+      static const double seconds[] = {365 * 24 * 3600.0, 24 * 3600.0, 3600.0, 60.0};
+      std::ios_base::fmtflags ff = os.flags ();
+      std::streamsize oldPrecision = os.precision ();
+      os << std::fixed << std::setprecision (precision) << std::showpos
+         << step * seconds[resolution] << "s";
+      os.precision (oldPrecision);
+      os.flags (ff);
+      return;
+    }
+  // the time is an exact decimal number of seconds
+  int digits = 3 * (resolution - Time::S);
+  uint64_t scale = 1;
+  for (int i = 0; i < digits; ++i)
+    {
+      scale *= 10;
+    }
+  uint64_t magnitude = step < 0 ? -static_cast<uint64_t> (step) : step;
+  std::ostringstream oss;
+  oss << (step < 0 ? '-' : '+') << magnitude / scale << '.';
+  if (digits > 0)
+    {
+      oss << std::setw (digits) << std::setfill ('0') << magnitude % scale;
+    }
+  oss << std::string (precision - digits, '0') << "s";
+  os << oss.str ();
+}
+
+/**
+ * \ingroup logging
+ * Decode and print a message.
+ * \param [in] is The block of the message.
+ * \param [in] os The output stream.
+ * \param [in] strings The strings of the file.
+ * \return \c true if the message was decoded.
+ */
+bool
+DecodeMessage (std::istream &is, std::ostream &os, const std::vector<std::string> &strings)
+{
+  uint8_t flags;
+  uint32_t level;
+  uint32_t component;
+  uint32_t function;
+  if (!Read (is, flags) || !Read (is, level) || !Read (is, component) || !Read (is, function)
+      || component >= strings.size () || function >= strings.size ())
+    {
+      return false;
+    }
+  std::string s;
+  if (flags & PREFIX_TIME)
+    {
+      int64_t step;
+      uint8_t resolution;
+      if (!Read (is, step) || !Read (is, resolution) || resolution >= Time::LAST)
+        {
+          return false;
+        }
+      PrintTime (os, step, static_cast<Time::Unit> (resolution));
+      os << " ";
+    }
+  else if (flags & PREFIX_TIME_TEXT)
+    {
+      uint8_t tag;
+      if (!Read (is, tag) || tag != ARG_STRING || !ReadString (is, s))
+        {
+          return false;
+        }
+      os << s << " ";
+    }
+  if (flags & PREFIX_NODE)
+    {
+      uint32_t context;
+      if (!Read (is, context))
+        {
+          return false;
+        }
+      if (context == Simulator::NO_CONTEXT)
+        {
+          os << "-1 ";
+        }
+      else
+        {
+          os << context << " ";
+        }
+    }
+  else if (flags & PREFIX_NODE_TEXT)
+    {
+      uint8_t tag;
+      if (!Read (is, tag) || tag != ARG_STRING || !ReadString (is, s))
+        {
+          return false;
+        }
+      os << s << " ";
+    }
+  if (flags & CONTEXT)
+    {
+      uint8_t tag;
+      if (!Read (is, tag) || tag != ARG_STRING || !ReadString (is, s))
+        {
+          return false;
+        }
+      os << s;
+    }
+  if (flags & PARAMETERS)
+    {
+      os << strings[component] << ":" << strings[function] << "(";
+    }
+  else
+    {
+      if (flags & PREFIX_FUNC)
+        {
+          os << strings[component] << ":" << strings[function] << "(): ";
+        }
+      if (flags & PREFIX_LEVEL)
+        {
+          os << "[" << LogComponent::GetLevelLabel (static_cast<LogLevel> (level)) << "] ";
+        }
+    }
+
+  while (true)
+    {
+      uint8_t tag;
+      if (!Read (is, tag))
+        {
+          return false;
+        }
+      if (tag == ARG_END)
+        {
+          break;
+        }
+      switch (tag)
+        {
+        case ARG_BOOL:
+          {
+            uint8_t value;
+            if (!Read (is, value))
+              {
+                return false;
+              }
+            os << (value != 0);
+            break;
+          }
+        case ARG_CHAR:
+          {
+            char value;
+            if (!Read (is, value))
+              {
+                return false;
+              }
+            os << value;
+            break;
+          }
+        case ARG_INT:
+          {
+            int64_t value;
+            if (!Read (is, value))
+              {
+                return false;
+              }
+            os << value;
+            break;
+          }
+        case ARG_UINT:
+          {
+            uint64_t value;
+            if (!Read (is, value))
+              {
+                return false;
+              }
+            os << value;
+            break;
+          }
+        case ARG_DOUBLE:
+          {
+            double value;
+            if (!Read (is, value))
+              {
+                return false;
+              }
+            os << value;
+            break;
+          }
+        case ARG_POINTER:
+          {
+            const void *value;
+            if (!Read (is, value))
+              {
+                return false;
+              }
+            os << value;
+            break;
+          }
+        case ARG_LITERAL:
+          {
+            uint32_t id;
+            if (!Read (is, id) || id >= strings.size ())
+              {
+                return false;
+              }
+            os << strings[id];
+            break;
+          }
+        case ARG_STRING:
+          if (!ReadString (is, s))
+            {
+              return false;
+            }
+          os << s;
+          break;
+        case ARG_SEPARATOR:
+          os << ", ";
+          break;
+        default:
+          return false;
+        }
+    }
+  if (flags & PARAMETERS)
+    {
+      os << ")";
+    }
+  os << std::endl;
+  return true;
+}
+
+} // unnamed namespace
+
+bool
+LogBinaryDecode (std::istream &is, std::ostream &os)
+{
+  char magic[sizeof (MAGIC)];
+  uint32_t version;
+  if (!is.read (magic, sizeof (magic)) || std::memcmp (magic, MAGIC, sizeof (MAGIC)) != 0
+      || !Read (is, version) || version != VERSION)
+    {
+      return false;
+    }
+  std::vector<std::string> strings;
+  uint8_t type;
+  while (Read (is, type))
+    {
+      if (type == FILE_STRING)
+        {
+          uint32_t id;
+          std::string s;
+          if (!Read (is, id) || !ReadString (is, s))
+            {
+              return false;
+            }
+          if (id >= strings.size ())
+            {
+              strings.resize (id + 1);
+            }
+          strings[id] = s;
+        }
+      else if (type == FILE_BLOCK)
+        {
+          uint32_t thread;
+          std::string block;
+          if (!Read (is, thread) || !ReadString (is, block))
+            {
+              return false;
+            }
+          std::istringstream messages (block);
+          while (messages.peek () != std::char_traits<char>::eof ())
+            {
+              if (!DecodeMessage (messages, os, strings))
+                {
+                  return false;
+                }
+            }
+        }
+      else
+        {
+          return false;
+        }
+    }
+  return is.eof ();
+}
+
+} // namespace ns3
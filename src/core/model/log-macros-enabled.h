@@ -189,12 +189,24 @@
   do {                                                          \
       if (g_log.IsEnabled (level))                              \
         {                                                       \
-          NS_LOG_APPEND_TIME_PREFIX;                            \
-          NS_LOG_APPEND_NODE_PREFIX;                            \
-          NS_LOG_APPEND_CONTEXT;                                \
-          NS_LOG_APPEND_FUNC_PREFIX;                            \
-          NS_LOG_APPEND_LEVEL_PREFIX (level);                   \
-          std::clog << msg << std::endl;                        \
+          if (ns3::LogBinaryIsEnabled ())                       \
+            {                                                   \
+              ns3::LogBinaryRecord ns3LogBinaryRecord           \
+                (g_log, level, __FUNCTION__, false);            \
+              ns3LogBinaryRecord.BeginContext ();               \
+              NS_LOG_APPEND_CONTEXT;                            \
+              ns3LogBinaryRecord.EndContext ();                 \
+              ns3LogBinaryRecord << msg;                        \
+            }                                                   \
+          else                                                  \
+            {                                                   \
+              NS_LOG_APPEND_TIME_PREFIX;                        \
+              NS_LOG_APPEND_NODE_PREFIX;                        \
+              NS_LOG_APPEND_CONTEXT;                            \
+              NS_LOG_APPEND_FUNC_PREFIX;                        \
+              NS_LOG_APPEND_LEVEL_PREFIX (level);               \
+              std::clog << msg << std::endl;                    \
+            }                                                   \
         }                                                       \
     } while (false)
 
@@ -211,11 +223,22 @@
   do {                                                          \
       if (g_log.IsEnabled (ns3::LOG_FUNCTION))                  \
         {                                                       \
-          NS_LOG_APPEND_TIME_PREFIX;                            \
-          NS_LOG_APPEND_NODE_PREFIX;                            \
-          NS_LOG_APPEND_CONTEXT;                                \
-          std::clog << g_log.Name () << ":"                     \
-                    << __FUNCTION__ << "()" << std::endl;       \
+          if (ns3::LogBinaryIsEnabled ())                       \
+            {                                                   \
+              ns3::LogBinaryRecord ns3LogBinaryRecord           \
+                (g_log, ns3::LOG_FUNCTION, __FUNCTION__, true); \
+              ns3LogBinaryRecord.BeginContext ();               \
+              NS_LOG_APPEND_CONTEXT;                            \
+              ns3LogBinaryRecord.EndContext ();                 \
+            }                                                   \
+          else                                                  \
+            {                                                   \
+              NS_LOG_APPEND_TIME_PREFIX;                        \
+              NS_LOG_APPEND_NODE_PREFIX;                        \
+              NS_LOG_APPEND_CONTEXT;                            \
+              std::clog << g_log.Name () << ":"                 \
+                        << __FUNCTION__ << "()" << std::endl;   \
+            }                                                   \
         }                                                       \
     } while (false)
 
@@ -247,13 +270,25 @@
     {                                                           \
       if (g_log.IsEnabled (ns3::LOG_FUNCTION))                  \
         {                                                       \
-          NS_LOG_APPEND_TIME_PREFIX;                            \
-          NS_LOG_APPEND_NODE_PREFIX;                            \
-          NS_LOG_APPEND_CONTEXT;                                \
-          std::clog << g_log.Name () << ":"                     \
-                    << __FUNCTION__ << "(";                     \
-          ns3::ParameterLogger (std::clog) << parameters;       \
-          std::clog << ")" << std::endl;                        \
+          if (ns3::LogBinaryIsEnabled ())                       \
+            {                                                   \
+              ns3::LogBinaryRecord ns3LogBinaryRecord           \
+                (g_log, ns3::LOG_FUNCTION, __FUNCTION__, true); \
+              ns3LogBinaryRecord.BeginContext ();               \
+              NS_LOG_APPEND_CONTEXT;                            \
+              ns3LogBinaryRecord.EndContext ();                 \
+              ns3LogBinaryRecord << parameters;                 \
+            }                                                   \
+          else                                                  \
+            {                                                   \
+              NS_LOG_APPEND_TIME_PREFIX;                        \
+              NS_LOG_APPEND_NODE_PREFIX;                        \
+              NS_LOG_APPEND_CONTEXT;                            \
+              std::clog << g_log.Name () << ":"                 \
+                        << __FUNCTION__ << "(";                 \
+              ns3::ParameterLogger (std::clog) << parameters;   \
+              std::clog << ")" << std::endl;                    \
+            }                                                   \
         }                                                       \
     }                                                           \
   while (false)
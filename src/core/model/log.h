@@ -29,6 +29,7 @@
 
 #include "node-printer.h"
 #include "time-printer.h"
+#include "log-binary.h"
 #include "log-macros-enabled.h"
 #include "log-macros-disabled.h"
 
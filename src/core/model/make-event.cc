@@ -51,6 +51,10 @@ EventImpl * MakeEvent (void (*f)(void))
     {
       (*m_function)();
     }
+    virtual const void * PeekFunction (void) const
+    {
+      return reinterpret_cast<const void *> (m_function);
+    }
 
   private:
     F m_function;
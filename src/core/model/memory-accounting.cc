@@ -0,0 +1,402 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "memory-accounting.h"
+#include "type-id.h"
+#include "global-value.h"
+#include "boolean.h"
+#include "log.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <typeindex>
+#include <unordered_map>
+
+#if (__GNUC__ >= 3)
+#include <cxxabi.h>
+#endif
+
+/**
+ * \file
+ * \ingroup debugging
+ * ns3::MemoryAccounting implementation.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MemoryAccounting");
+
+bool MemoryAccounting::m_enabled = false;
+
+namespace {
+
+/** The number of live instances and their memory usage. */
+struct Entry
+{
+  uint64_t count = 0;  //!< Number of live instances
+  uint64_t bytes = 0;  //!< Memory used by the instances
+};
+
+/**
+ * \ingroup debugging
+ * The accounting of the instances.
+ */
+struct Accounts
+{
+  std::mutex mutex;                                      //!< Protects the accounts
+  std::vector<Entry> objects;                            //!< Objects, by TypeId uid
+  std::unordered_map<std::type_index, Entry> types;      //!< Other instances, by type
+};
+
+/**
+ * \ingroup debugging
+ * \return The accounting of the instances, created on first use and
+ *         never destroyed, since instances can be created during the
+ *         static initialization and destroyed after the static
+ *         destruction.
+ */
+Accounts *
+GetAccounts (void)
+{
+  static Accounts *accounts = new Accounts ();
+  return accounts;
+}
+
+/**
+ * \ingroup debugging
+ * \param [in] tid The TypeId.
+ * \return The size of the Objects of a TypeId, or of its closest parent
+ *         with a registered size.
+ */
+std::size_t
+GetObjectSize (TypeId tid)
+{
+  while (true)
+    {
+      std::size_t size = tid.GetSize ();
+      if (size != static_cast<std::size_t> (-1))
+        {
+          return size;
+        }
+      if (!tid.HasParent () || tid.GetParent () == tid)
+        {
+          return 0;
+        }
+      tid = tid.GetParent ();
+    }
+}
+
+/**
+ * \ingroup debugging
+ * Demangle a C++ type name.
+ * \param [in] mangled The mangled name.
+ * \return The demangled name, or the mangled name if demangling fails.
+ */
+std::string
+Demangle (const char *mangled)
+{
+  std::string ret = mangled;
+#if (__GNUC__ >= 3)
+  int status;
+  char *demangled = abi::__cxa_demangle (mangled, NULL, NULL, &status);
+  if (status == 0)
+    {
+      ret = demangled;
+    }
+  std::free (demangled);
+#endif
+  return ret;
+}
+
+/**
+ * \ingroup debugging
+ * Sort the usages by decreasing memory usage.
+ * \param [in] usages The usages.
+ */
+void
+Sort (std::vector<MemoryAccounting::Usage> &usages)
+{
+  std::sort (usages.begin (), usages.end (),
+             [] (const MemoryAccounting::Usage &a, const MemoryAccounting::Usage &b)
+             {
+               return a.bytes > b.bytes || (a.bytes == b.bytes && a.name < b.name);
+             });
+}
+
+/**
+ * \ingroup debugging
+ * Print a table of usages.
+ * \param [in] os The output stream.
+ * \param [in] usages The usages.
+ * \param [in] title The title of the last column.
+ */
+void
+PrintTable (std::ostream &os, const std::vector<MemoryAccounting::Usage> &usages,
+            std::string title)
+{
+  std::ios::fmtflags flags = os.flags ();
+  os << std::setw (14) << "Bytes"
+     << std::setw (12) << "Instances"
+     << "  " << title << std::endl;
+  for (const MemoryAccounting::Usage &usage : usages)
+    {
+      os << std::setw (14) << usage.bytes
+         << std::setw (12) << usage.count
+         << "  " << (usage.name.empty () ? "(none)" : usage.name) << std::endl;
+    }
+  os.flags (flags);
+}
+
+/**
+ * \ingroup debugging
+ * Whether the instances are accounted from the start of the program.
+ */
+GlobalValue g_memoryAccounting ("MemoryAccounting",
+                                "Account the live instances and their memory usage "
+                                "from the start of the program",
+                                BooleanValue (false),
+                                MakeBooleanChecker ());
+
+/**
+ * \ingroup debugging
+ * Enable the accounting at the start of the program if the
+ * MemoryAccounting GlobalValue is set.
+ */
+struct EnableFromGlobalValue
+{
+  EnableFromGlobalValue ()
+  {
+    BooleanValue enabled;
+    g_memoryAccounting.GetValue (enabled);
+    if (enabled.Get ())
+      {
+        MemoryAccounting::Enable ();
+      }
+  }
+} g_enableFromGlobalValue;  //!< Enables the accounting at the start of the program
+
+} // unnamed namespace
+
+
+void
+MemoryAccounting::Enable (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  m_enabled = true;
+}
+
+void
+MemoryAccounting::Disable (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  m_enabled = false;
+}
+
+void
+MemoryAccounting::AddObject (TypeId tid)
+{
+  std::size_t bytes = GetObjectSize (tid);
+  Accounts *accounts = GetAccounts ();
+  std::lock_guard<std::mutex> lock (accounts->mutex);
+  if (accounts->objects.size () <= tid.GetUid ())
+    {
+      accounts->objects.resize (tid.GetUid () + 1);
+    }
+  Entry &entry = accounts->objects[tid.GetUid ()];
+  entry.count++;
+  entry.bytes += bytes;
+}
+
+void
+MemoryAccounting::RemoveObject (TypeId tid)
+{
+  std::size_t bytes = GetObjectSize (tid);
+  Accounts *accounts = GetAccounts ();
+  std::lock_guard<std::mutex> lock (accounts->mutex);
+  NS_ASSERT (tid.GetUid () < accounts->objects.size ());
+  Entry &entry = accounts->objects[tid.GetUid ()];
+  entry.count--;
+  entry.bytes -= bytes;
+}
+
+void
+MemoryAccounting::Add (const std::type_info &type, std::size_t bytes)
+{
+  Accounts *accounts = GetAccounts ();
+  std::lock_guard<std::mutex> lock (accounts->mutex);
+  Entry &entry = accounts->types[std::type_index (type)];
+  entry.count++;
+  entry.bytes += bytes;
+}
+
+void
+MemoryAccounting::Remove (const std::type_info &type, std::size_t bytes)
+{
+  Accounts *accounts = GetAccounts ();
+  std::lock_guard<std::mutex> lock (accounts->mutex);
+  Entry &entry = accounts->types[std::type_index (type)];
+  entry.count--;
+  entry.bytes -= bytes;
+}
+
+MemoryAccounting::Usage
+MemoryAccounting::GetUsage (TypeId tid)
+{
+  NS_LOG_FUNCTION (tid);
+  Usage usage = {tid.GetName (), 0, 0};
+  Accounts *accounts = GetAccounts ();
+  std::lock_guard<std::mutex> lock (accounts->mutex);
+  if (tid.GetUid () < accounts->objects.size ())
+    {
+      usage.count = accounts->objects[tid.GetUid ()].count;
+      usage.bytes = accounts->objects[tid.GetUid ()].bytes;
+    }
+  return usage;
+}
+
+MemoryAccounting::Usage
+MemoryAccounting::GetUsage (const std::type_info &type)
+{
+  NS_LOG_FUNCTION (type.name ());
+  Usage usage = {Demangle (type.name ()), 0, 0};
+  Accounts *accounts = GetAccounts ();
+  std::lock_guard<std::mutex> lock (accounts->mutex);
+  auto it = accounts->types.find (std::type_index (type));
+  if (it != accounts->types.end ())
+    {
+      usage.count = it->second.count;
+      usage.bytes = it->second.bytes;
+    }
+  return usage;
+}
+
+MemoryAccounting::Usage
+MemoryAccounting::GetTotal (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  Usage total = {"", 0, 0};
+  for (const Usage &usage : GetTypes ())
+    {
+      total.count += usage.count;
+      total.bytes += usage.bytes;
+    }
+  return total;
+}
+
+std::vector<MemoryAccounting::Usage>
+MemoryAccounting::GetTypes (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  // the accounts are copied, and the names resolved after releasing the lock
+  std::vector<std::pair<uint16_t, Entry> > objects;
+  std::vector<std::pair<std::type_index, Entry> > types;
+  {
+    Accounts *accounts = GetAccounts ();
+    std::lock_guard<std::mutex> lock (accounts->mutex);
+    for (uint16_t uid = 0; uid < accounts->objects.size (); ++uid)
+      {
+        if (accounts->objects[uid].count != 0)
+          {
+            objects.push_back (std::make_pair (uid, accounts->objects[uid]));
+          }
+      }
+    for (const auto &type : accounts->types)
+      {
+        if (type.second.count != 0)
+          {
+            types.push_back (type);
+          }
+      }
+  }
+  std::vector<Usage> usages;
+  for (const auto &object : objects)
+    {
+      TypeId tid = TypeId::GetRegistered (object.first - 1);
+      Usage usage = {tid.GetName (), object.second.count, object.second.bytes};
+      usages.push_back (usage);
+    }
+  for (const auto &type : types)
+    {
+      Usage usage = {Demangle (type.first.name ()), type.second.count, type.second.bytes};
+      usages.push_back (usage);
+    }
+  Sort (usages);
+  return usages;
+}
+
+std::vector<MemoryAccounting::Usage>
+MemoryAccounting::GetGroups (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  std::vector<std::pair<uint16_t, Entry> > objects;
+  Entry others;
+  {
+    Accounts *accounts = GetAccounts ();
+    std::lock_guard<std::mutex> lock (accounts->mutex);
+    for (uint16_t uid = 0; uid < accounts->objects.size (); ++uid)
+      {
+        if (accounts->objects[uid].count != 0)
+          {
+            objects.push_back (std::make_pair (uid, accounts->objects[uid]));
+          }
+      }
+    for (const auto &type : accounts->types)
+      {
+        others.count += type.second.count;
+        others.bytes += type.second.bytes;
+      }
+  }
+  std::map<std::string, Usage> groups;
+  for (const auto &object : objects)
+    {
+      std::string group = TypeId::GetRegistered (object.first - 1).GetGroupName ();
+      Usage &usage = groups[group];
+      usage.name = group;
+      usage.count += object.second.count;
+      usage.bytes += object.second.bytes;
+    }
+  Usage &usage = groups[""];
+  usage.count += others.count;
+  usage.bytes += others.bytes;
+
+  std::vector<Usage> usages;
+  for (const auto &group : groups)
+    {
+      if (group.second.count != 0)
+        {
+          usages.push_back (group.second);
+        }
+    }
+  Sort (usages);
+  return usages;
+}
+
+void
+MemoryAccounting::Print (std::ostream &os)
+{
+  NS_LOG_FUNCTION (&os);
+  Usage total = GetTotal ();
+  os << "Memory accounting: " << total.count << " instances, "
+     << total.bytes << " bytes" << std::endl << std::endl;
+  PrintTable (os, GetGroups (), "Group");
+  os << std::endl;
+  PrintTable (os, GetTypes (), "Type");
+}
+
+} // namespace ns3
@@ -0,0 +1,149 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MEMORY_ACCOUNTING_H
+#define MEMORY_ACCOUNTING_H
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <typeinfo>
+#include <vector>
+#include <stdint.h>
+
+/**
+ * \file
+ * \ingroup debugging
+ * ns3::MemoryAccounting declaration.
+ */
+
+namespace ns3 {
+
+class TypeId;
+
+/**
+ * \ingroup core
+ * \ingroup debugging
+ *
+ * \brief Count the live instances and their approximate memory usage
+ * for each TypeId and each type of reference counted object
+ *
+ * While the accounting is enabled, the Objects are accounted to their
+ * TypeId, with the size registered by NS_OBJECT_ENSURE_REGISTERED, and
+ * the other SimpleRefCount instances, such as the Packets and the
+ * events (EventImpl), to their C++ type, with their size.  Other
+ * allocations can be accounted with Add and Remove, as is done for the
+ * packet buffers (ns3::Buffer::Data).  The memory allocated by the
+ * instances themselves, such as the content of their containers, is not
+ * accounted.
+ *
+ * The instances created while the accounting is disabled are never
+ * accounted, so the accounting should be enabled at the start of the
+ * program, with Enable or with the MemoryAccounting GlobalValue set
+ * by the NS_GLOBAL_VALUE environment variable.  MemoryMonitor
+ * traces the accounting periodically.
+ */
+class MemoryAccounting
+{
+public:
+  /** The instances of a type, or of the types of a group. */
+  struct Usage
+  {
+    std::string name;  //!< Name of the type or group
+    uint64_t count;    //!< Number of live instances
+    uint64_t bytes;    //!< Approximate memory used by the instances
+  };
+
+  /** Start accounting the instances created from now on. */
+  static void Enable (void);
+  /**
+   * Stop accounting the instances created from now on.  The instances
+   * already accounted are still removed when they are destroyed.
+   */
+  static void Disable (void);
+  /** \return \c true if the instances are accounted when created. */
+  static bool IsEnabled (void)
+  {
+    return m_enabled;
+  }
+
+  /**
+   * \param [in] tid The TypeId.
+   * \return The usage of the Objects of a TypeId.
+   */
+  static Usage GetUsage (TypeId tid);
+  /**
+   * \param [in] type The C++ type.
+   * \return The usage of the instances of a C++ type.
+   */
+  static Usage GetUsage (const std::type_info &type);
+  /** \return The usage of all the accounted instances. */
+  static Usage GetTotal (void);
+  /**
+   * \return The usage of each TypeId and C++ type with live instances,
+   *         by decreasing memory usage.
+   */
+  static std::vector<Usage> GetTypes (void);
+  /**
+   * \return The usage of the Objects of each TypeId group name, that
+   *         is, of each module, by decreasing memory usage.  The other
+   *         instances are accounted to an empty group name.
+   */
+  static std::vector<Usage> GetGroups (void);
+  /**
+   * Print the usage of each group and each type.
+   * \param [in] os The output stream.
+   */
+  static void Print (std::ostream &os);
+
+  /**
+   * \name Account the instances.
+   * These functions are used by Object, SimpleRefCount and the other
+   * accounted classes.
+   * @{
+   */
+  /**
+   * Account a new Object.
+   * \param [in] tid The TypeId of the Object.
+   */
+  static void AddObject (TypeId tid);
+  /**
+   * Remove an Object from the accounting.
+   * \param [in] tid The TypeId of the Object.
+   */
+  static void RemoveObject (TypeId tid);
+  /**
+   * Account a new instance.
+   * \param [in] type The C++ type of the instance.
+   * \param [in] bytes The size of the instance.
+   */
+  static void Add (const std::type_info &type, std::size_t bytes);
+  /**
+   * Remove an instance from the accounting.
+   * \param [in] type The C++ type of the instance.
+   * \param [in] bytes The size of the instance.
+   */
+  static void Remove (const std::type_info &type, std::size_t bytes);
+  /**@}*/
+
+private:
+  /** Whether the instances are accounted when created. */
+  static bool m_enabled;
+};
+
+} // namespace ns3
+
+#endif /* MEMORY_ACCOUNTING_H */
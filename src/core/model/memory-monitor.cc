@@ -0,0 +1,124 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "memory-monitor.h"
+#include "simulator.h"
+#include "string.h"
+#include "log.h"
+
+/**
+ * \file
+ * \ingroup debugging
+ * ns3::MemoryMonitor implementation.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MemoryMonitor");
+
+NS_OBJECT_ENSURE_REGISTERED (MemoryMonitor);
+
+TypeId
+MemoryMonitor::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::MemoryMonitor")
+    .SetParent<Object> ()
+    .SetGroupName ("Core")
+    .AddConstructor<MemoryMonitor> ()
+    .AddAttribute ("Interval",
+                   "The simulation time between the snapshots.",
+                   TimeValue (Seconds (1)),
+                   MakeTimeAccessor (&MemoryMonitor::m_interval),
+                   MakeTimeChecker (Time (1)))
+    .AddAttribute ("FileName",
+                   "The name of the file the snapshots are written to, "
+                   "or an empty string.",
+                   StringValue (""),
+                   MakeStringAccessor (&MemoryMonitor::m_fileName),
+                   MakeStringChecker ())
+    .AddTraceSource ("Snapshot",
+                     "The memory usage of each type.",
+                     MakeTraceSourceAccessor (&MemoryMonitor::m_snapshotTrace),
+                     "ns3::MemoryMonitor::SnapshotTracedCallback")
+  ;
+  return tid;
+}
+
+MemoryMonitor::MemoryMonitor ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+MemoryMonitor::~MemoryMonitor ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+MemoryMonitor::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  Stop ();
+  Object::DoDispose ();
+}
+
+void
+MemoryMonitor::Start (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (!m_fileName.empty () && !m_file.is_open ())
+    {
+      m_file.open (m_fileName.c_str ());
+      if (!m_file)
+        {
+          NS_FATAL_ERROR ("Unable to open the memory snapshot file " << m_fileName);
+        }
+    }
+  m_event.Cancel ();
+  Snapshot ();
+}
+
+void
+MemoryMonitor::Stop (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_event.Cancel ();
+  if (m_file.is_open ())
+    {
+      m_file.close ();
+    }
+}
+
+void
+MemoryMonitor::Snapshot (void)
+{
+  NS_LOG_FUNCTION (this);
+  std::vector<MemoryAccounting::Usage> types = MemoryAccounting::GetTypes ();
+  m_snapshotTrace (types);
+  if (m_file.is_open ())
+    {
+      double now = Simulator::Now ().GetSeconds ();
+      for (const MemoryAccounting::Usage &usage : types)
+        {
+          m_file << now << '\t' << usage.count << '\t' << usage.bytes
+                 << '\t' << usage.name << '\n';
+        }
+      m_file.flush ();
+    }
+  m_event = Simulator::Schedule (m_interval, &MemoryMonitor::Snapshot, this);
+}
+
+} // namespace ns3
@@ -24,9 +24,6 @@
 #include "string.h"
 #include "ns3/core-config.h"
 
-#include <cstdlib>  // getenv
-#include <cstring>  // strlen
-
 /**
  * \file
  * \ingroup object
@@ -76,93 +73,159 @@ ObjectBase::NotifyConstructionCompleted (void)
   NS_LOG_FUNCTION (this);
 }
 
+Ptr<const ObjectBase::ConstructionValues>
+ObjectBase::ResolveConstructionValues (TypeId tid, const AttributeConstructionList &attributes)
+{
+  NS_LOG_FUNCTION (tid.GetName () << &attributes);
+  Ptr<const TypeId::ConstructionInformation> construction = tid.GetConstructionInformation ();
+
+  // The values of an empty list, indexed by TypeId uid.
+  static std::vector<Ptr<const ConstructionValues> > defaults;
+  bool empty = attributes.Begin () == attributes.End ();
+  if (empty && tid.GetUid () < defaults.size ())
+    {
+      Ptr<const ConstructionValues> values = defaults[tid.GetUid ()];
+      if (values != 0 && values->construction == construction)
+        {
+          return values;
+        }
+    }
+
+  Ptr<ConstructionValues> values = Create<ConstructionValues> ();
+  values->construction = construction;
+  for (std::size_t i = 0; i < construction->attributes.size (); i++)
+    {
+      const struct TypeId::AttributeInformation &info = construction->attributes[i];
+      Ptr<const AttributeValue> value = attributes.Find (info.checker);
+      if (!(info.flags & TypeId::ATTR_CONSTRUCT))
+        {
+          if (value != 0)
+            {
+              NS_FATAL_ERROR ("Attribute name=" << info.name << " tid=" << construction->tidNames[i] << ": initial value cannot be set using attributes");
+            }
+          continue;
+        }
+      // Same order as ConstructSelf: the value of the list, the value of
+      // the env var, then the initial value.
+      Ptr<const AttributeValue> candidates[] = { value, construction->envValues[i], info.initialValue };
+      for (std::size_t j = 0; j < sizeof (candidates) / sizeof (candidates[0]); j++)
+        {
+          if (candidates[j] == 0)
+            {
+              continue;
+            }
+          struct ConstructionValues::Item item;
+          item.attribute = i;
+          item.value = candidates[j];
+          item.valid = info.checker->Check (*candidates[j]);
+          values->items.push_back (item);
+        }
+    }
+
+  if (empty)
+    {
+      if (tid.GetUid () >= defaults.size ())
+        {
+          defaults.resize (tid.GetUid () + 1);
+        }
+      defaults[tid.GetUid ()] = values;
+    }
+  return values;
+}
+
 void
 ObjectBase::ConstructSelf (const AttributeConstructionList &attributes)
 {
-  // loop over the inheritance tree back to the Object base class.
+  // loop over the attributes of the inheritance tree back to the
+  // Object base class.
   NS_LOG_FUNCTION (this << &attributes);
-  TypeId tid = GetInstanceTypeId ();
-  do
+  if (attributes.Begin () == attributes.End ())
     {
-      // loop over all attributes in object type
-      NS_LOG_DEBUG ("construct tid=" << tid.GetName () << ", params=" << tid.GetAttributeN ());
-      for (uint32_t i = 0; i < tid.GetAttributeN (); i++)
+      ConstructSelf (*ResolveConstructionValues (GetInstanceTypeId (), attributes));
+      return;
+    }
+  Ptr<const TypeId::ConstructionInformation> construction = GetInstanceTypeId ().GetConstructionInformation ();
+  for (std::size_t i = 0; i < construction->attributes.size (); i++)
+    {
+      const struct TypeId::AttributeInformation &info = construction->attributes[i];
+      const std::string &tidName = construction->tidNames[i];
+      NS_LOG_DEBUG ("try to construct \"" << tidName << "::" <<
+                    info.name << "\"");
+      // is this attribute stored in this AttributeConstructionList instance ?
+      Ptr<AttributeValue> value = attributes.Find (info.checker);
+      // See if this attribute should not be set here in the
+      // constructor.
+      if (!(info.flags & TypeId::ATTR_CONSTRUCT))
         {
-          struct TypeId::AttributeInformation info = tid.GetAttribute (i);
-          NS_LOG_DEBUG ("try to construct \"" << tid.GetName () << "::" <<
-                        info.name << "\"");
-          // is this attribute stored in this AttributeConstructionList instance ?
-          Ptr<AttributeValue> value = attributes.Find (info.checker);
-          // See if this attribute should not be set here in the
-          // constructor.
-          if (!(info.flags & TypeId::ATTR_CONSTRUCT))
+          // Handle this attribute if it should not be
+          // set here.
+          if (value == 0)
             {
-              // Handle this attribute if it should not be
-              // set here.
-              if (value == 0)
-                {
-                  // Skip this attribute if it's not in the
-                  // AttributeConstructionList.
-                  continue;
-                }
-              else
-                {
-                  // This is an error because this attribute is not
-                  // settable in its constructor but is present in
-                  // the AttributeConstructionList.
-                  NS_FATAL_ERROR ("Attribute name=" << info.name << " tid=" << tid.GetName () << ": initial value cannot be set using attributes");
-                }
+              // Skip this attribute if it's not in the
+              // AttributeConstructionList.
+              continue;
             }
-
-          if (value != 0)
+          else
             {
-              // We have a matching attribute value.
-              if (DoSet (info.accessor, info.checker, *value))
-                {
-                  NS_LOG_DEBUG ("construct \"" << tid.GetName () << "::" <<
-                                info.name << "\"");
-                  continue;
-                }
+              // This is an error because this attribute is not
+              // settable in its constructor but is present in
+              // the AttributeConstructionList.
+              NS_FATAL_ERROR ("Attribute name=" << info.name << " tid=" << tidName << ": initial value cannot be set using attributes");
             }
+        }
 
-          // No matching attribute value so we try to look at the env var.
-          const char *envVar = getenv ("NS_ATTRIBUTE_DEFAULT");
-          if (envVar != 0 && std::strlen (envVar) > 0)
+      if (value != 0)
+        {
+          // We have a matching attribute value.
+          if (DoSet (info.accessor, info.checker, *value))
             {
-              std::string env = envVar;
-              std::string::size_type cur = 0;
-              std::string::size_type next = 0;
-              while (next != std::string::npos)
-                {
-                  next = env.find (";", cur);
-                  std::string tmp = std::string (env, cur, next - cur);
-                  std::string::size_type equal = tmp.find ("=");
-                  if (equal != std::string::npos)
-                    {
-                      std::string name = tmp.substr (0, equal);
-                      std::string envval = tmp.substr (equal + 1, tmp.size () - equal - 1);
-                      if (name == tid.GetAttributeFullName (i))
-                        {
-                          if (DoSet (info.accessor, info.checker, StringValue (envval)))
-                            {
-                              NS_LOG_DEBUG ("construct \"" << tid.GetName () << "::" <<
-                                            info.name << "\" from env var");
-                              break;
-                            }
-                        }
-                    }
-                  cur = next + 1;
-                }
+              NS_LOG_DEBUG ("construct \"" << tidName << "::" <<
+                            info.name << "\"");
+              continue;
             }
+        }
 
-          // No matching attribute value so we try to set the default value.
-          DoSet (info.accessor, info.checker, *info.initialValue);
-          NS_LOG_DEBUG ("construct \"" << tid.GetName () << "::" <<
-                        info.name << "\" from initial value.");
+      // No matching attribute value so we try to use the env var.
+      Ptr<const AttributeValue> envValue = construction->envValues[i];
+      if (envValue != 0 && DoSet (info.accessor, info.checker, *envValue))
+        {
+          NS_LOG_DEBUG ("construct \"" << tidName << "::" <<
+                        info.name << "\" from env var");
+          continue;
+        }
+
+      // No matching attribute value so we try to set the default value.
+      DoSet (info.accessor, info.checker, *info.initialValue);
+      NS_LOG_DEBUG ("construct \"" << tidName << "::" <<
+                    info.name << "\" from initial value.");
+    }
+  NotifyConstructionCompleted ();
+}
+
+void
+ObjectBase::ConstructSelf (const ConstructionValues &values)
+{
+  NS_LOG_FUNCTION (this << &values);
+  const TypeId::ConstructionInformation &construction = *values.construction;
+  // The index of the last Attribute set, whose other values are skipped.
+  std::size_t set = construction.attributes.size ();
+  for (std::vector<struct ConstructionValues::Item>::const_iterator i = values.items.begin ();
+       i != values.items.end (); ++i)
+    {
+      if (i->attribute == set)
+        {
+          continue;
+        }
+      const struct TypeId::AttributeInformation &info = construction.attributes[i->attribute];
+      // A valid value does not need to be copied by the checker.
+      bool ok = i->valid ? info.accessor->Set (this, *i->value) : DoSet (info.accessor, info.checker, *i->value);
+      if (ok)
+        {
+          NS_LOG_DEBUG ("construct \"" << construction.tidNames[i->attribute] << "::" <<
+                        info.name << "\"");
+          set = i->attribute;
         }
-      tid = tid.GetParent ();
     }
-  while (tid != ObjectBase::GetTypeId ());
   NotifyConstructionCompleted ();
 }
 
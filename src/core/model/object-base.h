@@ -24,6 +24,7 @@
 #include "callback.h"
 #include <string>
 #include <list>
+#include <vector>
 
 /**
  * \file
@@ -79,6 +80,35 @@
     }                                                                  \
   } Object ## type ## param ## RegistrationVariable
 
+/**
+ * \ingroup object
+ * \brief Explicitly instantiate a template class with two template parameters
+ *        and register the resulting instance with the TypeId system.
+ *
+ * This macro is the same as NS_OBJECT_TEMPLATE_CLASS_DEFINE, for template
+ * classes taking two parameters. Each parameter must be a single identifier
+ * (use a typedef for template types).
+ *
+ * The name of the type parameter is the name of the first parameter only,
+ * so that the TypeId of the instance is the same as if the second parameter
+ * was left to its default. Hence, a template class can be registered with
+ * only one second parameter for a given first parameter.
+ */
+#define NS_OBJECT_TEMPLATE_CLASS_TWO_DEFINE(type,param1,param2)                 \
+  template class type<param1, param2>;                                          \
+  template <> std::string DoGetTypeParamName<type<param1, param2> > ()          \
+  {                                                                             \
+    return #param1;                                                             \
+  }                                                                             \
+  static struct Object ## type ## param1 ## param2 ## RegistrationClass         \
+  {                                                                             \
+    Object ## type ## param1 ## param2 ## RegistrationClass () {                \
+      ns3::TypeId tid = type<param1, param2>::GetTypeId ();                     \
+      tid.SetSize (sizeof (type<param1, param2>));                              \
+      tid.GetParent ();                                                         \
+    }                                                                           \
+  } Object ## type ## param1 ## param2 ## RegistrationVariable
+
 
 namespace ns3 {
 
@@ -119,12 +149,61 @@ class AttributeConstructionList;
 class ObjectBase
 {
 public:
+  /**
+   * \brief The values to which ConstructSelf initializes the Attributes
+   * of the objects of a TypeId.
+   *
+   * ConstructSelf searches its AttributeConstructionList, then copies and
+   * checks a value, for each Attribute of each object.  The values
+   * returned by ResolveConstructionValues are found and checked once for
+   * all the objects constructed with the same TypeId and list, e.g., by
+   * an ObjectFactory.  The values which are valid for their Attribute are
+   * then given as they are to its accessor: only the other ones, e.g.,
+   * StringValues, are converted for each object, which gets its own
+   * instance of the random variables set with a string.
+   */
+  struct ConstructionValues : public SimpleRefCount<ConstructionValues>
+  {
+    /** A value to try to set an Attribute to. */
+    struct Item
+    {
+      /** The index of the Attribute in construction. */
+      std::size_t attribute;
+      /** The value. */
+      Ptr<const AttributeValue> value;
+      /** \c true if the value is valid for the Attribute as it is. */
+      bool valid;
+    };
+    /** The Attributes of the TypeId and of its parents. */
+    Ptr<const TypeId::ConstructionInformation> construction;
+    /**
+     * The values, in the order in which they are tried: an Attribute is
+     * set to the first of its values which can be set.
+     */
+    std::vector<struct Item> items;
+  };
+
   /**
    * Get the type ID.
    * \return The object TypeId.
    */
   static TypeId GetTypeId (void);
 
+  /**
+   * Find the values to which the Attributes of the objects of a TypeId
+   * are initialized.
+   *
+   * The values of an empty AttributeConstructionList are found once per
+   * TypeId, and found again only after the Attributes of the TypeId or
+   * their initial values change.
+   *
+   * \param [in] tid The TypeId of the objects.
+   * \param [in] attributes The attribute values used to initialize
+   *        the member variables of the objects.
+   * \returns The values.
+   */
+  static Ptr<const ConstructionValues> ResolveConstructionValues (TypeId tid, const AttributeConstructionList &attributes);
+
   /**
    * Virtual destructor.
    */
@@ -265,6 +344,14 @@ protected:
    *        the member variables of this object's instance.
    */
   void ConstructSelf (const AttributeConstructionList &attributes);
+  /**
+   * Complete construction of ObjectBase with values found by
+   * ResolveConstructionValues.
+   *
+   * \param [in] values The attribute values used to initialize
+   *        the member variables of this object's instance.
+   */
+  void ConstructSelf (const ConstructionValues &values);
 
 private:
   /**
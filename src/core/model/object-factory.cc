@@ -41,18 +41,21 @@ ObjectFactory::SetTypeId (TypeId tid)
 {
   NS_LOG_FUNCTION (this << tid.GetName ());
   m_tid = tid;
+  m_values = 0;
 }
 void
 ObjectFactory::SetTypeId (std::string tid)
 {
   NS_LOG_FUNCTION (this << tid);
   m_tid = TypeId::LookupByName (tid);
+  m_values = 0;
 }
 void
 ObjectFactory::SetTypeId (const char *tid)
 {
   NS_LOG_FUNCTION (this << tid);
   m_tid = TypeId::LookupByName (tid);
+  m_values = 0;
 }
 bool
 ObjectFactory::IsTypeIdSet (void) const
@@ -85,6 +88,7 @@ ObjectFactory::DoSet (const std::string &name, const AttributeValue &value)
       return;
     }
   m_parameters.Add (name, info.checker, value.Copy ());
+  m_values = 0;
 }
 
 TypeId
@@ -98,12 +102,44 @@ Ptr<Object>
 ObjectFactory::Create (void) const
 {
   NS_LOG_FUNCTION (this);
+  DoResolve ();
+  return DoCreate (*m_values);
+}
+
+std::vector<Ptr<Object> >
+ObjectFactory::Create (uint32_t n) const
+{
+  NS_LOG_FUNCTION (this << n);
+  DoResolve ();
+  // keep the values alive, should a constructor reset the factory cache
+  Ptr<const ObjectBase::ConstructionValues> values = m_values;
+  std::vector<Ptr<Object> > objects;
+  objects.reserve (n);
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      objects.push_back (DoCreate (*values));
+    }
+  return objects;
+}
+
+void
+ObjectFactory::DoResolve (void) const
+{
+  if (m_values == 0 || m_values->construction != m_tid.GetConstructionInformation ())
+    {
+      m_values = ObjectBase::ResolveConstructionValues (m_tid, m_parameters);
+    }
+}
+
+Ptr<Object>
+ObjectFactory::DoCreate (const ObjectBase::ConstructionValues &values) const
+{
   Callback<ObjectBase *> cb = m_tid.GetConstructor ();
   ObjectBase *base = cb ();
   Object *derived = dynamic_cast<Object *> (base);
   NS_ASSERT (derived != 0);
   derived->SetTypeId (m_tid);
-  derived->Construct (m_parameters);
+  derived->Construct (values);
   Ptr<Object> object = Ptr<Object> (derived, false);
   return object;
 }
@@ -187,6 +223,7 @@ std::istream & operator >> (std::istream &is, ObjectFactory &factory)
               else
                 {
                   factory.m_parameters.Add (name, info.checker, val);
+                  factory.m_values = 0;
                 }
             }
         }
@@ -23,6 +23,7 @@
 #include "attribute-construction-list.h"
 #include "object.h"
 #include "type-id.h"
+#include <vector>
 
 /**
  * \file
@@ -115,6 +116,11 @@ public:
   /**
    * Create an Object instance of the configured TypeId.
    *
+   * The attribute values of the factory and the initial values of the
+   * other attributes are found and checked when the first object is
+   * created, and reused for the next ones until the factory or the
+   * initial values change.
+   *
    * \returns A new object instance.
    */
   Ptr<Object> Create (void) const;
@@ -130,8 +136,39 @@ public:
    */
   template <typename T>
   Ptr<T> Create (void) const;
+  /**
+   * Create several Object instances of the configured TypeId.
+   *
+   * The attribute values are resolved at most once for all the objects,
+   * which are constructed in order.
+   *
+   * \param [in] n The number of objects to create.
+   * \returns The new object instances.
+   */
+  std::vector<Ptr<Object> > Create (uint32_t n) const;
+  /**
+   * Create several Object instances of the requested type.
+   *
+   * \tparam T \explicit The requested Object type.
+   * \param [in] n The number of objects to create.
+   * \returns The new object instances.
+   */
+  template <typename T>
+  std::vector<Ptr<T> > Create (uint32_t n) const;
 
 private:
+  /**
+   * Construct an Object instance with the resolved attribute values.
+   *
+   * \param [in] values The attribute values resolved for this factory.
+   * \returns A new object instance.
+   */
+  Ptr<Object> DoCreate (const ObjectBase::ConstructionValues &values) const;
+  /**
+   * Resolve the attribute values of this factory, unless they are
+   * up to date.
+   */
+  void DoResolve (void) const;
   /**
    * Set an attribute to be set during construction.
    *
@@ -169,6 +206,11 @@ private:
    * objects by this factory.
    */
   AttributeConstructionList m_parameters;
+  /**
+   * The attribute values resolved for the objects created by this
+   * factory, or 0 if they have not been resolved yet.
+   */
+  mutable Ptr<const ObjectBase::ConstructionValues> m_values;
 };
 
 std::ostream & operator << (std::ostream &os, const ObjectFactory &factory);
@@ -211,6 +253,20 @@ ObjectFactory::Create (void) const
   return object->GetObject<T> ();
 }
 
+template <typename T>
+std::vector<Ptr<T> >
+ObjectFactory::Create (uint32_t n) const
+{
+  std::vector<Ptr<Object> > objects = Create (n);
+  std::vector<Ptr<T> > results;
+  results.reserve (n);
+  for (const Ptr<Object> &object : objects)
+    {
+      results.push_back (object->GetObject<T> ());
+    }
+  return results;
+}
+
 template <typename... Args>
 ObjectFactory::ObjectFactory (const std::string& typeId, Args&&... args)
 {
@@ -24,6 +24,7 @@
 #include "assert.h"
 #include "attribute.h"
 #include "log.h"
+#include "memory-accounting.h"
 #include "string.h"
 #include <vector>
 #include <sstream>
@@ -97,12 +98,17 @@ Object::Object ()
   : m_tid (Object::GetTypeId ()),
     m_disposed (false),
     m_initialized (false),
+    m_accounted (MemoryAccounting::IsEnabled ()),
     m_aggregates ((struct Aggregates *) std::malloc (sizeof (struct Aggregates))),
     m_getObjectCount (0)
 {
   NS_LOG_FUNCTION (this);
   m_aggregates->n = 1;
   m_aggregates->buffer[0] = this;
+  if (m_accounted)
+    {
+      MemoryAccounting::AddObject (m_tid);
+    }
 }
 Object::~Object ()
 {
@@ -127,16 +133,25 @@ Object::~Object ()
       std::free (m_aggregates);
     }
   m_aggregates = 0;
+  if (m_accounted)
+    {
+      MemoryAccounting::RemoveObject (m_tid);
+    }
 }
 Object::Object (const Object &o)
   : m_tid (o.m_tid),
     m_disposed (false),
     m_initialized (false),
+    m_accounted (MemoryAccounting::IsEnabled ()),
     m_aggregates ((struct Aggregates *) std::malloc (sizeof (struct Aggregates))),
     m_getObjectCount (0)
 {
   m_aggregates->n = 1;
   m_aggregates->buffer[0] = this;
+  if (m_accounted)
+    {
+      MemoryAccounting::AddObject (m_tid);
+    }
 }
 void
 Object::Construct (const AttributeConstructionList &attributes)
@@ -145,6 +160,13 @@ Object::Construct (const AttributeConstructionList &attributes)
   ConstructSelf (attributes);
 }
 
+void
+Object::Construct (const ObjectBase::ConstructionValues &values)
+{
+  NS_LOG_FUNCTION (this << &values);
+  ConstructSelf (values);
+}
+
 Ptr<Object>
 Object::DoGetObject (TypeId tid) const
 {
@@ -339,6 +361,12 @@ Object::SetTypeId (TypeId tid)
 {
   NS_LOG_FUNCTION (this << tid);
   NS_ASSERT (Check ());
+  if (m_accounted)
+    {
+      // the Object is accounted to its most derived TypeId
+      MemoryAccounting::RemoveObject (m_tid);
+      MemoryAccounting::AddObject (tid);
+    }
   m_tid = tid;
 }
 
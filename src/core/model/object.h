@@ -396,6 +396,15 @@ private:
    * registered with the associated TypeId.
   */
   void Construct (const AttributeConstructionList &attributes);
+  /**
+   * Initialize all member variables registered as Attributes of this TypeId.
+   *
+   * \param [in] values The attribute values used to initialize
+   *        the member variables of this Object's instance.
+   *
+   * Invoked from ns3::ObjectFactory::Create only.
+   */
+  void Construct (const ObjectBase::ConstructionValues &values);
 
   /**
    * Keep the list of aggregates in most-recently-used order
@@ -427,6 +436,10 @@ private:
    * \c false otherwise
    */
   bool m_initialized;
+  /**
+   * Set to \c true if this Object is accounted by MemoryAccounting.
+   */
+  bool m_accounted;
   /**
    * A pointer to an array of 'aggregates'.
    *
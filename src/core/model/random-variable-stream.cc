@@ -73,15 +73,41 @@ RandomVariableStream::GetTypeId (void)
   return tid;
 }
 
+/**
+ * \ingroup randomvariable
+ * The first of the list of all the existing random variables.
+ */
+static RandomVariableStream *g_firstStream = 0;
+
 RandomVariableStream::RandomVariableStream ()
-  : m_rng (0)
+  : m_rng (0),
+    m_rngIndex (0),
+    m_prevStream (0),
+    m_nextStream (g_firstStream)
 {
   NS_LOG_FUNCTION (this);
+  if (g_firstStream != 0)
+    {
+      g_firstStream->m_prevStream = this;
+    }
+  g_firstStream = this;
 }
 RandomVariableStream::~RandomVariableStream ()
 {
   NS_LOG_FUNCTION (this);
   delete m_rng;
+  if (m_prevStream != 0)
+    {
+      m_prevStream->m_nextStream = m_nextStream;
+    }
+  else
+    {
+      g_firstStream = m_nextStream;
+    }
+  if (m_nextStream != 0)
+    {
+      m_nextStream->m_prevStream = m_prevStream;
+    }
 }
 
 void
@@ -109,9 +135,7 @@ RandomVariableStream::SetStream (int64_t stream)
       // number assignment.
       uint64_t nextStream = RngSeedManager::GetNextStreamIndex ();
       NS_ASSERT (nextStream <= ((1ULL) << 63));
-      m_rng = new RngStream (RngSeedManager::GetSeed (),
-                             nextStream,
-                             RngSeedManager::GetRun ());
+      m_rngIndex = nextStream;
     }
   else
     {
@@ -119,12 +143,29 @@ RandomVariableStream::SetStream (int64_t stream)
       // number assignment.
       uint64_t base = ((1ULL) << 63);
       uint64_t target = base + stream;
-      m_rng = new RngStream (RngSeedManager::GetSeed (),
-                             target,
-                             RngSeedManager::GetRun ());
+      m_rngIndex = target;
     }
+  m_rng = new RngStream (RngSeedManager::GetSeed (),
+                         m_rngIndex,
+                         RngSeedManager::GetRun ());
   m_stream = stream;
 }
+
+void
+RandomVariableStream::ResetStreams (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  for (RandomVariableStream *s = g_firstStream; s != 0; s = s->m_nextStream)
+    {
+      if (s->m_rng != 0)
+        {
+          delete s->m_rng;
+          s->m_rng = new RngStream (RngSeedManager::GetSeed (),
+                                    s->m_rngIndex,
+                                    RngSeedManager::GetRun ());
+        }
+    }
+}
 int64_t
 RandomVariableStream::GetStream (void) const
 {
@@ -132,6 +173,16 @@ RandomVariableStream::GetStream (void) const
   return m_stream;
 }
 
+void
+RandomVariableStream::GetValues (double *values, std::size_t n)
+{
+  NS_LOG_FUNCTION (this << values << n);
+  for (std::size_t i = 0; i < n; ++i)
+    {
+      values[i] = GetValue ();
+    }
+}
+
 RngStream *
 RandomVariableStream::Peek (void) const
 {
@@ -189,6 +240,21 @@ UniformRandomVariable::GetValue (double min, double max)
     }
   return v;
 }
+void
+UniformRandomVariable::GetValues (double min, double max, double *values, std::size_t n)
+{
+  NS_LOG_FUNCTION (this << min << max << values << n);
+  Peek ()->RandU01 (values, n);
+  for (std::size_t i = 0; i < n; ++i)
+    {
+      double v = min + values[i] * (max - min);
+      if (IsAntithetic ())
+        {
+          v = min + (max - v);
+        }
+      values[i] = v;
+    }
+}
 uint32_t
 UniformRandomVariable::GetInteger (uint32_t min, uint32_t max)
 {
@@ -209,6 +275,12 @@ UniformRandomVariable::GetInteger (void)
   NS_LOG_FUNCTION (this);
   return (uint32_t)GetValue (m_min, m_max + 1);
 }
+void
+UniformRandomVariable::GetValues (double *values, std::size_t n)
+{
+  NS_LOG_FUNCTION (this << values << n);
+  GetValues (m_min, m_max, values, n);
+}
 
 NS_OBJECT_ENSURE_REGISTERED (ConstantRandomVariable);
 
@@ -29,6 +29,7 @@
 #include "type-id.h"
 #include "object.h"
 #include "attribute-helper.h"
+#include <cstddef>
 #include <stdint.h>
 
 /**
@@ -137,6 +138,19 @@ public:
    */
   bool IsAntithetic (void) const;
 
+  /**
+   * \brief Restart the RngStream of all the existing random variables.
+   *
+   * The RngStream of each random variable is created again, with the
+   * same stream number and the current seed and run number, as if the
+   * variable had just been created.  This is used to give independent
+   * random values to the processes created by Simulator::Fork, after
+   * changing the run number with RngSeedManager::SetRun.  Values already
+   * drawn and kept by a variable (such as the second value of a pair
+   * drawn by NormalRandomVariable) are not discarded.
+   */
+  static void ResetStreams (void);
+
   /**
    * \brief Get the next random value as a double drawn from the distribution.
    * \return A floating point random value.
@@ -149,6 +163,17 @@ public:
    */
   virtual uint32_t GetInteger (void) = 0;
 
+  /**
+   * \brief Get the next random values drawn from the distribution.
+   *
+   * The values are the same as those returned by \pname{n} calls to
+   * GetValue (void).  Subclasses may compute them faster.
+   *
+   * \param [out] values The array to fill.
+   * \param [in] n The number of values.
+   */
+  virtual void GetValues (double *values, std::size_t n);
+
 protected:
   /**
    * \brief Get the pointer to the underlying RngStream.
@@ -187,6 +212,14 @@ private:
   /** The stream number for the RngStream. */
   int64_t m_stream;
 
+  /** The index of the RngStream, including the automatically allocated ones. */
+  uint64_t m_rngIndex;
+
+  /** The previous random variable in the list of all the random variables. */
+  RandomVariableStream *m_prevStream;
+  /** The next random variable in the list of all the random variables. */
+  RandomVariableStream *m_nextStream;
+
 };  // class RandomVariableStream
 
 
@@ -281,6 +314,21 @@ public:
    */
   uint32_t GetInteger (uint32_t min, uint32_t max);
 
+  /**
+   * \brief Get the next random values, as doubles in the specified range
+   * \f$[min, max)\f$.
+   *
+   * The values are the same as those returned by \pname{n} calls to
+   * GetValue (min, max), but the underlying RngStream generates them
+   * all at once.
+   *
+   * \param [in] min Low end of the range (included).
+   * \param [in] max High end of the range (excluded).
+   * \param [out] values The array to fill.
+   * \param [in] n The number of values.
+   */
+  void GetValues (double min, double max, double *values, std::size_t n);
+
   // Inherited from RandomVariableStream
   /**
    * \brief Get the next random value as a double drawn from the distribution.
@@ -294,6 +342,12 @@ public:
    * \note The upper limit is included in the output range.
    */
   virtual uint32_t GetInteger (void);
+  /**
+   * \brief Get the next random values drawn from the distribution.
+   * \param [out] values The array to fill.
+   * \param [in] n The number of values.
+   */
+  virtual void GetValues (double *values, std::size_t n);
 
 private:
   /** The lower bound on values that can be returned by this RNG stream. */
@@ -31,9 +31,13 @@
 #include "system-mutex.h"
 #include "boolean.h"
 #include "enum.h"
+#include "object-factory.h"
+#include "trace-source-accessor.h"
 
 
 #include <cmath>
+#include <iomanip>
+#include <sstream>
 
 
 /**
@@ -69,6 +73,16 @@ RealtimeSimulatorImpl::GetTypeId (void)
                    TimeValue (Seconds (0.1)),
                    MakeTimeAccessor (&RealtimeSimulatorImpl::m_hardLimit),
                    MakeTimeChecker ())
+    .AddAttribute ("SynchronizerType",
+                   "The type of the Synchronizer pacing the events.",
+                   TypeIdValue (WallClockSynchronizer::GetTypeId ()),
+                   MakeTypeIdAccessor (&RealtimeSimulatorImpl::SetSynchronizerType),
+                   MakeTypeIdChecker ())
+    .AddTraceSource ("Lateness",
+                     "The real time at which each event starts minus its "
+                     "simulation time.",
+                     MakeTraceSourceAccessor (&RealtimeSimulatorImpl::m_latenessTrace),
+                     "ns3::RealtimeSimulatorImpl::LatenessTracedCallback")
   ;
   return tid;
 }
@@ -97,6 +111,7 @@ RealtimeSimulatorImpl::RealtimeSimulatorImpl ()
   // Be very careful not to do anything that would cause a change or assignment
   // of the underlying reference counts of m_synchronizer or you will be sorry.
   m_synchronizer = CreateObject<WallClockSynchronizer> ();
+  m_latenessHistogram.resize (65, 0);
 }
 
 RealtimeSimulatorImpl::~RealtimeSimulatorImpl ()
@@ -317,6 +332,7 @@ RealtimeSimulatorImpl::ProcessOneEvent (void)
   // whatever event is at the head of this list if the list is in time order.
   //
   Scheduler::Event next;
+  Time lateness;
 
   {
     CriticalSection cs (m_mutex);
@@ -361,28 +377,42 @@ RealtimeSimulatorImpl::ProcessOneEvent (void)
     // We check the simulation time against the current real time to make this
     // judgement.
     //
-    if (m_synchronizationMode == SYNC_HARD_LIMIT)
-      {
-        uint64_t tsFinal = m_synchronizer->GetCurrentRealtime ();
-        uint64_t tsJitter;
+    // The same measure of the lateness feeds the lateness histogram and trace.
+    //
+    uint64_t tsFinal = m_synchronizer->GetCurrentRealtime ();
+    uint64_t tsJitter;
 
-        if (tsFinal >= m_currentTs)
-          {
-            tsJitter = tsFinal - m_currentTs;
-          }
-        else
-          {
-            tsJitter = m_currentTs - tsFinal;
-          }
+    if (tsFinal >= m_currentTs)
+      {
+        tsJitter = tsFinal - m_currentTs;
+        lateness = TimeStep (tsJitter);
+      }
+    else
+      {
+        tsJitter = m_currentTs - tsFinal;
+        lateness = TimeStep (-static_cast<int64_t> (tsJitter));
+      }
 
+    if (m_synchronizationMode == SYNC_HARD_LIMIT)
+      {
         if (tsJitter > static_cast<uint64_t> (m_hardLimit.GetTimeStep ()))
           {
             NS_FATAL_ERROR ("RealtimeSimulatorImpl::ProcessOneEvent (): "
                             "Hard real-time limit exceeded (jitter = " << tsJitter << ")");
           }
       }
+
+    uint32_t bin = 0;
+    for (uint64_t ns = lateness.IsStrictlyPositive () ? lateness.GetNanoSeconds () : 0;
+         ns != 0; ns >>= 1)
+      {
+        bin++;
+      }
+    m_latenessHistogram[bin]++;
   }
 
+  m_latenessTrace (lateness);
+
   //
   // We have got the event we're about to execute completely disentangled from the
   // event list so we can execute it outside a critical section without fear of someone
@@ -853,4 +883,57 @@ RealtimeSimulatorImpl::GetHardLimit (void) const
   return m_hardLimit;
 }
 
+void
+RealtimeSimulatorImpl::SetSynchronizerType (TypeId tid)
+{
+  NS_LOG_FUNCTION (this << tid);
+  NS_ASSERT_MSG (!m_running, "Cannot change the Synchronizer while running");
+  ObjectFactory factory;
+  factory.SetTypeId (tid);
+  m_synchronizer = factory.Create<Synchronizer> ();
+}
+
+Ptr<Synchronizer>
+RealtimeSimulatorImpl::GetSynchronizer (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_synchronizer;
+}
+
+std::vector<uint64_t>
+RealtimeSimulatorImpl::GetLatenessHistogram (void) const
+{
+  NS_LOG_FUNCTION (this);
+  CriticalSection cs (m_mutex);
+  std::vector<uint64_t> histogram = m_latenessHistogram;
+  while (!histogram.empty () && histogram.back () == 0)
+    {
+      histogram.pop_back ();
+    }
+  return histogram;
+}
+
+void
+RealtimeSimulatorImpl::PrintLatenessHistogram (std::ostream &os) const
+{
+  NS_LOG_FUNCTION (this << &os);
+  std::vector<uint64_t> histogram = GetLatenessHistogram ();
+  std::ios::fmtflags flags = os.flags ();
+  os << std::setw (24) << "Lateness (ns)" << std::setw (14) << "Events" << std::endl;
+  for (uint32_t bin = 0; bin < histogram.size (); ++bin)
+    {
+      std::ostringstream range;
+      if (bin == 0)
+        {
+          range << "<= 0";
+        }
+      else
+        {
+          range << "[" << (uint64_t (1) << (bin - 1)) << ", " << (uint64_t (1) << bin) << ")";
+        }
+      os << std::setw (24) << range.str () << std::setw (14) << histogram[bin] << std::endl;
+    }
+  os.flags (flags);
+}
+
 } // namespace ns3
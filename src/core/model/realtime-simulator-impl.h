@@ -30,8 +30,12 @@
 #include "assert.h"
 #include "log.h"
 #include "system-mutex.h"
+#include "nstime.h"
+#include "traced-callback.h"
 
 #include <list>
+#include <ostream>
+#include <vector>
 
 /**
  * \file
@@ -165,6 +169,43 @@ public:
    */
   Time GetHardLimit (void) const;
 
+  /**
+   * Set the type of the Synchronizer, which must not be changed while the
+   * simulation is running.
+   *
+   * \param [in] tid The TypeId of the Synchronizer.
+   */
+  void SetSynchronizerType (TypeId tid);
+  /**
+   * Get the Synchronizer in use.
+   * \returns The Synchronizer.
+   */
+  Ptr<Synchronizer> GetSynchronizer (void) const;
+
+  /**
+   * Get the histogram of the lateness of the events, which is the real
+   * time at which the events start minus their simulation time.  Bin 0
+   * counts the events which were not late, and bin \pname{i} the events
+   * late by \f$[2^{i-1}, 2^i)\f$ ns.
+   *
+   * \returns The number of events in each bin, up to the last non-empty bin.
+   */
+  std::vector<uint64_t> GetLatenessHistogram (void) const;
+  /**
+   * Print the histogram of the lateness of the events.
+   *
+   * \param [in] os The output stream.
+   */
+  void PrintLatenessHistogram (std::ostream &os) const;
+
+  /**
+   * TracedCallback signature for the lateness of the events.
+   *
+   * \param [in] lateness The real time at which the event starts minus
+   *     its simulation time, negative if the event starts early.
+   */
+  typedef void (* LatenessTracedCallback)(Time lateness);
+
 private:
   /**
    * Is the simulator running?
@@ -229,6 +270,11 @@ private:
   /** The maximum allowable drift from real-time in SYNC_HARD_LIMIT mode. */
   Time m_hardLimit;
 
+  /** Number of events in each bin of the lateness histogram. */
+  std::vector<uint64_t> m_latenessHistogram;
+  /** The lateness of each event. */
+  TracedCallback<Time> m_latenessTrace;
+
   /** Main SystemThread. */
   SystemThread::ThreadId m_main;
 };
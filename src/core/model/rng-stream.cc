@@ -81,6 +81,12 @@ const double two17 =      131072.0;
 /** IEEE-754 floating point precision, 2<sup>53</sup> */
 const double two53 =      9007199254740992.0;
 
+/** First component modulus, as an integer. */
+const uint64_t m1i  =     4294967087ULL;
+
+/** Second component modulus, as an integer. */
+const uint64_t m2i  =     4294944443ULL;
+
 /** First component transition matrix. */
 const Matrix A1p0 = {
   {       0.0,        1.0,       0.0 },
@@ -323,6 +329,37 @@ void PowerOfTwoMatrix (int n, Matrix a1p, Matrix a2p)
     }
 }
 
+/**
+ * Advance the state of the two components by one step.
+ *
+ * The state values are integers lower than the moduli, and all the
+ * products are lower than 2<sup>53</sup>, so that the results are exactly
+ * those of the floating point recurrence of L'Ecuyer.  Since the moduli
+ * are constants, the compiler computes the remainders with multiplications
+ * instead of (floating point) divisions, which are much slower.
+ *
+ * \param [in,out] x The state of the first component, oldest value first.
+ * \param [in,out] y The state of the second component, oldest value first.
+ * \returns The next random, on [0,1).
+ */
+inline double Step (uint64_t x[3], uint64_t y[3])
+{
+  const uint64_t a12i = static_cast<uint64_t> (a12);
+  const uint64_t a13i = static_cast<uint64_t> (a13n);
+  const uint64_t a21i = static_cast<uint64_t> (a21);
+  const uint64_t a23i = static_cast<uint64_t> (a23n);
+  // -a13n * x[0] = a13n * (m1 - x[0]) mod m1, and likewise for a23n
+  uint64_t p1 = (a12i * x[1] + a13i * (m1i - x[0])) % m1i;
+  uint64_t p2 = (a21i * y[2] + a23i * (m2i - y[0])) % m2i;
+  x[0] = x[1];
+  x[1] = x[2];
+  x[2] = p1;
+  y[0] = y[1];
+  y[1] = y[2];
+  y[2] = p2;
+  return ((p1 > p2) ? (p1 - p2) * norm : (p1 + m1i - p2) * norm);
+}
+
 } // namespace MRG32k3a
 
 // *NS_CHECK_STYLE_ON*
@@ -334,37 +371,38 @@ using namespace MRG32k3a;
 
 double RngStream::RandU01 ()
 {
-  int32_t k;
-  double p1, p2, u;
-
-  /* Component 1 */
-  p1 = a12 * m_currentState[1] - a13n * m_currentState[0];
-  k = static_cast<int32_t> (p1 / m1);
-  p1 -= k * m1;
-  if (p1 < 0.0)
+  uint64_t x[3] = { static_cast<uint64_t> (m_currentState[0]),
+                    static_cast<uint64_t> (m_currentState[1]),
+                    static_cast<uint64_t> (m_currentState[2]) };
+  uint64_t y[3] = { static_cast<uint64_t> (m_currentState[3]),
+                    static_cast<uint64_t> (m_currentState[4]),
+                    static_cast<uint64_t> (m_currentState[5]) };
+  double u = Step (x, y);
+  for (int i = 0; i < 3; ++i)
     {
-      p1 += m1;
+      m_currentState[i] = static_cast<double> (x[i]);
+      m_currentState[i + 3] = static_cast<double> (y[i]);
     }
-  m_currentState[0] = m_currentState[1];
-  m_currentState[1] = m_currentState[2];
-  m_currentState[2] = p1;
-
-  /* Component 2 */
-  p2 = a21 * m_currentState[5] - a23n * m_currentState[3];
-  k = static_cast<int32_t> (p2 / m2);
-  p2 -= k * m2;
-  if (p2 < 0.0)
+  return u;
+}
+
+void RngStream::RandU01 (double *values, std::size_t n)
+{
+  uint64_t x[3] = { static_cast<uint64_t> (m_currentState[0]),
+                    static_cast<uint64_t> (m_currentState[1]),
+                    static_cast<uint64_t> (m_currentState[2]) };
+  uint64_t y[3] = { static_cast<uint64_t> (m_currentState[3]),
+                    static_cast<uint64_t> (m_currentState[4]),
+                    static_cast<uint64_t> (m_currentState[5]) };
+  for (std::size_t i = 0; i < n; ++i)
     {
-      p2 += m2;
+      values[i] = Step (x, y);
+    }
+  for (int i = 0; i < 3; ++i)
+    {
+      m_currentState[i] = static_cast<double> (x[i]);
+      m_currentState[i + 3] = static_cast<double> (y[i]);
     }
-  m_currentState[3] = m_currentState[4];
-  m_currentState[4] = m_currentState[5];
-  m_currentState[5] = p2;
-
-  /* Combination */
-  u = ((p1 > p2) ? (p1 - p2) * norm : (p1 - p2 + m1) * norm);
-
-  return u;
 }
 
 RngStream::RngStream (uint32_t seedNumber, uint64_t stream, uint64_t substream)
@@ -20,6 +20,7 @@
 #ifndef RNGSTREAM_H
 #define RNGSTREAM_H
 #include <string>
+#include <cstddef>
 #include <stdint.h>
 
 /**
@@ -70,6 +71,17 @@ public:
    * \returns The next random.
    */
   double RandU01 (void);
+  /**
+   * Generate the next random numbers for this stream.
+   * Uniformly distributed between 0 and 1.
+   *
+   * The numbers are the same as those returned by \pname{n} calls
+   * to RandU01 (void), but they are computed faster.
+   *
+   * \param [out] values The array to fill.
+   * \param [in] n The number of values.
+   */
+  void RandU01 (double *values, std::size_t n);
 
 private:
   /**
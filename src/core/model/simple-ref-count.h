@@ -26,8 +26,11 @@
 #include "default-deleter.h"
 #include "assert.h"
 #include "unused.h"
+#include "memory-accounting.h"
 #include <stdint.h>
 #include <limits>
+#include <type_traits>
+#include <typeinfo>
 
 /**
  * \file
@@ -37,6 +40,8 @@
 
 namespace ns3 {
 
+class Object;
+
 /**
  * \ingroup ptr
  * \brief A template-based reference counting class
@@ -68,6 +73,10 @@ namespace ns3 {
  *      to the object it manages exist anymore.
  *
  * Interesting users of this class include ns3::Object as well as ns3::Packet.
+ *
+ * The instances created while MemoryAccounting is enabled are accounted
+ * to the type \pname{T}, except the Objects, which are accounted to
+ * their TypeId.
  */
 template <typename T, typename PARENT = empty, typename DELETER = DefaultDeleter<T> >
 class SimpleRefCount : public PARENT
@@ -75,16 +84,29 @@ class SimpleRefCount : public PARENT
 public:
   /** Default constructor.  */
   SimpleRefCount ()
-    : m_count (1)
-  {}
+    : m_count (1),
+      m_accounted (false)
+  {
+    Account ();
+  }
   /**
    * Copy constructor
    * \param [in] o The object to copy into this one.
    */
   SimpleRefCount (const SimpleRefCount &o)
-    : m_count (1)
+    : m_count (1),
+      m_accounted (false)
   {
     NS_UNUSED (o);
+    Account ();
+  }
+  /** Destructor. */
+  ~SimpleRefCount ()
+  {
+    if (m_accounted)
+      {
+        MemoryAccounting::Remove (typeid (T), sizeof (T));
+      }
   }
   /**
    * Assignment operator
@@ -134,6 +156,16 @@ public:
   }
 
 private:
+  /** Account this instance if MemoryAccounting is enabled. */
+  void Account (void)
+  {
+    if (MemoryAccounting::IsEnabled () && !std::is_same<T, Object>::value)
+      {
+        m_accounted = true;
+        MemoryAccounting::Add (typeid (T), sizeof (T));
+      }
+  }
+
   /**
    * The reference count.
    *
@@ -142,6 +174,8 @@ private:
    * change it.
    */
   mutable uint32_t m_count;
+  /** Whether this instance is accounted by MemoryAccounting. */
+  bool m_accounted;
 };
 
 } // namespace ns3
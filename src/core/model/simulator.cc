@@ -24,6 +24,7 @@
 #include "map-scheduler.h"
 #include "event-impl.h"
 #include "des-metrics.h"
+#include "arena-allocator.h"
 
 #include "ptr.h"
 #include "string.h"
@@ -32,12 +33,18 @@
 #include "assert.h"
 #include "log.h"
 
+#include <cerrno>
 #include <cmath>
+#include <cstdio>
+#include <cstring>  // strerror
 #include <fstream>
 #include <list>
 #include <vector>
 #include <iostream>
 #include <iomanip>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>  // fork
 
 /**
  * \file
@@ -152,6 +159,7 @@ Simulator::Destroy (void)
   (*pimpl)->Destroy ();
   (*pimpl)->Unref ();
   *pimpl = 0;
+  ArenaAllocator::Release ();
 }
 
 void
@@ -191,6 +199,49 @@ Simulator::Stop (Time const &delay)
   GetImpl ()->Stop (delay);
 }
 
+uint32_t
+Simulator::Fork (uint32_t n)
+{
+  NS_LOG_FUNCTION (n);
+  std::cout.flush ();
+  std::cerr.flush ();
+  std::clog.flush ();
+  std::fflush (0);
+
+  std::vector<pid_t> children;
+  for (uint32_t i = 1; i <= n; ++i)
+    {
+      pid_t pid = fork ();
+      if (pid == 0)
+        {
+          NS_LOG_LOGIC ("child " << i << " of " << n);
+          return i;
+        }
+      if (pid < 0)
+        {
+          NS_FATAL_ERROR ("Unable to fork child " << i << ": " << std::strerror (errno));
+        }
+      children.push_back (pid);
+    }
+
+  for (uint32_t i = 0; i < children.size (); ++i)
+    {
+      int status;
+      while (waitpid (children[i], &status, 0) < 0)
+        {
+          if (errno != EINTR)
+            {
+              NS_FATAL_ERROR ("Unable to wait for child " << i + 1 << ": " << std::strerror (errno));
+            }
+        }
+      if (!WIFEXITED (status) || WEXITSTATUS (status) != 0)
+        {
+          NS_LOG_WARN ("child " << i + 1 << " did not exit normally, status " << status);
+        }
+    }
+  return 0;
+}
+
 Time
 Simulator::Now (void)
 {
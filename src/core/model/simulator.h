@@ -119,6 +119,8 @@ public:
    * After this method has been invoked, it is actually possible
    * to restart a new simulation with a set of calls to Simulator::Run,
    * Simulator::Schedule and Simulator::ScheduleWithContext.
+   * The chunks of ArenaAllocator left unused by the simulation are
+   * released.
    */
   static void Destroy (void);
 
@@ -166,6 +168,33 @@ public:
    */
   static void Stop (const Time &delay);
 
+  /**
+   * Fork the simulation process into \p n child processes.
+   *
+   * Each child process continues the simulation from the current
+   * state (the memory of the parent is shared copy-on-write), so that
+   * several variants of a simulation can be run after a common warm-up
+   * phase.  A child process typically changes some attributes with
+   * Config::Set, or the run number of the random variables with
+   * RngSeedManager::SetRun followed by RandomVariableStream::ResetStreams,
+   * before continuing.
+   *
+   * The parent process waits until all the child processes have exited
+   * before returning.  The buffers of the standard output streams are
+   * flushed before forking, but the other files open at that time are
+   * shared by all the processes: the child processes should write their
+   * output to files of their own.
+   *
+   * This method is intended to be called from an event or before
+   * Simulator::Run, with the default simulator implementation;
+   * ForkHelper is a higher level interface.
+   *
+   * @param [in] n The number of child processes.
+   * @return 0 in the parent process, the index of the child
+   *         process (from 1 to \p n) in the child processes.
+   */
+  static uint32_t Fork (uint32_t n);
+
   /**
    * Get the current simulation context.
    *
@@ -21,8 +21,10 @@
 #ifndef TRACED_CALLBACK_H
 #define TRACED_CALLBACK_H
 
-#include <list>
+#include <vector>
 #include "callback.h"
+#include "ptr.h"
+#include "simple-ref-count.h"
 
 /**
  * \file
@@ -46,6 +48,19 @@ namespace ns3 {
  * calling the \c operator() form with the appropriate
  * number of arguments.
  *
+ * Most trace sources have no sink, or a single one, and many of them are
+ * fired on the packet path.  Hence the chain is held through a single
+ * pointer, null while there is no sink: firing a trace source without
+ * sinks costs a single test, and a TracedCallback without sinks takes
+ * the size of a pointer and allocates nothing.
+ *
+ * The chain is shared by reference counting.  Firing the trace source
+ * invokes a snapshot of the chain: a Callback connected by a sink is
+ * invoked from the next time the trace source is fired, and a Callback
+ * disconnected by a sink is still invoked this time.  Connect and
+ * Disconnect copy the chain rather than modify it while it is invoked,
+ * or shared with a copy of the TracedCallback.
+ *
  * \tparam Ts \explicit Types of the functor arguments.
  */
 template<typename... Ts>
@@ -54,6 +69,21 @@ class TracedCallback
 public:
   /** Constructor. */
   TracedCallback ();
+  /**
+   * Copy constructor.
+   *
+   * \param [in] o The TracedCallback to copy.
+   */
+  TracedCallback (const TracedCallback & o);
+  /**
+   * Assignment operator.
+   *
+   * \param [in] o The TracedCallback to copy.
+   * \return This TracedCallback.
+   */
+  TracedCallback & operator = (const TracedCallback & o);
+  /** Destructor. */
+  ~TracedCallback ();
   /**
    * Append a Callback to the chain (without a context).
    *
@@ -108,13 +138,36 @@ public:
 
 private:
   /**
-   * Container type for holding the chain of Callbacks.
+   * Container type for holding the chain of Callbacks after the first one.
    *
    * \tparam Ts \deduced Types of the functor arguments.
    */
-  typedef std::list<Callback<void,Ts...> > CallbackList;
-  /** The chain of Callbacks. */
-  CallbackList m_callbackList;
+  typedef std::vector<Callback<void,Ts...> > CallbackList;
+  /**
+   * The chain of Callbacks, shared by reference counting.  The first
+   * Callback is stored inline, to save an indirection when the trace
+   * source has a single sink.
+   */
+  struct Chain : public SimpleRefCount<Chain>
+  {
+    Callback<void,Ts...> first;  //!< The first Callback
+    CallbackList others;         //!< The other Callbacks, in the order they were connected
+  };
+  /**
+   * Get the chain to modify, which is not shared with a snapshot being
+   * invoked or with another TracedCallback.
+   *
+   * \return The chain to modify.
+   */
+  Chain * GetUnsharedChain (void);
+  /**
+   * Append a Callback to the chain.
+   *
+   * \param [in] callback Callback to add to chain.
+   */
+  void Append (const Callback<void,Ts...> & callback);
+  /** The chain of Callbacks, null if the chain is empty. */
+  Ptr<Chain> m_chain;
 };
 
 } // namespace ns3
@@ -128,9 +181,51 @@ namespace ns3 {
 
 template<typename... Ts>
 TracedCallback<Ts...>::TracedCallback ()
-  : m_callbackList ()
+  : m_chain (0)
+{}
+template<typename... Ts>
+TracedCallback<Ts...>::TracedCallback (const TracedCallback & o)
+  : m_chain (o.m_chain)
 {}
 template<typename... Ts>
+TracedCallback<Ts...> &
+TracedCallback<Ts...>::operator = (const TracedCallback & o)
+{
+  m_chain = o.m_chain;
+  return *this;
+}
+template<typename... Ts>
+TracedCallback<Ts...>::~TracedCallback ()
+{}
+template<typename... Ts>
+typename TracedCallback<Ts...>::Chain *
+TracedCallback<Ts...>::GetUnsharedChain (void)
+{
+  if (m_chain == 0)
+    {
+      m_chain = Create<Chain> ();
+    }
+  else if (m_chain->GetReferenceCount () > 1)
+    {
+      m_chain = Create<Chain> (*m_chain);
+    }
+  return PeekPointer (m_chain);
+}
+template<typename... Ts>
+void
+TracedCallback<Ts...>::Append (const Callback<void,Ts...> & callback)
+{
+  Chain *chain = GetUnsharedChain ();
+  if (chain->first.IsNull ())
+    {
+      chain->first = callback;
+    }
+  else
+    {
+      chain->others.push_back (callback);
+    }
+}
+template<typename... Ts>
 void
 TracedCallback<Ts...>::ConnectWithoutContext (const CallbackBase & callback)
 {
@@ -139,7 +234,7 @@ TracedCallback<Ts...>::ConnectWithoutContext (const CallbackBase & callback)
     {
       NS_FATAL_ERROR_NO_MSG ();
     }
-  m_callbackList.push_back (cb);
+  Append (cb);
 }
 template<typename... Ts>
 void
@@ -151,24 +246,42 @@ TracedCallback<Ts...>::Connect (const CallbackBase & callback, std::string path)
       NS_FATAL_ERROR ("when connecting to " << path);
     }
   Callback<void,Ts...> realCb = cb.Bind (path);
-  m_callbackList.push_back (realCb);
+  Append (realCb);
 }
 template<typename... Ts>
 void
 TracedCallback<Ts...>::DisconnectWithoutContext (const CallbackBase & callback)
 {
-  for (typename CallbackList::iterator i = m_callbackList.begin ();
-       i != m_callbackList.end (); /* empty */)
+  if (m_chain == 0)
+    {
+      return;
+    }
+  Chain *chain = GetUnsharedChain ();
+  for (typename CallbackList::iterator i = chain->others.begin ();
+       i != chain->others.end (); /* empty */)
     {
       if ((*i).IsEqual (callback))
         {
-          i = m_callbackList.erase (i);
+          i = chain->others.erase (i);
         }
       else
         {
           i++;
         }
     }
+  if (chain->first.IsEqual (callback))
+    {
+      // the next Callback (if any) becomes the first one
+      if (chain->others.empty ())
+        {
+          m_chain = 0;
+        }
+      else
+        {
+          chain->first = chain->others.front ();
+          chain->others.erase (chain->others.begin ());
+        }
+    }
 }
 template<typename... Ts>
 void
@@ -186,8 +299,16 @@ template<typename... Ts>
 void
 TracedCallback<Ts...>::operator() (Ts... args) const
 {
-  for (typename CallbackList::const_iterator i = m_callbackList.begin ();
-       i != m_callbackList.end (); i++)
+  if (m_chain == 0)
+    {
+      return;
+    }
+  // the snapshot is not modified by the sinks, which may connect and
+  // disconnect Callbacks
+  Ptr<const Chain> snapshot = m_chain;
+  snapshot->first (args...);
+  for (typename CallbackList::const_iterator i = snapshot->others.begin ();
+       i != snapshot->others.end (); i++)
     {
       (*i)(args...);
     }
@@ -197,7 +318,7 @@ template <typename... Ts>
 bool
 TracedCallback<Ts...>::IsEmpty () const
 {
-  return m_callbackList.empty ();
+  return m_chain == 0;
 }
 
 } // namespace ns3
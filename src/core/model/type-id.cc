@@ -22,11 +22,14 @@
 #include "type-id.h"
 #include "singleton.h"
 #include "trace-source-accessor.h"
+#include "string.h"
 
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include <sstream>
 #include <iomanip>
+#include <cstdlib>  // getenv
 
 /**
  * \file
@@ -78,6 +81,8 @@ NS_LOG_COMPONENT_DEFINE ("TypeId");
 class IidManager : public Singleton<IidManager>
 {
 public:
+  /** Constructor. */
+  IidManager ();
   /**
    * Create a new unique type id.
    * \param [in] name The name of this type id.
@@ -270,6 +275,30 @@ public:
    * \returns \c true if this TypeId should be hidden from the user.
    */
   bool MustHideFromDocumentation (uint16_t uid) const;
+  /**
+   * Find an Attribute of a type id or of its parents by name.
+   * \param [in] uid The id.
+   * \param [in] name The Attribute name.
+   * \returns The Attribute, or 0 if \pname{name} wasn't found.  The
+   *          Attribute is valid until the next type id or Attribute
+   *          is registered.
+   */
+  const struct TypeId::AttributeInformation * LookupAttribute (uint16_t uid, const std::string &name);
+  /**
+   * Find a TraceSource of a type id or of its parents by name.
+   * \param [in] uid The id.
+   * \param [in] name The TraceSource name.
+   * \returns The TraceSource, or 0 if \pname{name} wasn't found.  The
+   *          TraceSource is valid until the next type id or TraceSource
+   *          is registered.
+   */
+  const struct TypeId::TraceSourceInformation * LookupTraceSource (uint16_t uid, const std::string &name);
+  /**
+   * Get the Attributes of a type id and of its parents.
+   * \param [in] uid The id.
+   * \returns The Attributes initialized by ObjectBase::ConstructSelf.
+   */
+  Ptr<const TypeId::ConstructionInformation> GetConstructionInformation (uint16_t uid);
 
 private:
   /**
@@ -320,6 +349,16 @@ private:
     TypeId::SupportLevel supportLevel;
     /** Support message. */
     std::string supportMsg;
+    /** The value of IidManager::m_generation when the indexes were built. */
+    uint32_t generation;
+    /** The Attributes of this type id and of its parents. */
+    Ptr<TypeId::ConstructionInformation> construction;
+    /** The index of the Attributes in construction, by name. */
+    std::unordered_map<std::string, std::size_t> attributeIndex;
+    /** The TraceSources of this type id and of its parents. */
+    std::vector<struct TypeId::TraceSourceInformation> allTraceSources;
+    /** The index of the TraceSources in allTraceSources, by name. */
+    std::unordered_map<std::string, std::size_t> traceSourceIndex;
   };
   /** Iterator type. */
   typedef std::vector<struct IidInformation>::const_iterator Iterator;
@@ -330,6 +369,13 @@ private:
    * \returns The information record.
    */
   struct IidManager::IidInformation * LookupInformation (uint16_t uid) const;
+  /**
+   * Retrieve the information record for a type, after building the
+   * indexes of its Attributes and TraceSources if they are out of date.
+   * \param [in] uid The id.
+   * \returns The information record.
+   */
+  struct IidManager::IidInformation * LookupIndexedInformation (uint16_t uid);
 
   /** The container of all type id records. */
   std::vector<struct IidInformation> m_information;
@@ -344,6 +390,12 @@ private:
   /** The by-hash index. */
   hashmap_t m_hashmap;
 
+  /**
+   * Incremented each time an Attribute, a TraceSource, a parent or an
+   * initial value changes, to invalidate the indexes of all the type ids.
+   */
+  uint32_t m_generation;
+
 
   /** IidManager constants. */
   enum
@@ -380,6 +432,12 @@ IidManager::Hasher (const std::string name)
  */
 #define IIDL IID << ": "
 
+IidManager::IidManager ()
+  : m_generation (1)
+{
+  NS_LOG_FUNCTION (IID);
+}
+
 uint16_t
 IidManager::AllocateUid (std::string name)
 {
@@ -443,6 +501,7 @@ IidManager::AllocateUid (std::string name)
   information.hasConstructor = false;
   information.mustHideFromDocumentation = false;
   information.supportLevel = TypeId::SUPPORTED;
+  information.generation = 0;
   m_information.push_back (information);
   std::size_t tuid = m_information.size ();
   NS_ASSERT (tuid <= 0xffff);
@@ -471,6 +530,7 @@ IidManager::SetParent (uint16_t uid, uint16_t parent)
   NS_ASSERT (parent <= m_information.size ());
   struct IidInformation *information = LookupInformation (uid);
   information->parent = parent;
+  m_generation++;
 }
 void
 IidManager::SetGroupName (uint16_t uid, std::string groupName)
@@ -681,6 +741,7 @@ IidManager::AddAttribute (uint16_t uid,
   info.supportLevel = supportLevel;
   info.supportMsg = supportMsg;
   information->attributes.push_back (info);
+  m_generation++;
   NS_LOG_LOGIC (IIDL << information->attributes.size () - 1);
 }
 void
@@ -692,6 +753,7 @@ IidManager::SetAttributeInitialValue (uint16_t uid,
   struct IidInformation *information = LookupInformation (uid);
   NS_ASSERT (i < information->attributes.size ());
   information->attributes[i].initialValue = initialValue;
+  m_generation++;
 }
 
 
@@ -773,6 +835,7 @@ IidManager::AddTraceSource (uint16_t uid,
   source.supportLevel = supportLevel;
   source.supportMsg = supportMsg;
   information->traceSources.push_back (source);
+  m_generation++;
   NS_LOG_LOGIC (IIDL << information->traceSources.size () - 1);
 }
 std::size_t
@@ -803,6 +866,125 @@ IidManager::MustHideFromDocumentation (uint16_t uid) const
   return hide;
 }
 
+/**
+ * \ingroup object
+ * \internal
+ * Get the value of an Attribute in the NS_ATTRIBUTE_DEFAULT environment
+ * variable.
+ * \param [in] env The value of the environment variable.
+ * \param [in] fullName The full name of the Attribute.
+ * \returns The value of the Attribute, or 0 if it is not set in \pname{env}.
+ */
+static Ptr<const AttributeValue>
+GetEnvValue (const std::string &env, const std::string &fullName)
+{
+  std::string::size_type cur = 0;
+  std::string::size_type next = 0;
+  while (next != std::string::npos)
+    {
+      next = env.find (";", cur);
+      std::string tmp = std::string (env, cur, next - cur);
+      std::string::size_type equal = tmp.find ("=");
+      if (equal != std::string::npos && tmp.substr (0, equal) == fullName)
+        {
+          return Create<StringValue> (tmp.substr (equal + 1));
+        }
+      cur = next + 1;
+    }
+  return 0;
+}
+
+struct IidManager::IidInformation *
+IidManager::LookupIndexedInformation (uint16_t uid)
+{
+  NS_LOG_FUNCTION (IID << uid);
+  struct IidInformation *information = LookupInformation (uid);
+  if (information->generation == m_generation)
+    {
+      return information;
+    }
+
+  std::string env;
+  const char *envVar = getenv ("NS_ATTRIBUTE_DEFAULT");
+  if (envVar != 0)
+    {
+      env = envVar;
+    }
+
+  // The most derived Attribute or TraceSource of a given name hides
+  // those of its parents: insert does not replace it.
+  Ptr<TypeId::ConstructionInformation> construction = Create<TypeId::ConstructionInformation> ();
+  information->attributeIndex.clear ();
+  information->allTraceSources.clear ();
+  information->traceSourceIndex.clear ();
+  struct IidInformation *current = information;
+  while (true)
+    {
+      for (std::vector<struct TypeId::AttributeInformation>::const_iterator i = current->attributes.begin ();
+           i != current->attributes.end (); ++i)
+        {
+          information->attributeIndex.insert (std::make_pair (i->name, construction->attributes.size ()));
+          construction->attributes.push_back (*i);
+          construction->tidNames.push_back (current->name);
+          construction->envValues.push_back (env.empty () ? 0 : GetEnvValue (env, current->name + "::" + i->name));
+        }
+      for (std::vector<struct TypeId::TraceSourceInformation>::const_iterator i = current->traceSources.begin ();
+           i != current->traceSources.end (); ++i)
+        {
+          information->traceSourceIndex.insert (std::make_pair (i->name, information->allTraceSources.size ()));
+          information->allTraceSources.push_back (*i);
+        }
+      if (current->parent == 0)
+        {
+          break;
+        }
+      struct IidInformation *parent = LookupInformation (current->parent);
+      if (parent == current)
+        {
+          // top of inheritance tree
+          break;
+        }
+      current = parent;
+    }
+  information->construction = construction;
+  information->generation = m_generation;
+  NS_LOG_LOGIC (IIDL << construction->attributes.size () << " " << information->allTraceSources.size ());
+  return information;
+}
+
+const struct TypeId::AttributeInformation *
+IidManager::LookupAttribute (uint16_t uid, const std::string &name)
+{
+  NS_LOG_FUNCTION (IID << uid << name);
+  struct IidInformation *information = LookupIndexedInformation (uid);
+  std::unordered_map<std::string, std::size_t>::const_iterator it = information->attributeIndex.find (name);
+  if (it == information->attributeIndex.end ())
+    {
+      return 0;
+    }
+  return &information->construction->attributes[it->second];
+}
+
+const struct TypeId::TraceSourceInformation *
+IidManager::LookupTraceSource (uint16_t uid, const std::string &name)
+{
+  NS_LOG_FUNCTION (IID << uid << name);
+  struct IidInformation *information = LookupIndexedInformation (uid);
+  std::unordered_map<std::string, std::size_t>::const_iterator it = information->traceSourceIndex.find (name);
+  if (it == information->traceSourceIndex.end ())
+    {
+      return 0;
+    }
+  return &information->allTraceSources[it->second];
+}
+
+Ptr<const TypeId::ConstructionInformation>
+IidManager::GetConstructionInformation (uint16_t uid)
+{
+  NS_LOG_FUNCTION (IID << uid);
+  return LookupIndexedInformation (uid)->construction;
+}
+
 } // namespace ns3
 
 namespace ns3 {
@@ -883,40 +1065,24 @@ bool
 TypeId::LookupAttributeByName (std::string name, struct TypeId::AttributeInformation *info) const
 {
   NS_LOG_FUNCTION (this << name << info);
-  TypeId tid;
-  TypeId nextTid = *this;
-  do
+  const struct TypeId::AttributeInformation *tmp = IidManager::Get ()->LookupAttribute (m_tid, name);
+  if (tmp == 0)
     {
-      tid = nextTid;
-      for (std::size_t i = 0; i < tid.GetAttributeN (); i++)
-        {
-          struct TypeId::AttributeInformation tmp = tid.GetAttribute (i);
-          if (tmp.name == name)
-            {
-              if (tmp.supportLevel == TypeId::SUPPORTED)
-                {
-                  *info = tmp;
-                  return true;
-                }
-              else if (tmp.supportLevel == TypeId::DEPRECATED)
-                {
-                  std::cerr << "Attribute '" << name << "' is deprecated: "
-                            << tmp.supportMsg << std::endl;
-                  *info = tmp;
-                  return true;
-                }
-              else if (tmp.supportLevel == TypeId::OBSOLETE)
-                {
-                  NS_FATAL_ERROR ("Attribute '" << name <<
-                                  "' is obsolete, with no fallback: " <<
-                                  tmp.supportMsg);
-                }
-            }
-        }
-      nextTid = tid.GetParent ();
+      return false;
     }
-  while (nextTid != tid);
-  return false;
+  if (tmp->supportLevel == TypeId::DEPRECATED)
+    {
+      std::cerr << "Attribute '" << name << "' is deprecated: "
+                << tmp->supportMsg << std::endl;
+    }
+  else if (tmp->supportLevel == TypeId::OBSOLETE)
+    {
+      NS_FATAL_ERROR ("Attribute '" << name <<
+                      "' is obsolete, with no fallback: " <<
+                      tmp->supportMsg);
+    }
+  *info = *tmp;
+  return true;
 }
 
 TypeId
@@ -1086,6 +1252,12 @@ TypeId::GetAttribute (std::size_t i) const
   NS_LOG_FUNCTION (this << i);
   return IidManager::Get ()->GetAttribute (m_tid, i);
 }
+Ptr<const TypeId::ConstructionInformation>
+TypeId::GetConstructionInformation (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return IidManager::Get ()->GetConstructionInformation (m_tid);
+}
 std::string
 TypeId::GetAttributeFullName (std::size_t i) const
 {
@@ -1137,41 +1309,24 @@ TypeId::LookupTraceSourceByName (std::string name,
                                  struct TraceSourceInformation *info) const
 {
   NS_LOG_FUNCTION (this << name);
-  TypeId tid;
-  TypeId nextTid = *this;
-  struct TypeId::TraceSourceInformation tmp;
-  do
+  const struct TypeId::TraceSourceInformation *tmp = IidManager::Get ()->LookupTraceSource (m_tid, name);
+  if (tmp == 0)
     {
-      tid = nextTid;
-      for (std::size_t i = 0; i < tid.GetTraceSourceN (); i++)
-        {
-          tmp = tid.GetTraceSource (i);
-          if (tmp.name == name)
-            {
-              if (tmp.supportLevel == TypeId::SUPPORTED)
-                {
-                  *info = tmp;
-                  return tmp.accessor;
-                }
-              else if (tmp.supportLevel == TypeId::DEPRECATED)
-                {
-                  std::cerr << "TraceSource '" << name << "' is deprecated: "
-                            << tmp.supportMsg << std::endl;
-                  *info = tmp;
-                  return tmp.accessor;
-                }
-              else if (tmp.supportLevel == TypeId::OBSOLETE)
-                {
-                  NS_FATAL_ERROR ("TraceSource '" << name <<
-                                  "' is obsolete, with no fallback: " <<
-                                  tmp.supportMsg);
-                }
-            }
-        }
-      nextTid = tid.GetParent ();
+      return 0;
     }
-  while (nextTid != tid);
-  return 0;
+  if (tmp->supportLevel == TypeId::DEPRECATED)
+    {
+      std::cerr << "TraceSource '" << name << "' is deprecated: "
+                << tmp->supportMsg << std::endl;
+    }
+  else if (tmp->supportLevel == TypeId::OBSOLETE)
+    {
+      NS_FATAL_ERROR ("TraceSource '" << name <<
+                      "' is obsolete, with no fallback: " <<
+                      tmp->supportMsg);
+    }
+  *info = *tmp;
+  return tmp->accessor;
 }
 
 Ptr<const TraceSourceAccessor>
@@ -27,7 +27,9 @@
 #include "callback.h"
 #include "deprecated.h"
 #include "hash.h"
+#include "simple-ref-count.h"
 #include <string>
+#include <vector>
 #include <stdint.h>
 
 /**
@@ -111,6 +113,22 @@ public:
     /** Support message. */
     std::string supportMsg;
   };
+  /**
+   * The Attributes of a TypeId and of its parents, in the order in
+   * which ObjectBase::ConstructSelf initializes them.
+   */
+  struct ConstructionInformation : public SimpleRefCount<ConstructionInformation>
+  {
+    /** The Attributes, starting with those of the TypeId itself. */
+    std::vector<struct AttributeInformation> attributes;
+    /** The name of the TypeId which registered each Attribute. */
+    std::vector<std::string> tidNames;
+    /**
+     * The value of each Attribute in the NS_ATTRIBUTE_DEFAULT environment
+     * variable, or 0 if it is not set there.
+     */
+    std::vector<Ptr<const AttributeValue> > envValues;
+  };
 
   /** Type of hash values. */
   typedef uint32_t hash_t;
@@ -258,6 +276,15 @@ public:
    * \returns The information associated to attribute whose index is \pname{i}.
    */
   struct TypeId::AttributeInformation GetAttribute (std::size_t i) const;
+  /**
+   * Get the Attributes of this TypeId and of its parents.
+   *
+   * The information is built when it is first requested, and built
+   * again after Attributes are added or their initial values change.
+   *
+   * \returns The Attributes initialized by ObjectBase::ConstructSelf.
+   */
+  Ptr<const ConstructionInformation> GetConstructionInformation (void) const;
   /**
    * Get the Attribute name by index.
    *
@@ -465,6 +492,9 @@ public:
   /**
    * Find an Attribute by name, retrieving the associated AttributeInformation.
    *
+   * The Attributes of this TypeId and of its parents are searched with a
+   * hash table of their names.
+   *
    * \param [in]  name The name of the requested attribute
    * \param [in,out] info A pointer to the TypeId::AttributeInformation
    *              data structure where the result value of this method
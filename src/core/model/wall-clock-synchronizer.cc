@@ -44,6 +44,7 @@ WallClockSynchronizer::GetTypeId (void)
   static TypeId tid = TypeId ("ns3::WallClockSynchronizer")
     .SetParent<Synchronizer> ()
     .SetGroupName ("Core")
+    .AddConstructor<WallClockSynchronizer> ()
   ;
   return tid;
 }
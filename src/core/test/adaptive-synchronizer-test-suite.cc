@@ -0,0 +1,263 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <chrono>
+#include <numeric>
+#include <thread>
+#include <vector>
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/realtime-simulator-impl.h"
+#include "ns3/adaptive-wall-clock-synchronizer.h"
+#include "ns3/wall-clock-synchronizer.h"
+#include "ns3/make-event.h"
+#include "ns3/config.h"
+#include "ns3/string.h"
+#include "ns3/nstime.h"
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup adaptive-synchronizer-tests
+ * Adaptive wall clock synchronizer test suite.
+ */
+
+/**
+ * \ingroup core-tests
+ * \defgroup adaptive-synchronizer-tests Adaptive synchronizer test suite
+ */
+
+namespace ns3 {
+
+namespace tests {
+
+
+/**
+ * \ingroup adaptive-synchronizer-tests
+ * Base class of the test cases, running a real time simulation with the
+ * adaptive synchronizer.
+ */
+class AdaptiveSynchronizerTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor.
+   * \param [in] name The name of the test case.
+   * \param [in] batchWindow The BatchWindow of the synchronizer.
+   */
+  AdaptiveSynchronizerTestCase (std::string name, Time batchWindow);
+
+protected:
+  virtual void DoSetup (void);
+  virtual void DoTeardown (void);
+  /** \returns The real time simulator. */
+  Ptr<RealtimeSimulatorImpl> GetRealtimeSimulator (void) const;
+
+  Time m_batchWindow;  //!< BatchWindow of the synchronizer
+};
+
+AdaptiveSynchronizerTestCase::AdaptiveSynchronizerTestCase (std::string name,
+                                                            Time batchWindow)
+  : TestCase (name),
+    m_batchWindow (batchWindow)
+{}
+
+void
+AdaptiveSynchronizerTestCase::DoSetup (void)
+{
+  Config::SetGlobal ("SimulatorImplementationType", StringValue ("ns3::RealtimeSimulatorImpl"));
+  Config::SetDefault ("ns3::RealtimeSimulatorImpl::SynchronizerType",
+                      TypeIdValue (AdaptiveWallClockSynchronizer::GetTypeId ()));
+  Config::SetDefault ("ns3::AdaptiveWallClockSynchronizer::BatchWindow",
+                      TimeValue (m_batchWindow));
+}
+
+void
+AdaptiveSynchronizerTestCase::DoTeardown (void)
+{
+  Config::SetDefault ("ns3::AdaptiveWallClockSynchronizer::BatchWindow", TimeValue (Time (0)));
+  Config::SetDefault ("ns3::RealtimeSimulatorImpl::SynchronizerType",
+                      TypeIdValue (WallClockSynchronizer::GetTypeId ()));
+  Config::SetGlobal ("SimulatorImplementationType", StringValue ("ns3::DefaultSimulatorImpl"));
+}
+
+Ptr<RealtimeSimulatorImpl>
+AdaptiveSynchronizerTestCase::GetRealtimeSimulator (void) const
+{
+  return DynamicCast<RealtimeSimulatorImpl> (Simulator::GetImplementation ());
+}
+
+
+/**
+ * \ingroup adaptive-synchronizer-tests
+ * Check the pacing of the events and their lateness.
+ */
+class AdaptiveSynchronizerPacingTestCase : public AdaptiveSynchronizerTestCase
+{
+public:
+  /**
+   * Constructor.
+   * \param [in] batchWindow The BatchWindow of the synchronizer.
+   */
+  AdaptiveSynchronizerPacingTestCase (Time batchWindow);
+
+private:
+  virtual void DoRun (void);
+  /** Count an event. */
+  void Event (void);
+  /**
+   * Record the lateness of an event.
+   * \param [in] lateness The lateness.
+   */
+  void Lateness (Time lateness);
+
+  uint32_t m_events;              //!< Number of events run
+  std::vector<Time> m_lateness;   //!< Lateness of the events
+};
+
+AdaptiveSynchronizerPacingTestCase::AdaptiveSynchronizerPacingTestCase (Time batchWindow)
+  : AdaptiveSynchronizerTestCase ("Check the pacing of the events with a batch window of "
+                                  + std::to_string (batchWindow.GetMicroSeconds ()) + " us",
+                                  batchWindow),
+    m_events (0)
+{}
+
+void
+AdaptiveSynchronizerPacingTestCase::Event (void)
+{
+  m_events++;
+}
+
+void
+AdaptiveSynchronizerPacingTestCase::Lateness (Time lateness)
+{
+  m_lateness.push_back (lateness);
+}
+
+void
+AdaptiveSynchronizerPacingTestCase::DoRun (void)
+{
+  Ptr<RealtimeSimulatorImpl> impl = GetRealtimeSimulator ();
+  NS_TEST_ASSERT_MSG_NE (impl, 0, "Not a real time simulation");
+  NS_TEST_ASSERT_MSG_NE (DynamicCast<AdaptiveWallClockSynchronizer> (impl->GetSynchronizer ()), 0,
+                         "Synchronizer type not set");
+  impl->TraceConnectWithoutContext ("Lateness",
+                                    MakeCallback (&AdaptiveSynchronizerPacingTestCase::Lateness,
+                                                  this));
+  for (uint32_t i = 1; i <= 20; ++i)
+    {
+      Simulator::Schedule (MilliSeconds (2 * i), &AdaptiveSynchronizerPacingTestCase::Event, this);
+    }
+  // the real time simulation does not stop when it runs out of events
+  Simulator::Stop (MilliSeconds (41));
+  Simulator::Run ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_events, 20, "Events not run");
+  // the Stop event is traced too
+  NS_TEST_EXPECT_MSG_EQ (m_lateness.size (), 21, "Lateness not traced for each event");
+  for (Time lateness : m_lateness)
+    {
+      // the events are never early, except in the batch window
+      NS_TEST_EXPECT_MSG_GT_OR_EQ (lateness + m_batchWindow, Time (0), "Event too early");
+    }
+  std::vector<uint64_t> histogram = impl->GetLatenessHistogram ();
+  NS_TEST_EXPECT_MSG_EQ (std::accumulate (histogram.begin (), histogram.end (), uint64_t (0)),
+                         21, "Lateness histogram does not count each event");
+  Simulator::Destroy ();
+}
+
+
+/**
+ * \ingroup adaptive-synchronizer-tests
+ * Check that a sleep is interrupted by an event scheduled in real time
+ * by another thread.
+ */
+class AdaptiveSynchronizerInterruptTestCase : public AdaptiveSynchronizerTestCase
+{
+public:
+  /** Constructor. */
+  AdaptiveSynchronizerInterruptTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /** Stop the simulation and record the time. */
+  void Interrupt (void);
+
+  Time m_interrupted;  //!< Simulation time of the interruption
+};
+
+AdaptiveSynchronizerInterruptTestCase::AdaptiveSynchronizerInterruptTestCase ()
+  : AdaptiveSynchronizerTestCase ("Check the interruption of a sleep", Time (0)),
+    m_interrupted (Seconds (-1))
+{}
+
+void
+AdaptiveSynchronizerInterruptTestCase::Interrupt (void)
+{
+  m_interrupted = Simulator::Now ();
+  Simulator::Stop ();
+}
+
+void
+AdaptiveSynchronizerInterruptTestCase::DoRun (void)
+{
+  Ptr<RealtimeSimulatorImpl> impl = GetRealtimeSimulator ();
+  NS_TEST_ASSERT_MSG_NE (impl, 0, "Not a real time simulation");
+  // the simulation sleeps until this event, unless interrupted
+  Simulator::Schedule (Seconds (5), &Simulator::Stop);
+  // the reference count of the simulator must not be shared with the thread
+  RealtimeSimulatorImpl *simulator = PeekPointer (impl);
+  std::thread thread ([this, simulator] ()
+    {
+      std::this_thread::sleep_for (std::chrono::milliseconds (50));
+      simulator->ScheduleRealtimeNow (MakeEvent (&AdaptiveSynchronizerInterruptTestCase::Interrupt,
+                                            this));
+    });
+  Simulator::Run ();
+  thread.join ();
+
+  NS_TEST_EXPECT_MSG_GT (m_interrupted, Time (0), "Sleep not interrupted");
+  NS_TEST_EXPECT_MSG_LT (m_interrupted, Seconds (1), "Sleep interrupted too late");
+  Simulator::Destroy ();
+}
+
+
+/**
+ * \ingroup adaptive-synchronizer-tests
+ * Adaptive synchronizer test suite.
+ */
+class AdaptiveSynchronizerTestSuite : public TestSuite
+{
+public:
+  AdaptiveSynchronizerTestSuite ()
+    : TestSuite ("adaptive-synchronizer")
+  {
+    AddTestCase (new AdaptiveSynchronizerPacingTestCase (Time (0)));
+    AddTestCase (new AdaptiveSynchronizerPacingTestCase (MilliSeconds (5)));
+    AddTestCase (new AdaptiveSynchronizerInterruptTestCase ());
+  }
+};
+
+/**
+ * \ingroup adaptive-synchronizer-tests
+ * AdaptiveSynchronizerTestSuite instance variable.
+ */
+static AdaptiveSynchronizerTestSuite g_adaptiveSynchronizerTestSuite;
+
+
+}    // namespace tests
+
+}  // namespace ns3
@@ -0,0 +1,312 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cstring>
+#include <set>
+#include <vector>
+#include "ns3/core-config.h"
+#include "ns3/test.h"
+#include "ns3/arena-allocator.h"
+#include "ns3/object.h"
+#include "ns3/simulator.h"
+
+#ifdef HAVE_PTHREAD_H
+#include <thread>
+#endif
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup arena-allocator-tests
+ * Arena allocator test suite.
+ */
+
+/**
+ * \ingroup core-tests
+ * \defgroup arena-allocator-tests Arena allocator test suite
+ *
+ * The arenas are disabled by default, in which case only the fallback
+ * to the global allocator is checked.  They are tested with
+ * \code
+ *   NS_GLOBAL_VALUE="ArenaAllocator=1" ./test.py -s arena-allocator
+ * \endcode
+ */
+
+namespace ns3 {
+
+namespace tests {
+
+
+/**
+ * \ingroup arena-allocator-tests
+ * \param [in] blockSize The size of the blocks of a size class.
+ * \return The statistics of the size class, or empty statistics.
+ */
+static ArenaAllocator::SizeClass
+GetSizeClass (std::size_t blockSize)
+{
+  for (const ArenaAllocator::SizeClass &size : ArenaAllocator::GetStats ().sizeClasses)
+    {
+      if (size.blockSize == blockSize)
+        {
+          return size;
+        }
+    }
+  ArenaAllocator::SizeClass none = {blockSize, 0, 0, 0, 0};
+  return none;
+}
+
+
+/**
+ * \ingroup arena-allocator-tests
+ * Check the allocation, deallocation and release of the blocks.
+ */
+class ArenaAllocatorBlocksTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  ArenaAllocatorBlocksTestCase ();
+  virtual void DoRun (void);
+};
+
+ArenaAllocatorBlocksTestCase::ArenaAllocatorBlocksTestCase ()
+  : TestCase ("Check the allocation and release of the blocks")
+{}
+
+void
+ArenaAllocatorBlocksTestCase::DoRun (void)
+{
+  // a size class unlikely to be used by the other instances
+  const std::size_t size = 490;
+  const std::size_t blockSize = 496;
+  std::vector<void *> blocks;
+  std::set<void *> distinct;
+  for (uint32_t i = 0; i < 1000; ++i)
+    {
+      void *p = ArenaAllocator::Allocate (size);
+      NS_TEST_EXPECT_MSG_EQ (reinterpret_cast<uintptr_t> (p) % 16, 0, "Block not aligned");
+      std::memset (p, i & 0xff, size);
+      blocks.push_back (p);
+      distinct.insert (p);
+    }
+  NS_TEST_EXPECT_MSG_EQ (distinct.size (), blocks.size (), "Block allocated twice");
+  for (uint32_t i = 0; i < blocks.size (); ++i)
+    {
+      uint8_t *p = static_cast<uint8_t *> (blocks[i]);
+      NS_TEST_EXPECT_MSG_EQ ((uint32_t) p[0], (i & 0xff), "Block overwritten");
+      NS_TEST_EXPECT_MSG_EQ ((uint32_t) p[size - 1], (i & 0xff), "Block overwritten");
+    }
+
+  if (ArenaAllocator::IsEnabled ())
+    {
+      ArenaAllocator::SizeClass stats = GetSizeClass (blockSize);
+      NS_TEST_EXPECT_MSG_GT_OR_EQ (stats.used, 1000, "Allocated blocks not used");
+      NS_TEST_EXPECT_MSG_GT_OR_EQ (stats.blocks, stats.used, "More used than allocated blocks");
+      NS_TEST_EXPECT_MSG_EQ (stats.chunks, (stats.blocks + 131) / 132, "Wrong number of chunks");
+    }
+
+  for (void *p : blocks)
+    {
+      ArenaAllocator::Deallocate (p, size);
+    }
+
+  // too large for the arenas
+  void *large = ArenaAllocator::Allocate (4000);
+  std::memset (large, 0, 4000);
+  ArenaAllocator::Deallocate (large, 4000);
+
+  if (ArenaAllocator::IsEnabled ())
+    {
+      ArenaAllocator::Stats before = ArenaAllocator::GetStats ();
+      ArenaAllocator::Release ();
+      ArenaAllocator::Stats after = ArenaAllocator::GetStats ();
+      NS_TEST_EXPECT_MSG_EQ (GetSizeClass (blockSize).chunks, 0, "Unused chunks not released");
+      NS_TEST_EXPECT_MSG_GT (after.releases, before.releases, "No chunk released");
+      NS_TEST_EXPECT_MSG_GT (after.large, 0, "Large instance not counted");
+    }
+}
+
+
+#ifdef HAVE_PTHREAD_H
+/**
+ * \ingroup arena-allocator-tests
+ * Check the blocks allocated and deallocated by different threads.
+ */
+class ArenaAllocatorThreadsTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  ArenaAllocatorThreadsTestCase ();
+  virtual void DoRun (void);
+};
+
+ArenaAllocatorThreadsTestCase::ArenaAllocatorThreadsTestCase ()
+  : TestCase ("Check the blocks exchanged by threads")
+{}
+
+void
+ArenaAllocatorThreadsTestCase::DoRun (void)
+{
+  const std::size_t size = 480;
+  const std::size_t blockSize = 480;
+  const uint32_t count = 5000;
+  std::vector<void *> blocks[4];
+  std::vector<std::thread> threads;
+  for (uint32_t t = 0; t < 4; ++t)
+    {
+      std::vector<void *> *mine = &blocks[t];
+      threads.push_back (std::thread ([mine, t, size, count] ()
+        {
+          for (uint32_t i = 0; i < count; ++i)
+            {
+              void *p = ArenaAllocator::Allocate (size);
+              std::memset (p, t, size);
+              mine->push_back (p);
+              if (i % 3 == 0)
+                {
+                  // some blocks are freed, and reused, by the same thread
+                  ArenaAllocator::Deallocate (mine->back (), size);
+                  mine->pop_back ();
+                }
+            }
+        }));
+    }
+  for (std::thread &thread : threads)
+    {
+      thread.join ();
+    }
+
+  std::set<void *> distinct;
+  uint32_t total = 0;
+  for (uint32_t t = 0; t < 4; ++t)
+    {
+      for (void *p : blocks[t])
+        {
+          distinct.insert (p);
+          NS_TEST_EXPECT_MSG_EQ ((uint32_t) *static_cast<uint8_t *> (p), t, "Block overwritten");
+        }
+      total += blocks[t].size ();
+    }
+  NS_TEST_EXPECT_MSG_EQ (distinct.size (), total, "Block allocated twice");
+
+  // the blocks allocated by the other threads are freed by this one
+  for (uint32_t t = 0; t < 4; ++t)
+    {
+      for (void *p : blocks[t])
+        {
+          ArenaAllocator::Deallocate (p, size);
+        }
+    }
+  if (ArenaAllocator::IsEnabled ())
+    {
+      ArenaAllocator::Release ();
+      NS_TEST_EXPECT_MSG_EQ (GetSizeClass (blockSize).chunks, 0,
+                             "Blocks of the exited threads not returned");
+    }
+}
+#endif /* HAVE_PTHREAD_H */
+
+
+/**
+ * \ingroup arena-allocator-tests
+ * Object allocated in the arenas.
+ */
+class ArenaAllocatedObject : public Object, public ArenaAllocated
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return The object TypeId.
+   */
+  static TypeId GetTypeId (void)
+  {
+    static TypeId tid = TypeId ("ns3::tests::ArenaAllocatedObject")
+      .SetParent<Object> ()
+      .SetGroupName ("Core")
+      .AddConstructor<ArenaAllocatedObject> ()
+    ;
+    return tid;
+  }
+
+  uint8_t m_data[400 - sizeof (Object)];  //!< Data making a 400 bytes instance
+};
+
+
+/**
+ * \ingroup arena-allocator-tests
+ * Check that the Objects opting in are allocated in the arenas.
+ */
+class ArenaAllocatedObjectTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  ArenaAllocatedObjectTestCase ();
+  virtual void DoRun (void);
+};
+
+ArenaAllocatedObjectTestCase::ArenaAllocatedObjectTestCase ()
+  : TestCase ("Check the Objects allocated in the arenas")
+{}
+
+void
+ArenaAllocatedObjectTestCase::DoRun (void)
+{
+  const std::size_t blockSize = (sizeof (ArenaAllocatedObject) + 15) / 16 * 16;
+  uint64_t used = GetSizeClass (blockSize).used;
+  std::vector<Ptr<Object> > objects;
+  for (uint32_t i = 0; i < 10; ++i)
+    {
+      objects.push_back (CreateObject<ArenaAllocatedObject> ());
+    }
+  if (ArenaAllocator::IsEnabled ())
+    {
+      NS_TEST_EXPECT_MSG_GT_OR_EQ (GetSizeClass (blockSize).used, used + 10,
+                                   "Objects not allocated in the arenas");
+    }
+  // deleted through a pointer to Object
+  objects.clear ();
+  Simulator::Destroy ();
+}
+
+
+/**
+ * \ingroup arena-allocator-tests
+ * Arena allocator test suite.
+ */
+class ArenaAllocatorTestSuite : public TestSuite
+{
+public:
+  ArenaAllocatorTestSuite ()
+    : TestSuite ("arena-allocator")
+  {
+    AddTestCase (new ArenaAllocatorBlocksTestCase ());
+#ifdef HAVE_PTHREAD_H
+    AddTestCase (new ArenaAllocatorThreadsTestCase ());
+#endif
+    AddTestCase (new ArenaAllocatedObjectTestCase ());
+  }
+};
+
+/**
+ * \ingroup arena-allocator-tests
+ * ArenaAllocatorTestSuite instance variable.
+ */
+static ArenaAllocatorTestSuite g_arenaAllocatorTestSuite;
+
+
+}    // namespace tests
+
+}  // namespace ns3
@@ -595,6 +595,119 @@ NullifyCallbackTestCase::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ (target1.IsNull (), true, "Nullified Callback reports not IsNull()");
 }
 
+// ===========================================================================
+// Test the copies of callbacks, whose implementation is either stored
+// inline or shared on the heap.
+// ===========================================================================
+class CopyCallbackTestCase : public TestCase
+{
+public:
+  CopyCallbackTestCase ();
+  virtual ~CopyCallbackTestCase ()
+  {}
+
+private:
+  virtual void DoRun (void);
+};
+
+class CopyCallbackTarget : public SimpleRefCount<CopyCallbackTarget>
+{
+public:
+  CopyCallbackTarget ()
+    : m_sum (0)
+  {}
+  void Add (int a)
+  {
+    m_sum += a;
+  }
+  int m_sum;
+};
+
+static int gCopyCallbackSum;
+
+/** A functor with a state, which the copies of a callback must share */
+struct CopyCallbackCounter
+{
+  CopyCallbackCounter ()
+    : m_count (0)
+  {}
+  int operator() (void)
+  {
+    return ++m_count;
+  }
+  bool operator!= (const CopyCallbackCounter &o) const
+  {
+    return this != &o;
+  }
+  int m_count;
+};
+
+void
+CopyCallbackAdd (int a, int b)
+{
+  gCopyCallbackSum += a + b;
+}
+
+CopyCallbackTestCase::CopyCallbackTestCase ()
+  : TestCase ("Check copies of callbacks")
+{}
+
+void
+CopyCallbackTestCase::DoRun (void)
+{
+  Ptr<CopyCallbackTarget> target = Create<CopyCallbackTarget> ();
+  {
+    Callback<void, int> a = MakeCallback (&CopyCallbackTarget::Add, target);
+    NS_TEST_ASSERT_MSG_EQ (target->GetReferenceCount (), 2, "Callback does not hold the object");
+    Callback<void, int> b = a;
+    Callback<void, int> c;
+    c = b;
+    NS_TEST_ASSERT_MSG_EQ (a.IsEqual (b), true, "Copy is not equal to the original");
+    NS_TEST_ASSERT_MSG_EQ (c.IsEqual (a), true, "Copy is not equal to the original");
+    a (1);
+    b (2);
+    c (3);
+    NS_TEST_ASSERT_MSG_EQ (target->m_sum, 6, "Copies did not fire");
+
+    CallbackBase base = c;
+    Callback<void, int> d;
+    NS_TEST_ASSERT_MSG_EQ (d.Assign (base), true, "Could not assign the callback");
+    NS_TEST_ASSERT_MSG_EQ (d.IsEqual (a), true, "Assigned callback is not equal to the original");
+    NS_TEST_ASSERT_MSG_EQ (a.GetImpl ()->IsEqual (b.GetImpl ()), true, "Implementations are not equal");
+
+    c.Nullify ();
+    NS_TEST_ASSERT_MSG_EQ (c.IsNull (), true, "Nullified Callback reports not IsNull()");
+    NS_TEST_ASSERT_MSG_EQ (b.IsEqual (a), true, "Nullify modified a copy");
+  }
+  NS_TEST_ASSERT_MSG_EQ (target->GetReferenceCount (), 1, "Callbacks did not release the object");
+
+  gCopyCallbackSum = 0;
+  Callback<void, int> bound = MakeBoundCallback (&CopyCallbackAdd, 10);
+  Callback<void, int> other = MakeBoundCallback (&CopyCallbackAdd, 20);
+  Callback<void, int> copy = bound;
+  NS_TEST_ASSERT_MSG_EQ (copy.IsEqual (bound), true, "Copy is not equal to the original");
+  NS_TEST_ASSERT_MSG_EQ (copy.IsEqual (other), false, "Callbacks with different bound arguments are equal");
+  copy = other;
+  NS_TEST_ASSERT_MSG_EQ (copy.IsEqual (other), true, "Copy is not equal to the original");
+  bound (1);
+  copy (2);
+  NS_TEST_ASSERT_MSG_EQ (gCopyCallbackSum, 33, "Bound callbacks did not fire");
+
+  // a callback binding another callback does not fit inline
+  Callback<void> twice = bound.Bind (5);
+  Callback<void> twiceCopy = twice;
+  NS_TEST_ASSERT_MSG_EQ (twiceCopy.IsEqual (twice), true, "Copy is not equal to the original");
+  twiceCopy ();
+  NS_TEST_ASSERT_MSG_EQ (gCopyCallbackSum, 48, "Bound callback did not fire");
+
+  // the copies of a functor callback share the functor and its state
+  Callback<int> counter (CopyCallbackCounter (), true, true);
+  Callback<int> counterCopy = counter;
+  NS_TEST_ASSERT_MSG_EQ (counter (), 1, "Functor callback did not fire");
+  NS_TEST_ASSERT_MSG_EQ (counterCopy (), 2, "Copy does not share the functor");
+  NS_TEST_ASSERT_MSG_EQ (counter (), 3, "Original does not share the functor");
+}
+
 // ===========================================================================
 // Make sure that various MakeCallback template functions compile and execute.
 // Doesn't check an results of the execution.
@@ -755,6 +868,7 @@ CallbackTestSuite::CallbackTestSuite ()
   AddTestCase (new MakeCallbackTestCase, TestCase::QUICK);
   AddTestCase (new MakeBoundCallbackTestCase, TestCase::QUICK);
   AddTestCase (new NullifyCallbackTestCase, TestCase::QUICK);
+  AddTestCase (new CopyCallbackTestCase, TestCase::QUICK);
   AddTestCase (new MakeCallbackTemplatesTestCase, TestCase::QUICK);
 }
 
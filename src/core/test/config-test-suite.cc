@@ -840,6 +840,133 @@ SearchAttributesOfParentObjectsTestCase::DoRun (void)
 
 }
 
+/**
+ * \ingroup config-tests
+ * Test for compiled paths and batches of configuration operations.
+ */
+class BatchConfigTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  BatchConfigTestCase ();
+  /** Destructor. */
+  virtual ~BatchConfigTestCase ()
+  {}
+
+  /**
+   * Trace callback without context.
+   * \param oldValue The old value.
+   * \param newValue The new value.
+   */
+  void Trace (int16_t oldValue, int16_t newValue)
+  {
+    NS_UNUSED (oldValue);
+    m_newValue = newValue;
+  }
+  /**
+   * Trace callback with context path.
+   * \param path The context path.
+   * \param old The old value.
+   * \param newValue The new value.
+   */
+  void TraceWithPath (std::string path, int16_t old, int16_t newValue)
+  {
+    NS_UNUSED (old);
+    m_newValue = newValue;
+    m_path = path;
+  }
+
+private:
+  virtual void DoRun (void);
+
+  int16_t m_newValue; //!< Flag to detect tracing result.
+  std::string m_path; //!< The context path.
+};
+
+BatchConfigTestCase::BatchConfigTestCase ()
+  : TestCase ("Check compiled paths and batches of configuration operations")
+{}
+
+void
+BatchConfigTestCase::DoRun (void)
+{
+  IntegerValue iv;
+
+  Ptr<ConfigTestObject> root = CreateObject<ConfigTestObject> ();
+  Names::Add ("BatchRoot", root);
+  std::vector<Ptr<ConfigTestObject> > objects;
+  for (uint32_t i = 0; i < 100; i++)
+    {
+      objects.push_back (CreateObject<ConfigTestObject> ());
+      root->AddNodeA (objects.back ());
+    }
+
+  //
+  // Set an attribute of each object with its own path, and connect to the
+  // trace source of a few of them.  Nothing happens until the batch is
+  // applied.
+  //
+  Config::Batch batch;
+  for (uint32_t i = 0; i < objects.size (); i++)
+    {
+      std::ostringstream oss;
+      oss << "/Names/BatchRoot/NodesA/" << i << "/A";
+      batch.Set (oss.str (), IntegerValue (static_cast<int8_t> (i) - 50));
+    }
+  batch.ConnectWithoutContext ("/Names/BatchRoot/NodesA/7/Source",
+                               MakeCallback (&BatchConfigTestCase::Trace, this));
+  batch.Connect ("/Names/BatchRoot/NodesA/[10-12]/Source",
+                 MakeCallback (&BatchConfigTestCase::TraceWithPath, this));
+  NS_TEST_ASSERT_MSG_EQ (batch.GetN (), objects.size () + 2, "Unexpected number of operations");
+  objects[0]->GetAttribute ("A", iv);
+  NS_TEST_ASSERT_MSG_EQ (iv.Get (), 10, "Object Attribute \"A\" set before the batch is applied");
+
+  batch.Apply ();
+  NS_TEST_ASSERT_MSG_EQ (batch.GetN (), 0, "Operations not forgotten after the batch is applied");
+  for (uint32_t i = 0; i < objects.size (); i++)
+    {
+      objects[i]->GetAttribute ("A", iv);
+      NS_TEST_ASSERT_MSG_EQ (iv.Get (), static_cast<int8_t> (i) - 50, "Object Attribute \"A\" not set as expected");
+    }
+
+  m_newValue = 0;
+  objects[7]->SetAttribute ("Source", IntegerValue (-7));
+  NS_TEST_ASSERT_MSG_EQ (m_newValue, -7, "Trace 7 did not fire as expected");
+  m_newValue = 0;
+  m_path = "";
+  objects[11]->SetAttribute ("Source", IntegerValue (-11));
+  NS_TEST_ASSERT_MSG_EQ (m_newValue, -11, "Trace 11 did not fire as expected");
+  NS_TEST_ASSERT_MSG_EQ (m_path, "/Names/BatchRoot/NodesA/11/Source", "Trace 11 did not provide expected context");
+  m_newValue = 0;
+  objects[13]->SetAttribute ("Source", IntegerValue (-13));
+  NS_TEST_ASSERT_MSG_EQ (m_newValue, 0, "Trace 13 fired unexpectedly");
+
+  //
+  // The objects matching a compiled path are looked up again only after
+  // it is invalidated.
+  //
+  Config::CompiledPath path ("/Names/BatchRoot/NodesA/*");
+  NS_TEST_ASSERT_MSG_EQ (path.LookupMatches ().GetN (), 100, "Unexpected number of matches");
+  NS_TEST_ASSERT_MSG_EQ (path.LookupMatches ().GetMatchedPath (5), "/Names/BatchRoot/NodesA/5/", "Unexpected context");
+  objects.push_back (CreateObject<ConfigTestObject> ());
+  root->AddNodeA (objects.back ());
+  NS_TEST_ASSERT_MSG_EQ (path.LookupMatches ().GetN (), 100, "Matches looked up again");
+  path.Invalidate ();
+  NS_TEST_ASSERT_MSG_EQ (path.LookupMatches ().GetN (), 101, "Matches not looked up again");
+
+  //
+  // Indices beyond the end of the container are ignored.
+  //
+  Config::MatchContainer matches = Config::LookupMatches ("/Names/BatchRoot/NodesA/3|200");
+  NS_TEST_ASSERT_MSG_EQ (matches.GetN (), 1, "Unexpected number of matches");
+  NS_TEST_ASSERT_MSG_EQ (matches.Get (0), objects[3], "Unexpected match");
+  matches = Config::LookupMatches ("/Names/BatchRoot/NodesA/[98-150]");
+  NS_TEST_ASSERT_MSG_EQ (matches.GetN (), 3, "Unexpected number of matches");
+  NS_TEST_ASSERT_MSG_EQ (matches.GetMatchedPath (2), "/Names/BatchRoot/NodesA/100/", "Unexpected context");
+
+  Names::Clear ();
+}
+
 /**
  * \ingroup config-tests
  * The Test Suite that glues all of the Test Cases together.
@@ -858,6 +985,7 @@ ConfigTestSuite::ConfigTestSuite ()
   AddTestCase (new UnderRootNamespaceConfigTestCase);
   AddTestCase (new ObjectVectorConfigTestCase);
   AddTestCase (new SearchAttributesOfParentObjectsTestCase);
+  AddTestCase (new BatchConfigTestCase);
 }
 
 /**
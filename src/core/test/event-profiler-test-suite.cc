@@ -0,0 +1,252 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/make-event.h"
+#include "ns3/event-profiler.h"
+#include "ns3/config.h"
+#include "ns3/string.h"
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup event-profiler-tests
+ * EventProfiler test suite.
+ */
+
+/**
+ * \ingroup core-tests
+ * \defgroup event-profiler-tests EventProfiler test suite
+ */
+
+namespace ns3 {
+
+namespace tests {
+
+
+/** Number of calls of the profiled functions. */
+static uint32_t g_profiledCalls = 0;
+
+/** Function invoked by the profiled events. */
+void
+ProfiledFunction (void)
+{
+  g_profiledCalls++;
+}
+
+/**
+ * \ingroup event-profiler-tests
+ * Base class of the objects of the profiled events.
+ */
+class ProfiledBase
+{
+public:
+  virtual ~ProfiledBase ();
+  /** Method invoked by the profiled events. */
+  virtual void Handle (void);
+};
+
+ProfiledBase::~ProfiledBase ()
+{}
+
+void
+ProfiledBase::Handle (void)
+{
+  g_profiledCalls++;
+}
+
+/**
+ * \ingroup event-profiler-tests
+ * Derived class of the objects of the profiled events.
+ */
+class ProfiledDerived : public ProfiledBase
+{
+public:
+  virtual void Handle (void);
+};
+
+void
+ProfiledDerived::Handle (void)
+{
+  g_profiledCalls += 2;
+}
+
+/**
+ * \ingroup event-profiler-tests
+ * Check that the events are attributed to the functions they invoke.
+ */
+class EventProfilerFunctionTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  EventProfilerFunctionTestCase ();
+  virtual void DoRun (void);
+};
+
+EventProfilerFunctionTestCase::EventProfilerFunctionTestCase ()
+  : TestCase ("Check the functions of the events")
+{}
+
+void
+EventProfilerFunctionTestCase::DoRun (void)
+{
+  ProfiledBase base;
+  ProfiledDerived derived;
+  ProfiledBase *object = &derived;
+
+  Ptr<EventImpl> function = Ptr<EventImpl> (MakeEvent (&ProfiledFunction), false);
+  Ptr<EventImpl> viaBase = Ptr<EventImpl> (MakeEvent (&ProfiledBase::Handle, object), false);
+  Ptr<EventImpl> viaDerived = Ptr<EventImpl> (MakeEvent (&ProfiledDerived::Handle, &derived), false);
+  Ptr<EventImpl> other = Ptr<EventImpl> (MakeEvent (&ProfiledBase::Handle, &base), false);
+
+  NS_TEST_EXPECT_MSG_EQ (function->PeekFunction (), reinterpret_cast<const void *> (&ProfiledFunction),
+                         "Wrong function address");
+  NS_TEST_EXPECT_MSG_NE (viaBase->PeekFunction (), 0, "Unknown method address");
+  NS_TEST_EXPECT_MSG_EQ (viaBase->PeekFunction (), viaDerived->PeekFunction (),
+                         "Virtual method not resolved");
+  NS_TEST_EXPECT_MSG_NE (viaBase->PeekFunction (), other->PeekFunction (),
+                         "Virtual method not resolved");
+  std::string name = EventProfiler::GetName (PeekPointer (viaBase));
+  NS_TEST_EXPECT_MSG_EQ (name, EventProfiler::GetName (PeekPointer (viaDerived)),
+                         "Different names for the same method");
+  NS_TEST_EXPECT_MSG_NE (name, EventProfiler::GetName (PeekPointer (other)),
+                         "Same name for different methods");
+
+  EventProfiler profiler;
+  g_profiledCalls = 0;
+  profiler.Invoke (PeekPointer (function), 1);
+  profiler.Invoke (PeekPointer (function), 1);
+  profiler.Invoke (PeekPointer (viaBase), 2);
+  profiler.Invoke (PeekPointer (other), Simulator::NO_CONTEXT);
+  NS_TEST_EXPECT_MSG_EQ (g_profiledCalls, 5, "Events not invoked");
+  NS_TEST_EXPECT_MSG_EQ (profiler.GetEventCount (), 4, "Events not counted");
+
+  std::ostringstream report;
+  profiler.PrintReport (report);
+  NS_TEST_EXPECT_MSG_NE (report.str ().find ("Event profile: 4 events"), std::string::npos,
+                         "Wrong report:\n" << report.str ());
+  NS_TEST_EXPECT_MSG_NE (report.str ().find (EventProfiler::GetName (PeekPointer (function))), std::string::npos,
+                         "Function missing from the report:\n" << report.str ());
+  NS_TEST_EXPECT_MSG_NE (report.str ().find ("no context"), std::string::npos,
+                         "Context missing from the report:\n" << report.str ());
+
+  std::ostringstream folded;
+  profiler.PrintFolded (folded);
+  std::istringstream lines (folded.str ());
+  std::string line;
+  uint32_t n = 0;
+  bool found = false;
+  while (std::getline (lines, line))
+    {
+      n++;
+      found |= line.find ("node 2;" + name + " ") == 0;
+    }
+  NS_TEST_EXPECT_MSG_EQ (n, 3, "Wrong number of stacks:\n" << folded.str ());
+  NS_TEST_EXPECT_MSG_EQ (found, true, "Stack missing:\n" << folded.str ());
+
+  profiler.Clear ();
+  NS_TEST_EXPECT_MSG_EQ (profiler.GetEventCount (), 0, "Profile not cleared");
+}
+
+/**
+ * \ingroup event-profiler-tests
+ * Check that the simulator writes the event profile at Simulator::Destroy.
+ */
+class EventProfilerSimulatorTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  EventProfilerSimulatorTestCase ();
+  virtual void DoRun (void);
+};
+
+EventProfilerSimulatorTestCase::EventProfilerSimulatorTestCase ()
+  : TestCase ("Check the event profile of the simulator")
+{}
+
+void
+EventProfilerSimulatorTestCase::DoRun (void)
+{
+  std::string filename = CreateTempDirFilename ("event-profile");
+  // the attribute is used by the next simulator
+  Simulator::Destroy ();
+  Config::SetDefault ("ns3::DefaultSimulatorImpl::ProfileFileName", StringValue (filename));
+
+  ProfiledDerived derived;
+  for (uint32_t i = 0; i < 10; ++i)
+    {
+      Simulator::ScheduleWithContext (7, Seconds (i), &ProfiledBase::Handle, &derived);
+    }
+  Simulator::Schedule (Seconds (1), &ProfiledFunction);
+  Simulator::Run ();
+  Simulator::Destroy ();
+  Config::SetDefault ("ns3::DefaultSimulatorImpl::ProfileFileName", StringValue (""));
+
+  std::ifstream report (filename.c_str ());
+  std::ostringstream contents;
+  contents << report.rdbuf ();
+  NS_TEST_EXPECT_MSG_NE (contents.str ().find ("Event profile: 11 events"), std::string::npos,
+                         "Wrong report:\n" << contents.str ());
+  Ptr<EventImpl> event = Ptr<EventImpl> (MakeEvent (&ProfiledDerived::Handle, &derived), false);
+  std::string name = EventProfiler::GetName (PeekPointer (event));
+  NS_TEST_EXPECT_MSG_NE (contents.str ().find (name), std::string::npos,
+                         "Method missing from the report:\n" << contents.str ());
+  report.close ();
+
+  std::string foldedname = filename + ".folded";
+  std::ifstream folded (foldedname.c_str ());
+  std::string line;
+  bool found = false;
+  while (std::getline (folded, line))
+    {
+      found |= line.find ("node 7;" + name + " ") == 0;
+    }
+  NS_TEST_EXPECT_MSG_EQ (found, true, "Stack missing from " << foldedname);
+  folded.close ();
+
+  std::remove (filename.c_str ());
+  std::remove (foldedname.c_str ());
+}
+
+/**
+ * \ingroup event-profiler-tests
+ * EventProfiler test suite.
+ */
+class EventProfilerTestSuite : public TestSuite
+{
+public:
+  EventProfilerTestSuite ()
+    : TestSuite ("event-profiler")
+  {
+    AddTestCase (new EventProfilerFunctionTestCase ());
+    AddTestCase (new EventProfilerSimulatorTestCase ());
+  }
+};
+
+/**
+ * \ingroup event-profiler-tests
+ * EventProfilerTestSuite instance variable.
+ */
+static EventProfilerTestSuite g_eventProfilerTestSuite;
+
+
+}    // namespace tests
+
+}  // namespace ns3
@@ -0,0 +1,213 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cstdlib>
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/fork-helper.h"
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup fork-tests
+ * Simulator::Fork and ForkHelper test suite.
+ */
+
+/**
+ * \ingroup core-tests
+ * \defgroup fork-tests Simulator::Fork test suite
+ */
+
+namespace ns3 {
+
+namespace tests {
+
+
+/**
+ * \ingroup fork-tests
+ * Check that RandomVariableStream::ResetStreams restarts the existing
+ * random variables with the current run number.
+ */
+class ResetStreamsTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  ResetStreamsTestCase ();
+  virtual void DoRun (void);
+};
+
+ResetStreamsTestCase::ResetStreamsTestCase ()
+  : TestCase ("Check that the random variables are restarted with the current run number")
+{}
+
+void
+ResetStreamsTestCase::DoRun (void)
+{
+  uint64_t run = RngSeedManager::GetRun ();
+  Ptr<UniformRandomVariable> automatic = CreateObject<UniformRandomVariable> ();
+  Ptr<UniformRandomVariable> fixed = CreateObject<UniformRandomVariable> ();
+  fixed->SetStream (3);
+
+  RngSeedManager::SetRun (7);
+  RandomVariableStream::ResetStreams ();
+  double automatic7 = automatic->GetValue ();
+  double fixed7 = fixed->GetValue ();
+  automatic->GetValue ();
+
+  RngSeedManager::SetRun (7);
+  RandomVariableStream::ResetStreams ();
+  NS_TEST_EXPECT_MSG_EQ (automatic->GetValue (), automatic7, "Stream not restarted");
+  NS_TEST_EXPECT_MSG_EQ (fixed->GetValue (), fixed7, "Stream not restarted");
+
+  RngSeedManager::SetRun (8);
+  RandomVariableStream::ResetStreams ();
+  NS_TEST_EXPECT_MSG_NE (automatic->GetValue (), automatic7, "Run number not used");
+  NS_TEST_EXPECT_MSG_NE (fixed->GetValue (), fixed7, "Run number not used");
+
+  Ptr<UniformRandomVariable> other = CreateObject<UniformRandomVariable> ();
+  other->SetStream (3);
+  RngSeedManager::SetRun (7);
+  RandomVariableStream::ResetStreams ();
+  NS_TEST_EXPECT_MSG_EQ (other->GetValue (), fixed7, "Stream number not kept");
+
+  RngSeedManager::SetRun (run);
+  RandomVariableStream::ResetStreams ();
+}
+
+/**
+ * \ingroup fork-tests
+ * Check that the child processes created by ForkHelper continue the
+ * simulation with their own run number and configuration, and that their
+ * results are collected by the parent process.
+ */
+class ForkHelperTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  ForkHelperTestCase ();
+  virtual void DoRun (void);
+
+private:
+  /**
+   * Record the index of the child process.
+   * \param [in] child The index of the child process.
+   */
+  void Configure (uint32_t child);
+  /** Draw a value of the random variable. */
+  void Draw (void);
+
+  Ptr<UniformRandomVariable> m_variable; //!< Random variable created before the fork
+  uint32_t m_configured;                 //!< Index passed to the child callback
+  uint32_t m_draws;                      //!< Number of values drawn
+  double m_value;                        //!< Last value drawn
+};
+
+ForkHelperTestCase::ForkHelperTestCase ()
+  : TestCase ("Check that the forked simulations report their results"),
+    m_configured (0),
+    m_draws (0),
+    m_value (0)
+{}
+
+void
+ForkHelperTestCase::Configure (uint32_t child)
+{
+  m_configured = child;
+}
+
+void
+ForkHelperTestCase::Draw (void)
+{
+  m_draws++;
+  m_value = m_variable->GetValue ();
+}
+
+void
+ForkHelperTestCase::DoRun (void)
+{
+  uint64_t run = RngSeedManager::GetRun ();
+  m_variable = CreateObject<UniformRandomVariable> ();
+
+  ForkHelper fork (3);
+  fork.SetFirstRun (5);
+  fork.SetChildCallback (MakeCallback (&ForkHelperTestCase::Configure, this));
+  fork.ForkAt (Seconds (2));
+  Simulator::Schedule (Seconds (1), &ForkHelperTestCase::Draw, this);
+  Simulator::Schedule (Seconds (3), &ForkHelperTestCase::Draw, this);
+  Simulator::Stop (Seconds (4));
+  Simulator::Run ();
+
+  if (fork.IsChild ())
+    {
+      fork.Report ("configured", m_configured);
+      fork.Report ("draws", m_draws);
+      fork.Report ("value", m_value);
+      fork.Report ("time", Simulator::Now ().GetSeconds ());
+      // do not return to the test framework
+      std::_Exit (0);
+    }
+
+  NS_TEST_EXPECT_MSG_EQ (fork.GetChildIndex (), 0, "Not the parent process");
+  NS_TEST_EXPECT_MSG_EQ (Simulator::Now (), Seconds (2), "Parent did not stop at the fork");
+  NS_TEST_EXPECT_MSG_EQ (m_draws, 1, "Parent continued after the fork");
+  NS_TEST_EXPECT_MSG_EQ (fork.HasResult (1, "missing"), false, "Unexpected result");
+  for (uint32_t i = 1; i <= 3; ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (fork.HasResult (i, "value"), true, "No result from child " << i);
+      NS_TEST_EXPECT_MSG_EQ (fork.GetResult (i, "configured"), i, "Child callback not invoked");
+      NS_TEST_EXPECT_MSG_EQ (fork.GetResult (i, "draws"), 2, "Child did not continue the simulation");
+      NS_TEST_EXPECT_MSG_EQ (fork.GetResult (i, "time"), 4, "Child did not continue the simulation");
+
+      // the child drew the first value of the variable with its own run number
+      RngSeedManager::SetRun (5 + i - 1);
+      RandomVariableStream::ResetStreams ();
+      NS_TEST_EXPECT_MSG_EQ (fork.GetResult (i, "value"), m_variable->GetValue (),
+                             "Child " << i << " did not use its run number");
+    }
+
+  RngSeedManager::SetRun (run);
+  RandomVariableStream::ResetStreams ();
+  m_variable = 0;
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup fork-tests
+ * Simulator::Fork test suite.
+ */
+class ForkTestSuite : public TestSuite
+{
+public:
+  ForkTestSuite ()
+    : TestSuite ("fork")
+  {
+    AddTestCase (new ResetStreamsTestCase ());
+    AddTestCase (new ForkHelperTestCase ());
+  }
+};
+
+/**
+ * \ingroup fork-tests
+ * ForkTestSuite instance variable.
+ */
+static ForkTestSuite g_forkTestSuite;
+
+
+}    // namespace tests
+
+}  // namespace ns3
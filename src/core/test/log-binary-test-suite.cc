@@ -0,0 +1,190 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#define NS_LOG_APPEND_CONTEXT                                   \
+  if (m_id != 0) { std::clog << "[id=" << m_id << "] "; }
+
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup log-binary-tests
+ * Binary logging test suite.
+ */
+
+/**
+ * \ingroup core-tests
+ * \defgroup log-binary-tests Binary logging test suite
+ */
+
+namespace ns3 {
+
+namespace tests {
+
+NS_LOG_COMPONENT_DEFINE ("LogBinaryTestSuite");
+
+
+/**
+ * \ingroup log-binary-tests
+ * Object logging messages with arguments of various types.
+ */
+class LogBinaryLogger : public Object
+{
+public:
+  /**
+   * Constructor.
+   * \param [in] id The identifier appended to the messages.
+   */
+  LogBinaryLogger (uint32_t id);
+  /**
+   * Log the messages.
+   * \param [in] name A string argument.
+   */
+  void LogMessages (std::string name);
+
+private:
+  uint32_t m_id;  //!< Identifier appended to the messages
+};
+
+LogBinaryLogger::LogBinaryLogger (uint32_t id)
+  : m_id (id)
+{}
+
+void
+LogBinaryLogger::LogMessages (std::string name)
+{
+  NS_LOG_FUNCTION (this << name << "literal" << 'c' << int8_t (-3) << uint8_t (200));
+  NS_LOG_INFO ("integers " << 1 << " " << -2L << " " << 3U << " " << (uint64_t (1) << 63));
+  NS_LOG_DEBUG ("reals " << 0.1 << " " << 2.5f << " " << 1e300);
+  NS_LOG_LOGIC ("characters " << 'x' << int8_t ('y') << " string " << name);
+  NS_LOG_WARN ("pointers " << this << " " << Ptr<LogBinaryLogger> (this)
+               << " " << static_cast<void *> (0));
+  NS_LOG_ERROR ("bool " << true << " time " << Seconds (1.5));
+  NS_LOG_INFO ("manipulators " << std::hex << 255 << " " << std::setw (6) << 7
+               << std::dec << " " << 255 << std::endl << "next line");
+  char buffer[16];
+  for (int i = 0; i < 2; ++i)
+    {
+      // the same array with a different content
+      std::snprintf (buffer, sizeof (buffer), "buffer %d", i);
+      const char (&constant)[16] = buffer;
+      NS_LOG_INFO (buffer << " " << constant);
+    }
+  std::vector<int> parameters = {1, 2, 3};
+  NS_LOG_FUNCTION (parameters);
+}
+
+
+/**
+ * \ingroup log-binary-tests
+ * Check that the decoded binary log file matches the text log.
+ */
+class LogBinaryDecodeTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  LogBinaryDecodeTestCase ();
+  virtual void DoRun (void);
+
+private:
+  /**
+   * Log the messages in a simulation.
+   * \param [in] logger The object logging the messages.
+   */
+  void Simulate (Ptr<LogBinaryLogger> logger);
+};
+
+LogBinaryDecodeTestCase::LogBinaryDecodeTestCase ()
+  : TestCase ("Check that the decoded binary log matches the text log")
+{}
+
+void
+LogBinaryDecodeTestCase::Simulate (Ptr<LogBinaryLogger> logger)
+{
+  Simulator::ScheduleWithContext (3, NanoSeconds (1500000001), &LogBinaryLogger::LogMessages,
+                                  logger, "first");
+  Simulator::Schedule (Seconds (2), &LogBinaryLogger::LogMessages, logger, "second");
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+void
+LogBinaryDecodeTestCase::DoRun (void)
+{
+  Ptr<LogBinaryLogger> logger = CreateObject<LogBinaryLogger> (5);
+  LogComponentEnable ("LogBinaryTestSuite", LOG_LEVEL_ALL);
+  LogComponentEnable ("LogBinaryTestSuite", LOG_PREFIX_ALL);
+
+  std::ostringstream text;
+  std::streambuf *clog = std::clog.rdbuf (text.rdbuf ());
+  Simulate (logger);
+
+  std::string filename = CreateTempDirFilename ("log-binary.bin");
+  LogSetBinaryFile (filename);
+  NS_TEST_EXPECT_MSG_EQ (LogBinaryIsEnabled (), true, "Binary logging not enabled");
+  Simulate (logger);
+  LogSetBinaryFile ("");
+  std::clog.rdbuf (clog);
+  LogComponentDisable ("LogBinaryTestSuite", LOG_LEVEL_ALL);
+  NS_TEST_EXPECT_MSG_EQ (LogBinaryIsEnabled (), false, "Binary logging not disabled");
+
+  std::ifstream is (filename.c_str (), std::ios::binary);
+  std::ostringstream decoded;
+  NS_TEST_EXPECT_MSG_EQ (LogBinaryDecode (is, decoded), true, "Invalid binary log file");
+  NS_TEST_EXPECT_MSG_EQ (decoded.str (), text.str (), "Decoded log differs from the text log");
+  is.close ();
+  std::remove (filename.c_str ());
+
+  std::istringstream invalid ("not a binary log");
+  NS_TEST_EXPECT_MSG_EQ (LogBinaryDecode (invalid, decoded), false, "Invalid file decoded");
+}
+
+/**
+ * \ingroup log-binary-tests
+ * Binary logging test suite.
+ */
+class LogBinaryTestSuite : public TestSuite
+{
+public:
+  LogBinaryTestSuite ()
+    : TestSuite ("log-binary")
+  {
+#ifdef NS3_LOG_ENABLE
+    AddTestCase (new LogBinaryDecodeTestCase ());
+#endif
+  }
+};
+
+/**
+ * \ingroup log-binary-tests
+ * LogBinaryTestSuite instance variable.
+ */
+static LogBinaryTestSuite g_logBinaryTestSuite;
+
+
+}    // namespace tests
+
+}  // namespace ns3
@@ -0,0 +1,267 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <vector>
+#include "ns3/test.h"
+#include "ns3/memory-accounting.h"
+#include "ns3/memory-monitor.h"
+#include "ns3/object.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/simulator.h"
+#include "ns3/nstime.h"
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup memory-accounting-tests
+ * Memory accounting test suite.
+ */
+
+/**
+ * \ingroup core-tests
+ * \defgroup memory-accounting-tests Memory accounting test suite
+ */
+
+namespace ns3 {
+
+namespace tests {
+
+
+/**
+ * \ingroup memory-accounting-tests
+ * Object accounted to its TypeId.
+ */
+class MemoryAccountingObject : public Object
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return The object TypeId.
+   */
+  static TypeId GetTypeId (void)
+  {
+    static TypeId tid = TypeId ("ns3::tests::MemoryAccountingObject")
+      .SetParent<Object> ()
+      .SetGroupName ("MemoryAccountingTests")
+      .AddConstructor<MemoryAccountingObject> ()
+    ;
+    return tid;
+  }
+
+private:
+  double m_data[8];  //!< Some data
+};
+
+NS_OBJECT_ENSURE_REGISTERED (MemoryAccountingObject);
+
+/**
+ * \ingroup memory-accounting-tests
+ * Reference counted instance accounted to its C++ type.
+ */
+class MemoryAccountingRefCount : public SimpleRefCount<MemoryAccountingRefCount>
+{
+private:
+  double m_data[4];  //!< Some data
+};
+
+
+/**
+ * \ingroup memory-accounting-tests
+ * Check the accounting of Objects and SimpleRefCount instances.
+ */
+class MemoryAccountingCountTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  MemoryAccountingCountTestCase ();
+  virtual void DoRun (void);
+};
+
+MemoryAccountingCountTestCase::MemoryAccountingCountTestCase ()
+  : TestCase ("Check the accounting of the live instances")
+{}
+
+void
+MemoryAccountingCountTestCase::DoRun (void)
+{
+  bool enabled = MemoryAccounting::IsEnabled ();
+  TypeId tid = MemoryAccountingObject::GetTypeId ();
+  const std::type_info &type = typeid (MemoryAccountingRefCount);
+
+  MemoryAccounting::Enable ();
+  std::vector<Ptr<MemoryAccountingObject> > objects;
+  std::vector<Ptr<MemoryAccountingRefCount> > refCounts;
+  for (int i = 0; i < 3; ++i)
+    {
+      objects.push_back (CreateObject<MemoryAccountingObject> ());
+      refCounts.push_back (Create<MemoryAccountingRefCount> ());
+    }
+  MemoryAccounting::Disable ();
+  // not accounted
+  objects.push_back (CreateObject<MemoryAccountingObject> ());
+  refCounts.push_back (Create<MemoryAccountingRefCount> ());
+
+  MemoryAccounting::Usage usage = MemoryAccounting::GetUsage (tid);
+  NS_TEST_EXPECT_MSG_EQ (usage.name, tid.GetName (), "Wrong TypeId name");
+  NS_TEST_EXPECT_MSG_EQ (usage.count, 3, "Wrong number of Objects");
+  NS_TEST_EXPECT_MSG_EQ (usage.bytes, 3 * sizeof (MemoryAccountingObject),
+                         "Wrong memory usage of the Objects");
+
+  usage = MemoryAccounting::GetUsage (type);
+  NS_TEST_EXPECT_MSG_EQ (usage.name, "ns3::tests::MemoryAccountingRefCount",
+                         "Wrong type name");
+  NS_TEST_EXPECT_MSG_EQ (usage.count, 3, "Wrong number of instances");
+  NS_TEST_EXPECT_MSG_EQ (usage.bytes, 3 * sizeof (MemoryAccountingRefCount),
+                         "Wrong memory usage of the instances");
+
+  bool found = false;
+  for (const MemoryAccounting::Usage &group : MemoryAccounting::GetGroups ())
+    {
+      if (group.name == "MemoryAccountingTests")
+        {
+          found = true;
+          NS_TEST_EXPECT_MSG_EQ (group.count, 3, "Wrong number of Objects in the group");
+        }
+    }
+  NS_TEST_EXPECT_MSG_EQ (found, true, "Group not found");
+
+  objects.erase (objects.begin ());
+  refCounts.erase (refCounts.begin ());
+  objects.pop_back ();
+  refCounts.pop_back ();
+  NS_TEST_EXPECT_MSG_EQ (MemoryAccounting::GetUsage (tid).count, 2,
+                         "Destroyed Object not removed");
+  NS_TEST_EXPECT_MSG_EQ (MemoryAccounting::GetUsage (type).count, 2,
+                         "Destroyed instance not removed");
+
+  objects.clear ();
+  refCounts.clear ();
+  NS_TEST_EXPECT_MSG_EQ (MemoryAccounting::GetUsage (tid).bytes, 0,
+                         "Memory usage of the Objects not released");
+  NS_TEST_EXPECT_MSG_EQ (MemoryAccounting::GetUsage (type).bytes, 0,
+                         "Memory usage of the instances not released");
+
+  if (enabled)
+    {
+      MemoryAccounting::Enable ();
+    }
+}
+
+
+/**
+ * \ingroup memory-accounting-tests
+ * Check the periodic snapshots of MemoryMonitor.
+ */
+class MemoryMonitorTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  MemoryMonitorTestCase ();
+  virtual void DoRun (void);
+
+private:
+  /**
+   * Record a snapshot.
+   * \param [in] types The usage of each type.
+   */
+  void Snapshot (const std::vector<MemoryAccounting::Usage> &types);
+  /** Create an Object. */
+  void CreateOne (void);
+
+  std::vector<uint64_t> m_counts;                       //!< Objects in each snapshot
+  std::vector<Ptr<MemoryAccountingObject> > m_objects;  //!< Objects created
+};
+
+MemoryMonitorTestCase::MemoryMonitorTestCase ()
+  : TestCase ("Check the periodic memory snapshots")
+{}
+
+void
+MemoryMonitorTestCase::Snapshot (const std::vector<MemoryAccounting::Usage> &types)
+{
+  uint64_t count = 0;
+  for (const MemoryAccounting::Usage &usage : types)
+    {
+      if (usage.name == MemoryAccountingObject::GetTypeId ().GetName ())
+        {
+          count = usage.count;
+        }
+    }
+  m_counts.push_back (count);
+}
+
+void
+MemoryMonitorTestCase::CreateOne (void)
+{
+  m_objects.push_back (CreateObject<MemoryAccountingObject> ());
+}
+
+void
+MemoryMonitorTestCase::DoRun (void)
+{
+  bool enabled = MemoryAccounting::IsEnabled ();
+  MemoryAccounting::Enable ();
+
+  Ptr<MemoryMonitor> monitor = CreateObjectWithAttributes<MemoryMonitor>
+      ("Interval", TimeValue (Seconds (1)));
+  monitor->TraceConnectWithoutContext ("Snapshot",
+                                       MakeCallback (&MemoryMonitorTestCase::Snapshot, this));
+  monitor->Start ();
+  Simulator::Schedule (Seconds (0.5), &MemoryMonitorTestCase::CreateOne, this);
+  Simulator::Schedule (Seconds (1.5), &MemoryMonitorTestCase::CreateOne, this);
+  Simulator::Stop (Seconds (2.5));
+  Simulator::Run ();
+  monitor->Dispose ();
+  Simulator::Destroy ();
+  m_objects.clear ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_counts.size (), 3, "Wrong number of snapshots");
+  NS_TEST_EXPECT_MSG_EQ (m_counts[0], 0, "Wrong number of Objects at 0 s");
+  NS_TEST_EXPECT_MSG_EQ (m_counts[1], 1, "Wrong number of Objects at 1 s");
+  NS_TEST_EXPECT_MSG_EQ (m_counts[2], 2, "Wrong number of Objects at 2 s");
+
+  if (!enabled)
+    {
+      MemoryAccounting::Disable ();
+    }
+}
+
+
+/**
+ * \ingroup memory-accounting-tests
+ * Memory accounting test suite.
+ */
+class MemoryAccountingTestSuite : public TestSuite
+{
+public:
+  MemoryAccountingTestSuite ()
+    : TestSuite ("memory-accounting")
+  {
+    AddTestCase (new MemoryAccountingCountTestCase ());
+    AddTestCase (new MemoryMonitorTestCase ());
+  }
+};
+
+/**
+ * \ingroup memory-accounting-tests
+ * MemoryAccountingTestSuite instance variable.
+ */
+static MemoryAccountingTestSuite g_memoryAccountingTestSuite;
+
+
+}    // namespace tests
+
+}  // namespace ns3
@@ -22,6 +22,11 @@
 #include "ns3/object.h"
 #include "ns3/object-factory.h"
 #include "ns3/assert.h"
+#include "ns3/config.h"
+#include "ns3/integer.h"
+#include "ns3/pointer.h"
+#include "ns3/string.h"
+#include "ns3/random-variable-stream.h"
 
 /**
  * \file
@@ -151,6 +156,54 @@ protected:
   }
 };
 
+/**
+ * \ingroup object-tests
+ * Class with attributes.
+ */
+class AttributesA : public ns3::Object
+{
+public:
+  /**
+   * Register this type.
+   * \return The TypeId.
+   */
+  static ns3::TypeId GetTypeId (void)
+  {
+    static ns3::TypeId tid = ns3::TypeId ("ObjectTest:AttributesA")
+      .SetParent<Object> ()
+      .SetGroupName ("Core")
+      .HideFromDocumentation ()
+      .AddConstructor<AttributesA> ()
+      .AddAttribute ("Value", "An integer value.",
+                     ns3::IntegerValue (1),
+                     ns3::MakeIntegerAccessor (&AttributesA::m_value),
+                     ns3::MakeIntegerChecker<int32_t> ())
+      .AddAttribute ("Variable", "A random variable.",
+                     ns3::StringValue ("ns3::ConstantRandomVariable[Constant=3.0]"),
+                     ns3::MakePointerAccessor (&AttributesA::m_variable),
+                     ns3::MakePointerChecker<ns3::RandomVariableStream> ());
+    return tid;
+  }
+  /** Constructor. */
+  AttributesA ()
+    : m_value (0)
+  {}
+  /** \return The integer value. */
+  int32_t GetValue (void) const
+  {
+    return m_value;
+  }
+  /** \return The random variable. */
+  ns3::Ptr<ns3::RandomVariableStream> GetVariable (void) const
+  {
+    return m_variable;
+  }
+
+private:
+  int32_t m_value;                                //!< The integer value.
+  ns3::Ptr<ns3::RandomVariableStream> m_variable; //!< The random variable.
+};
+
 NS_OBJECT_ENSURE_REGISTERED (BaseA);
 NS_OBJECT_ENSURE_REGISTERED (DerivedA);
 NS_OBJECT_ENSURE_REGISTERED (BaseB);
@@ -475,6 +528,84 @@ ObjectFactoryTestCase::DoRun (void)
   NS_TEST_ASSERT_MSG_NE (a->GetObject<DerivedA> (), 0, "Unexpectedly able to work around C++ type system");
 }
 
+/**
+ * \ingroup object-tests
+ * Test the attribute values of the Objects created by an Object factory
+ */
+class ObjectFactoryValuesTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  ObjectFactoryValuesTestCase ();
+  /** Destructor. */
+  virtual ~ObjectFactoryValuesTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+ObjectFactoryValuesTestCase::ObjectFactoryValuesTestCase ()
+  : TestCase ("Check the attribute values of the Objects created by an ObjectFactory")
+{}
+
+ObjectFactoryValuesTestCase::~ObjectFactoryValuesTestCase ()
+{}
+
+void
+ObjectFactoryValuesTestCase::DoRun (void)
+{
+  ObjectFactory factory;
+  factory.SetTypeId (AttributesA::GetTypeId ());
+  factory.Set ("Value", IntegerValue (5));
+
+  //
+  // The values are resolved once, but each Object gets its own random
+  // variable from the string initial value.
+  //
+  Ptr<AttributesA> a1 = factory.Create<AttributesA> ();
+  Ptr<AttributesA> a2 = factory.Create<AttributesA> ();
+  NS_TEST_ASSERT_MSG_EQ (a1->GetValue (), 5, "Wrong value of the first Object");
+  NS_TEST_ASSERT_MSG_EQ (a2->GetValue (), 5, "Wrong value of the second Object");
+  NS_TEST_ASSERT_MSG_NE (a1->GetVariable (), 0, "No variable in the first Object");
+  NS_TEST_ASSERT_MSG_NE (a1->GetVariable (), a2->GetVariable (), "Objects share a variable");
+  NS_TEST_ASSERT_MSG_EQ (a2->GetVariable ()->GetInteger (), 3, "Wrong variable of the second Object");
+
+  //
+  // Changing the factory changes the values of the next Objects.
+  //
+  factory.Set ("Value", IntegerValue (6));
+  a1 = factory.Create<AttributesA> ();
+  NS_TEST_ASSERT_MSG_EQ (a1->GetValue (), 6, "Value of the factory not updated");
+
+  //
+  // Changing the initial value changes the values of the next Objects
+  // which do not set it.
+  //
+  ObjectFactory defaults;
+  defaults.SetTypeId (AttributesA::GetTypeId ());
+  NS_TEST_ASSERT_MSG_EQ (defaults.Create<AttributesA> ()->GetValue (), 1, "Wrong initial value");
+  NS_TEST_ASSERT_MSG_EQ (CreateObject<AttributesA> ()->GetValue (), 1, "Wrong initial value");
+  Config::SetDefault ("ObjectTest:AttributesA::Value", IntegerValue (7));
+  NS_TEST_ASSERT_MSG_EQ (defaults.Create<AttributesA> ()->GetValue (), 7, "Initial value not updated");
+  NS_TEST_ASSERT_MSG_EQ (CreateObject<AttributesA> ()->GetValue (), 7, "Initial value not updated");
+  NS_TEST_ASSERT_MSG_EQ (factory.Create<AttributesA> ()->GetValue (), 6, "Value of the factory overridden");
+  Config::SetDefault ("ObjectTest:AttributesA::Value", IntegerValue (1));
+
+  //
+  // Objects created in bulk get the same values, and their own variables.
+  //
+  std::vector<Ptr<AttributesA> > bulk = factory.Create<AttributesA> (3);
+  NS_TEST_ASSERT_MSG_EQ (bulk.size (), 3, "Wrong number of Objects");
+  for (uint32_t i = 0; i < bulk.size (); ++i)
+    {
+      NS_TEST_ASSERT_MSG_NE (bulk[i], 0, "Object " << i << " not created");
+      NS_TEST_ASSERT_MSG_EQ (bulk[i]->GetValue (), 6, "Wrong value of Object " << i);
+      NS_TEST_ASSERT_MSG_EQ (bulk[i]->GetVariable ()->GetInteger (), 3, "Wrong variable of Object " << i);
+    }
+  NS_TEST_ASSERT_MSG_NE (bulk[0]->GetVariable (), bulk[1]->GetVariable (), "Objects share a variable");
+  NS_TEST_ASSERT_MSG_EQ (defaults.Create (0).size (), 0, "Objects created");
+}
+
 /**
  * \ingroup object-tests
  * The Test Suite that glues the Test Cases together.
@@ -492,6 +623,7 @@ ObjectTestSuite::ObjectTestSuite ()
   AddTestCase (new CreateObjectTestCase);
   AddTestCase (new AggregateObjectTestCase);
   AddTestCase (new ObjectFactoryTestCase);
+  AddTestCase (new ObjectFactoryValuesTestCase);
 }
 
 /**
@@ -0,0 +1,207 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <vector>
+#include "ns3/test.h"
+#include "ns3/double.h"
+#include "ns3/boolean.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/rng-stream.h"
+#include "ns3/random-variable-stream.h"
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup randomvariable
+ * \ingroup rng-stream-tests
+ * RngStream test suite.
+ */
+
+/**
+ * \ingroup core-tests
+ * \defgroup rng-stream-tests RngStream test suite
+ */
+
+namespace ns3 {
+
+namespace tests {
+
+
+/**
+ * \ingroup rng-stream-tests
+ * Check that RngStream draws the values of the original floating point
+ * implementation of MRG32k3a.
+ */
+class RngStreamGoldenTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  RngStreamGoldenTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+RngStreamGoldenTestCase::RngStreamGoldenTestCase ()
+  : TestCase ("Check the values of MRG32k3a against the floating point implementation")
+{}
+
+void
+RngStreamGoldenTestCase::DoRun (void)
+{
+  /** Values drawn by a stream, after skipping some values. */
+  struct Golden
+  {
+    uint32_t seed;        //!< Seed
+    uint64_t stream;      //!< Stream number
+    uint64_t substream;   //!< Substream number
+    uint32_t skip;        //!< Number of values skipped
+    double values[5];     //!< Next values
+  };
+  // printed with 17 significant digits by the floating point implementation
+  // of ns-3.35, hence exact
+  const Golden goldens[] = {
+    {1, 0, 0, 0,
+     {0.0003395772237870988, 0.55588071598279964, 0.014204660652803588,
+      0.088122671313936751, 0.44117338204850992}},
+    {12345, 7, 3, 1000,
+     {0.2634679816666386, 0.95067526347480136, 0.022937145962129899,
+      0.74077056070796143, 0.22289058085559887}},
+    {42, (uint64_t (1) << 63) + 5, 2, 0,
+     {0.062181627828110618, 0.60908433811029949, 0.077099742842080668,
+      0.030060870166090551, 0.92944199622700352}},
+  };
+
+  for (const Golden &golden : goldens)
+    {
+      RngStream scalar (golden.seed, golden.stream, golden.substream);
+      RngStream block (golden.seed, golden.stream, golden.substream);
+      std::vector<double> values (golden.skip + 5);
+      block.RandU01 (values.data (), values.size ());
+      for (uint32_t i = 0; i < golden.skip; ++i)
+        {
+          scalar.RandU01 ();
+        }
+      for (uint32_t i = 0; i < 5; ++i)
+        {
+          NS_TEST_EXPECT_MSG_EQ (scalar.RandU01 (), golden.values[i],
+                                 "Wrong value " << golden.skip + i << " of stream " << golden.stream);
+          NS_TEST_EXPECT_MSG_EQ (values[golden.skip + i], golden.values[i],
+                                 "Wrong value " << golden.skip + i << " in a block of stream " << golden.stream);
+        }
+    }
+}
+
+
+/**
+ * \ingroup rng-stream-tests
+ * Check that the blocks of random values hold the values drawn one at a
+ * time.
+ */
+class RngStreamBlockTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  RngStreamBlockTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+RngStreamBlockTestCase::RngStreamBlockTestCase ()
+  : TestCase ("Check the blocks of random values")
+{}
+
+void
+RngStreamBlockTestCase::DoRun (void)
+{
+  const std::size_t size = 50;
+  for (uint64_t stream = 0; stream < 3; ++stream)
+    {
+      RngStream scalar (RngSeedManager::GetSeed (), stream, RngSeedManager::GetRun ());
+      RngStream block (RngSeedManager::GetSeed (), stream, RngSeedManager::GetRun ());
+      std::vector<double> values (size);
+      for (uint32_t i = 0; i < 1000; ++i)
+        {
+          block.RandU01 (values.data (), size - i % 7);
+          for (std::size_t j = 0; j < size - i % 7; ++j)
+            {
+              NS_TEST_ASSERT_MSG_EQ (values[j], scalar.RandU01 (), "Different values in a block");
+            }
+        }
+    }
+
+  for (bool antithetic : {false, true})
+    {
+      Ptr<UniformRandomVariable> x = CreateObject<UniformRandomVariable> ();
+      Ptr<UniformRandomVariable> y = CreateObject<UniformRandomVariable> ();
+      x->SetStream (1);
+      y->SetStream (1);
+      x->SetAttribute ("Antithetic", BooleanValue (antithetic));
+      y->SetAttribute ("Antithetic", BooleanValue (antithetic));
+      x->SetAttribute ("Min", DoubleValue (-3.0));
+      x->SetAttribute ("Max", DoubleValue (5.0));
+      std::vector<double> values (size);
+      x->GetValues (values.data (), values.size ());
+      for (double value : values)
+        {
+          NS_TEST_ASSERT_MSG_EQ (value, y->GetValue (-3.0, 5.0), "Different uniform values in a block");
+        }
+      x->GetValues (10.0, 20.0, values.data (), values.size ());
+      for (double value : values)
+        {
+          NS_TEST_ASSERT_MSG_EQ (value, y->GetValue (10.0, 20.0), "Different uniform values in a block");
+        }
+    }
+
+  Ptr<NormalRandomVariable> x = CreateObject<NormalRandomVariable> ();
+  Ptr<NormalRandomVariable> y = CreateObject<NormalRandomVariable> ();
+  x->SetStream (2);
+  y->SetStream (2);
+  std::vector<double> values (size + 1);
+  x->GetValues (values.data (), values.size ());
+  for (double value : values)
+    {
+      NS_TEST_ASSERT_MSG_EQ (value, y->GetValue (), "Different normal values in a block");
+    }
+}
+
+
+/**
+ * \ingroup rng-stream-tests
+ * RngStream test suite.
+ */
+class RngStreamTestSuite : public TestSuite
+{
+public:
+  RngStreamTestSuite ()
+    : TestSuite ("rng-stream")
+  {
+    AddTestCase (new RngStreamGoldenTestCase ());
+    AddTestCase (new RngStreamBlockTestCase ());
+  }
+};
+
+/**
+ * \ingroup rng-stream-tests
+ * RngStreamTestSuite instance variable.
+ */
+static RngStreamTestSuite g_rngStreamTestSuite;
+
+
+}    // namespace tests
+
+}  // namespace ns3
@@ -19,6 +19,7 @@
 #include "ns3/test.h"
 #include "ns3/traced-callback.h"
 #include "ns3/unused.h"
+#include <vector>
 
 using namespace ns3;
 
@@ -113,6 +114,217 @@ BasicTracedCallbackTestCase::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ (m_two, true, "Callback CbTwo not called");
 }
 
+class OrderTracedCallbackTestCase : public TestCase
+{
+public:
+  OrderTracedCallbackTestCase ();
+  virtual ~OrderTracedCallbackTestCase ()
+  {}
+
+private:
+  virtual void DoRun (void);
+
+  void Cb (uint32_t id, uint32_t value);
+  void CbConnect (uint32_t value);
+  Callback<void, uint32_t> MakeCb (uint32_t id);
+
+  std::vector<uint32_t> m_calls;
+  TracedCallback<uint32_t> m_trace;
+};
+
+OrderTracedCallbackTestCase::OrderTracedCallbackTestCase ()
+  : TestCase ("Check the order of the TracedCallback chain")
+{}
+
+void
+OrderTracedCallbackTestCase::Cb (uint32_t id, uint32_t value)
+{
+  NS_UNUSED (value);
+  m_calls.push_back (id);
+}
+
+Callback<void, uint32_t>
+OrderTracedCallbackTestCase::MakeCb (uint32_t id)
+{
+  return MakeCallback (&OrderTracedCallbackTestCase::Cb, this).Bind (id);
+}
+
+void
+OrderTracedCallbackTestCase::CbConnect (uint32_t value)
+{
+  NS_UNUSED (value);
+  m_calls.push_back (0);
+  m_trace.ConnectWithoutContext (MakeCb (9));
+}
+
+void
+OrderTracedCallbackTestCase::DoRun (void)
+{
+  NS_TEST_ASSERT_MSG_EQ (m_trace.IsEmpty (), true, "Chain not empty");
+  m_trace (1);
+
+  //
+  // The callbacks must be called in the order they were connected
+  //
+  for (uint32_t id = 1; id <= 3; ++id)
+    {
+      m_trace.ConnectWithoutContext (MakeCb (id));
+    }
+  NS_TEST_ASSERT_MSG_EQ (m_trace.IsEmpty (), false, "Chain empty");
+  m_calls.clear ();
+  m_trace (1);
+  NS_TEST_ASSERT_MSG_EQ (m_calls.size (), 3, "Unexpected number of calls");
+  NS_TEST_EXPECT_MSG_EQ (m_calls[0], 1, "Unexpected order of calls");
+  NS_TEST_EXPECT_MSG_EQ (m_calls[1], 2, "Unexpected order of calls");
+  NS_TEST_EXPECT_MSG_EQ (m_calls[2], 3, "Unexpected order of calls");
+
+  //
+  // Disconnecting the first callback must keep the order of the others
+  //
+  m_trace.DisconnectWithoutContext (MakeCb (1));
+  m_trace.ConnectWithoutContext (MakeCb (4));
+  m_calls.clear ();
+  m_trace (1);
+  NS_TEST_ASSERT_MSG_EQ (m_calls.size (), 3, "Unexpected number of calls");
+  NS_TEST_EXPECT_MSG_EQ (m_calls[0], 2, "Unexpected order of calls");
+  NS_TEST_EXPECT_MSG_EQ (m_calls[1], 3, "Unexpected order of calls");
+  NS_TEST_EXPECT_MSG_EQ (m_calls[2], 4, "Unexpected order of calls");
+
+  m_trace.DisconnectWithoutContext (MakeCb (2));
+  m_trace.DisconnectWithoutContext (MakeCb (3));
+  m_trace.DisconnectWithoutContext (MakeCb (4));
+  NS_TEST_ASSERT_MSG_EQ (m_trace.IsEmpty (), true, "Chain not empty");
+
+  //
+  // A callback may connect another callback, which is called from the
+  // next time on
+  //
+  m_trace.ConnectWithoutContext (MakeCallback (&OrderTracedCallbackTestCase::CbConnect, this));
+  m_trace.ConnectWithoutContext (MakeCb (1));
+  m_calls.clear ();
+  m_trace (1);
+  NS_TEST_ASSERT_MSG_EQ (m_calls.size (), 2, "Unexpected number of calls");
+  NS_TEST_EXPECT_MSG_EQ (m_calls[0], 0, "Unexpected order of calls");
+  NS_TEST_EXPECT_MSG_EQ (m_calls[1], 1, "Unexpected order of calls");
+  m_calls.clear ();
+  m_trace (1);
+  NS_TEST_ASSERT_MSG_EQ (m_calls.size (), 3, "Unexpected number of calls");
+  NS_TEST_EXPECT_MSG_EQ (m_calls[0], 0, "Unexpected order of calls");
+  NS_TEST_EXPECT_MSG_EQ (m_calls[1], 1, "Unexpected order of calls");
+  NS_TEST_EXPECT_MSG_EQ (m_calls[2], 9, "Unexpected order of calls");
+}
+
+class ReentrantTracedCallbackTestCase : public TestCase
+{
+public:
+  ReentrantTracedCallbackTestCase ();
+  virtual ~ReentrantTracedCallbackTestCase ()
+  {}
+
+private:
+  virtual void DoRun (void);
+
+  void Cb (uint32_t id, uint32_t value);
+  void CbConnectMany (uint32_t value);
+  void CbDisconnectSelf (uint32_t value);
+  void CbDisconnectNext (uint32_t value);
+  Callback<void, uint32_t> MakeCb (uint32_t id);
+
+  std::vector<uint32_t> m_calls;
+  TracedCallback<uint32_t> m_trace;
+};
+
+ReentrantTracedCallbackTestCase::ReentrantTracedCallbackTestCase ()
+  : TestCase ("Check the callbacks connecting and disconnecting callbacks")
+{}
+
+void
+ReentrantTracedCallbackTestCase::Cb (uint32_t id, uint32_t value)
+{
+  NS_UNUSED (value);
+  m_calls.push_back (id);
+}
+
+Callback<void, uint32_t>
+ReentrantTracedCallbackTestCase::MakeCb (uint32_t id)
+{
+  return MakeCallback (&ReentrantTracedCallbackTestCase::Cb, this).Bind (id);
+}
+
+void
+ReentrantTracedCallbackTestCase::CbConnectMany (uint32_t value)
+{
+  m_calls.push_back (1);
+  if (value == 1)
+    {
+      // enough callbacks to outgrow any storage of the chain
+      for (uint32_t id = 100; id < 120; ++id)
+        {
+          m_trace.ConnectWithoutContext (MakeCb (id));
+        }
+    }
+}
+
+void
+ReentrantTracedCallbackTestCase::CbDisconnectSelf (uint32_t value)
+{
+  NS_UNUSED (value);
+  m_calls.push_back (2);
+  m_trace.DisconnectWithoutContext (MakeCallback (&ReentrantTracedCallbackTestCase::CbDisconnectSelf, this));
+}
+
+void
+ReentrantTracedCallbackTestCase::CbDisconnectNext (uint32_t value)
+{
+  NS_UNUSED (value);
+  m_calls.push_back (3);
+  m_trace.DisconnectWithoutContext (MakeCb (4));
+}
+
+void
+ReentrantTracedCallbackTestCase::DoRun (void)
+{
+  m_trace.ConnectWithoutContext (MakeCallback (&ReentrantTracedCallbackTestCase::CbConnectMany, this));
+  m_trace.ConnectWithoutContext (MakeCallback (&ReentrantTracedCallbackTestCase::CbDisconnectSelf, this));
+  m_trace.ConnectWithoutContext (MakeCallback (&ReentrantTracedCallbackTestCase::CbDisconnectNext, this));
+  m_trace.ConnectWithoutContext (MakeCb (4));
+  TracedCallback<uint32_t> copy = m_trace;
+
+  //
+  // The callbacks invoked are those connected when the trace is fired
+  //
+  m_trace (1);
+  NS_TEST_ASSERT_MSG_EQ (m_calls.size (), 4, "Unexpected number of calls");
+  for (uint32_t i = 0; i < 4; ++i)
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_calls[i], i + 1, "Unexpected order of calls");
+    }
+
+  //
+  // The changes made by the callbacks apply from the next time on
+  //
+  m_calls.clear ();
+  m_trace (2);
+  NS_TEST_ASSERT_MSG_EQ (m_calls.size (), 22, "Unexpected number of calls");
+  NS_TEST_EXPECT_MSG_EQ (m_calls[0], 1, "Unexpected order of calls");
+  NS_TEST_EXPECT_MSG_EQ (m_calls[1], 3, "Unexpected order of calls");
+  for (uint32_t i = 0; i < 20; ++i)
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_calls[2 + i], 100 + i, "Unexpected order of calls");
+    }
+
+  //
+  // The changes do not apply to a copy of the TracedCallback
+  //
+  m_calls.clear ();
+  copy.DisconnectWithoutContext (MakeCallback (&ReentrantTracedCallbackTestCase::CbConnectMany, this));
+  copy (2);
+  NS_TEST_ASSERT_MSG_EQ (m_calls.size (), 3, "Unexpected number of calls");
+  NS_TEST_EXPECT_MSG_EQ (m_calls[0], 2, "Unexpected order of calls");
+  NS_TEST_EXPECT_MSG_EQ (m_calls[1], 3, "Unexpected order of calls");
+  NS_TEST_EXPECT_MSG_EQ (m_calls[2], 4, "Unexpected order of calls");
+}
+
 class TracedCallbackTestSuite : public TestSuite
 {
 public:
@@ -123,6 +335,8 @@ TracedCallbackTestSuite::TracedCallbackTestSuite ()
   : TestSuite ("traced-callback", UNIT)
 {
   AddTestCase (new BasicTracedCallbackTestCase, TestCase::QUICK);
+  AddTestCase (new OrderTracedCallbackTestCase, TestCase::QUICK);
+  AddTestCase (new ReentrantTracedCallbackTestCase, TestCase::QUICK);
 }
 
 static TracedCallbackTestSuite tracedCallbackTestSuite;
@@ -25,6 +25,7 @@
 #include "ns3/integer.h"
 #include "ns3/double.h"
 #include "ns3/object.h"
+#include "ns3/config.h"
 #include "ns3/traced-value.h"
 #include "ns3/type-id.h"
 #include "ns3/test.h"
@@ -334,6 +335,112 @@ DeprecatedAttributeTestCase::DoRun (void)
 }
 
 
+//----------------------------
+//
+// Inherited Attribute test
+
+class InheritedAttribute : public DeprecatedAttribute
+{
+private:
+  int m_derived;
+  TracedValue<double> m_derivedTrace;
+
+public:
+  InheritedAttribute ()
+    : m_derived (0)
+  {}
+  virtual ~InheritedAttribute ()
+  {}
+
+  int GetDerived (void) const
+  {
+    return m_derived;
+  }
+
+  // Register a type with an Attribute and a TraceSource, and inherit
+  // those of DeprecatedAttribute
+  static TypeId GetTypeId (void)
+  {
+    static TypeId tid = TypeId ("InheritedAttribute")
+      .SetParent<DeprecatedAttribute> ()
+      .AddConstructor<InheritedAttribute> ()
+      .AddAttribute ("derived",
+                     "the derived Attribute",
+                     IntegerValue (2),
+                     MakeIntegerAccessor (&InheritedAttribute::m_derived),
+                     MakeIntegerChecker<int> ())
+      .AddTraceSource ("derivedTrace",
+                       "the derived TraceSource",
+                       MakeTraceSourceAccessor (&InheritedAttribute::m_derivedTrace),
+                       "ns3::TracedValueCallback::Double");
+    return tid;
+  }
+};
+
+
+class InheritedAttributeTestCase : public TestCase
+{
+public:
+  InheritedAttributeTestCase ();
+  virtual ~InheritedAttributeTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+};
+
+InheritedAttributeTestCase::InheritedAttributeTestCase ()
+  : TestCase ("Check the lookup of inherited Attributes and TraceSources")
+{}
+
+InheritedAttributeTestCase::~InheritedAttributeTestCase ()
+{}
+
+void
+InheritedAttributeTestCase::DoRun (void)
+{
+  TypeId tid = InheritedAttribute::GetTypeId ();
+
+  struct TypeId::AttributeInformation ainfo;
+  NS_TEST_ASSERT_MSG_EQ (tid.LookupAttributeByName ("derived", &ainfo), true,
+                         "lookup derived attribute");
+  NS_TEST_ASSERT_MSG_EQ (tid.LookupAttributeByName ("attribute", &ainfo), true,
+                         "lookup inherited attribute");
+  NS_TEST_ASSERT_MSG_EQ (ainfo.name, "attribute", "wrong inherited attribute");
+  NS_TEST_ASSERT_MSG_EQ (tid.LookupAttributeByName ("missing", &ainfo), false,
+                         "lookup missing attribute");
+
+  struct TypeId::TraceSourceInformation tinfo;
+  NS_TEST_ASSERT_MSG_NE (tid.LookupTraceSourceByName ("derivedTrace", &tinfo), 0,
+                         "lookup derived trace source");
+  NS_TEST_ASSERT_MSG_NE (tid.LookupTraceSourceByName ("trace", &tinfo), 0,
+                         "lookup inherited trace source");
+  NS_TEST_ASSERT_MSG_EQ (tid.LookupTraceSourceByName ("missing"), 0,
+                         "lookup missing trace source");
+
+  // The Attributes of the TypeId come first, followed by those of its parents
+  Ptr<const TypeId::ConstructionInformation> construction = tid.GetConstructionInformation ();
+  NS_TEST_ASSERT_MSG_EQ (construction->attributes.size (),
+                         tid.GetAttributeN () + DeprecatedAttribute::GetTypeId ().GetAttributeN ()
+                         + Object::GetTypeId ().GetAttributeN (),
+                         "wrong number of attributes");
+  NS_TEST_ASSERT_MSG_EQ (construction->attributes[0].name, "derived", "wrong first attribute");
+  NS_TEST_ASSERT_MSG_EQ (construction->tidNames[0], "InheritedAttribute", "wrong first TypeId");
+  NS_TEST_ASSERT_MSG_EQ (construction->attributes[1].name, "attribute", "wrong second attribute");
+  NS_TEST_ASSERT_MSG_EQ (construction->tidNames[1], "DeprecatedAttribute", "wrong second TypeId");
+
+  // Changing an initial value rebuilds the information
+  Ptr<InheritedAttribute> object = CreateObject<InheritedAttribute> ();
+  NS_TEST_ASSERT_MSG_EQ (object->GetDerived (), 2, "wrong initial value");
+  Config::SetDefault ("InheritedAttribute::derived", IntegerValue (3));
+  object = CreateObject<InheritedAttribute> ();
+  NS_TEST_ASSERT_MSG_EQ (object->GetDerived (), 3, "initial value not updated");
+  NS_TEST_ASSERT_MSG_NE (tid.GetConstructionInformation (), construction,
+                         "construction information not rebuilt");
+  Config::SetDefault ("InheritedAttribute::derived", IntegerValue (2));
+}
+
+
 //----------------------------
 //
 // Performance test
@@ -447,6 +554,7 @@ TypeIdTestSuite::TypeIdTestSuite ()
   AddTestCase (new UniqueTypeIdTestCase, QUICK);
   AddTestCase (new CollisionTestCase, QUICK);
   AddTestCase (new DeprecatedAttributeTestCase, QUICK);
+  AddTestCase (new InheritedAttributeTestCase, QUICK);
 }
 
 static TypeIdTestSuite g_TypeIdTestSuite;
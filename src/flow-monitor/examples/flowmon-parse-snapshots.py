@@ -0,0 +1,108 @@
+from __future__ import division
+import sys
+import struct
+
+## Magic string at the beginning of a snapshot file
+SNAPSHOT_MAGIC = b'NS3FMONS'
+
+## Columns of a snapshot: (name, struct format of one value)
+COLUMNS = [
+    ('flowId', 'I'),
+    ('txBytes', 'Q'),
+    ('rxBytes', 'Q'),
+    ('txPackets', 'I'),
+    ('rxPackets', 'I'),
+    ('lostPackets', 'I'),
+    ('delaySum', 'q'),
+    ('jitterSum', 'q'),
+]
+
+
+## Snapshot
+class Snapshot(object):
+    ## class variables
+    ## @var time
+    #  simulation time of the snapshot, in nanoseconds
+    ## @var flows
+    #  dictionary flowId -> dictionary of the counter deltas of the flow
+    ## @var __slots_
+    #  class variable list
+    __slots_ = ['time', 'flows']
+    def __init__(self, time, columns):
+        '''! The initializer.
+        @param self The object pointer.
+        @param time The simulation time of the snapshot, in nanoseconds.
+        @param columns The dictionary column name -> tuple of values.
+        '''
+        self.time = time
+        self.flows = {}
+        for i, flowId in enumerate(columns['flowId']):
+            self.flows[flowId] = dict((name, columns[name][i]) for name, _ in COLUMNS[1:])
+
+
+def read_exactly(f, size):
+    '''! Read a given number of bytes.
+    @param f The file.
+    @param size The number of bytes.
+    @returns The bytes read, or None at the end of the file.
+    '''
+    data = f.read(size)
+    if len(data) == 0:
+        return None
+    if len(data) != size:
+        raise ValueError("truncated snapshot file")
+    return data
+
+
+def parse_snapshots(f):
+    '''! Parse a file written by FlowMonitor::EnablePeriodicSnapshots.
+    @param f The file, opened in binary mode.
+    @returns The snapshot interval in nanoseconds and the list of snapshots.
+    '''
+    magic = read_exactly(f, 8)
+    if magic != SNAPSHOT_MAGIC:
+        raise ValueError("not a FlowMonitor snapshot file")
+    version, interval = struct.unpack('<Iq', read_exactly(f, 12))
+    if version != 1:
+        raise ValueError("unsupported snapshot file version %i" % version)
+
+    snapshots = []
+    while True:
+        header = read_exactly(f, 12)
+        if header is None:
+            break
+        time, n = struct.unpack('<qI', header)
+        columns = {}
+        for name, fmt in COLUMNS:
+            size = struct.calcsize('<' + fmt)
+            columns[name] = struct.unpack('<%i%s' % (n, fmt), read_exactly(f, n * size) if n else b'')
+        snapshots.append(Snapshot(time, columns))
+    return interval, snapshots
+
+
+def main(argv):
+    with open(argv[1], 'rb') as f:
+        interval, snapshots = parse_snapshots(f)
+
+    print("Snapshot interval: %.3f s" % (interval * 1e-9))
+    previous = 0
+    for snapshot in snapshots:
+        duration = (snapshot.time - previous) * 1e-9
+        previous = snapshot.time
+        print("Time %.3f s" % (snapshot.time * 1e-9))
+        for flowId in sorted(snapshot.flows):
+            flow = snapshot.flows[flowId]
+            if duration > 0:
+                throughput = "%.2f Kbps" % (flow['rxBytes'] * 8.0 / duration / 1024)
+            else:
+                throughput = "None"
+            if flow['rxPackets']:
+                delay = "%.4f s" % (flow['delaySum'] * 1e-9 / flow['rxPackets'])
+            else:
+                delay = "None"
+            print("\tFlowID: %i\tTX packets: %i\tRX packets: %i\tLost packets: %i\tRX bitrate: %s\tMean Delay: %s"
+                  % (flowId, flow['txPackets'], flow['rxPackets'], flow['lostPackets'], throughput, delay))
+
+
+if __name__ == '__main__':
+    main(sys.argv)
@@ -31,6 +31,32 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("FlowMonitor");
 
+namespace {
+
+/// Magic string at the beginning of a snapshot file
+const char SNAPSHOT_MAGIC[8] = { 'N', 'S', '3', 'F', 'M', 'O', 'N', 'S' };
+/// Version of the snapshot file format
+const uint32_t SNAPSHOT_VERSION = 1;
+
+/**
+ * Write an integer to a stream, in little-endian byte order
+ * \param os the output stream
+ * \param value the value to write
+ * \param size the number of bytes to write
+ */
+void
+WriteLittleEndian (std::ostream &os, uint64_t value, uint32_t size)
+{
+  char buf[8];
+  for (uint32_t i = 0; i < size; i++)
+    {
+      buf[i] = static_cast<char> (value >> (8 * i));
+    }
+  os.write (buf, size);
+}
+
+} // unnamed namespace
+
 NS_OBJECT_ENSURE_REGISTERED (FlowMonitor);
 
 TypeId 
@@ -91,6 +117,8 @@ FlowMonitor::DoDispose (void)
   NS_LOG_FUNCTION (this);
   Simulator::Cancel (m_startEvent);
   Simulator::Cancel (m_stopEvent);
+  Simulator::Cancel (m_snapshotDestroyEvent);
+  FinishSnapshots ();
   for (std::list<Ptr<FlowClassifier> >::iterator iter = m_classifiers.begin ();
       iter != m_classifiers.end ();
       iter ++)
@@ -105,13 +133,19 @@ FlowMonitor::DoDispose (void)
   Object::DoDispose ();
 }
 
+size_t
+FlowMonitor::TrackedPacketKeyHash::operator() (const std::pair<FlowId, FlowPacketId> &key) const
+{
+  return std::hash<uint64_t> () ((static_cast<uint64_t> (key.first) << 32) | key.second);
+}
+
 inline FlowMonitor::FlowStats&
 FlowMonitor::GetStatsForFlow (FlowId flowId)
 {
   NS_LOG_FUNCTION (this);
-  FlowStatsContainerI iter;
-  iter = m_flowStats.find (flowId);
-  if (iter == m_flowStats.end ())
+  std::unordered_map<FlowId, FlowStats *>::iterator iter;
+  iter = m_flowStatsIndex.find (flowId);
+  if (iter == m_flowStatsIndex.end ())
     {
       FlowMonitor::FlowStats &ref = m_flowStats[flowId];
       ref.delaySum = Seconds (0);
@@ -127,11 +161,13 @@ FlowMonitor::GetStatsForFlow (FlowId flowId)
       ref.jitterHistogram.SetDefaultBinWidth (m_jitterBinWidth);
       ref.packetSizeHistogram.SetDefaultBinWidth (m_packetSizeBinWidth);
       ref.flowInterruptionsHistogram.SetDefaultBinWidth (m_flowInterruptionsBinWidth);
+      // std::map never moves its elements, so the index can keep a pointer
+      m_flowStatsIndex[flowId] = &ref;
       return ref;
     }
   else
     {
-      return iter->second;
+      return *iter->second;
     }
 }
 
@@ -311,12 +347,12 @@ FlowMonitor::CheckForLostPackets (Time maxDelay)
       if (now - iter->second.lastSeenTime >= maxDelay)
         {
           // packet is considered lost, add it to the loss statistics
-          FlowStatsContainerI flow = m_flowStats.find (iter->first.first);
-          NS_ASSERT (flow != m_flowStats.end ());
-          flow->second.lostPackets++;
+          std::unordered_map<FlowId, FlowStats *>::iterator flow = m_flowStatsIndex.find (iter->first.first);
+          NS_ASSERT (flow != m_flowStatsIndex.end ());
+          flow->second->lostPackets++;
 
           // we won't track it anymore
-          m_trackedPackets.erase (iter++);
+          iter = m_trackedPackets.erase (iter);
         }
       else
         {
@@ -393,6 +429,11 @@ FlowMonitor::StartRightNow ()
       return;
     }
   m_enabled = true;
+  m_snapshotStart = Simulator::Now ();
+  if (m_snapshotFile.is_open ())
+    {
+      ScheduleSnapshot ();
+    }
 }
 
 
@@ -407,6 +448,12 @@ FlowMonitor::StopRightNow ()
     }
   m_enabled = false;
   CheckForLostPackets ();
+  if (m_snapshotFile.is_open ())
+    {
+      // the counters will not change anymore: write what is left and stop
+      Simulator::Cancel (m_snapshotEvent);
+      WriteSnapshot ();
+    }
 }
 
 void
@@ -523,5 +570,153 @@ FlowMonitor::SerializeToXmlFile (std::string fileName, bool enableHistograms, bo
 }
 
 
-} // namespace ns3
+void
+FlowMonitor::EnablePeriodicSnapshots (std::string fileName, Time interval)
+{
+  NS_LOG_FUNCTION (this << fileName << interval.As (Time::S));
+  NS_ASSERT_MSG (interval.IsStrictlyPositive (), "The snapshot interval must be positive");
+
+  Simulator::Cancel (m_snapshotEvent);
+  if (m_snapshotFile.is_open ())
+    {
+      m_snapshotFile.close ();
+    }
+  m_snapshotFile.open (fileName.c_str (), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!m_snapshotFile.is_open ())
+    {
+      NS_FATAL_ERROR ("Could not open snapshot file " << fileName);
+    }
+
+  // file header: magic, version, snapshot interval (ns)
+  m_snapshotFile.write (SNAPSHOT_MAGIC, sizeof (SNAPSHOT_MAGIC));
+  WriteLittleEndian (m_snapshotFile, SNAPSHOT_VERSION, 4);
+  WriteLittleEndian (m_snapshotFile, interval.GetNanoSeconds (), 8);
+  m_snapshotFile.flush ();
+
+  m_snapshotState.clear ();
+  m_snapshotInterval = interval;
+  // otherwise the snapshots are scheduled when the monitor starts
+  if (m_enabled)
+    {
+      ScheduleSnapshot ();
+    }
+  Simulator::Cancel (m_snapshotDestroyEvent);
+  m_snapshotDestroyEvent = Simulator::ScheduleDestroy (&FlowMonitor::FinishSnapshots, this);
+}
+
+void
+FlowMonitor::ScheduleSnapshot ()
+{
+  NS_LOG_FUNCTION (this);
+  // the snapshots are taken every interval since the monitor started
+  int64_t elapsed = (Simulator::Now () - m_snapshotStart).GetTimeStep ();
+  int64_t interval = m_snapshotInterval.GetTimeStep ();
+  Time delay = TimeStep ((elapsed / interval + 1) * interval - elapsed);
+  Simulator::Cancel (m_snapshotEvent);
+  m_snapshotEvent = Simulator::Schedule (delay, &FlowMonitor::PeriodicSnapshot, this);
+}
 
+void
+FlowMonitor::FinishSnapshots ()
+{
+  NS_LOG_FUNCTION (this);
+  Simulator::Cancel (m_snapshotEvent);
+  if (m_snapshotFile.is_open ())
+    {
+      // a stopped monitor already wrote its last snapshot
+      if (m_enabled)
+        {
+          WriteSnapshot ();
+        }
+      m_snapshotFile.close ();
+    }
+}
+
+void
+FlowMonitor::PeriodicSnapshot ()
+{
+  NS_LOG_FUNCTION (this);
+  WriteSnapshot ();
+  m_snapshotEvent = Simulator::Schedule (m_snapshotInterval, &FlowMonitor::PeriodicSnapshot, this);
+}
+
+void
+FlowMonitor::WriteSnapshot ()
+{
+  NS_LOG_FUNCTION (this);
+
+  std::vector<FlowId> flowIds;
+  std::vector<SnapshotState> deltas;
+  for (FlowStatsContainerCI flowI = m_flowStats.begin ();
+       flowI != m_flowStats.end (); flowI++)
+    {
+      const FlowStats &stats = flowI->second;
+      SnapshotState &last = m_snapshotState[flowI->first];
+      if (stats.txPackets == last.txPackets
+          && stats.rxPackets == last.rxPackets
+          && stats.lostPackets == last.lostPackets)
+        {
+          continue;
+        }
+
+      SnapshotState delta;
+      delta.txBytes = stats.txBytes - last.txBytes;
+      delta.rxBytes = stats.rxBytes - last.rxBytes;
+      delta.txPackets = stats.txPackets - last.txPackets;
+      delta.rxPackets = stats.rxPackets - last.rxPackets;
+      delta.lostPackets = stats.lostPackets - last.lostPackets;
+      delta.delaySum = stats.delaySum - last.delaySum;
+      delta.jitterSum = stats.jitterSum - last.jitterSum;
+      flowIds.push_back (flowI->first);
+      deltas.push_back (delta);
+
+      last.txBytes = stats.txBytes;
+      last.rxBytes = stats.rxBytes;
+      last.txPackets = stats.txPackets;
+      last.rxPackets = stats.rxPackets;
+      last.lostPackets = stats.lostPackets;
+      last.delaySum = stats.delaySum;
+      last.jitterSum = stats.jitterSum;
+    }
+
+  // snapshot header: time (ns), number of flows; then one column per counter
+  uint32_t n = flowIds.size ();
+  WriteLittleEndian (m_snapshotFile, Simulator::Now ().GetNanoSeconds (), 8);
+  WriteLittleEndian (m_snapshotFile, n, 4);
+  for (uint32_t i = 0; i < n; i++)
+    {
+      WriteLittleEndian (m_snapshotFile, flowIds[i], 4);
+    }
+  for (uint32_t i = 0; i < n; i++)
+    {
+      WriteLittleEndian (m_snapshotFile, deltas[i].txBytes, 8);
+    }
+  for (uint32_t i = 0; i < n; i++)
+    {
+      WriteLittleEndian (m_snapshotFile, deltas[i].rxBytes, 8);
+    }
+  for (uint32_t i = 0; i < n; i++)
+    {
+      WriteLittleEndian (m_snapshotFile, deltas[i].txPackets, 4);
+    }
+  for (uint32_t i = 0; i < n; i++)
+    {
+      WriteLittleEndian (m_snapshotFile, deltas[i].rxPackets, 4);
+    }
+  for (uint32_t i = 0; i < n; i++)
+    {
+      WriteLittleEndian (m_snapshotFile, deltas[i].lostPackets, 4);
+    }
+  for (uint32_t i = 0; i < n; i++)
+    {
+      WriteLittleEndian (m_snapshotFile, deltas[i].delaySum.GetNanoSeconds (), 8);
+    }
+  for (uint32_t i = 0; i < n; i++)
+    {
+      WriteLittleEndian (m_snapshotFile, deltas[i].jitterSum.GetNanoSeconds (), 8);
+    }
+  m_snapshotFile.flush ();
+}
+
+
+} // namespace ns3
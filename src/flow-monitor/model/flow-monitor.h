@@ -23,6 +23,8 @@
 
 #include <vector>
 #include <map>
+#include <unordered_map>
+#include <fstream>
 
 #include "ns3/ptr.h"
 #include "ns3/object.h"
@@ -258,6 +260,18 @@ public:
   /// \param enableProbes if true, include also the per-probe/flow pair statistics in the output
   void SerializeToXmlFile (std::string fileName, bool enableHistograms, bool enableProbes);
 
+  /// Periodically write the per-flow counters accumulated since the previous
+  /// snapshot to a compact binary file, flushed after each snapshot.  The
+  /// snapshots are taken every interval since the monitor started, and when
+  /// it stops or is disposed of.  Only the flows that changed during the
+  /// interval are written, and the histograms are not included.  The file
+  /// format is described in the model
+  /// documentation; src/flow-monitor/examples/flowmon-parse-snapshots.py
+  /// can be used to read it.
+  /// \param fileName name or path of the output file that will be created
+  /// \param interval the time between two snapshots
+  void EnablePeriodicSnapshots (std::string fileName, Time interval);
+
 
 protected:
 
@@ -274,11 +288,35 @@ private:
     uint32_t timesForwarded; //!< number of times the packet was reportedly forwarded
   };
 
+  /// Hash function for the (FlowId,PacketId) key of the tracked packets
+  class TrackedPacketKeyHash
+  {
+  public:
+    /// Hash function
+    /// \param key the (FlowId,PacketId) pair
+    /// \return the hash of the key
+    size_t operator() (const std::pair<FlowId, FlowPacketId> &key) const;
+  };
+
+  /// Cumulative counters of a flow at the time of the last snapshot
+  struct SnapshotState
+  {
+    uint64_t txBytes;     //!< Total transmitted bytes
+    uint64_t rxBytes;     //!< Total received bytes
+    uint32_t txPackets;   //!< Total transmitted packets
+    uint32_t rxPackets;   //!< Total received packets
+    uint32_t lostPackets; //!< Total lost packets
+    Time delaySum;        //!< Sum of all end-to-end delays
+    Time jitterSum;       //!< Sum of all end-to-end delay jitter values
+  };
+
   /// FlowId --> FlowStats
   FlowStatsContainer m_flowStats;
+  /// FlowId --> FlowStats, hashed index of m_flowStats used on the per-packet path
+  std::unordered_map<FlowId, FlowStats *> m_flowStatsIndex;
 
   /// (FlowId,PacketId) --> TrackedPacket
-  typedef std::map< std::pair<FlowId, FlowPacketId>, TrackedPacket> TrackedPacketMap;
+  typedef std::unordered_map< std::pair<FlowId, FlowPacketId>, TrackedPacket, TrackedPacketKeyHash> TrackedPacketMap;
   TrackedPacketMap m_trackedPackets; //!< Tracked packets
   Time m_maxPerHopDelay; //!< Minimum per-hop delay
   FlowProbeContainer m_flowProbes; //!< all the FlowProbes
@@ -295,6 +333,13 @@ private:
   double m_flowInterruptionsBinWidth; //!< Flow interruptions bin width (for histograms)
   Time m_flowInterruptionsMinTime; //!< Flow interruptions minimum time
 
+  std::ofstream m_snapshotFile;  //!< Output file of the periodic snapshots
+  Time m_snapshotInterval;       //!< Time between two snapshots
+  Time m_snapshotStart;          //!< Time the monitor started, to which the snapshots are aligned
+  EventId m_snapshotEvent;       //!< Next snapshot event
+  EventId m_snapshotDestroyEvent; //!< Event writing the last snapshot when the simulator is destroyed
+  std::unordered_map<FlowId, SnapshotState> m_snapshotState; //!< Flow counters at the last snapshot
+
   /// Get the stats for a given flow
   /// \param flowId the Flow identification
   /// \returns the stats of the flow
@@ -302,6 +347,20 @@ private:
 
   /// Periodic function to check for lost packets and prune statistics
   void PeriodicCheckForLostPackets ();
+
+  /// Write to the snapshot file the changes of the flows since the last snapshot
+  void WriteSnapshot ();
+
+  /// Write a snapshot and schedule the next one
+  void PeriodicSnapshot ();
+
+  /// Schedule the next snapshot, a whole number of intervals after the
+  /// monitor started
+  void ScheduleSnapshot ();
+
+  /// Write the last snapshot, unless the monitor was stopped, and close the
+  /// snapshot file
+  void FinishSnapshots ();
 };
 
 
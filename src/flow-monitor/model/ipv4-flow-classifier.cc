@@ -95,6 +95,17 @@ bool operator == (const Ipv4FlowClassifier::FiveTuple &t1,
 }
 
 
+size_t
+Ipv4FlowClassifier::FiveTupleHash::operator() (const FiveTuple &t) const
+{
+  size_t h = Ipv4AddressHash () (t.sourceAddress);
+  h ^= Ipv4AddressHash () (t.destinationAddress) + 0x9e3779b9 + (h << 6) + (h >> 2);
+  uint64_t rest = (static_cast<uint64_t> (t.protocol) << 32)
+    | (static_cast<uint64_t> (t.sourcePort) << 16) | t.destinationPort;
+  h ^= std::hash<uint64_t> () (rest) + 0x9e3779b9 + (h << 6) + (h >> 2);
+  return h;
+}
+
 
 Ipv4FlowClassifier::Ipv4FlowClassifier ()
 {
@@ -148,7 +159,7 @@ Ipv4FlowClassifier::Classify (const Ipv4Header &ipHeader, Ptr<const Packet> ipPa
   tuple.destinationPort = dstPort;
 
   // try to insert the tuple, but check if it already exists
-  std::pair<std::map<FiveTuple, FlowId>::iterator, bool> insert
+  std::pair<std::unordered_map<FiveTuple, FlowId, FiveTupleHash>::iterator, bool> insert
     = m_flowMap.insert (std::pair<FiveTuple, FlowId> (tuple, 0));
 
   // if the insertion succeeded, we need to assign this tuple a new flow identifier
@@ -157,7 +168,6 @@ Ipv4FlowClassifier::Classify (const Ipv4Header &ipHeader, Ptr<const Packet> ipPa
       FlowId newFlowId = GetNewFlowId ();
       insert.first->second = newFlowId;
       m_flowPktIdMap[newFlowId] = 0;
-      m_flowDscpMap[newFlowId];
     }
   else
     {
@@ -165,15 +175,7 @@ Ipv4FlowClassifier::Classify (const Ipv4Header &ipHeader, Ptr<const Packet> ipPa
     }
 
   // increment the counter of packets with the same DSCP value
-  Ipv4Header::DscpType dscp = ipHeader.GetDscp ();
-  std::pair<std::map<Ipv4Header::DscpType, uint32_t>::iterator, bool> dscpInserter
-    = m_flowDscpMap[insert.first->second].insert (std::pair<Ipv4Header::DscpType, uint32_t> (dscp, 1));
-
-  // if the insertion did not succeed, we need to increment the counter
-  if (!dscpInserter.second)
-    {
-      m_flowDscpMap[insert.first->second][dscp] ++;
-    }
+  m_flowDscpMap[insert.first->second][ipHeader.GetDscp ()] ++;
 
   *out_flowId = insert.first->second;
   *out_packetId = m_flowPktIdMap[*out_flowId];
@@ -185,7 +187,7 @@ Ipv4FlowClassifier::Classify (const Ipv4Header &ipHeader, Ptr<const Packet> ipPa
 Ipv4FlowClassifier::FiveTuple
 Ipv4FlowClassifier::FindFlow (FlowId flowId) const
 {
-  for (std::map<FiveTuple, FlowId>::const_iterator
+  for (std::unordered_map<FiveTuple, FlowId, FiveTupleHash>::const_iterator
        iter = m_flowMap.begin (); iter != m_flowMap.end (); iter++)
     {
       if (iter->second == flowId)
@@ -208,7 +210,7 @@ Ipv4FlowClassifier::SortByCount::operator() (std::pair<Ipv4Header::DscpType, uin
 std::vector<std::pair<Ipv4Header::DscpType, uint32_t> >
 Ipv4FlowClassifier::GetDscpCounts (FlowId flowId) const
 {
-  std::map<FlowId, std::map<Ipv4Header::DscpType, uint32_t> >::const_iterator flow
+  std::unordered_map<FlowId, std::map<Ipv4Header::DscpType, uint32_t> >::const_iterator flow
     = m_flowDscpMap.find (flowId);
 
   if (flow == m_flowDscpMap.end ())
@@ -226,9 +228,13 @@ Ipv4FlowClassifier::SerializeToXmlStream (std::ostream &os, uint16_t indent) con
 {
   Indent (os, indent); os << "<Ipv4FlowClassifier>\n";
 
+  // the flows are written ordered by their FiveTuple, as the hashed index has no order
+  std::vector<std::pair<FiveTuple, FlowId> > flows (m_flowMap.begin (), m_flowMap.end ());
+  std::sort (flows.begin (), flows.end ());
+
   indent += 2;
-  for (std::map<FiveTuple, FlowId>::const_iterator
-       iter = m_flowMap.begin (); iter != m_flowMap.end (); iter++)
+  for (std::vector<std::pair<FiveTuple, FlowId> >::const_iterator
+       iter = flows.begin (); iter != flows.end (); iter++)
     {
       Indent (os, indent);
       os << "<Flow flowId=\"" << iter->second << "\""
@@ -239,7 +245,7 @@ Ipv4FlowClassifier::SerializeToXmlStream (std::ostream &os, uint16_t indent) con
          << " destinationPort=\"" << iter->first.destinationPort << "\">\n";
 
       indent += 2;
-      std::map<FlowId, std::map<Ipv4Header::DscpType, uint32_t> >::const_iterator flow
+      std::unordered_map<FlowId, std::map<Ipv4Header::DscpType, uint32_t> >::const_iterator flow
         = m_flowDscpMap.find (iter->second);
 
       if (flow != m_flowDscpMap.end ())
@@ -23,6 +23,7 @@
 
 #include <stdint.h>
 #include <map>
+#include <unordered_map>
 
 #include "ns3/ipv4-header.h"
 #include "ns3/flow-classifier.h"
@@ -92,12 +93,22 @@ public:
 
 private:
 
+  /// Hash function for FiveTuple
+  class FiveTupleHash
+  {
+  public:
+    /// Hash function
+    /// \param t the FiveTuple
+    /// \return the hash of the FiveTuple
+    size_t operator() (const FiveTuple &t) const;
+  };
+
   /// Map to Flows Identifiers to FlowIds
-  std::map<FiveTuple, FlowId> m_flowMap;
+  std::unordered_map<FiveTuple, FlowId, FiveTupleHash> m_flowMap;
   /// Map to FlowIds to FlowPacketId
-  std::map<FlowId, FlowPacketId> m_flowPktIdMap;
+  std::unordered_map<FlowId, FlowPacketId> m_flowPktIdMap;
   /// Map FlowIds to (DSCP value, packet count) pairs
-  std::map<FlowId, std::map<Ipv4Header::DscpType, uint32_t> > m_flowDscpMap;
+  std::unordered_map<FlowId, std::map<Ipv4Header::DscpType, uint32_t> > m_flowDscpMap;
 
 };
 
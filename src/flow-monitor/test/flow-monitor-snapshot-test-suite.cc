@@ -0,0 +1,233 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/flow-monitor.h"
+#include "ns3/flow-probe.h"
+
+using namespace ns3;
+
+/**
+ * \defgroup flow-monitor-test FlowMonitor module tests
+ */
+
+/**
+ * \ingroup flow-monitor-test
+ * \ingroup tests
+ *
+ * \brief Probe reporting the packets given by the test.
+ */
+class SnapshotTestProbe : public FlowProbe
+{
+public:
+  /**
+   * Constructor
+   * \param monitor the FlowMonitor this probe is associated with
+   */
+  SnapshotTestProbe (Ptr<FlowMonitor> monitor)
+    : FlowProbe (monitor)
+  {}
+};
+
+/**
+ * \ingroup flow-monitor-test
+ * \ingroup tests
+ *
+ * \brief FlowMonitor periodic snapshots Test
+ *
+ * The monitor starts at 0.3 s and the simulation stops at 2 s.  A packet
+ * of flow 1 is sent at 0.5 s and received at 0.6 s, another one is sent
+ * at 1.5 s.  The snapshots must be taken at 1.3 s, aligned with the start
+ * of the monitor, and at 2 s, when the monitor is either disposed of or
+ * destroyed with the simulator while still running.
+ */
+class FlowMonitorSnapshotTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   * \param dispose whether the monitor is disposed of before the
+   *        simulator is destroyed
+   */
+  FlowMonitorSnapshotTestCase (bool dispose);
+
+private:
+  virtual void DoRun (void);
+
+  /// A snapshot read back from the file
+  struct Snapshot
+  {
+    uint64_t time;                     //!< Time, in nanoseconds
+    std::vector<uint32_t> flowIds;     //!< Flows
+    std::vector<uint64_t> txBytes;     //!< Transmitted bytes
+    std::vector<uint64_t> rxBytes;     //!< Received bytes
+    std::vector<uint32_t> txPackets;   //!< Transmitted packets
+    std::vector<uint32_t> rxPackets;   //!< Received packets
+    std::vector<uint32_t> lostPackets; //!< Lost packets
+    std::vector<uint64_t> delaySum;    //!< Sum of the delays, in nanoseconds
+    std::vector<uint64_t> jitterSum;   //!< Sum of the jitters, in nanoseconds
+  };
+
+  /**
+   * Read a little-endian integer
+   * \param is the input stream
+   * \param size the number of bytes
+   * \returns the value
+   */
+  static uint64_t ReadLittleEndian (std::istream &is, uint32_t size);
+
+  /**
+   * Read a column of a snapshot
+   * \param is the input stream
+   * \param n the number of values
+   * \param size the number of bytes of each value
+   * \param [out] column the values
+   */
+  template <typename T>
+  static void ReadColumn (std::istream &is, uint32_t n, uint32_t size, std::vector<T> &column);
+
+  bool m_dispose; //!< Whether the monitor is disposed of before the simulator is destroyed
+};
+
+FlowMonitorSnapshotTestCase::FlowMonitorSnapshotTestCase (bool dispose)
+  : TestCase (std::string ("Check the periodic snapshots of a monitor ")
+              + (dispose ? "disposed of" : "destroyed with the simulator")),
+    m_dispose (dispose)
+{
+}
+
+uint64_t
+FlowMonitorSnapshotTestCase::ReadLittleEndian (std::istream &is, uint32_t size)
+{
+  unsigned char buf[8] = { 0 };
+  is.read (reinterpret_cast<char *> (buf), size);
+  uint64_t value = 0;
+  for (uint32_t i = 0; i < size; i++)
+    {
+      value |= static_cast<uint64_t> (buf[i]) << (8 * i);
+    }
+  return value;
+}
+
+template <typename T>
+void
+FlowMonitorSnapshotTestCase::ReadColumn (std::istream &is, uint32_t n, uint32_t size, std::vector<T> &column)
+{
+  for (uint32_t i = 0; i < n; i++)
+    {
+      column.push_back (static_cast<T> (ReadLittleEndian (is, size)));
+    }
+}
+
+void
+FlowMonitorSnapshotTestCase::DoRun (void)
+{
+  std::string fileName = CreateTempDirFilename ("flow-monitor.snapshots");
+
+  Ptr<FlowMonitor> monitor = CreateObject<FlowMonitor> ();
+  Ptr<FlowProbe> probe = CreateObject<SnapshotTestProbe> (monitor);
+  monitor->EnablePeriodicSnapshots (fileName, Seconds (1));
+  monitor->Start (MilliSeconds (300));
+
+  Simulator::Schedule (MilliSeconds (500), &FlowMonitor::ReportFirstTx, monitor, probe, 1, 1, 100);
+  Simulator::Schedule (MilliSeconds (600), &FlowMonitor::ReportLastRx, monitor, probe, 1, 1, 100);
+  Simulator::Schedule (MilliSeconds (1500), &FlowMonitor::ReportFirstTx, monitor, probe, 1, 2, 200);
+  Simulator::Stop (Seconds (2));
+  Simulator::Run ();
+  if (m_dispose)
+    {
+      monitor->Dispose ();
+    }
+  Simulator::Destroy ();
+  probe = 0;
+  monitor = 0;
+  // releasing the monitor may have used the simulator again
+  Simulator::Destroy ();
+
+  std::ifstream is (fileName.c_str (), std::ios::in | std::ios::binary);
+  NS_TEST_ASSERT_MSG_EQ (is.is_open (), true, "Could not open " << fileName);
+  char magic[8];
+  is.read (magic, sizeof (magic));
+  NS_TEST_ASSERT_MSG_EQ (std::string (magic, sizeof (magic)), "NS3FMONS", "Wrong magic");
+  NS_TEST_ASSERT_MSG_EQ (ReadLittleEndian (is, 4), 1, "Wrong version");
+  NS_TEST_ASSERT_MSG_EQ (ReadLittleEndian (is, 8), 1000000000, "Wrong interval");
+
+  std::vector<Snapshot> snapshots;
+  while (true)
+    {
+      Snapshot snapshot;
+      snapshot.time = ReadLittleEndian (is, 8);
+      uint32_t n = ReadLittleEndian (is, 4);
+      if (!is)
+        {
+          break;
+        }
+      ReadColumn (is, n, 4, snapshot.flowIds);
+      ReadColumn (is, n, 8, snapshot.txBytes);
+      ReadColumn (is, n, 8, snapshot.rxBytes);
+      ReadColumn (is, n, 4, snapshot.txPackets);
+      ReadColumn (is, n, 4, snapshot.rxPackets);
+      ReadColumn (is, n, 4, snapshot.lostPackets);
+      ReadColumn (is, n, 8, snapshot.delaySum);
+      ReadColumn (is, n, 8, snapshot.jitterSum);
+      NS_TEST_ASSERT_MSG_EQ (bool (is), true, "Truncated snapshot");
+      snapshots.push_back (snapshot);
+    }
+  is.close ();
+  remove (fileName.c_str ());
+
+  NS_TEST_ASSERT_MSG_EQ (snapshots.size (), 2, "Wrong number of snapshots");
+
+  NS_TEST_EXPECT_MSG_EQ (snapshots[0].time, 1300000000, "First snapshot not aligned with the start");
+  NS_TEST_ASSERT_MSG_EQ (snapshots[0].flowIds.size (), 1, "Wrong number of flows in the first snapshot");
+  NS_TEST_EXPECT_MSG_EQ (snapshots[0].flowIds[0], 1, "Wrong flow in the first snapshot");
+  NS_TEST_EXPECT_MSG_EQ (snapshots[0].txBytes[0], 100, "Wrong txBytes in the first snapshot");
+  NS_TEST_EXPECT_MSG_EQ (snapshots[0].rxBytes[0], 100, "Wrong rxBytes in the first snapshot");
+  NS_TEST_EXPECT_MSG_EQ (snapshots[0].txPackets[0], 1, "Wrong txPackets in the first snapshot");
+  NS_TEST_EXPECT_MSG_EQ (snapshots[0].rxPackets[0], 1, "Wrong rxPackets in the first snapshot");
+  NS_TEST_EXPECT_MSG_EQ (snapshots[0].delaySum[0], 100000000, "Wrong delaySum in the first snapshot");
+
+  NS_TEST_EXPECT_MSG_EQ (snapshots[1].time, 2000000000, "Last snapshot not taken at the end");
+  NS_TEST_ASSERT_MSG_EQ (snapshots[1].flowIds.size (), 1, "Wrong number of flows in the last snapshot");
+  NS_TEST_EXPECT_MSG_EQ (snapshots[1].txBytes[0], 200, "Wrong txBytes in the last snapshot");
+  NS_TEST_EXPECT_MSG_EQ (snapshots[1].rxBytes[0], 0, "Wrong rxBytes in the last snapshot");
+  NS_TEST_EXPECT_MSG_EQ (snapshots[1].txPackets[0], 1, "Wrong txPackets in the last snapshot");
+  NS_TEST_EXPECT_MSG_EQ (snapshots[1].rxPackets[0], 0, "Wrong rxPackets in the last snapshot");
+}
+
+/**
+ * \ingroup flow-monitor-test
+ * \ingroup tests
+ *
+ * \brief FlowMonitor periodic snapshots TestSuite
+ */
+class FlowMonitorSnapshotTestSuite : public TestSuite
+{
+public:
+  FlowMonitorSnapshotTestSuite () : TestSuite ("flow-monitor-snapshot", UNIT)
+  {
+    AddTestCase (new FlowMonitorSnapshotTestCase (true), TestCase::QUICK);
+    AddTestCase (new FlowMonitorSnapshotTestCase (false), TestCase::QUICK);
+  }
+};
+
+/// Static variable for test initialization
+static FlowMonitorSnapshotTestSuite g_flowMonitorSnapshotTestSuite;
@@ -267,6 +267,9 @@ InternetStackHelper::SetTcp (std::string tid, std::string n0, const AttributeVal
 void 
 InternetStackHelper::Install (NodeContainer c) const
 {
+  // The stacks are installed one node at a time rather than with
+  // ObjectFactory::Create (n): the protocols own random variables, whose
+  // streams are numbered in the order in which the objects are created.
   for (NodeContainer::Iterator i = c.Begin (); i != c.End (); ++i)
     {
       Install (*i);
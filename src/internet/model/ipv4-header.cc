@@ -41,6 +41,7 @@ Ipv4Header::Ipv4Header ()
     m_fragmentOffset (0),
     m_checksum (0),
     m_goodChecksum (true),
+    m_checksumValid (false),
     m_headerSize(5*4)
 {
 }
@@ -56,6 +57,7 @@ void
 Ipv4Header::SetPayloadSize (uint16_t size)
 {
   NS_LOG_FUNCTION (this << size);
+  m_checksumValid = false;
   m_payloadSize = size;
 }
 uint16_t
@@ -75,6 +77,7 @@ void
 Ipv4Header::SetIdentification (uint16_t identification)
 {
   NS_LOG_FUNCTION (this << identification);
+  m_checksumValid = false;
   m_identification = identification;
 }
 
@@ -82,6 +85,7 @@ void
 Ipv4Header::SetTos (uint8_t tos)
 {
   NS_LOG_FUNCTION (this << static_cast<uint32_t> (tos));
+  m_checksumValid = false;
   m_tos = tos;
 }
 
@@ -89,6 +93,7 @@ void
 Ipv4Header::SetDscp (DscpType dscp)
 {
   NS_LOG_FUNCTION (this << dscp);
+  m_checksumValid = false;
   m_tos &= 0x3; // Clear out the DSCP part, retain 2 bits of ECN
   m_tos |= (dscp << 2);
 }
@@ -97,6 +102,7 @@ void
 Ipv4Header::SetEcn (EcnType ecn)
 {
   NS_LOG_FUNCTION (this << ecn);
+  m_checksumValid = false;
   m_tos &= 0xFC; // Clear out the ECN part, retain 6 bits of DSCP
   m_tos |= ecn;
 }
@@ -200,12 +206,14 @@ void
 Ipv4Header::SetMoreFragments (void)
 {
   NS_LOG_FUNCTION (this);
+  m_checksumValid = false;
   m_flags |= MORE_FRAGMENTS;
 }
 void
 Ipv4Header::SetLastFragment (void)
 {
   NS_LOG_FUNCTION (this);
+  m_checksumValid = false;
   m_flags &= ~MORE_FRAGMENTS;
 }
 bool 
@@ -219,12 +227,14 @@ void
 Ipv4Header::SetDontFragment (void)
 {
   NS_LOG_FUNCTION (this);
+  m_checksumValid = false;
   m_flags |= DONT_FRAGMENT;
 }
 void 
 Ipv4Header::SetMayFragment (void)
 {
   NS_LOG_FUNCTION (this);
+  m_checksumValid = false;
   m_flags &= ~DONT_FRAGMENT;
 }
 bool 
@@ -238,6 +248,7 @@ void
 Ipv4Header::SetFragmentOffset (uint16_t offsetBytes)
 {
   NS_LOG_FUNCTION (this << offsetBytes);
+  m_checksumValid = false;
   // check if the user is trying to set an invalid offset
   NS_ABORT_MSG_IF ((offsetBytes & 0x7), "offsetBytes must be multiple of 8 bytes");
   m_fragmentOffset = offsetBytes;
@@ -259,8 +270,31 @@ void
 Ipv4Header::SetTtl (uint8_t ttl)
 {
   NS_LOG_FUNCTION (this << static_cast<uint32_t> (ttl));
+  m_checksumValid = false;
   m_ttl = ttl;
 }
+void
+Ipv4Header::DecrementTtl (void)
+{
+  NS_LOG_FUNCTION (this);
+  // TTL and protocol share a 16-bit word of the header, read by
+  // Buffer::Iterator::CalculateIpChecksum as ttl | (protocol << 8).
+  uint16_t oldWord = static_cast<uint16_t> (m_ttl | (m_protocol << 8));
+  m_ttl = static_cast<uint8_t> (m_ttl - 1);
+  if (m_checksumValid)
+    {
+      // Incremental update, HC' = ~(~HC + ~m + m') (RFC 1624, eqn. 3)
+      uint16_t newWord = static_cast<uint16_t> (m_ttl | (m_protocol << 8));
+      uint32_t sum = static_cast<uint16_t> (~m_checksum);
+      sum += static_cast<uint16_t> (~oldWord);
+      sum += newWord;
+      while (sum >> 16)
+        {
+          sum = (sum & 0xffff) + (sum >> 16);
+        }
+      m_checksum = static_cast<uint16_t> (~sum);
+    }
+}
 uint8_t 
 Ipv4Header::GetTtl (void) const
 {
@@ -278,6 +312,7 @@ void
 Ipv4Header::SetProtocol (uint8_t protocol)
 {
   NS_LOG_FUNCTION (this << static_cast<uint32_t> (protocol));
+  m_checksumValid = false;
   m_protocol = protocol;
 }
 
@@ -285,6 +320,7 @@ void
 Ipv4Header::SetSource (Ipv4Address source)
 {
   NS_LOG_FUNCTION (this << source);
+  m_checksumValid = false;
   m_source = source;
 }
 Ipv4Address
@@ -298,6 +334,7 @@ void
 Ipv4Header::SetDestination (Ipv4Address dst)
 {
   NS_LOG_FUNCTION (this << dst);
+  m_checksumValid = false;
   m_destination = dst;
 }
 Ipv4Address
@@ -409,7 +446,14 @@ Ipv4Header::Serialize (Buffer::Iterator start) const
   i.WriteHtonU32 (m_source.Get ());
   i.WriteHtonU32 (m_destination.Get ());
 
-  if (m_calcChecksum) 
+  if (m_calcChecksum && m_checksumValid)
+    {
+      // The received checksum has been kept up to date, no need to
+      // compute it again
+      i.Prev (10);
+      i.WriteU16 (m_checksum);
+    }
+  else if (m_calcChecksum) 
     {
       i = start;
       uint16_t checksum = i.CalculateIpChecksum (20);
@@ -469,6 +513,13 @@ Ipv4Header::Deserialize (Buffer::Iterator start)
       NS_LOG_LOGIC ("checksum=" <<checksum);
 
       m_goodChecksum = (checksum == 0);
+      // Options are not serialized back, in which case the received
+      // checksum does not cover the serialized header anymore
+      m_checksumValid = m_goodChecksum && headerSize == 20;
+    }
+  else
+    {
+      m_checksumValid = false;
     }
   return GetSerializedSize ();
 }
@@ -149,6 +149,15 @@ public:
    * \param ttl the ipv4 TTL
    */
   void SetTtl (uint8_t ttl);
+  /**
+   * \brief Decrement the TTL by one.
+   *
+   * If the header has been deserialized with a correct checksum, and
+   * no other field has been changed since, the checksum is updated
+   * incrementally (RFC 1624) instead of being computed again when the
+   * header is serialized.
+   */
+  void DecrementTtl (void);
   /**
    * \param num the ipv4 protocol field
    */
@@ -259,6 +268,7 @@ private:
   Ipv4Address m_destination; //!< destination address
   uint16_t m_checksum; //!< checksum
   bool m_goodChecksum; //!< true if checksum is correct
+  bool m_checksumValid; //!< true if m_checksum matches the current header fields
   uint16_t m_headerSize; //!< IP header size
 };
 
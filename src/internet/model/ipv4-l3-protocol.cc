@@ -1029,7 +1029,7 @@ Ipv4L3Protocol::IpMulticastForward (Ptr<Ipv4MulticastRoute> mrtentry, Ptr<const
 
       Ptr<Packet> packet = p->Copy ();
       Ipv4Header ipHeader = header;
-      ipHeader.SetTtl (header.GetTtl () - 1);
+      ipHeader.DecrementTtl ();
       if (ipHeader.GetTtl () == 0)
         {
           NS_LOG_WARN ("TTL exceeded.  Drop.");
@@ -1059,7 +1059,7 @@ Ipv4L3Protocol::IpForward (Ptr<Ipv4Route> rtentry, Ptr<const Packet> p, const Ip
   Ipv4Header ipHeader = header;
   Ptr<Packet> packet = p->Copy ();
   int32_t interface = GetInterfaceForDevice (rtentry->GetOutputDevice ());
-  ipHeader.SetTtl (ipHeader.GetTtl () - 1);
+  ipHeader.DecrementTtl ();
   if (ipHeader.GetTtl () == 0)
     {
       // Do not reply to multicast/broadcast IP address
@@ -155,8 +155,14 @@ TcpRxBuffer::Add (Ptr<Packet> p, TcpHeader const& tcph)
       if (maxSeq < tailSeq) tailSeq = maxSeq;
       if (tailSeq < headSeq) headSeq = tailSeq;
     }
-  // Remove overlapped bytes from packet
-  BufIterator i = m_data.begin ();
+  // Remove overlapped bytes from packet. Stored packets never overlap each
+  // other, so the first one that can overlap the incoming head is the last
+  // one starting at or before it.
+  BufIterator i = m_data.upper_bound (headSeq);
+  if (i != m_data.begin ())
+    {
+      --i;
+    }
   while (i != m_data.end () && i->first <= tailSeq)
     {
       SequenceNumber32 lastByteSeq = i->first + SequenceNumber32 (i->second->GetSize ());
@@ -185,40 +191,41 @@ TcpRxBuffer::Add (Ptr<Packet> p, TcpHeader const& tcph)
       NS_LOG_LOGIC ("Nothing to buffer");
       return false; // Nothing to buffer anyway
     }
+  uint32_t start = static_cast<uint32_t> (headSeq - tcph.GetSequenceNumber ());
+  uint32_t length = static_cast<uint32_t> (tailSeq - headSeq);
+  if (start == 0 && length == pktSize)
+    { // Nothing to trim: share the packet buffer instead of fragmenting it
+      p = p->Copy ();
+    }
   else
     {
-      uint32_t start = static_cast<uint32_t> (headSeq - tcph.GetSequenceNumber ());
-      uint32_t length = static_cast<uint32_t> (tailSeq - headSeq);
       p = p->CreateFragment (start, length);
-      NS_ASSERT (length == p->GetSize ());
     }
+  NS_ASSERT (length == p->GetSize ());
   // Insert packet into buffer
   NS_ASSERT (m_data.find (headSeq) == m_data.end ()); // Shouldn't be there yet
   m_data [ headSeq ] = p;
-
-  if (headSeq > m_nextRxSeq)
+  m_size += length;      // Occupancy
+
+  // Coalesce the new data with the contiguous range it belongs to. If that
+  // range starts at (or before) the first missing byte, the hole has been
+  // filled and everything up to its end is now in order; otherwise, the
+  // range is the out-of-order block to advertise first in the SACK list.
+  RangeIterator range = InsertRange (headSeq, tailSeq);
+  if (range->first <= m_nextRxSeq)
+    {
+      NS_ASSERT (range->second > m_nextRxSeq);
+      m_availBytes += static_cast<uint32_t> (range->second - m_nextRxSeq);
+      m_nextRxSeq = range->second;
+      ClearSackList (m_nextRxSeq);
+    }
+  else
     {
       // Generate a new SACK block
-      UpdateSackList (headSeq, tailSeq);
+      UpdateSackList (range->first, range->second);
     }
 
   NS_LOG_LOGIC ("Buffered packet of seqno=" << headSeq << " len=" << p->GetSize ());
-  // Update variables
-  m_size += p->GetSize ();      // Occupancy
-  for (i = m_data.begin (); i != m_data.end (); ++i)
-    {
-      if (i->first < m_nextRxSeq)
-        {
-          continue;
-        }
-      else if (i->first > m_nextRxSeq)
-        {
-          break;
-        };
-      m_nextRxSeq = i->first + SequenceNumber32 (i->second->GetSize ());
-      m_availBytes += i->second->GetSize ();
-      ClearSackList (m_nextRxSeq);
-    }
   NS_LOG_LOGIC ("Updated buffer occupancy=" << m_size << " nextRxSeq=" << m_nextRxSeq);
   if (m_gotFin && m_nextRxSeq == m_finSeq)
     { // Account for the FIN packet
@@ -227,6 +234,41 @@ TcpRxBuffer::Add (Ptr<Packet> p, TcpHeader const& tcph)
   return true;
 }
 
+std::map<SequenceNumber32, SequenceNumber32>::iterator
+TcpRxBuffer::InsertRange (const SequenceNumber32 &head, const SequenceNumber32 &tail)
+{
+  NS_LOG_FUNCTION (this << head << tail);
+  NS_ASSERT (head < tail);
+
+  SequenceNumber32 first = head;
+  SequenceNumber32 last = tail;
+
+  // Start from the range preceding head, if it touches the new one
+  RangeIterator it = m_ranges.upper_bound (head);
+  if (it != m_ranges.begin ())
+    {
+      RangeIterator prev = std::prev (it);
+      if (prev->second >= head)
+        {
+          it = prev;
+        }
+    }
+  // Absorb every range overlapping or adjacent to [head; tail)
+  while (it != m_ranges.end () && it->first <= last)
+    {
+      if (it->first < first)
+        {
+          first = it->first;
+        }
+      if (it->second > last)
+        {
+          last = it->second;
+        }
+      it = m_ranges.erase (it);
+    }
+  return m_ranges.insert (it, std::make_pair (first, last));
+}
+
 uint32_t
 TcpRxBuffer::GetSackListSize () const
 {
@@ -271,65 +313,30 @@ TcpRxBuffer::UpdateSackList (const SequenceNumber32 &head, const SequenceNumber3
   //     following SACK blocks in the SACK option may be listed in
   //     arbitrary order.
 
-  m_sackList.push_front (current);
-
-  // We have inserted the block at the beginning of the list. Now, we should
-  // check if any existing blocks overlap with that.
-  bool updated = false;
-  TcpOptionSack::SackList::iterator it = m_sackList.begin ();
-  TcpOptionSack::SackBlock begin = *it;
-  TcpOptionSack::SackBlock merged;
-  ++it;
-
-  // Iterates until we examined all blocks in the list (maximum 4)
-  while (it != m_sackList.end ())
+  // The block passed is the whole contiguous range containing the segment
+  // which triggered this ACK. Any block already in the list which overlaps
+  // it is therefore a subset of it, and it is removed (point (c)).
+  TcpOptionSack::SackList::iterator it;
+  for (it = m_sackList.begin (); it != m_sackList.end (); )
     {
-      current = *it;
-
-      // This is a left merge:
-      // [current_first; current_second] [beg_first; beg_second]
-      if (begin.first == current.second)
+      if (it->first >= head && it->second <= tail)
         {
-          NS_ASSERT (current.first < begin.second);
-          merged = TcpOptionSack::SackBlock (current.first, begin.second);
-          updated = true;
-        }
-      // while this is a right merge
-      // [begin_first; begin_second] [current_first; current_second]
-      else if (begin.second == current.first)
-        {
-          NS_ASSERT (begin.first < current.second);
-          merged = TcpOptionSack::SackBlock (begin.first, current.second);
-          updated = true;
+          it = m_sackList.erase (it);
         }
-
-      // If we have merged the blocks (and the result is in merged) we should
-      // delete the current block (it), the first block, and insert the merged
-      // one at the beginning.
-      if (updated)
+      else
         {
-          m_sackList.erase (it);
-          m_sackList.pop_front ();
-          m_sackList.push_front (merged);
-          it = m_sackList.begin ();
-          begin = *it;
-          updated = false;
+          ++it;
         }
-
-      ++it;
     }
 
+  m_sackList.push_front (current);
+
   // Since the maximum blocks that fits into a TCP header are 4, there's no
   // point on maintaining the others.
   if (m_sackList.size () > 4)
     {
       m_sackList.pop_back ();
     }
-
-  // Please note that, if a block b is discarded and then a block contiguous
-  // to b is received, only that new block (without the b part) is reported.
-  // This is perfectly fine for the RFC point (a), given that we do not report any
-  // overlapping blocks shortly after.
 }
 
 void
@@ -369,7 +376,8 @@ TcpRxBuffer::Extract (uint32_t maxSize)
   NS_LOG_LOGIC ("Requested to extract " << extractSize << " bytes from TcpRxBuffer of size=" << m_size);
   if (extractSize == 0) return nullptr;  // No contiguous block to return
   NS_ASSERT (m_data.size ()); // At least we have something to extract
-  Ptr<Packet> outPkt = Create<Packet> (); // The packet that contains all the data to return
+  Ptr<Packet> outPkt; // The packet that contains all the data to return
+  uint32_t extracted = extractSize;
   BufIterator i;
   while (extractSize)
     { // Check the buffered data for delivery
@@ -379,7 +387,14 @@ TcpRxBuffer::Extract (uint32_t maxSize)
       uint32_t pktSize = i->second->GetSize ();
       if (pktSize <= extractSize)
         { // Whole packet is extracted
-          outPkt->AddAtEnd (i->second);
+          if (outPkt)
+            {
+              outPkt->AddAtEnd (i->second);
+            }
+          else
+            { // The buffer owns the packet: hand it over without copying
+              outPkt = i->second;
+            }
           m_data.erase (i);
           m_size -= pktSize;
           m_availBytes -= pktSize;
@@ -387,7 +402,14 @@ TcpRxBuffer::Extract (uint32_t maxSize)
         }
       else
         { // Partial is extracted and done
-          outPkt->AddAtEnd (i->second->CreateFragment (0, extractSize));
+          if (outPkt)
+            {
+              outPkt->AddAtEnd (i->second->CreateFragment (0, extractSize));
+            }
+          else
+            {
+              outPkt = i->second->CreateFragment (0, extractSize);
+            }
           m_data[i->first + SequenceNumber32 (extractSize)] = i->second->CreateFragment (extractSize, pktSize - extractSize);
           m_data.erase (i);
           m_size -= extractSize;
@@ -395,6 +417,17 @@ TcpRxBuffer::Extract (uint32_t maxSize)
           extractSize = 0;
         }
     }
+  // Extracted data always comes from the head of the first range
+  RangeIterator range = m_ranges.begin ();
+  NS_ASSERT (range != m_ranges.end ());
+  SequenceNumber32 rangeHead = range->first + SequenceNumber32 (extracted);
+  SequenceNumber32 rangeTail = range->second;
+  NS_ASSERT (rangeHead <= rangeTail);
+  range = m_ranges.erase (range);
+  if (rangeHead < rangeTail)
+    {
+      m_ranges.insert (range, std::make_pair (rangeHead, rangeTail));
+    }
   if (outPkt->GetSize () == 0)
     {
       NS_LOG_LOGIC ("Nothing extracted.");
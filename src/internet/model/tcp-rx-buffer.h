@@ -64,6 +64,11 @@ class Packet;
  * > If sent at all, SACK options SHOULD be included in all ACKs which do
  * > not ACK the highest sequence number in the data receiver's queue.
  *
+ * Besides the stored segments, the buffer keeps an index of the disjoint
+ * contiguous ranges of data it holds, coalesced as segments arrive. Filling
+ * a hole or building the first SACK block is then a lookup on that index,
+ * instead of a walk over every buffered segment.
+ *
  * For more information about the SACK list, please check the documentation of
  * the method GetSackList.
  *
@@ -197,11 +202,27 @@ private:
    * (or other) options, it is even less. For more detail about this function,
    * please see the source code and in-line comments.
    *
+   * The block passed is the whole contiguous range of out-of-order data
+   * which contains the segment just received (as tracked by m_ranges), so
+   * any block already in the list which overlaps it is a subset and gets
+   * replaced.
+   *
    * \param head sequence number of the block at the beginning
    * \param tail sequence number of the block at the end
    */
   void UpdateSackList (const SequenceNumber32 &head, const SequenceNumber32 &tail);
 
+  /**
+   * \brief Insert a range of data into the range index, coalescing it with
+   * any overlapping or adjacent range
+   *
+   * \param head first sequence number of the range
+   * \param tail sequence number following the last byte of the range
+   * \return an iterator to the (possibly merged) range containing [head; tail)
+   */
+  std::map<SequenceNumber32, SequenceNumber32>::iterator
+  InsertRange (const SequenceNumber32 &head, const SequenceNumber32 &tail);
+
   /**
    * \brief Remove old blocks from the sack list
    *
@@ -219,6 +240,8 @@ private:
 
   /// container for data stored in the buffer
   typedef std::map<SequenceNumber32, Ptr<Packet> >::iterator BufIterator;
+  /// container for the contiguous ranges of data stored in the buffer
+  typedef std::map<SequenceNumber32, SequenceNumber32>::iterator RangeIterator;
   TracedValue<SequenceNumber32> m_nextRxSeq; //!< Seqnum of the first missing byte in data (RCV.NXT)
   SequenceNumber32 m_finSeq;                 //!< Seqnum of the FIN packet
   bool m_gotFin;                             //!< Did I received FIN packet?
@@ -226,6 +249,7 @@ private:
   uint32_t m_maxBuffer;                      //!< Upper bound of the number of data bytes in buffer (RCV.WND)
   uint32_t m_availBytes;                     //!< Number of bytes available to read, i.e. contiguous block at head
   std::map<SequenceNumber32, Ptr<Packet> > m_data; //!< Corresponding data (may be null)
+  std::map<SequenceNumber32, SequenceNumber32> m_ranges; //!< Disjoint, coalesced [head; tail) ranges covered by m_data
 };
 
 } //namespace ns3
@@ -265,6 +265,75 @@ Ipv4HeaderTest::DoRun (void)
   Simulator::Destroy ();
 }
 
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief IPv4 Header incremental checksum Test
+ */
+class Ipv4HeaderChecksumTest : public TestCase
+{
+public:
+  virtual void DoRun (void);
+  Ipv4HeaderChecksumTest ();
+};
+
+Ipv4HeaderChecksumTest::Ipv4HeaderChecksumTest ()
+  : TestCase ("IPv4 Header incremental checksum Test")
+{
+}
+
+void
+Ipv4HeaderChecksumTest::DoRun (void)
+{
+  Ipv4Header header;
+  header.EnableChecksum ();
+  header.SetSource (Ipv4Address ("10.1.2.3"));
+  header.SetDestination (Ipv4Address ("192.168.200.17"));
+  header.SetProtocol (17);
+  header.SetPayloadSize (1000);
+  header.SetIdentification (0xbeef);
+  header.SetDscp (Ipv4Header::DSCP_AF21);
+
+  for (uint32_t ttl = 255; ttl > 0; ttl--)
+    {
+      header.SetTtl (static_cast<uint8_t> (ttl));
+      Ptr<Packet> p = Create<Packet> ();
+      p->AddHeader (header);
+
+      // Forwarding: the checksum is updated, not computed again
+      Ipv4Header forwarded;
+      forwarded.EnableChecksum ();
+      p->RemoveHeader (forwarded);
+      NS_TEST_ASSERT_MSG_EQ (forwarded.IsChecksumOk (), true, "Bad checksum before forwarding");
+      forwarded.DecrementTtl ();
+      p->AddHeader (forwarded);
+
+      // Reference header, with the checksum computed from scratch
+      Ipv4Header reference = header;
+      reference.SetTtl (static_cast<uint8_t> (ttl - 1));
+      Ptr<Packet> q = Create<Packet> ();
+      q->AddHeader (reference);
+
+      uint8_t forwardedBytes[20];
+      uint8_t referenceBytes[20];
+      p->CopyData (forwardedBytes, 20);
+      q->CopyData (referenceBytes, 20);
+      for (uint32_t j = 0; j < 20; j++)
+        {
+          NS_TEST_ASSERT_MSG_EQ (static_cast<uint32_t> (forwardedBytes[j]),
+                                 static_cast<uint32_t> (referenceBytes[j]),
+                                 "Forwarded header differs from reference, TTL " << ttl);
+        }
+
+      Ipv4Header received;
+      received.EnableChecksum ();
+      p->RemoveHeader (received);
+      NS_TEST_ASSERT_MSG_EQ (received.IsChecksumOk (), true, "Bad checksum after forwarding");
+      NS_TEST_ASSERT_MSG_EQ (static_cast<uint32_t> (received.GetTtl ()), ttl - 1, "Bad TTL after forwarding");
+    }
+}
+
 /**
  * \ingroup internet-test
  * \ingroup tests
@@ -277,6 +346,7 @@ public:
   Ipv4HeaderTestSuite () : TestSuite ("ipv4-header", UNIT)
   {
     AddTestCase (new Ipv4HeaderTest, TestCase::QUICK);
+    AddTestCase (new Ipv4HeaderChecksumTest, TestCase::QUICK);
   }
 };
 
@@ -0,0 +1,202 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the containers storing the items of
+// a Queue. Packets are pushed through a queue kept at a given depth: each
+// step enqueues one packet and dequeues the packet at the head. The program
+// reports, for each depth, the wall clock time per enqueue/dequeue pair and
+// the number of heap allocations per pair:
+//
+// - of a std::deque and a std::list of Ptr<Packet> alone, which are the
+//   containers available to Queue<Item, Container>;
+// - of a DropTailQueue<Packet>, which stores its packets in a std::deque,
+//   including the cost of the Queue statistics and trace sources.
+//
+// The packets are created once, so that their allocation is not counted.
+// Heap allocations are accounted for by replacing the global operator new
+// in this program. Build in optimized mode to get meaningful timings.
+//
+// Sample usage:
+//   ./waf --run 'bench-queue --n=100000000 --depths=10,100,1000'
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <list>
+#include <new>
+#include <sstream>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("BenchQueue");
+
+/// Number of calls to the global operator new
+static uint64_t g_nAllocations = 0;
+
+void *
+operator new (std::size_t size)
+{
+  void *ptr = std::malloc (size);
+  if (ptr == 0)
+    {
+      throw std::bad_alloc ();
+    }
+  g_nAllocations++;
+  return ptr;
+}
+
+void
+operator delete (void *ptr) noexcept
+{
+  std::free (ptr);
+}
+
+void
+operator delete (void *ptr, std::size_t) noexcept
+{
+  std::free (ptr);
+}
+
+/**
+ * Push packets through a container of Ptr<Packet> kept at a given depth.
+ *
+ * \tparam Container The container type.
+ * \param [in] packets The packets to push.
+ * \param [in] n The number of enqueue/dequeue pairs.
+ * \param [in] depth The number of packets in the container.
+ * \return The checksum of the dequeued packets, which keeps the loop alive.
+ */
+template <typename Container>
+uint64_t
+PushThroughContainer (const std::vector<Ptr<Packet> > &packets, uint64_t n, uint32_t depth)
+{
+  Container container;
+  uint64_t sum = 0;
+  for (uint32_t i = 0; i < depth; i++)
+    {
+      container.push_back (packets[i % packets.size ()]);
+    }
+  for (uint64_t i = 0; i < n; i++)
+    {
+      container.push_back (packets[i % packets.size ()]);
+      sum += container.front ()->GetSize ();
+      container.pop_front ();
+    }
+  return sum;
+}
+
+/**
+ * Push packets through a DropTailQueue kept at a given depth.
+ *
+ * \param [in] packets The packets to push.
+ * \param [in] n The number of enqueue/dequeue pairs.
+ * \param [in] depth The number of packets in the queue.
+ * \return The checksum of the dequeued packets, which keeps the loop alive.
+ */
+uint64_t
+PushThroughQueue (const std::vector<Ptr<Packet> > &packets, uint64_t n, uint32_t depth)
+{
+  Ptr<DropTailQueue<Packet> > queue = CreateObject<DropTailQueue<Packet> > ();
+  queue->SetMaxSize (QueueSize (QueueSizeUnit::PACKETS, depth + 1));
+  uint64_t sum = 0;
+  for (uint32_t i = 0; i < depth; i++)
+    {
+      queue->Enqueue (packets[i % packets.size ()]);
+    }
+  for (uint64_t i = 0; i < n; i++)
+    {
+      queue->Enqueue (packets[i % packets.size ()]);
+      sum += queue->Dequeue ()->GetSize ();
+    }
+  return sum;
+}
+
+/**
+ * Run a benchmark and print its results.
+ *
+ * \param [in] name The name of the benchmark.
+ * \param [in] depth The number of packets in the queue.
+ * \param [in] n The number of enqueue/dequeue pairs.
+ * \param [in] run The function running the benchmark.
+ */
+void
+Bench (std::string name, uint32_t depth, uint64_t n, std::function<uint64_t (void)> run)
+{
+  uint64_t allocations = g_nAllocations;
+  auto start = std::chrono::steady_clock::now ();
+  uint64_t sum = run ();
+  auto stop = std::chrono::steady_clock::now ();
+  allocations = g_nAllocations - allocations;
+  double seconds = std::chrono::duration<double> (stop - start).count ();
+  NS_LOG_INFO (name << " checksum " << sum);
+  std::cout << std::left << std::setw (16) << name << std::right << std::fixed
+            << std::setw (8) << depth
+            << std::setw (12) << std::setprecision (3) << seconds
+            << std::setw (14) << std::setprecision (1) << seconds * 1e9 / n
+            << std::setw (14) << std::setprecision (3) << double (allocations) / n
+            << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint64_t n = 1000000;
+  std::string depths = "10,100,1000";
+
+  CommandLine cmd (__FILE__);
+  cmd.AddValue ("n", "number of enqueue/dequeue pairs for each container and depth", n);
+  cmd.AddValue ("depths", "comma separated list of queue depths, in packets", depths);
+  cmd.Parse (argc, argv);
+
+  std::vector<uint32_t> depthList;
+  std::istringstream iss (depths);
+  std::string depth;
+  while (std::getline (iss, depth, ','))
+    {
+      depthList.push_back (std::stoul (depth));
+    }
+
+  std::vector<Ptr<Packet> > packets;
+  for (uint32_t i = 0; i < 1024; i++)
+    {
+      packets.push_back (Create<Packet> (100 + i));
+    }
+
+  std::cout << "Running bench-queue with n=" << n << std::endl;
+  std::cout << std::left << std::setw (16) << "Container" << std::right
+            << std::setw (8) << "Depth"
+            << std::setw (12) << "Time (s)"
+            << std::setw (14) << "ns/pair"
+            << std::setw (14) << "allocs/pair"
+            << std::endl;
+  for (uint32_t d : depthList)
+    {
+      Bench ("std::deque", d, n, [&packets, n, d] ()
+             { return PushThroughContainer<std::deque<Ptr<Packet> > > (packets, n, d); });
+      Bench ("std::list", d, n, [&packets, n, d] ()
+             { return PushThroughContainer<std::list<Ptr<Packet> > > (packets, n, d); });
+      Bench ("DropTailQueue", d, n, [&packets, n, d] ()
+             { return PushThroughQueue (packets, n, d); });
+    }
+
+  Simulator::Destroy ();
+  return 0;
+}
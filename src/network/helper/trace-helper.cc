@@ -19,9 +19,13 @@
 #include <stdint.h>
 #include <string>
 #include <fstream>
+#include <map>
+#include <sstream>
 
 #include "ns3/abort.h"
 #include "ns3/assert.h"
+#include "ns3/boolean.h"
+#include "ns3/global-value.h"
 #include "ns3/log.h"
 #include "ns3/ptr.h"
 #include "ns3/node.h"
@@ -35,7 +39,38 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("TraceHelper");
 
+/**
+ * \ingroup network
+ * \brief A global switch to write the trace files created by the helpers
+ * in gzip format.
+ */
+static GlobalValue g_compressTraces =
+  GlobalValue ("CompressTraces",
+               "Whether to write the pcap, pcapng and ascii trace files created by the helpers in gzip format",
+               BooleanValue (false),
+               MakeBooleanChecker ());
+
+/**
+ * \param filename the name of a trace file
+ * \param filemode the mode the file is opened with
+ * \returns the name of the file to create, with a ".gz" suffix if the
+ * files opened for writing must be compressed
+ */
+static std::string
+GetTraceFilename (std::string filename, std::ios::openmode filemode)
+{
+  BooleanValue compress;
+  g_compressTraces.GetValue (compress);
+  if (compress.Get () && (filemode & (std::ios::in | std::ios::app)) == 0
+      && !(filename.size () > 3 && filename.compare (filename.size () - 3, 3, ".gz") == 0))
+    {
+      filename += ".gz";
+    }
+  return filename;
+}
+
 PcapHelper::PcapHelper ()
+  : m_nodeId (NO_NODE)
 {
   NS_LOG_FUNCTION_NOARGS ();
 }
@@ -56,6 +91,24 @@ PcapHelper::CreateFile (
   NS_LOG_FUNCTION (filename << filemode << dataLinkType << snapLen << tzCorrection);
 
   Ptr<PcapFileWrapper> file = CreateObject<PcapFileWrapper> ();
+  if (!GetPcapNgState ().prefix.empty () && (filemode & std::ios::in) == 0)
+    {
+      //
+      // Record the file as an interface of a pcapng file, named after the
+      // file without its extension.
+      //
+      std::string name = filename;
+      if (name.size () > 5 && name.compare (name.size () - 5, 5, ".pcap") == 0)
+        {
+          name.erase (name.size () - 5);
+        }
+      file->Open (GetPcapNgFile (), name);
+      file->Init (dataLinkType, snapLen, tzCorrection);
+      NS_ABORT_MSG_IF (file->Fail (), "Unable to Init " << filename);
+      return file;
+    }
+
+  filename = GetTraceFilename (filename, filemode);
   file->Open (filename, filemode);
   NS_ABORT_MSG_IF (file->Fail (), "Unable to Open " << filename << " for mode " << filemode);
 
@@ -76,6 +129,71 @@ PcapHelper::CreateFile (
   return file;
 }
 
+void
+PcapHelper::EnablePcapNg (std::string prefix, uint32_t nodesPerFile, uint32_t bufferSize)
+{
+  NS_LOG_FUNCTION (prefix << nodesPerFile << bufferSize);
+  NS_ABORT_MSG_UNLESS (prefix.size (), "Empty prefix string");
+  PcapNgState &state = GetPcapNgState ();
+  state.prefix = prefix;
+  state.nodesPerFile = nodesPerFile;
+  state.bufferSize = bufferSize;
+}
+
+void
+PcapHelper::DisablePcapNg (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  GetPcapNgState ().prefix.clear ();
+  ReleasePcapNgFiles ();
+}
+
+PcapHelper::PcapNgState &
+PcapHelper::GetPcapNgState (void)
+{
+  static PcapNgState state = { "", 0, PcapNgFile::BUFFER_SIZE_DEFAULT, {} };
+  return state;
+}
+
+void
+PcapHelper::ReleasePcapNgFiles (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  GetPcapNgState ().files.clear ();
+}
+
+Ptr<PcapNgFile>
+PcapHelper::GetPcapNgFile (void) const
+{
+  NS_LOG_FUNCTION (this);
+  PcapNgState &state = GetPcapNgState ();
+  std::ostringstream oss;
+  oss << state.prefix;
+  if (state.nodesPerFile > 0 && m_nodeId != NO_NODE)
+    {
+      uint32_t first = m_nodeId - m_nodeId % state.nodesPerFile;
+      oss << "-" << first << "-" << first + state.nodesPerFile - 1;
+    }
+  oss << ".pcapng";
+  std::string filename = GetTraceFilename (oss.str (), std::ios::out);
+
+  std::map<std::string, Ptr<PcapNgFile> >::iterator it = state.files.find (filename);
+  if (it != state.files.end ())
+    {
+      return it->second;
+    }
+
+  Ptr<PcapNgFile> file = Create<PcapNgFile> ();
+  file->Open (filename, state.bufferSize);
+  NS_ABORT_MSG_IF (file->Fail (), "Unable to Open " << filename);
+  if (state.files.empty ())
+    {
+      Simulator::ScheduleDestroy (&PcapHelper::ReleasePcapNgFiles);
+    }
+  state.files[filename] = file;
+  return file;
+}
+
 std::string
 PcapHelper::GetFilenameFromDevice (std::string prefix, Ptr<NetDevice> device, bool useObjectNames)
 {
@@ -89,6 +207,7 @@ PcapHelper::GetFilenameFromDevice (std::string prefix, Ptr<NetDevice> device, bo
   std::string devicename;
 
   Ptr<Node> node = device->GetNode ();
+  m_nodeId = node->GetId ();
 
   if (useObjectNames)
     {
@@ -134,6 +253,7 @@ PcapHelper::GetFilenameFromInterfacePair (std::string prefix, Ptr<Object> object
   std::string nodename;
 
   Ptr<Node> node = object->GetObject<Node> ();
+  m_nodeId = node->GetId ();
 
   if (useObjectNames)
     {
@@ -192,7 +312,7 @@ AsciiTraceHelper::CreateFileStream (std::string filename, std::ios::openmode fil
 {
   NS_LOG_FUNCTION (filename << filemode);
 
-  Ptr<OutputStreamWrapper> StreamWrapper = Create<OutputStreamWrapper> (filename, filemode);
+  Ptr<OutputStreamWrapper> StreamWrapper = Create<OutputStreamWrapper> (GetTraceFilename (filename, filemode), filemode);
 
   //
   // Note that the ascii trace helper promptly forgets all about the trace file.
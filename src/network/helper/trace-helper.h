@@ -19,6 +19,7 @@
 #ifndef TRACE_HELPER_H
 #define TRACE_HELPER_H
 
+#include <map>
 #include "ns3/assert.h"
 #include "ns3/net-device-container.h"
 #include "ns3/node-container.h"
@@ -98,6 +99,10 @@ public:
   /**
    * @brief Create and initialize a pcap file.
    * 
+   * If the CompressTraces global value is true, a ".gz" suffix is appended
+   * to the name of a file opened for writing, which is then written in gzip
+   * format.
+   *
    * @param filename file name
    * @param filemode file mode
    * @param dataLinkType data link type of packet data
@@ -110,6 +115,42 @@ public:
                                    DataLinkType dataLinkType,
                                    uint32_t snapLen = std::numeric_limits<uint32_t>::max (),
                                    int32_t tzCorrection = 0);
+
+  /**
+   * @brief Record the pcap traces created from now on in pcapng files.
+   *
+   * Once enabled, CreateFile (and hence the EnablePcap methods of the
+   * helpers) does not create a pcap file for each file opened for writing.
+   * Instead, each such file is recorded as an interface, named after the
+   * file (without its .pcap extension), of a shared pcapng file.  By default,
+   * a single file named <prefix>.pcapng records all the interfaces.  If
+   * nodesPerFile is not zero, the traces whose file name was given by
+   * GetFilenameFromDevice or GetFilenameFromInterfacePair, i.e., the device
+   * and the IPv4 and IPv6 traces enabled by the helpers without an explicit
+   * file name, are recorded in one file per range of nodesPerFile node ids,
+   * named <prefix>-<first id>-<last id>.pcapng.  The other traces are
+   * recorded in <prefix>.pcapng.
+   *
+   * Hence a simulation tracing many devices writes a few files sequentially
+   * rather than keeping one file open per device.  The pcapng files are
+   * complete once all of their interfaces are closed or Simulator::Destroy
+   * is called.
+   *
+   * @param prefix prefix of the names of the pcapng files
+   * @param nodesPerFile number of nodes per pcapng file, or zero for a single file
+   * @param bufferSize size of the write buffer of each pcapng file, in bytes
+   */
+  static void EnablePcapNg (std::string prefix, uint32_t nodesPerFile = 0,
+                            uint32_t bufferSize = PcapNgFile::BUFFER_SIZE_DEFAULT);
+
+  /**
+   * @brief Create one pcap file per file name again, which is the default.
+   *
+   * The pcapng files already created remain open until all of their
+   * interfaces are closed.
+   */
+  static void DisablePcapNg (void);
+
   /**
    * @brief Hook a trace source to the default trace sink
    * 
@@ -142,6 +183,38 @@ private:
    * @see DefaultSink
    */
   static void SinkWithHeader (Ptr<PcapFileWrapper> file, const Header& header, Ptr<const Packet> p);
+
+  /// The configuration and the files of the pcapng output
+  struct PcapNgState
+  {
+    std::string prefix;    //!< Prefix of the pcapng files, or empty if disabled
+    uint32_t nodesPerFile; //!< Number of nodes recorded in each file (0 for a single file)
+    uint32_t bufferSize;   //!< Size of the write buffer of the files
+    std::map<std::string, Ptr<PcapNgFile> > files; //!< The files created, by name
+  };
+
+  /**
+   * @returns the pcapng output state, shared by all the pcap helpers
+   */
+  static PcapNgState & GetPcapNgState (void);
+
+  /**
+   * Release the references to the pcapng files, so that the files are
+   * closed once their interfaces are closed.
+   */
+  static void ReleasePcapNgFiles (void);
+
+  /**
+   * @returns the pcapng file recording the next trace created by this helper
+   */
+  Ptr<PcapNgFile> GetPcapNgFile (void) const;
+
+  /// Value of m_nodeId when the node of the traces is not known
+  static const uint32_t NO_NODE = 0xffffffff;
+
+  /// Id of the node of the last file name given by this helper, which
+  /// selects the pcapng file of the next trace
+  uint32_t m_nodeId;
 };
 
 template <typename T> void
@@ -216,6 +289,10 @@ public:
    * that can solve the problem so we use one of those to carry the stream
    * around and deal with the lifetime issues.
    * 
+   * If the CompressTraces global value is true, a ".gz" suffix is appended
+   * to the name of a file opened for writing, which is then written in gzip
+   * format.
+   *
    * @param filename file name
    * @param filemode file mode
    * @returns a smart pointer to the output stream
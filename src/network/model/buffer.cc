@@ -20,6 +20,7 @@
 #include "buffer.h"
 #include "ns3/assert.h"
 #include "ns3/log.h"
+#include "ns3/memory-accounting.h"
 
 #define LOG_INTERNAL_STATE(y)                                                                    \
   NS_LOG_LOGIC (y << "start="<<m_start<<", end="<<m_end<<", zero start="<<m_zeroAreaStart<<              \
@@ -43,6 +44,50 @@ static struct Zeroes
   const uint32_t size;  //!< buffer size
 } g_zeroes; //!< Zero-filled buffer
 
+/**
+ * \ingroup packet
+ * \brief Compute the one's complement sum of a contiguous block of bytes.
+ *
+ * The block is summed as a sequence of little-endian 16-bit words (the
+ * format returned by Buffer::Iterator::ReadU16), a trailing odd byte being
+ * the low-order byte of the last word. The bytes are accumulated four at a
+ * time into a 64-bit sum, and the carries are folded back only once at the
+ * end (see RFC 1071, section 4.1).
+ *
+ * \param data the block of bytes
+ * \param len the number of bytes in the block
+ * \return the sum, folded to 16 bits
+ */
+static uint16_t
+ChecksumBlock (const uint8_t *data, uint32_t len)
+{
+  uint64_t sum = 0;
+  while (len >= 4)
+    {
+      sum += static_cast<uint32_t> (data[0])
+        | (static_cast<uint32_t> (data[1]) << 8)
+        | (static_cast<uint32_t> (data[2]) << 16)
+        | (static_cast<uint32_t> (data[3]) << 24);
+      data += 4;
+      len -= 4;
+    }
+  if (len >= 2)
+    {
+      sum += static_cast<uint32_t> (data[0]) | (static_cast<uint32_t> (data[1]) << 8);
+      data += 2;
+      len -= 2;
+    }
+  if (len)
+    {
+      sum += data[0];
+    }
+  while (sum >> 16)
+    {
+      sum = (sum & 0xffff) + (sum >> 16);
+    }
+  return static_cast<uint16_t> (sum);
+}
+
 }
 
 namespace ns3 {
@@ -173,6 +218,11 @@ Buffer::Allocate (uint32_t reqSize)
   struct Buffer::Data *data = reinterpret_cast<struct Buffer::Data*>(b);
   data->m_size = reqSize;
   data->m_count = 1;
+  data->m_accounted = MemoryAccounting::IsEnabled ();
+  if (data->m_accounted)
+    {
+      MemoryAccounting::Add (typeid (struct Buffer::Data), size);
+    }
   return data;
 }
 
@@ -181,6 +231,11 @@ Buffer::Deallocate (struct Buffer::Data *data)
 {
   NS_LOG_FUNCTION (data);
   NS_ASSERT (data->m_count == 0);
+  if (data->m_accounted)
+    {
+      MemoryAccounting::Remove (typeid (struct Buffer::Data),
+                                data->m_size - 1 + sizeof (struct Buffer::Data));
+    }
   uint8_t *buf = reinterpret_cast<uint8_t *> (data);
   delete [] buf;
 }
@@ -1141,18 +1196,52 @@ uint16_t
 Buffer::Iterator::CalculateIpChecksum (uint16_t size, uint32_t initialChecksum)
 {
   NS_LOG_FUNCTION (this << size << initialChecksum);
+  NS_ASSERT_MSG (m_current >= m_dataStart && m_current + size <= m_dataEnd,
+                 "Attempt to compute the checksum outside of the buffer");
   /* see RFC 1071 to understand this code. */
-  uint32_t sum = initialChecksum;
-
-  for (int j = 0; j < size/2; j++)
-    sum += ReadU16 ();
+  uint64_t sum = initialChecksum;
+  uint32_t end = m_current + size;
+  bool odd = false; // true when the next byte is the high byte of a word
 
-  if (size & 1)
-    sum += ReadU8 ();
+  // The data is summed in contiguous blocks: the bytes before the zero
+  // area, the zero area itself (which adds nothing) and the bytes after it.
+  while (m_current < end)
+    {
+      const uint8_t *block = 0;
+      uint32_t blockEnd;
+      if (m_current < m_zeroStart)
+        {
+          block = &m_data[m_current];
+          blockEnd = std::min (end, m_zeroStart);
+        }
+      else if (m_current < m_zeroEnd)
+        {
+          blockEnd = std::min (end, m_zeroEnd);
+        }
+      else
+        {
+          block = &m_data[m_current - (m_zeroEnd - m_zeroStart)];
+          blockEnd = end;
+        }
+      uint32_t len = blockEnd - m_current;
+      if (block != 0)
+        {
+          uint16_t partial = ChecksumBlock (block, len);
+          if (odd)
+            {
+              // A block starting on an odd offset contributes its
+              // byte-swapped sum (RFC 1071, section 2.B)
+              partial = static_cast<uint16_t> ((partial >> 8) | (partial << 8));
+            }
+          sum += partial;
+        }
+      odd ^= (len & 1);
+      m_current = blockEnd;
+    }
 
   while (sum >> 16)
     sum = (sum & 0xffff) + (sum >> 16);
-  return ~sum;
+  return ~static_cast<uint16_t> (sum);
 }
 
 uint32_t 
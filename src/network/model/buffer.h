@@ -678,6 +678,10 @@ private:
      * end of the area in which user bytes were written.
      */
     uint32_t m_dirtyEnd;
+    /**
+     * Whether this instance is accounted by ns3::MemoryAccounting.
+     */
+    bool m_accounted;
     /**
      * The real data buffer holds _at least_ one byte.
      * Its real size is stored in the m_size field.
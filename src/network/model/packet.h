@@ -33,6 +33,7 @@
 #include "ns3/callback.h"
 #include "ns3/assert.h"
 #include "ns3/ptr.h"
+#include "ns3/arena-allocator.h"
 #include "ns3/deprecated.h"
 
 namespace ns3 {
@@ -227,8 +228,10 @@ private:
  *
  * The performance aspects copy-on-write semantics of the
  * Packet API are discussed in \ref packetperf
+ *
+ * The packets are allocated by ns3::ArenaAllocator.
  */
-class Packet : public SimpleRefCount<Packet>
+class Packet : public SimpleRefCount<Packet>, public ArenaAllocated
 {
 public:
 
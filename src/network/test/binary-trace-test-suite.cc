@@ -0,0 +1,142 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/names.h"
+#include "ns3/string.h"
+#include "ns3/packet.h"
+#include "ns3/drop-tail-queue.h"
+#include "ns3/binary-trace-recorder.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Test case to make sure that the events of the trace sources
+ * connected to a BinaryTraceRecorder are recorded, and that the most recent
+ * records are kept when the ring wraps around.
+ */
+class BinaryTraceRecorderTestCase : public TestCase
+{
+public:
+  BinaryTraceRecorderTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * \brief Enqueue a packet whose first byte is the given value
+   * \param value the value of the first byte
+   */
+  void Enqueue (uint8_t value);
+
+  Ptr<Queue<Packet> > m_queue;  //!< the queue whose traces are recorded
+  std::vector<uint64_t> m_uids; //!< the uids of the packets enqueued
+};
+
+BinaryTraceRecorderTestCase::BinaryTraceRecorderTestCase ()
+  : TestCase ("Check that binary trace files can be written and converted")
+{
+}
+
+void
+BinaryTraceRecorderTestCase::Enqueue (uint8_t value)
+{
+  uint8_t data[40] = { value };
+  Ptr<Packet> p = Create<Packet> (data, sizeof (data));
+  m_uids.push_back (p->GetUid ());
+  m_queue->Enqueue (p);
+}
+
+void
+BinaryTraceRecorderTestCase::DoRun (void)
+{
+  m_queue = CreateObject<DropTailQueue<Packet> > ();
+  m_queue->SetAttribute ("MaxSize", StringValue ("8p"));
+  Names::Add ("BinaryTraceQueue", m_queue);
+
+  std::string filename = CreateTempDirFilename ("trace.bin");
+  Ptr<BinaryTraceRecorder> recorder = Create<BinaryTraceRecorder> ();
+  NS_TEST_ASSERT_MSG_EQ (recorder->Open (filename, 4), true, "Unable to open " << filename);
+  uint16_t enqueue = recorder->Connect ("/Names/BinaryTraceQueue/Enqueue");
+  uint16_t drop = recorder->Connect ("/Names/BinaryTraceQueue/Drop");
+  NS_TEST_EXPECT_MSG_EQ (enqueue, 0, "Unexpected identifier of the first path");
+  NS_TEST_EXPECT_MSG_EQ (drop, 1, "Unexpected identifier of the second path");
+
+  // 8 packets are enqueued and 2 are dropped, only the last 4 events are kept
+  const uint64_t period = 1000000001;
+  for (uint32_t i = 0; i < 10; ++i)
+    {
+      Simulator::Schedule (NanoSeconds (period * i), &BinaryTraceRecorderTestCase::Enqueue, this, i);
+    }
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (recorder->GetNRecords (), 10, "Unexpected number of events");
+  recorder->Close ();
+  Simulator::Destroy ();
+
+  std::string zeros (2 * (BinaryTraceRecorder::HEADER_BYTES - 1), '0');
+  std::ostringstream expected;
+  expected << "time,context,trace,uid,size,header" << std::endl;
+  for (uint32_t i = 6; i < 10; ++i)
+    {
+      std::string trace = i < 8 ? "/Names/BinaryTraceQueue/Enqueue" : "/Names/BinaryTraceQueue/Drop";
+      expected << period * i << "," << trace << "," << trace << "," << m_uids[i]
+               << ",40,0" << i << zeros << std::endl;
+    }
+  std::ostringstream csv;
+  NS_TEST_ASSERT_MSG_EQ (BinaryTraceRecorder::Convert (filename, csv, true), true,
+                         "Unable to convert " << filename);
+  NS_TEST_EXPECT_MSG_EQ (csv.str (), expected.str (), "Unexpected CSV output");
+
+  std::ostringstream lastLine;
+  lastLine << "9.000000009 /Names/BinaryTraceQueue/Drop trace=/Names/BinaryTraceQueue/Drop uid=" << m_uids[9]
+           << " size=40 header=09" << zeros << std::endl;
+  std::ostringstream text;
+  NS_TEST_ASSERT_MSG_EQ (BinaryTraceRecorder::Convert (filename, text), true,
+                         "Unable to convert " << filename);
+  NS_TEST_ASSERT_MSG_GT (text.str ().size (), lastLine.str ().size (), "Text output too short");
+  NS_TEST_EXPECT_MSG_EQ (text.str ().substr (text.str ().size () - lastLine.str ().size ()),
+                         lastLine.str (), "Unexpected text output");
+
+  m_queue = 0;
+  remove (filename.c_str ());
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Binary trace recorder TestSuite
+ */
+class BinaryTraceTestSuite : public TestSuite
+{
+public:
+  BinaryTraceTestSuite ();
+};
+
+BinaryTraceTestSuite::BinaryTraceTestSuite ()
+  : TestSuite ("binary-trace", UNIT)
+{
+  AddTestCase (new BinaryTraceRecorderTestCase, TestCase::QUICK);
+}
+
+static BinaryTraceTestSuite g_binaryTraceTestSuite; //!< Static variable for test initialization
@@ -387,6 +387,44 @@ BufferTest::DoRun (void)
   val2 <<= 8;
   val2 |= i.ReadU8 ();
   NS_TEST_ASSERT_MSG_EQ (val1, val2, "Bad ReadNtohU16()");
+
+  // Checksum over data and zero area, starting on even and odd offsets
+  buffer = Buffer (5);
+  buffer.AddAtStart (3);
+  i = buffer.Begin ();
+  i.WriteU8 (0xab);
+  i.WriteU8 (0xcd);
+  i.WriteU8 (0xef);
+  buffer.AddAtEnd (3);
+  i = buffer.End ();
+  i.Prev (3);
+  i.WriteU8 (0x12);
+  i.WriteU8 (0x34);
+  i.WriteU8 (0x56);
+  for (uint32_t offset = 0; offset < 2; offset++)
+    {
+      uint32_t sum = 0;
+      i = buffer.Begin ();
+      i.Next (offset);
+      uint16_t checksumSize = static_cast<uint16_t> (buffer.GetSize () - offset);
+      for (uint16_t j = 0; j < checksumSize / 2; j++)
+        {
+          sum += i.ReadU16 ();
+        }
+      if (checksumSize & 1)
+        {
+          sum += i.ReadU8 ();
+        }
+      while (sum >> 16)
+        {
+          sum = (sum & 0xffff) + (sum >> 16);
+        }
+      uint16_t expected = static_cast<uint16_t> (~sum);
+      i = buffer.Begin ();
+      i.Next (offset);
+      NS_TEST_ASSERT_MSG_EQ (i.CalculateIpChecksum (checksumSize), expected, "Bad CalculateIpChecksum()");
+      NS_TEST_ASSERT_MSG_EQ (i.IsEnd (), true, "CalculateIpChecksum() did not consume the data");
+    }
 }
 
 /**
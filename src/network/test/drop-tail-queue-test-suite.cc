@@ -19,6 +19,7 @@
 #include "ns3/test.h"
 #include "ns3/drop-tail-queue.h"
 #include "ns3/string.h"
+#include <deque>
 
 using namespace ns3;
 
@@ -83,6 +84,75 @@ DropTailQueueTestCase::DoRun (void)
   NS_TEST_EXPECT_MSG_EQ ((packet == 0), true, "There are really no packets in there");
 }
 
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * DropTailQueue test on many interleaved enqueue and dequeue operations,
+ * which make the storage of the queue grow and shrink several times.
+ */
+class DropTailQueueOrderTestCase : public TestCase
+{
+public:
+  DropTailQueueOrderTestCase ();
+  virtual void DoRun (void);
+};
+
+DropTailQueueOrderTestCase::DropTailQueueOrderTestCase ()
+  : TestCase ("Check the order of the packets when the drop tail queue grows and shrinks")
+{
+}
+
+void
+DropTailQueueOrderTestCase::DoRun (void)
+{
+  Ptr<DropTailQueue<Packet> > queue = CreateObject<DropTailQueue<Packet> > ();
+  queue->SetMaxSize (QueueSize ("1000p"));
+
+  std::deque<uint64_t> expected;
+  uint32_t bytes = 0;
+  for (uint32_t round = 0; round < 4; round++)
+    {
+      // fill the queue, dequeuing one packet every three enqueues
+      for (uint32_t i = 0; queue->GetNPackets () < 1000; i++)
+        {
+          Ptr<Packet> p = Create<Packet> (1 + i % 100);
+          NS_TEST_EXPECT_MSG_EQ (queue->Enqueue (p), true, "The packet should be enqueued");
+          expected.push_back (p->GetUid ());
+          bytes += p->GetSize ();
+          if (i % 3 == 2)
+            {
+              Ptr<Packet> packet = queue->Dequeue ();
+              NS_TEST_ASSERT_MSG_EQ (packet->GetUid (), expected.front (), "Packets should leave in FIFO order");
+              expected.pop_front ();
+              bytes -= packet->GetSize ();
+            }
+        }
+      NS_TEST_EXPECT_MSG_EQ (queue->Enqueue (Create<Packet> ()), false, "The queue should be full");
+      NS_TEST_EXPECT_MSG_EQ (queue->GetNBytes (), bytes, "Wrong number of bytes in the queue");
+      NS_TEST_EXPECT_MSG_EQ (queue->Peek ()->GetUid (), expected.front (), "Wrong packet at the head");
+
+      // empty the queue, enqueuing one packet every three dequeues
+      for (uint32_t i = 0; !queue->IsEmpty (); i++)
+        {
+          Ptr<Packet> packet = queue->Dequeue ();
+          NS_TEST_ASSERT_MSG_EQ (packet->GetUid (), expected.front (), "Packets should leave in FIFO order");
+          expected.pop_front ();
+          bytes -= packet->GetSize ();
+          if (i % 3 == 2 && i < 1500)
+            {
+              Ptr<Packet> p = Create<Packet> (1 + i % 100);
+              queue->Enqueue (p);
+              expected.push_back (p->GetUid ());
+              bytes += p->GetSize ();
+            }
+        }
+      NS_TEST_EXPECT_MSG_EQ (expected.size (), 0, "All the packets should have been dequeued");
+      NS_TEST_EXPECT_MSG_EQ (queue->GetNBytes (), 0, "There should be no bytes in there");
+    }
+  NS_TEST_EXPECT_MSG_EQ (queue->GetTotalDroppedPackets (), 4, "Only the packets sent to a full queue are dropped");
+}
+
 /**
  * \ingroup network-test
  * \ingroup tests
@@ -96,6 +166,7 @@ public:
     : TestSuite ("drop-tail-queue", UNIT)
   {
     AddTestCase (new DropTailQueueTestCase (), TestCase::QUICK);
+    AddTestCase (new DropTailQueueOrderTestCase (), TestCase::QUICK);
   }
 };
 
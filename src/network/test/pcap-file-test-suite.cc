@@ -21,10 +21,21 @@
 #include <cstdlib>
 #include <sstream>
 #include <cstring>
+#include <fstream>
 
 #include "ns3/log.h"
 #include "ns3/test.h"
+#include "ns3/core-config.h"
+#include "ns3/global-value.h"
+#include "ns3/uinteger.h"
+#include "ns3/packet.h"
 #include "ns3/pcap-file.h"
+#include "ns3/output-stream-wrapper.h"
+#include "ns3/network-config.h"
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif /* HAVE_ZLIB */
 
 using namespace ns3;
 
@@ -1144,6 +1155,321 @@ DiffTestCase::DoRun (void)
   NS_TEST_EXPECT_MSG_EQ (usec, 3696, "Files are different from 2.3696 seconds");
 }
 
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Test case to make sure that a pcap file written asynchronously
+ * is identical to the same file written synchronously.
+ */
+class AsyncWriteTestCase : public TestCase
+{
+public:
+  AsyncWriteTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+AsyncWriteTestCase::AsyncWriteTestCase ()
+  : TestCase ("Check that PcapFile::SetAsyncWrite produces the same file as synchronous writes")
+{
+}
+
+void
+AsyncWriteTestCase::DoRun (void)
+{
+  std::string syncFilename = CreateTempDirFilename ("sync.pcap");
+  std::string asyncFilename = CreateTempDirFilename ("async.pcap");
+
+  for (uint32_t bufferSize = 0; bufferSize <= 40; bufferSize += 40)
+    {
+      PcapFile f;
+      f.SetAsyncWrite (bufferSize);
+      std::string filename = bufferSize ? asyncFilename : syncFilename;
+
+      f.Open (filename, std::ios::out);
+      NS_TEST_ASSERT_MSG_EQ (f.Fail (), false, "Open (" << filename << ", \"std::ios::out\") returns error");
+      f.Init (1, N_PACKET_BYTES);
+      NS_TEST_ASSERT_MSG_EQ (f.Fail (), false, "Init (1, " << N_PACKET_BYTES << ") returns error");
+
+      for (uint32_t i = 0; i < N_KNOWN_PACKETS; ++i)
+        {
+          PacketEntry const & p = knownPackets[i];
+
+          f.Write (p.tsSec, p.tsUsec, (uint8_t const *)p.data, p.origLen);
+          NS_TEST_EXPECT_MSG_EQ (f.Fail (), false, "Write must not fail");
+        }
+      f.Close ();
+      NS_TEST_EXPECT_MSG_EQ (f.Fail (), false, "Close must not fail");
+    }
+
+  //
+  // 24 bytes of file header and, for each packet, 16 bytes of record header
+  // and N_PACKET_BYTES bytes of (truncated) packet data.
+  //
+  uint64_t size = 24 + N_KNOWN_PACKETS * (16 + N_PACKET_BYTES);
+  NS_TEST_EXPECT_MSG_EQ (CheckFileLength (asyncFilename, size), true,
+                         "Asynchronously written file has unexpected length");
+
+  uint32_t sec (0), usec (0), packets (0);
+  bool diff = PcapFile::Diff (syncFilename, asyncFilename, sec, usec, packets);
+  NS_TEST_EXPECT_MSG_EQ (diff, false, "Asynchronously written file differs from synchronously written file");
+  NS_TEST_EXPECT_MSG_EQ (packets, N_KNOWN_PACKETS, "Unexpected number of packets compared");
+
+  remove (syncFilename.c_str ());
+  remove (asyncFilename.c_str ());
+
+  //
+  // Errors must be reported when the file cannot be created
+  //
+  PcapFile f;
+  f.SetAsyncWrite (40);
+  std::string badFilename = CreateTempDirFilename ("no-such-directory/async.pcap");
+  f.Open (badFilename, std::ios::out);
+  NS_TEST_EXPECT_MSG_EQ (f.Fail (), true, "Open (" << badFilename << ", \"std::ios::out\") must fail");
+  f.Clear ();
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Test case to make sure that many pcap files can be written
+ * asynchronously while few files are kept open, and that the packets
+ * are truncated to the snapshot length when they are captured.
+ */
+class AsyncManyFilesTestCase : public TestCase
+{
+public:
+  AsyncManyFilesTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+AsyncManyFilesTestCase::AsyncManyFilesTestCase ()
+  : TestCase ("Check that many pcap files can be written asynchronously")
+{
+}
+
+void
+AsyncManyFilesTestCase::DoRun (void)
+{
+  const uint32_t nFiles = 10;
+  const uint32_t nRecords = 5;
+  const uint32_t snapLen = 16;
+  const uint32_t packetSize = 100;
+
+#ifdef HAVE_PTHREAD_H
+  UintegerValue maxOpenFiles;
+  GlobalValue::GetValueByName ("PcapMaxOpenFiles", maxOpenFiles);
+  GlobalValue::Bind ("PcapMaxOpenFiles", UintegerValue (3));
+#endif /* HAVE_PTHREAD_H */
+
+  std::vector<std::string> filenames;
+  std::vector<PcapFile *> files;
+  for (uint32_t i = 0; i < nFiles; ++i)
+    {
+      std::stringstream filename;
+      filename << "async-" << i << ".pcap";
+      filenames.push_back (CreateTempDirFilename (filename.str ()));
+
+      PcapFile *f = new PcapFile;
+      // each record fills the buffer, hence every write is handed over
+      f->SetAsyncWrite (1);
+      f->Open (filenames.back (), std::ios::out);
+      NS_TEST_ASSERT_MSG_EQ (f->Fail (), false, "Open (" << filenames.back () << ", \"std::ios::out\") returns error");
+      f->Init (1, snapLen);
+      files.push_back (f);
+    }
+
+  uint8_t data[packetSize];
+  for (uint32_t j = 0; j < nRecords; ++j)
+    {
+      for (uint32_t i = 0; i < nFiles; ++i)
+        {
+          for (uint32_t k = 0; k < packetSize; ++k)
+            {
+              data[k] = static_cast<uint8_t> (i + j + k);
+            }
+          files[i]->Write (j, i, Create<Packet> (data, packetSize));
+          NS_TEST_EXPECT_MSG_EQ (files[i]->Fail (), false, "Write must not fail");
+        }
+    }
+
+  for (uint32_t i = 0; i < nFiles; ++i)
+    {
+      files[i]->Close ();
+      NS_TEST_EXPECT_MSG_EQ (files[i]->Fail (), false, "Close must not fail");
+      delete files[i];
+    }
+
+#ifdef HAVE_PTHREAD_H
+  GlobalValue::Bind ("PcapMaxOpenFiles", maxOpenFiles);
+#endif /* HAVE_PTHREAD_H */
+
+  uint32_t tsSec, tsUsec, inclLen, origLen, readLen;
+  for (uint32_t i = 0; i < nFiles; ++i)
+    {
+      PcapFile f;
+      f.Open (filenames[i], std::ios::in);
+      NS_TEST_ASSERT_MSG_EQ (f.Fail (), false, "Open (" << filenames[i] << ", \"std::ios::in\") returns error");
+      NS_TEST_EXPECT_MSG_EQ (f.GetSnapLen (), snapLen, "Unexpected snapshot length");
+
+      for (uint32_t j = 0; j < nRecords; ++j)
+        {
+          f.Read (data, packetSize, tsSec, tsUsec, inclLen, origLen, readLen);
+          NS_TEST_ASSERT_MSG_EQ (f.Fail (), false, "Read() of asynchronously written file returns error");
+          NS_TEST_EXPECT_MSG_EQ (tsSec, j, "Incorrectly read seconds timestamp");
+          NS_TEST_EXPECT_MSG_EQ (tsUsec, i, "Incorrectly read microseconds timestamp");
+          NS_TEST_EXPECT_MSG_EQ (inclLen, snapLen, "Packet not truncated to the snapshot length");
+          NS_TEST_EXPECT_MSG_EQ (origLen, packetSize, "Incorrect original length");
+          for (uint32_t k = 0; k < readLen; ++k)
+            {
+              NS_TEST_EXPECT_MSG_EQ (static_cast<uint32_t> (data[k]), (i + j + k) % 256,
+                                     "Incorrect packet data");
+            }
+        }
+
+      f.Read (data, 1, tsSec, tsUsec, inclLen, origLen, readLen);
+      NS_TEST_EXPECT_MSG_EQ (f.Eof (), true, "Asynchronously written file has trailing data");
+      f.Close ();
+      remove (filenames[i].c_str ());
+    }
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Test case to make sure that compressed pcap and ascii trace files
+ * are written in gzip format, with the same content as uncompressed files.
+ */
+class CompressedWriteTestCase : public TestCase
+{
+public:
+  CompressedWriteTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * \brief Decompress a gzip file
+   * \param gzFilename the name of the compressed file
+   * \param filename the name of the decompressed file to create
+   * \return true if the file could be decompressed
+   */
+  bool Decompress (std::string gzFilename, std::string filename);
+};
+
+CompressedWriteTestCase::CompressedWriteTestCase ()
+  : TestCase ("Check that compressed trace files can be written")
+{
+}
+
+bool
+CompressedWriteTestCase::Decompress (std::string gzFilename, std::string filename)
+{
+#ifdef HAVE_ZLIB
+  gzFile in = gzopen (gzFilename.c_str (), "rb");
+  FILE *out = std::fopen (filename.c_str (), "wb");
+  bool ok = in != 0 && out != 0;
+  char buffer[4096];
+  int n;
+  while (ok && (n = gzread (in, buffer, sizeof (buffer))) != 0)
+    {
+      ok = n > 0 && std::fwrite (buffer, 1, n, out) == static_cast<std::size_t> (n);
+    }
+  if (in != 0)
+    {
+      gzclose (in);
+    }
+  if (out != 0)
+    {
+      std::fclose (out);
+    }
+  return ok;
+#else
+  return false;
+#endif /* HAVE_ZLIB */
+}
+
+void
+CompressedWriteTestCase::DoRun (void)
+{
+#if defined (HAVE_ZLIB) && defined (HAVE_PTHREAD_H)
+  std::string syncFilename = CreateTempDirFilename ("uncompressed.pcap");
+  std::string gzFilename = CreateTempDirFilename ("compressed.pcap.gz");
+  std::string gunzipFilename = CreateTempDirFilename ("decompressed.pcap");
+
+  for (uint32_t bufferSize = 0; bufferSize <= 40; bufferSize += 40)
+    {
+      PcapFile f;
+      f.SetAsyncWrite (bufferSize);
+      std::string filename = bufferSize ? gzFilename : syncFilename;
+
+      f.Open (filename, std::ios::out);
+      NS_TEST_ASSERT_MSG_EQ (f.Fail (), false, "Open (" << filename << ", \"std::ios::out\") returns error");
+      f.Init (1, N_PACKET_BYTES);
+      NS_TEST_ASSERT_MSG_EQ (f.Fail (), false, "Init (1, " << N_PACKET_BYTES << ") returns error");
+
+      for (uint32_t i = 0; i < N_KNOWN_PACKETS; ++i)
+        {
+          PacketEntry const & p = knownPackets[i];
+
+          f.Write (p.tsSec, p.tsUsec, (uint8_t const *)p.data, p.origLen);
+          NS_TEST_EXPECT_MSG_EQ (f.Fail (), false, "Write must not fail");
+        }
+      f.Close ();
+      NS_TEST_EXPECT_MSG_EQ (f.Fail (), false, "Close must not fail");
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (Decompress (gzFilename, gunzipFilename), true,
+                         "Compressed pcap file is not a valid gzip file");
+  uint32_t sec (0), usec (0), packets (0);
+  bool diff = PcapFile::Diff (syncFilename, gunzipFilename, sec, usec, packets);
+  NS_TEST_EXPECT_MSG_EQ (diff, false, "Compressed file differs from uncompressed file");
+  NS_TEST_EXPECT_MSG_EQ (packets, N_KNOWN_PACKETS, "Unexpected number of packets compared");
+
+  remove (syncFilename.c_str ());
+  remove (gzFilename.c_str ());
+  remove (gunzipFilename.c_str ());
+
+  //
+  // Ascii traces, flushed at every line and larger than the write buffer
+  //
+  std::string asciiGzFilename = CreateTempDirFilename ("compressed.tr.gz");
+  std::string asciiFilename = CreateTempDirFilename ("decompressed.tr");
+  const uint32_t nLines = 100000;
+  {
+    Ptr<OutputStreamWrapper> stream = Create<OutputStreamWrapper> (asciiGzFilename, std::ios::out);
+    for (uint32_t i = 0; i < nLines; ++i)
+      {
+        *stream->GetStream () << "line " << i << std::endl;
+      }
+    NS_TEST_EXPECT_MSG_EQ (stream->GetStream ()->fail (), false, "Ascii trace write must not fail");
+  }
+
+  NS_TEST_ASSERT_MSG_EQ (Decompress (asciiGzFilename, asciiFilename), true,
+                         "Compressed ascii trace file is not a valid gzip file");
+  std::ifstream in (asciiFilename.c_str ());
+  std::string line;
+  uint32_t nRead = 0;
+  while (std::getline (in, line))
+    {
+      std::ostringstream expected;
+      expected << "line " << nRead;
+      NS_TEST_ASSERT_MSG_EQ (line, expected.str (), "Unexpected line in ascii trace file");
+      ++nRead;
+    }
+  NS_TEST_EXPECT_MSG_EQ (nRead, nLines, "Unexpected number of lines in ascii trace file");
+  in.close ();
+
+  remove (asciiGzFilename.c_str ());
+  remove (asciiFilename.c_str ());
+#endif /* HAVE_ZLIB && HAVE_PTHREAD_H */
+}
+
 /**
  * \ingroup network-test
  * \ingroup tests
@@ -1167,6 +1493,9 @@ PcapFileTestSuite::PcapFileTestSuite ()
   AddTestCase (new RecordHeaderTestCase, TestCase::QUICK);
   AddTestCase (new ReadFileTestCase, TestCase::QUICK);
   AddTestCase (new DiffTestCase, TestCase::QUICK);
+  AddTestCase (new AsyncWriteTestCase, TestCase::QUICK);
+  AddTestCase (new AsyncManyFilesTestCase, TestCase::QUICK);
+  AddTestCase (new CompressedWriteTestCase, TestCase::QUICK);
 }
 
 static PcapFileTestSuite pcapFileTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,439 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <set>
+#include <sstream>
+#include <vector>
+
+#include "ns3/test.h"
+#include "ns3/core-config.h"
+#include "ns3/network-config.h"
+#include "ns3/simulator.h"
+#include "ns3/packet.h"
+#include "ns3/node-container.h"
+#include "ns3/net-device-container.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/trace-helper.h"
+#include "ns3/pcapng-file.h"
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif /* HAVE_ZLIB */
+
+using namespace ns3;
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief A block read from a pcapng file
+ */
+struct PcapNgBlock
+{
+  uint32_t type;              //!< Block type
+  std::vector<uint8_t> body;  //!< Block body (without type and lengths)
+};
+
+/**
+ * \brief Read a 32 bit value in host byte order
+ * \param data the data
+ * \param offset the offset of the value
+ * \returns the value
+ */
+static uint32_t
+Get32 (std::vector<uint8_t> const &data, uint32_t offset)
+{
+  uint32_t value;
+  std::memcpy (&value, &data[offset], sizeof (value));
+  return value;
+}
+
+/**
+ * \brief Read the blocks of a pcapng file written in host byte order
+ * \param filename the name of the file
+ * \param blocks [out] the blocks read
+ * \returns true if the file could be read and its block lengths are consistent
+ */
+static bool
+ReadPcapNgFile (std::string const &filename, std::vector<PcapNgBlock> &blocks)
+{
+  std::ifstream is (filename.c_str (), std::ios::binary);
+  std::vector<uint8_t> data ((std::istreambuf_iterator<char> (is)), std::istreambuf_iterator<char> ());
+  blocks.clear ();
+
+  uint32_t offset = 0;
+  while (offset + 12 <= data.size ())
+    {
+      uint32_t length = Get32 (data, offset + 4);
+      if (length < 12 || length % 4 != 0 || offset + length > data.size ()
+          || Get32 (data, offset + length - 4) != length)
+        {
+          return false;
+        }
+      PcapNgBlock block;
+      block.type = Get32 (data, offset);
+      block.body.assign (data.begin () + offset + 8, data.begin () + offset + length - 4);
+      blocks.push_back (block);
+      offset += length;
+    }
+  return is && offset == data.size () && !blocks.empty ();
+}
+
+/**
+ * \brief Decompress a gzip file
+ * \param gzFilename the name of the compressed file
+ * \param filename the name of the decompressed file to create
+ * \returns true if the file could be decompressed
+ */
+static bool
+Decompress (std::string const &gzFilename, std::string const &filename)
+{
+#ifdef HAVE_ZLIB
+  gzFile in = gzopen (gzFilename.c_str (), "rb");
+  std::ofstream out (filename.c_str (), std::ios::binary);
+  bool ok = in != 0 && out;
+  char buffer[4096];
+  int n;
+  while (ok && (n = gzread (in, buffer, sizeof (buffer))) != 0)
+    {
+      ok = n > 0 && out.write (buffer, n);
+    }
+  if (in != 0)
+    {
+      gzclose (in);
+    }
+  return ok;
+#else
+  return false;
+#endif /* HAVE_ZLIB */
+}
+
+/**
+ * \brief Get the value of the if_name option of an Interface Description Block
+ * \param block the block
+ * \returns the name of the interface
+ */
+static std::string
+GetInterfaceName (PcapNgBlock const &block)
+{
+  uint32_t offset = 8;
+  while (offset + 4 <= block.body.size ())
+    {
+      uint16_t code, length;
+      std::memcpy (&code, &block.body[offset], sizeof (code));
+      std::memcpy (&length, &block.body[offset + 2], sizeof (length));
+      if (code == 2)
+        {
+          return std::string (block.body.begin () + offset + 4, block.body.begin () + offset + 4 + length);
+        }
+      if (code == 0)
+        {
+          break;
+        }
+      offset += 4 + ((length + 3) & ~3u);
+    }
+  return "";
+}
+
+/**
+ * \brief Count the packets of an interface of a pcapng file
+ * \param blocks the blocks of the file
+ * \param name the name of the interface
+ * \param dataLinkType [out] the link type of the interface
+ * \param length [out] the original length of the last packet of the interface
+ * \returns the number of packets of the interface, or -1 if it is not found
+ */
+static int32_t
+CountInterfacePackets (std::vector<PcapNgBlock> const &blocks, std::string const &name,
+                       uint32_t &dataLinkType, uint32_t &length)
+{
+  uint32_t interface = 0;
+  int32_t packets = -1;
+  for (uint32_t j = 0; j < blocks.size (); ++j)
+    {
+      if (blocks[j].type == 1 && GetInterfaceName (blocks[j]) == name)
+        {
+          dataLinkType = Get32 (blocks[j].body, 0) & 0xffff;
+          packets = 0;
+        }
+      else if (blocks[j].type == 1 && packets < 0)
+        {
+          interface++;
+        }
+      else if (blocks[j].type == 6 && packets >= 0 && Get32 (blocks[j].body, 0) == interface)
+        {
+          length = Get32 (blocks[j].body, 16);
+          packets++;
+        }
+    }
+  return packets;
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Test case to make sure that PcapNgFile writes the interfaces and
+ * the packets of several interfaces in a single file, possibly compressed.
+ */
+class PcapNgFileTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   * \param compress whether to write the file in gzip format
+   */
+  PcapNgFileTestCase (bool compress);
+
+private:
+  virtual void DoRun (void);
+
+  bool m_compress; //!< Whether to write the file in gzip format
+};
+
+PcapNgFileTestCase::PcapNgFileTestCase (bool compress)
+  : TestCase (std::string ("Check that PcapNgFile writes the blocks of several interfaces")
+              + (compress ? " in gzip format" : "")),
+    m_compress (compress)
+{
+}
+
+void
+PcapNgFileTestCase::DoRun (void)
+{
+#if !defined (HAVE_ZLIB) || !defined (HAVE_PTHREAD_H)
+  if (m_compress)
+    {
+      return;
+    }
+#endif /* !HAVE_ZLIB || !HAVE_PTHREAD_H */
+  std::string filename = CreateTempDirFilename ("interfaces.pcapng");
+  std::string gzFilename = filename + ".gz";
+  uint8_t data[40];
+  for (uint32_t i = 0; i < sizeof (data); ++i)
+    {
+      data[i] = i;
+    }
+
+  {
+    // a small buffer, so that it is written several times
+    Ptr<PcapNgFile> f = Create<PcapNgFile> ();
+    f->Open (m_compress ? gzFilename : filename, 64);
+    NS_TEST_ASSERT_MSG_EQ (f->Fail (), false, "Open (" << filename << ") returns error");
+    NS_TEST_EXPECT_MSG_EQ (f->AddInterface (1, 16, "first"), 0, "Unexpected interface identifier");
+    NS_TEST_EXPECT_MSG_EQ (f->AddInterface (9, 65535, "second"), 1, "Unexpected interface identifier");
+    NS_TEST_EXPECT_MSG_EQ (f->GetNInterfaces (), 2, "Unexpected number of interfaces");
+
+    for (uint32_t i = 0; i < 4; ++i)
+      {
+        f->Write (i % 2, 1000000000ULL * i + 7, data, i % 2 ? 5 : 40);
+      }
+    f->Write (1, 5000000000ULL, Create<Packet> (data, 6));
+    NS_TEST_EXPECT_MSG_EQ (f->Fail (), false, "Write must not fail");
+    f->Close ();
+    NS_TEST_EXPECT_MSG_EQ (f->Fail (), false, "Close must not fail");
+  }
+
+  if (m_compress)
+    {
+      NS_TEST_ASSERT_MSG_EQ (Decompress (gzFilename, filename), true, "Compressed pcapng file is not a valid gzip file");
+      std::remove (gzFilename.c_str ());
+    }
+
+  std::vector<PcapNgBlock> blocks;
+  NS_TEST_ASSERT_MSG_EQ (ReadPcapNgFile (filename, blocks), true, "Malformed pcapng file");
+  NS_TEST_ASSERT_MSG_EQ (blocks.size (), 8, "Unexpected number of blocks");
+
+  NS_TEST_EXPECT_MSG_EQ (blocks[0].type, 0x0a0d0d0a, "First block is not a Section Header Block");
+  NS_TEST_EXPECT_MSG_EQ (Get32 (blocks[0].body, 0), 0x1a2b3c4d, "Unexpected byte-order magic");
+
+  NS_TEST_EXPECT_MSG_EQ (blocks[1].type, 1, "Second block is not an Interface Description Block");
+  NS_TEST_EXPECT_MSG_EQ (Get32 (blocks[1].body, 0), 1, "Unexpected link type");
+  NS_TEST_EXPECT_MSG_EQ (Get32 (blocks[1].body, 4), 16, "Unexpected snapshot length");
+  NS_TEST_EXPECT_MSG_EQ (GetInterfaceName (blocks[1]), "first", "Unexpected interface name");
+  NS_TEST_EXPECT_MSG_EQ (blocks[2].type, 1, "Third block is not an Interface Description Block");
+  NS_TEST_EXPECT_MSG_EQ (Get32 (blocks[2].body, 0), 9, "Unexpected link type");
+  NS_TEST_EXPECT_MSG_EQ (GetInterfaceName (blocks[2]), "second", "Unexpected interface name");
+
+  for (uint32_t i = 0; i < 5; ++i)
+    {
+      PcapNgBlock const &block = blocks[3 + i];
+      uint32_t interface = i < 4 ? i % 2 : 1;
+      uint64_t timestamp = i < 4 ? 1000000000ULL * i + 7 : 5000000000ULL;
+      uint32_t origLen = i < 4 ? (i % 2 ? 5 : 40) : 6;
+      uint32_t inclLen = interface == 0 ? 16 : origLen;
+
+      NS_TEST_EXPECT_MSG_EQ (block.type, 6, "Not an Enhanced Packet Block");
+      NS_TEST_EXPECT_MSG_EQ (Get32 (block.body, 0), interface, "Unexpected interface");
+      NS_TEST_EXPECT_MSG_EQ ((uint64_t (Get32 (block.body, 4)) << 32) + Get32 (block.body, 8), timestamp,
+                             "Unexpected timestamp");
+      NS_TEST_EXPECT_MSG_EQ (Get32 (block.body, 12), inclLen, "Unexpected captured length");
+      NS_TEST_EXPECT_MSG_EQ (Get32 (block.body, 16), origLen, "Unexpected original length");
+      NS_TEST_EXPECT_MSG_EQ (block.body.size (), 20 + ((inclLen + 3) & ~3u), "Unexpected block length");
+      NS_TEST_EXPECT_MSG_EQ (std::memcmp (&block.body[20], data, inclLen), 0, "Unexpected packet data");
+    }
+
+  std::remove (filename.c_str ());
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Device helper creating the pcap files of simple net devices,
+ * which are kept to write packets to them directly.
+ */
+class PcapNgTestHelper : public PcapHelperForDevice
+{
+public:
+  std::vector<Ptr<PcapFileWrapper> > m_files; //!< Files created
+
+private:
+  virtual void EnablePcapInternal (std::string prefix, Ptr<NetDevice> nd, bool promiscuous, bool explicitFilename)
+  {
+    PcapHelper pcapHelper;
+    std::string filename = pcapHelper.GetFilenameFromDevice (prefix, nd);
+    m_files.push_back (pcapHelper.CreateFile (filename, std::ios::out, PcapHelper::DLT_EN10MB));
+  }
+};
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Test case to make sure that the pcap helpers record the traces of
+ * the devices and of the interfaces (as the internet helpers name them) of
+ * a range of nodes in a single pcapng file.
+ */
+class PcapNgHelperTestCase : public TestCase
+{
+public:
+  PcapNgHelperTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+PcapNgHelperTestCase::PcapNgHelperTestCase ()
+  : TestCase ("Check that PcapHelper::EnablePcapNg records the devices of a range of nodes in a pcapng file")
+{
+}
+
+void
+PcapNgHelperTestCase::DoRun (void)
+{
+  const uint32_t nodesPerFile = 2;
+  std::string prefix = CreateTempDirFilename ("pcapng-helper");
+
+  NodeContainer nodes;
+  nodes.Create (2 * nodesPerFile);
+  SimpleNetDeviceHelper simple;
+  NetDeviceContainer devices = simple.Install (nodes);
+
+  PcapHelper::EnablePcapNg (prefix, nodesPerFile);
+  PcapNgTestHelper helper;
+  helper.EnablePcap (prefix, nodes);
+  // the traces of the IPv4 and IPv6 helpers, named after the interfaces
+  std::vector<Ptr<PcapFileWrapper> > interfaceFiles;
+  std::vector<std::string> interfaceNames;
+  for (uint32_t i = 0; i < nodes.GetN (); ++i)
+    {
+      PcapHelper pcapHelper;
+      std::string filename = pcapHelper.GetFilenameFromInterfacePair (prefix, nodes.Get (i), 1);
+      interfaceFiles.push_back (pcapHelper.CreateFile (filename, std::ios::out, PcapHelper::DLT_RAW));
+      interfaceNames.push_back (filename.substr (0, filename.size () - 5));
+    }
+  PcapHelper::DisablePcapNg ();
+
+  NS_TEST_ASSERT_MSG_EQ (helper.m_files.size (), devices.GetN (), "Unexpected number of pcap files");
+  NS_TEST_EXPECT_MSG_EQ (helper.m_files[0]->GetMagic (), 0x1a2b3c4d, "Unexpected magic of a pcapng file");
+  NS_TEST_EXPECT_MSG_EQ (helper.m_files[0]->GetVersionMajor (), 1, "Unexpected major version of a pcapng file");
+  NS_TEST_EXPECT_MSG_EQ (helper.m_files[0]->GetVersionMinor (), 0, "Unexpected minor version of a pcapng file");
+  NS_TEST_EXPECT_MSG_EQ (helper.m_files[0]->GetDataLinkType (), PcapHelper::DLT_EN10MB, "Unexpected link type of a device");
+  NS_TEST_EXPECT_MSG_EQ (helper.m_files[0]->GetSnapLen (), PcapFile::SNAPLEN_DEFAULT, "Unexpected snapshot length");
+  NS_TEST_EXPECT_MSG_EQ (interfaceFiles[0]->GetDataLinkType (), PcapHelper::DLT_RAW, "Unexpected link type of an interface");
+  for (uint32_t i = 0; i < devices.GetN (); ++i)
+    {
+      helper.m_files[i]->Write (Seconds (i), Create<Packet> (100));
+      interfaceFiles[i]->Write (Seconds (i), Create<Packet> (60));
+    }
+  helper.m_files.clear ();
+  interfaceFiles.clear ();
+
+  // the files are closed once all of their interfaces are closed
+  std::set<std::string> filenames;
+  for (uint32_t i = 0; i < nodes.GetN (); ++i)
+    {
+      uint32_t id = nodes.Get (i)->GetId ();
+      uint32_t first = id - id % nodesPerFile;
+      std::ostringstream filename;
+      filename << prefix << "-" << first << "-" << first + nodesPerFile - 1 << ".pcapng";
+
+      std::vector<PcapNgBlock> blocks;
+      NS_TEST_ASSERT_MSG_EQ (ReadPcapNgFile (filename.str (), blocks), true, "Malformed pcapng file " << filename.str ());
+
+      // look for the interface of the device of the node, and its packet
+      std::ostringstream name;
+      name << prefix << "-" << id << "-0";
+      uint32_t dataLinkType = 0;
+      uint32_t length = 0;
+      NS_TEST_EXPECT_MSG_EQ (CountInterfacePackets (blocks, name.str (), dataLinkType, length), 1,
+                             "Interface " << name.str () << " or its packet not found in " << filename.str ());
+      NS_TEST_EXPECT_MSG_EQ (dataLinkType, PcapHelper::DLT_EN10MB, "Unexpected link type");
+      NS_TEST_EXPECT_MSG_EQ (length, 100, "Unexpected original length");
+
+      // and for the interface of the node named as by the internet helpers
+      NS_TEST_EXPECT_MSG_EQ (CountInterfacePackets (blocks, interfaceNames[i], dataLinkType, length), 1,
+                             "Interface " << interfaceNames[i] << " or its packet not found in " << filename.str ());
+      NS_TEST_EXPECT_MSG_EQ (dataLinkType, PcapHelper::DLT_RAW, "Unexpected link type");
+      NS_TEST_EXPECT_MSG_EQ (length, 60, "Unexpected original length");
+
+      filenames.insert (filename.str ());
+    }
+
+  for (std::set<std::string>::iterator it = filenames.begin (); it != filenames.end (); ++it)
+    {
+      std::remove (it->c_str ());
+    }
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief pcapng file TestSuite
+ */
+class PcapNgFileTestSuite : public TestSuite
+{
+public:
+  PcapNgFileTestSuite ();
+};
+
+PcapNgFileTestSuite::PcapNgFileTestSuite ()
+  : TestSuite ("pcapng-file", UNIT)
+{
+  AddTestCase (new PcapNgFileTestCase (false), TestCase::QUICK);
+  AddTestCase (new PcapNgFileTestCase (true), TestCase::QUICK);
+  AddTestCase (new PcapNgHelperTestCase, TestCase::QUICK);
+}
+
+static PcapNgFileTestSuite pcapNgFileTestSuite; //!< Static variable for test initialization
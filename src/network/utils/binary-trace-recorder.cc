@@ -0,0 +1,394 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/simulator.h"
+#include "binary-trace-recorder.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("BinaryTraceRecorder");
+
+/// Identifies binary trace files
+static const char MAGIC[8] = { 'n', 's', '3', 'b', 't', 'r', 'c', 0 };
+/// Version of the format of binary trace files
+static const uint32_t VERSION = 1;
+
+/**
+ * \ingroup network
+ * \brief The header of a binary trace file, followed by the ring of records
+ * and by the names of the paths and contexts.
+ */
+struct BinaryTraceFileHeader
+{
+  char magic[8];         //!< MAGIC
+  uint32_t version;      //!< VERSION
+  uint32_t recordSize;   //!< Size of a record
+  uint64_t capacity;     //!< Number of records of the ring
+  uint64_t count;        //!< Number of events recorded
+  uint64_t namesOffset;  //!< Offset of the names in the file, or zero if not written
+  uint64_t namesSize;    //!< Size of the names
+  uint8_t reserved[16];  //!< Padding, set to zero
+};
+
+BinaryTraceRecorder::BinaryTraceRecorder ()
+  : m_fd (-1),
+    m_map (0),
+    m_mapSize (0),
+    m_records (0),
+    m_next (0),
+    m_capacity (0),
+    m_count (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+BinaryTraceRecorder::~BinaryTraceRecorder ()
+{
+  NS_LOG_FUNCTION (this);
+  Close ();
+}
+
+bool
+BinaryTraceRecorder::Open (std::string const &filename, uint64_t capacity)
+{
+  NS_LOG_FUNCTION (this << filename << capacity);
+  NS_ASSERT (m_fd == -1);
+  NS_ASSERT (capacity > 0);
+
+  m_filename = filename;
+  m_capacity = capacity;
+  m_count = 0;
+  m_next = 0;
+  m_traces.clear ();
+  m_contexts.clear ();
+
+  m_fd = open (filename.c_str (), O_RDWR | O_CREAT | O_TRUNC, 0666);
+  if (m_fd == -1)
+    {
+      return false;
+    }
+  m_mapSize = sizeof (BinaryTraceFileHeader) + capacity * sizeof (TraceRecord);
+  void *map = MAP_FAILED;
+  if (ftruncate (m_fd, m_mapSize) == 0)
+    {
+      map = mmap (0, m_mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    }
+  if (map == MAP_FAILED)
+    {
+      close (m_fd);
+      m_fd = -1;
+      return false;
+    }
+  m_map = static_cast<uint8_t *> (map);
+  m_records = reinterpret_cast<TraceRecord *> (m_map + sizeof (BinaryTraceFileHeader));
+
+  BinaryTraceFileHeader *header = reinterpret_cast<BinaryTraceFileHeader *> (m_map);
+  std::memcpy (header->magic, MAGIC, sizeof (MAGIC));
+  header->version = VERSION;
+  header->recordSize = sizeof (TraceRecord);
+  header->capacity = capacity;
+  header->count = 0;
+  header->namesOffset = 0;
+  header->namesSize = 0;
+  return true;
+}
+
+/**
+ * \brief Append a string, preceded by its length, to a buffer
+ * \param buffer the buffer
+ * \param s the string
+ */
+static void
+AppendName (std::vector<char> &buffer, std::string const &s)
+{
+  uint32_t length = s.size ();
+  buffer.insert (buffer.end (), reinterpret_cast<char *> (&length), reinterpret_cast<char *> (&length) + sizeof (length));
+  buffer.insert (buffer.end (), s.begin (), s.end ());
+}
+
+void
+BinaryTraceRecorder::Close (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_fd == -1)
+    {
+      return;
+    }
+
+  std::vector<char> names;
+  uint32_t n = m_traces.size ();
+  names.insert (names.end (), reinterpret_cast<char *> (&n), reinterpret_cast<char *> (&n) + sizeof (n));
+  for (std::vector<std::string>::const_iterator i = m_traces.begin (); i != m_traces.end (); ++i)
+    {
+      AppendName (names, *i);
+    }
+  n = m_contexts.size ();
+  names.insert (names.end (), reinterpret_cast<char *> (&n), reinterpret_cast<char *> (&n) + sizeof (n));
+  for (std::vector<std::string>::const_iterator i = m_contexts.begin (); i != m_contexts.end (); ++i)
+    {
+      AppendName (names, *i);
+    }
+
+  BinaryTraceFileHeader *header = reinterpret_cast<BinaryTraceFileHeader *> (m_map);
+  if (pwrite (m_fd, names.data (), names.size (), m_mapSize) == static_cast<ssize_t> (names.size ()))
+    {
+      header->namesOffset = m_mapSize;
+      header->namesSize = names.size ();
+    }
+  else
+    {
+      NS_LOG_WARN ("Unable to write the names of the traces to " << m_filename);
+    }
+  header->count = m_count;
+
+  munmap (m_map, m_mapSize);
+  close (m_fd);
+  m_fd = -1;
+  m_map = 0;
+  m_records = 0;
+}
+
+uint16_t
+BinaryTraceRecorder::AddTrace (std::string const &name)
+{
+  NS_LOG_FUNCTION (this << name);
+  NS_ABORT_MSG_IF (m_traces.size () > 0xffff, "Too many traces");
+  m_traces.push_back (name);
+  return m_traces.size () - 1;
+}
+
+uint32_t
+BinaryTraceRecorder::AddContext (std::string const &name)
+{
+  NS_LOG_FUNCTION (this << name);
+  m_contexts.push_back (name);
+  return m_contexts.size () - 1;
+}
+
+uint64_t
+BinaryTraceRecorder::GetNRecords (void) const
+{
+  return m_count;
+}
+
+void
+BinaryTraceRecorder::Record (uint16_t trace, uint32_t context, Ptr<const Packet> p)
+{
+  if (m_records == 0)
+    {
+      return;
+    }
+
+  TraceRecord &record = m_records[m_next];
+  uint32_t size = p->GetSize ();
+  uint32_t headerLen = size < HEADER_BYTES ? size : HEADER_BYTES;
+  record.time = Simulator::Now ().GetNanoSeconds ();
+  record.uid = p->GetUid ();
+  record.context = context;
+  record.size = size;
+  record.trace = trace;
+  record.headerLen = headerLen;
+  record.reserved = 0;
+  p->CopyData (record.header, headerLen);
+  std::memset (record.header + headerLen, 0, HEADER_BYTES - headerLen);
+
+  if (++m_next == m_capacity)
+    {
+      m_next = 0;
+    }
+  ++m_count;
+  reinterpret_cast<BinaryTraceFileHeader *> (m_map)->count = m_count;
+}
+
+Ptr<const Packet>
+BinaryTraceRecorder::GetPacket (Ptr<const Packet> p)
+{
+  return p;
+}
+
+void
+BinaryTraceRecorder::LookupMatches (std::string const &path, Config::MatchContainer &matches, std::string &name)
+{
+  NS_LOG_FUNCTION (path);
+  std::string::size_type pos = path.rfind ('/');
+  NS_ABORT_MSG_IF (pos == std::string::npos, "Invalid path " << path);
+  name = path.substr (pos + 1);
+  matches = Config::LookupMatches (path.substr (0, pos));
+}
+
+/**
+ * \brief Read a string, preceded by its length, from a buffer
+ * \param buffer the buffer
+ * \param offset [in,out] the offset of the string in the buffer
+ * \param s [out] the string
+ * \return true if the string could be read
+ */
+static bool
+ReadName (std::vector<char> const &buffer, std::size_t &offset, std::string &s)
+{
+  uint32_t length;
+  if (offset + sizeof (length) > buffer.size ())
+    {
+      return false;
+    }
+  std::memcpy (&length, &buffer[offset], sizeof (length));
+  offset += sizeof (length);
+  if (offset + length > buffer.size ())
+    {
+      return false;
+    }
+  s.assign (&buffer[offset], length);
+  offset += length;
+  return true;
+}
+
+/**
+ * \brief Read a list of strings, preceded by their number, from a buffer
+ * \param buffer the buffer
+ * \param offset [in,out] the offset of the list in the buffer
+ * \param names [out] the strings
+ * \return true if the list could be read
+ */
+static bool
+ReadNames (std::vector<char> const &buffer, std::size_t &offset, std::vector<std::string> &names)
+{
+  uint32_t n;
+  if (offset + sizeof (n) > buffer.size ())
+    {
+      return false;
+    }
+  std::memcpy (&n, &buffer[offset], sizeof (n));
+  offset += sizeof (n);
+  names.resize (n);
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      if (!ReadName (buffer, offset, names[i]))
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+bool
+BinaryTraceRecorder::Convert (std::string const &filename, std::ostream &os, bool csv)
+{
+  NS_LOG_FUNCTION (filename << &os << csv);
+  std::ifstream in (filename.c_str (), std::ios::in | std::ios::binary);
+  BinaryTraceFileHeader header;
+  in.read (reinterpret_cast<char *> (&header), sizeof (header));
+  if (!in || std::memcmp (header.magic, MAGIC, sizeof (MAGIC)) != 0
+      || header.version != VERSION || header.recordSize != sizeof (TraceRecord)
+      || header.capacity == 0)
+    {
+      return false;
+    }
+
+  std::vector<std::string> traces;
+  std::vector<std::string> contexts;
+  if (header.namesOffset != 0)
+    {
+      std::vector<char> names (header.namesSize);
+      in.seekg (header.namesOffset);
+      in.read (names.data (), names.size ());
+      std::size_t offset = 0;
+      if (!in || !ReadNames (names, offset, traces) || !ReadNames (names, offset, contexts))
+        {
+          return false;
+        }
+    }
+
+  //
+  // The oldest record is the next one to be overwritten if the ring wrapped
+  // around, the first one otherwise.
+  //
+  uint64_t n = std::min (header.count, header.capacity);
+  uint64_t first = header.count > header.capacity ? header.count % header.capacity : 0;
+
+  if (csv)
+    {
+      os << "time,context,trace,uid,size,header" << std::endl;
+    }
+  std::ios::fmtflags flags = os.flags ();
+  char fill = os.fill ();
+  TraceRecord record;
+  for (uint64_t i = 0; i < n; ++i)
+    {
+      uint64_t index = (first + i) % header.capacity;
+      in.seekg (sizeof (header) + index * sizeof (TraceRecord));
+      in.read (reinterpret_cast<char *> (&record), sizeof (record));
+      if (!in)
+        {
+          return false;
+        }
+
+      std::string context;
+      if (record.context < contexts.size ())
+        {
+          context = contexts[record.context];
+        }
+      else
+        {
+          std::ostringstream oss;
+          oss << record.context;
+          context = oss.str ();
+        }
+      std::string trace;
+      if (record.trace < traces.size ())
+        {
+          trace = traces[record.trace];
+        }
+      else
+        {
+          std::ostringstream oss;
+          oss << record.trace;
+          trace = oss.str ();
+        }
+
+      if (csv)
+        {
+          os << std::dec << record.time << "," << context << "," << trace << ","
+             << record.uid << "," << record.size << ",";
+        }
+      else
+        {
+          os << std::dec << record.time / 1000000000 << "."
+             << std::setfill ('0') << std::setw (9) << record.time % 1000000000
+             << " " << context << " trace=" << trace << " uid=" << record.uid << " size=" << record.size << " header=";
+        }
+      os << std::hex << std::setfill ('0');
+      for (uint16_t j = 0; j < record.headerLen && j < HEADER_BYTES; ++j)
+        {
+          os << std::setw (2) << static_cast<uint32_t> (record.header[j]);
+        }
+      os << std::endl;
+    }
+  os.flags (flags);
+  os.fill (fill);
+  return true;
+}
+
+} // namespace ns3
@@ -20,16 +20,120 @@
 #include "ns3/log.h"
 #include "ns3/fatal-impl.h"
 #include "ns3/abort.h"
+#include "ns3/core-config.h"
 #include <fstream>
+#include <vector>
+#ifdef HAVE_PTHREAD_H
+#include "pcap-async-writer.h"
+#endif /* HAVE_PTHREAD_H */
 
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("OutputStreamWrapper");
 
+#ifdef HAVE_PTHREAD_H
+/**
+ * \ingroup network
+ *
+ * \brief A stream buffer writing a gzip-compressed file asynchronously
+ *
+ * The characters are accumulated into a memory buffer, which is handed to
+ * the PcapAsyncWriter, to be compressed and written by its background
+ * thread, when full.  Flushing the stream (e.g., with std::endl) does not
+ * hand the buffer over, since trace sinks usually flush every line; the
+ * remaining characters are written when the stream buffer is deleted.
+ */
+class CompressedStreamBuf : public std::streambuf
+{
+public:
+  /**
+   * Create (or truncate) a compressed file.
+   * \param filename the name of the file
+   */
+  CompressedStreamBuf (std::string const &filename)
+  {
+    m_open = PcapAsyncWriter::Get ()->Open (filename, m_id, true);
+    Reset ();
+  }
+  ~CompressedStreamBuf ()
+  {
+    if (m_open)
+      {
+        Flush ();
+        PcapAsyncWriter::Get ()->Close (m_id);
+      }
+  }
+  /**
+   * \return true if the file was created
+   */
+  bool IsOpen (void) const
+  {
+    return m_open;
+  }
+
+protected:
+  virtual int_type overflow (int_type c)
+  {
+    Flush ();
+    if (!traits_type::eq_int_type (c, traits_type::eof ()))
+      {
+        *pptr () = traits_type::to_char_type (c);
+        pbump (1);
+      }
+    return traits_type::not_eof (c);
+  }
+  virtual int sync (void)
+  {
+    return m_open && !PcapAsyncWriter::Get ()->Fail (m_id) ? 0 : -1;
+  }
+
+private:
+  /// Hand the characters buffered so far to the writer
+  void Flush (void)
+  {
+    m_buffer.resize (pptr () - pbase ());
+    if (m_open && !m_buffer.empty ())
+      {
+        PcapAsyncWriter::Get ()->Write (m_id, m_buffer);
+      }
+    Reset ();
+  }
+  /// Make the (empty) buffer the put area of the stream buffer
+  void Reset (void)
+  {
+    m_buffer.resize (BUFFER_SIZE);
+    char *begin = reinterpret_cast<char *> (m_buffer.data ());
+    setp (begin, begin + m_buffer.size ());
+  }
+
+  static const std::size_t BUFFER_SIZE = 1024 * 1024; //!< Size of the buffer
+  std::vector<uint8_t> m_buffer;  //!< The buffered characters
+  uint32_t m_id;                  //!< Identifier of the file in the writer
+  bool m_open;                    //!< Whether the file was created
+};
+#endif /* HAVE_PTHREAD_H */
+
 OutputStreamWrapper::OutputStreamWrapper (std::string filename, std::ios::openmode filemode)
-  : m_destroyable (true)
+  : m_streambuf (0),
+    m_destroyable (true)
 {
   NS_LOG_FUNCTION (this << filename << filemode);
+  if (filename.size () > 3 && filename.compare (filename.size () - 3, 3, ".gz") == 0)
+    {
+      // gzip-compressed file
+      NS_ABORT_MSG_IF (filemode & std::ios::app, "Unable to append to compressed file " << filename);
+#ifdef HAVE_PTHREAD_H
+      CompressedStreamBuf *buf = new CompressedStreamBuf (filename);
+      m_streambuf = buf;
+      m_ostream = new std::ostream (buf);
+      FatalImpl::RegisterStream (m_ostream);
+      NS_ABORT_MSG_UNLESS (buf->IsOpen (), "AsciiTraceHelper::CreateFileStream():  " <<
+                           "Unable to Open " << filename << " for mode " << filemode);
+      return;
+#else
+      NS_FATAL_ERROR ("Compressed trace files require thread support: " << filename);
+#endif /* HAVE_PTHREAD_H */
+    }
   std::ofstream* os = new std::ofstream ();
   os->open (filename.c_str (), filemode);
   m_ostream = os;
@@ -39,7 +143,7 @@ OutputStreamWrapper::OutputStreamWrapper (std::string filename, std::ios::openmo
 }
 
 OutputStreamWrapper::OutputStreamWrapper (std::ostream* os)
-  : m_ostream (os), m_destroyable (false)
+  : m_ostream (os), m_streambuf (0), m_destroyable (false)
 {
   NS_LOG_FUNCTION (this << os);
   FatalImpl::RegisterStream (m_ostream);
@@ -52,6 +156,8 @@ OutputStreamWrapper::~OutputStreamWrapper ()
   FatalImpl::UnregisterStream (m_ostream);
   if (m_destroyable) delete m_ostream;
   m_ostream = 0;
+  delete m_streambuf;
+  m_streambuf = 0;
 }
 
 std::ostream *
@@ -72,6 +72,10 @@ class OutputStreamWrapper : public SimpleRefCount<OutputStreamWrapper>
 public:
   /**
    * Constructor
+   *
+   * If the file name ends with ".gz", the file is written in gzip format,
+   * by a background thread (this requires zlib and thread support).
+   *
    * \param filename file name
    * \param filemode std::ios::openmode flags
    */
@@ -94,6 +98,7 @@ public:
 
 private:
   std::ostream *m_ostream; //!< The output stream
+  std::streambuf *m_streambuf; //!< The buffer of the output stream, if owned
   bool m_destroyable; //!< Can be destroyed
 };
 
@@ -0,0 +1,387 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/abort.h"
+#include "ns3/global-value.h"
+#include "ns3/uinteger.h"
+#include "ns3/network-config.h"
+#include "pcap-async-writer.h"
+
+#include <pthread.h>  // pthread_atfork
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif /* HAVE_ZLIB */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("PcapAsyncWriter");
+
+/**
+ * \ingroup network
+ * \brief The maximum number of files kept open by the thread writing
+ * asynchronous pcap files.
+ */
+static GlobalValue g_pcapMaxOpenFiles =
+  GlobalValue ("PcapMaxOpenFiles",
+               "The maximum number of files kept open by the thread writing asynchronous pcap files",
+               UintegerValue (256),
+               MakeUintegerChecker<uint32_t> (1));
+
+/// Amount of queued data above which PcapAsyncWriter::Write blocks
+static const uint64_t MAX_QUEUED_BYTES = 64 * 1024 * 1024;
+/// Maximum number of written buffers kept for reuse
+static const std::size_t MAX_SPARE_BUFFERS = 16;
+/// Size of the chunks of compressed data
+static const std::size_t DEFLATE_CHUNK_SIZE = 256 * 1024;
+
+PcapAsyncWriter *
+PcapAsyncWriter::Get (void)
+{
+  static PcapAsyncWriter writer;
+  return &writer;
+}
+
+PcapAsyncWriter::PcapAsyncWriter ()
+  : m_queuedBytes (0),
+    m_nextId (0),
+    m_maxOpenFiles (0),
+    m_stop (false)
+{
+  NS_LOG_FUNCTION (this);
+  pthread_atfork (&PcapAsyncWriter::PrepareFork, &PcapAsyncWriter::ResumeParent,
+                  &PcapAsyncWriter::ResumeChild);
+}
+
+PcapAsyncWriter::~PcapAsyncWriter ()
+{
+  NS_LOG_FUNCTION (this);
+  StopThread ();
+}
+
+void
+PcapAsyncWriter::PrepareFork (void)
+{
+  PcapAsyncWriter *writer = Get ();
+  writer->StopThread ();
+  for (File *file : writer->m_openFiles)
+    {
+      file->stream.flush ();
+    }
+}
+
+void
+PcapAsyncWriter::ResumeParent (void)
+{
+  Get ()->StartThread ();
+}
+
+void
+PcapAsyncWriter::ResumeChild (void)
+{
+  PcapAsyncWriter *writer = Get ();
+  for (auto &file : writer->m_files)
+    {
+      file.second->inherited = true;
+    }
+  writer->StartThread ();
+}
+
+void
+PcapAsyncWriter::StopThread (void)
+{
+  if (m_thread.joinable ())
+    {
+      {
+        std::lock_guard<std::mutex> lock (m_mutex);
+        m_stop = true;
+      }
+      m_jobQueued.notify_one ();
+      m_thread.join ();
+    }
+}
+
+void
+PcapAsyncWriter::StartThread (void)
+{
+  if (!m_files.empty () && !m_thread.joinable ())
+    {
+      m_stop = false;
+      m_thread = std::thread (&PcapAsyncWriter::Run, this);
+    }
+}
+
+bool
+PcapAsyncWriter::IsCompressionSupported (void)
+{
+#ifdef HAVE_ZLIB
+  return true;
+#else
+  return false;
+#endif /* HAVE_ZLIB */
+}
+
+bool
+PcapAsyncWriter::Open (std::string const &filename, uint32_t &id, bool compress)
+{
+  NS_LOG_FUNCTION (this << filename << compress);
+  NS_ABORT_MSG_IF (compress && !IsCompressionSupported (),
+                   "Compressed trace files are not supported (zlib not found)");
+
+  // create or truncate the file now, so that errors are reported to the caller
+  std::ofstream stream (filename.c_str (), std::ios::out | std::ios::trunc | std::ios::binary);
+  if (!stream)
+    {
+      return false;
+    }
+  stream.close ();
+
+  UintegerValue maxOpenFiles;
+  g_pcapMaxOpenFiles.GetValue (maxOpenFiles);
+
+  std::lock_guard<std::mutex> lock (m_mutex);
+  id = m_nextId++;
+  std::unique_ptr<File> file (new File);
+  file->name = filename;
+  file->failed = false;
+  file->closed = false;
+  file->inherited = false;
+  file->zstream = 0;
+#ifdef HAVE_ZLIB
+  if (compress)
+    {
+      file->zstream = new z_stream ();
+      // a window size of 15 bits plus 16 selects the gzip format
+      if (deflateInit2 (file->zstream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8,
+                        Z_DEFAULT_STRATEGY) != Z_OK)
+        {
+          delete file->zstream;
+          return false;
+        }
+    }
+#endif /* HAVE_ZLIB */
+  m_files[id] = std::move (file);
+  m_maxOpenFiles = maxOpenFiles.Get ();
+  StartThread ();
+  return true;
+}
+
+void
+PcapAsyncWriter::Write (uint32_t id, std::vector<uint8_t> &buffer)
+{
+  NS_LOG_FUNCTION (this << id << buffer.size ());
+
+  std::unique_lock<std::mutex> lock (m_mutex);
+  NS_ASSERT (m_files.find (id) != m_files.end ());
+  m_jobDone.wait (lock, [this] { return m_queuedBytes < MAX_QUEUED_BYTES; });
+
+  Job job;
+  job.id = id;
+  job.close = false;
+  job.data.swap (buffer);
+  m_queuedBytes += job.data.size ();
+  m_jobs.push_back (std::move (job));
+
+  if (!m_spare.empty ())
+    {
+      buffer.swap (m_spare.back ());
+      m_spare.pop_back ();
+    }
+  m_jobQueued.notify_one ();
+}
+
+bool
+PcapAsyncWriter::Close (uint32_t id)
+{
+  NS_LOG_FUNCTION (this << id);
+
+  std::unique_lock<std::mutex> lock (m_mutex);
+  auto it = m_files.find (id);
+  NS_ASSERT (it != m_files.end ());
+  File *file = it->second.get ();
+
+  Job job;
+  job.id = id;
+  job.close = true;
+  m_jobs.push_back (std::move (job));
+  m_jobQueued.notify_one ();
+  m_jobDone.wait (lock, [file] { return file->closed; });
+
+  bool ok = !file->failed;
+  m_files.erase (it);
+
+  if (m_files.empty ())
+    {
+      // no more files to write, stop the background thread
+      m_stop = true;
+      lock.unlock ();
+      m_jobQueued.notify_one ();
+      m_thread.join ();
+    }
+  return ok;
+}
+
+bool
+PcapAsyncWriter::Fail (uint32_t id)
+{
+  std::lock_guard<std::mutex> lock (m_mutex);
+  auto it = m_files.find (id);
+  NS_ASSERT (it != m_files.end ());
+  return it->second->failed;
+}
+
+void
+PcapAsyncWriter::Run (void)
+{
+  // no logging here, this is not the simulation thread
+  std::unique_lock<std::mutex> lock (m_mutex);
+  while (true)
+    {
+      m_jobQueued.wait (lock, [this] { return m_stop || !m_jobs.empty (); });
+      if (m_jobs.empty ())
+        {
+          return;
+        }
+
+      Job job = std::move (m_jobs.front ());
+      m_jobs.pop_front ();
+      File *file = m_files[job.id].get ();
+      uint32_t maxOpenFiles = m_maxOpenFiles;
+
+      lock.unlock ();
+      Process (*file, job, maxOpenFiles);
+      lock.lock ();
+
+      m_queuedBytes -= job.data.size ();
+      if (job.close)
+        {
+          file->closed = true;
+        }
+      if (m_spare.size () < MAX_SPARE_BUFFERS && job.data.capacity () > 0)
+        {
+          job.data.clear ();
+          m_spare.push_back (std::move (job.data));
+        }
+      m_jobDone.notify_all ();
+    }
+}
+
+void
+PcapAsyncWriter::Process (File &file, Job &job, uint32_t maxOpenFiles)
+{
+  uint8_t const *data = job.data.data ();
+  std::size_t size = job.data.size ();
+  if (file.zstream && !file.failed && !file.inherited)
+    {
+      std::vector<uint8_t> const &deflated = Deflate (file, job);
+      data = deflated.data ();
+      size = deflated.size ();
+    }
+
+  if (!file.failed && !file.inherited && size > 0)
+    {
+      if (file.stream.is_open ())
+        {
+          m_openFiles.splice (m_openFiles.end (), m_openFiles, file.lru);
+        }
+      else
+        {
+          // close the least recently written files if needed
+          while (m_openFiles.size () >= maxOpenFiles)
+            {
+              File *victim = m_openFiles.front ();
+              victim->stream.close ();
+              if (victim->stream.fail ())
+                {
+                  victim->failed = true;
+                }
+              m_openFiles.pop_front ();
+            }
+          file.stream.clear ();
+          file.stream.open (file.name.c_str (), std::ios::out | std::ios::app | std::ios::binary);
+          if (file.stream)
+            {
+              file.lru = m_openFiles.insert (m_openFiles.end (), &file);
+            }
+          else
+            {
+              file.failed = true;
+            }
+        }
+    }
+
+  if (!file.failed && !file.inherited && size > 0)
+    {
+      file.stream.write (reinterpret_cast<const char *> (data), size);
+      if (file.stream.fail ())
+        {
+          file.failed = true;
+        }
+    }
+
+  if (job.close)
+    {
+#ifdef HAVE_ZLIB
+      if (file.zstream)
+        {
+          deflateEnd (file.zstream);
+          delete file.zstream;
+          file.zstream = 0;
+        }
+#endif /* HAVE_ZLIB */
+      if (file.stream.is_open ())
+        {
+          file.stream.close ();
+          if (file.stream.fail ())
+            {
+              file.failed = true;
+            }
+          m_openFiles.erase (file.lru);
+        }
+    }
+}
+
+std::vector<uint8_t> const &
+PcapAsyncWriter::Deflate (File &file, Job const &job)
+{
+  m_deflated.clear ();
+#ifdef HAVE_ZLIB
+  z_stream *zs = file.zstream;
+  zs->next_in = const_cast<Bytef *> (job.data.data ());
+  zs->avail_in = job.data.size ();
+  int flush = job.close ? Z_FINISH : Z_NO_FLUSH;
+  int ret;
+  do
+    {
+      std::size_t offset = m_deflated.size ();
+      m_deflated.resize (offset + DEFLATE_CHUNK_SIZE);
+      zs->next_out = m_deflated.data () + offset;
+      zs->avail_out = DEFLATE_CHUNK_SIZE;
+      ret = deflate (zs, flush);
+      m_deflated.resize (offset + DEFLATE_CHUNK_SIZE - zs->avail_out);
+    }
+  while (ret == Z_OK && (zs->avail_in > 0 || zs->avail_out == 0 || flush == Z_FINISH));
+  if (ret == Z_STREAM_ERROR || (flush == Z_FINISH && ret != Z_STREAM_END))
+    {
+      file.failed = true;
+    }
+#endif /* HAVE_ZLIB */
+  return m_deflated;
+}
+
+} // namespace ns3
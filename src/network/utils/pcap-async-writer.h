@@ -0,0 +1,193 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PCAP_ASYNC_WRITER_H
+#define PCAP_ASYNC_WRITER_H
+
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct z_stream_s;
+
+namespace ns3 {
+
+/**
+ * \ingroup network
+ *
+ * \brief Background I/O thread writing the data of asynchronous pcap files
+ *
+ * A PcapFile opened for asynchronous writing accumulates its records into a
+ * buffer, which is handed to the (single) instance of this class when full.
+ * The buffers are written to disk, in order, by a background thread, so that
+ * the simulation thread does not block on file I/O.  The same applies to the
+ * compressed pcap and ascii trace files, which are gzip-compressed by the
+ * background thread too (if zlib is available).
+ *
+ * The background thread keeps at most a given number of files open (see the
+ * PcapMaxOpenFiles global value). When this limit is reached, the least
+ * recently written file is closed, and it is reopened in append mode when new
+ * data for it arrive. Thus, thousands of pcap files can be written without
+ * exhausting the file descriptors of the process.
+ *
+ * The background thread is started when the first file is opened and stopped
+ * when the last file is closed.  It is also stopped while the process is
+ * forked (see Simulator::Fork), after writing the data queued so far, and
+ * the child processes do not write the files opened before the fork.
+ */
+class PcapAsyncWriter
+{
+public:
+  /**
+   * \return the instance of the writer
+   */
+  static PcapAsyncWriter * Get (void);
+
+  /**
+   * \brief Create (or truncate) a file to be written asynchronously
+   *
+   * The file is created on the calling thread, so that errors are detected
+   * immediately, and then closed until data are written to it.
+   *
+   * \param filename the name of the file
+   * \param id [out] the identifier of the file, to be used with the other methods
+   * \param compress whether to write the data in gzip format
+   * \return true if the file could be created, false otherwise
+   */
+  bool Open (std::string const &filename, uint32_t &id, bool compress = false);
+
+  /**
+   * \return true if compressed files can be written
+   */
+  static bool IsCompressionSupported (void);
+
+  /**
+   * \brief Append data to a file
+   *
+   * The content of the given buffer is moved to the queue of the background
+   * thread and the buffer is replaced with an empty one (possibly reusing the
+   * memory of a buffer already written). This call blocks if the amount of
+   * data waiting to be written exceeds a threshold, to bound memory usage.
+   *
+   * \param id the identifier of the file
+   * \param buffer the data to write
+   */
+  void Write (uint32_t id, std::vector<uint8_t> &buffer);
+
+  /**
+   * \brief Close a file, waiting for all of its data to be written
+   * \param id the identifier of the file
+   * \return true if all the data of the file were written successfully
+   */
+  bool Close (uint32_t id);
+
+  /**
+   * \param id the identifier of the file
+   * \return true if an error occurred while writing the file so far
+   */
+  bool Fail (uint32_t id);
+
+private:
+  PcapAsyncWriter ();
+  ~PcapAsyncWriter ();
+
+  /// A file written by the background thread
+  struct File
+  {
+    std::string name;                   //!< File name
+    std::ofstream stream;               //!< File stream, if open
+    std::list<File *>::iterator lru;    //!< Position in the list of open files
+    std::atomic<bool> failed;           //!< Whether a write error occurred
+    z_stream_s *zstream;                //!< Compression state, if the file is compressed
+    bool closed;                        //!< Whether the file has been closed
+    bool inherited;                     //!< Whether the file was opened before the process was forked
+  };
+
+  /// A request to the background thread
+  struct Job
+  {
+    uint32_t id;                //!< Identifier of the file
+    std::vector<uint8_t> data;  //!< Data to write (if any)
+    bool close;                 //!< Whether to close the file
+  };
+
+  /**
+   * \brief Stop the background thread before the process is forked
+   *
+   * The jobs queued are processed and the open files are flushed, so that
+   * their data are not written twice.
+   */
+  static void PrepareFork (void);
+  /**
+   * \brief Restart the background thread in the parent process after a fork
+   */
+  static void ResumeParent (void);
+  /**
+   * \brief Restart the background thread in a child process after a fork
+   *
+   * The files opened by the parent process are no longer written.
+   */
+  static void ResumeChild (void);
+  /// Stop the background thread, once all the queued jobs are processed
+  void StopThread (void);
+  /// Start the background thread, if there are files to write
+  void StartThread (void);
+
+  /// The body of the background thread
+  void Run (void);
+  /**
+   * \brief Write data to a file (or close it), on the background thread
+   * \param file the file
+   * \param job the request
+   * \param maxOpenFiles the maximum number of open files
+   */
+  void Process (File &file, Job &job, uint32_t maxOpenFiles);
+  /**
+   * \brief Compress data, on the background thread
+   * \param file the (compressed) file
+   * \param job the request
+   * \return the compressed data
+   */
+  std::vector<uint8_t> const &Deflate (File &file, Job const &job);
+
+  std::mutex m_mutex;                          //!< Protects the members below
+  std::condition_variable m_jobQueued;         //!< Signaled when a job is queued
+  std::condition_variable m_jobDone;           //!< Signaled when a job is done
+  std::deque<Job> m_jobs;                      //!< Jobs waiting to be processed
+  std::vector<std::vector<uint8_t> > m_spare;  //!< Buffers already written, for reuse
+  std::map<uint32_t, std::unique_ptr<File> > m_files; //!< Files being written
+  uint64_t m_queuedBytes;                      //!< Bytes waiting to be written
+  uint32_t m_nextId;                           //!< Identifier of the next file
+  uint32_t m_maxOpenFiles;                     //!< Maximum number of open files
+  bool m_stop;                                 //!< Whether the background thread must exit
+  std::thread m_thread;                        //!< The background thread
+
+  std::list<File *> m_openFiles;               //!< Open files, least recently written first (background thread only)
+  std::vector<uint8_t> m_deflated;             //!< Compressed data (background thread only)
+};
+
+} // namespace ns3
+
+#endif /* PCAP_ASYNC_WRITER_H */
@@ -17,6 +17,7 @@
  */
 
 #include "ns3/log.h"
+#include "ns3/abort.h"
 #include "ns3/boolean.h"
 #include "ns3/uinteger.h"
 #include "ns3/buffer.h"
@@ -46,12 +47,26 @@ PcapFileWrapper::GetTypeId (void)
                    BooleanValue (false),
                    MakeBooleanAccessor (&PcapFileWrapper::m_nanosecMode),
                    MakeBooleanChecker())
+    .AddAttribute ("AsyncWrite",
+                   "Whether files opened for writing are written by a background thread. "
+                   "Records are buffered in memory and the file content is complete only "
+                   "once the file is closed.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&PcapFileWrapper::m_asyncWrite),
+                   MakeBooleanChecker ())
+    .AddAttribute ("AsyncBufferSize",
+                   "Size in bytes of the buffer handed to the background thread when "
+                   "AsyncWrite is enabled",
+                   UintegerValue (1024 * 1024),
+                   MakeUintegerAccessor (&PcapFileWrapper::m_asyncBufferSize),
+                   MakeUintegerChecker<uint32_t> (1))
   ;
   return tid;
 }
 
 
 PcapFileWrapper::PcapFileWrapper ()
+  : m_ngInterface (0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -66,6 +81,10 @@ bool
 PcapFileWrapper::Fail (void) const
 {
   NS_LOG_FUNCTION (this);
+  if (m_ngFile)
+    {
+      return m_ngFile->Fail ();
+    }
   return m_file.Fail ();
 }
 
@@ -86,6 +105,12 @@ void
 PcapFileWrapper::Close (void)
 {
   NS_LOG_FUNCTION (this);
+  if (m_ngFile)
+    {
+      // the pcapng file is closed when its last interface is closed
+      m_ngFile = 0;
+      return;
+    }
   m_file.Close ();
 }
 
@@ -93,9 +118,19 @@ void
 PcapFileWrapper::Open (std::string const &filename, std::ios::openmode mode)
 {
   NS_LOG_FUNCTION (this << filename << mode);
+  m_file.SetAsyncWrite (m_asyncWrite ? m_asyncBufferSize : 0);
   m_file.Open (filename, mode);
 }
 
+void
+PcapFileWrapper::Open (Ptr<PcapNgFile> file, std::string const &name)
+{
+  NS_LOG_FUNCTION (this << file << name);
+  NS_ASSERT (file);
+  m_ngFile = file;
+  m_ngName = name;
+}
+
 void
 PcapFileWrapper::Init (uint32_t dataLinkType, uint32_t snapLen, int32_t tzCorrection)
 {
@@ -105,6 +140,13 @@ PcapFileWrapper::Init (uint32_t dataLinkType, uint32_t snapLen, int32_t tzCorrec
   // a snaplen, we use the one provided.
   //
   NS_LOG_FUNCTION (this << dataLinkType << snapLen << tzCorrection);
+  if (m_ngFile)
+    {
+      // the time zone correction does not apply, pcapng timestamps are in UTC
+      snapLen = snapLen != std::numeric_limits<uint32_t>::max () ? snapLen : m_snapLen;
+      m_ngInterface = m_ngFile->AddInterface (dataLinkType, snapLen, m_ngName);
+      return;
+    }
   if (snapLen != std::numeric_limits<uint32_t>::max ())
     {
       m_file.Init (dataLinkType, snapLen, tzCorrection, false, m_nanosecMode);
@@ -119,6 +161,11 @@ void
 PcapFileWrapper::Write (Time t, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (this << t << p);
+  if (m_ngFile)
+    {
+      m_ngFile->Write (m_ngInterface, t.GetNanoSeconds (), p);
+      return;
+    }
   if (m_file.IsNanoSecMode())
     {
       uint64_t current = t.GetNanoSeconds ();
@@ -139,6 +186,11 @@ void
 PcapFileWrapper::Write (Time t, const Header &header, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (this << t << &header << p);
+  if (m_ngFile)
+    {
+      m_ngFile->Write (m_ngInterface, t.GetNanoSeconds (), header, p);
+      return;
+    }
   if (m_file.IsNanoSecMode())
     {
       uint64_t current = t.GetNanoSeconds ();
@@ -159,6 +211,11 @@ void
 PcapFileWrapper::Write (Time t, uint8_t const *buffer, uint32_t length)
 {
   NS_LOG_FUNCTION (this << t << &buffer << length);
+  if (m_ngFile)
+    {
+      m_ngFile->Write (m_ngInterface, t.GetNanoSeconds (), buffer, length);
+      return;
+    }
   if (m_file.IsNanoSecMode())
     {
       uint64_t current = t.GetNanoSeconds ();
@@ -184,6 +241,7 @@ PcapFileWrapper::Read (Time &t)
   uint32_t origLen;
   uint32_t readLen;
 
+  NS_ABORT_MSG_IF (m_ngFile, "Reading packets is not supported from pcapng files");
   uint8_t  datbuf[65536];
 
   m_file.Read (datbuf,65536,tsSec,tsUsec,inclLen,origLen,readLen);
@@ -210,6 +268,10 @@ uint32_t
 PcapFileWrapper::GetMagic (void)
 {
   NS_LOG_FUNCTION (this);
+  if (m_ngFile)
+    {
+      return m_ngFile->GetMagic ();
+    }
   return m_file.GetMagic ();
 }
 
@@ -217,6 +279,10 @@ uint16_t
 PcapFileWrapper::GetVersionMajor (void)
 {
   NS_LOG_FUNCTION (this);
+  if (m_ngFile)
+    {
+      return m_ngFile->GetVersionMajor ();
+    }
   return m_file.GetVersionMajor ();
 }
 
@@ -224,6 +290,10 @@ uint16_t
 PcapFileWrapper::GetVersionMinor (void)
 {
   NS_LOG_FUNCTION (this);
+  if (m_ngFile)
+    {
+      return m_ngFile->GetVersionMinor ();
+    }
   return m_file.GetVersionMinor ();
 }
 
@@ -231,6 +301,11 @@ int32_t
 PcapFileWrapper::GetTimeZoneOffset (void)
 {
   NS_LOG_FUNCTION (this);
+  if (m_ngFile)
+    {
+      // not recorded in pcapng files
+      return 0;
+    }
   return m_file.GetTimeZoneOffset ();
 }
 
@@ -238,6 +313,11 @@ uint32_t
 PcapFileWrapper::GetSigFigs (void)
 {
   NS_LOG_FUNCTION (this);
+  if (m_ngFile)
+    {
+      // not recorded in pcapng files
+      return 0;
+    }
   return m_file.GetSigFigs ();
 }
 
@@ -245,6 +325,10 @@ uint32_t
 PcapFileWrapper::GetSnapLen (void)
 {
   NS_LOG_FUNCTION (this);
+  if (m_ngFile)
+    {
+      return m_ngFile->GetSnapLen (m_ngInterface);
+    }
   return m_file.GetSnapLen ();
 }
 
@@ -252,6 +336,10 @@ uint32_t
 PcapFileWrapper::GetDataLinkType (void)
 {
   NS_LOG_FUNCTION (this);
+  if (m_ngFile)
+    {
+      return m_ngFile->GetDataLinkType (m_ngInterface);
+    }
   return m_file.GetDataLinkType ();
 }
 
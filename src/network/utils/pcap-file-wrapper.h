@@ -27,6 +27,7 @@
 #include "ns3/object.h"
 #include "ns3/nstime.h"
 #include "pcap-file.h"
+#include "pcapng-file.h"
 
 namespace ns3 {
 
@@ -77,6 +78,17 @@ public:
    */
   void Open (std::string const &filename, std::ios::openmode mode);
 
+  /**
+   * Record the packets written to this wrapper as the packets of an
+   * interface of a (possibly shared) pcapng file, instead of a pcap file.
+   * The interface is added to the pcapng file by Init, with the given name.
+   * Reading packets is not supported in this mode.
+   *
+   * \param file the pcapng file, already opened.
+   * \param name the name of the interface.
+   */
+  void Open (Ptr<PcapNgFile> file, std::string const &name);
+
   /**
    * Close the underlying pcap file.
    */
@@ -154,6 +166,11 @@ public:
    * \brief Returns the magic number of the pcap file as defined by the magic_number
    * field in the pcap global header.
    *
+   * If the wrapper records an interface of a pcapng file, this getter and
+   * the following ones return the fields of the pcapng Section Header Block
+   * and Interface Description Block instead; the time zone offset and the
+   * accuracy of timestamps, which pcapng files do not record, are 0.
+   *
    * See http://wiki.wireshark.org/Development/LibpcapFileFormat
    *
    * \returns magic number
@@ -224,6 +241,11 @@ private:
   PcapFile m_file; //!< Pcap file
   uint32_t m_snapLen; //!< max length of saved packets
   bool     m_nanosecMode; //!< Timestamps in nanosecond mode
+  bool     m_asyncWrite; //!< Whether files are written asynchronously
+  Ptr<PcapNgFile> m_ngFile; //!< Pcapng file, if recording an interface of a pcapng file
+  std::string m_ngName; //!< Name of the pcapng interface
+  uint32_t m_ngInterface; //!< Identifier of the pcapng interface
+  uint32_t m_asyncBufferSize; //!< Size of the asynchronous write buffer
 };
 
 } // namespace ns3
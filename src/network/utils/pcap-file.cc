@@ -21,6 +21,7 @@
 #include <iostream>
 #include <cstring>
 #include "ns3/assert.h"
+#include "ns3/abort.h"
 #include "ns3/packet.h"
 #include "ns3/fatal-error.h"
 #include "ns3/fatal-impl.h"
@@ -29,6 +30,10 @@
 #include "pcap-file.h"
 #include "ns3/log.h"
 #include "ns3/build-profile.h"
+#include "ns3/core-config.h"
+#ifdef HAVE_PTHREAD_H
+#include "pcap-async-writer.h"
+#endif /* HAVE_PTHREAD_H */
 //
 // This file is used as part of the ns-3 test framework, so please refrain from 
 // adding any ns-3 specific constructs such as Packet to this file.
@@ -50,7 +55,11 @@ const uint16_t VERSION_MINOR = 4;             /**< Minor version of supported pc
 PcapFile::PcapFile ()
   : m_file (),
     m_swapMode (false),
-    m_nanosecMode (false)
+    m_nanosecMode (false),
+    m_asyncBufferSize (0),
+    m_async (false),
+    m_asyncFailed (false),
+    m_asyncId (0)
 {
   NS_LOG_FUNCTION (this);
   FatalImpl::RegisterStream (&m_file); 
@@ -68,6 +77,16 @@ bool
 PcapFile::Fail (void) const
 {
   NS_LOG_FUNCTION (this);
+  if (m_asyncFailed)
+    {
+      return true;
+    }
+#ifdef HAVE_PTHREAD_H
+  if (m_async)
+    {
+      return PcapAsyncWriter::Get ()->Fail (m_asyncId);
+    }
+#endif /* HAVE_PTHREAD_H */
   return m_file.fail ();
 }
 bool 
@@ -81,13 +100,44 @@ PcapFile::Clear (void)
 {
   NS_LOG_FUNCTION (this);
   m_file.clear ();
+  m_asyncFailed = false;
 }
 
+void
+PcapFile::SetAsyncWrite (uint32_t bufferSize)
+{
+  NS_LOG_FUNCTION (this << bufferSize);
+#ifndef HAVE_PTHREAD_H
+  if (bufferSize > 0)
+    {
+      NS_LOG_WARN ("Asynchronous writing requires thread support, pcap files are written synchronously");
+      bufferSize = 0;
+    }
+#endif /* HAVE_PTHREAD_H */
+  m_asyncBufferSize = bufferSize;
+}
 
 void
 PcapFile::Close (void)
 {
   NS_LOG_FUNCTION (this);
+#ifdef HAVE_PTHREAD_H
+  if (m_async)
+    {
+      PcapAsyncWriter *writer = PcapAsyncWriter::Get ();
+      if (!m_buffer.empty ())
+        {
+          writer->Write (m_asyncId, m_buffer);
+        }
+      if (!writer->Close (m_asyncId))
+        {
+          m_asyncFailed = true;
+        }
+      m_async = false;
+      std::vector<uint8_t> ().swap (m_buffer);
+      return;
+    }
+#endif /* HAVE_PTHREAD_H */
   m_file.close ();
 }
 
@@ -204,9 +254,17 @@ PcapFile::WriteFileHeader (void)
   NS_LOG_FUNCTION (this);
   //
   // If we're initializing the file, we need to write the pcap file header
-  // at the start of the file.
+  // at the start of the file.  Records are appended to the buffer in
+  // asynchronous mode, hence the header must be written first.
   //
-  m_file.seekp (0, std::ios::beg);
+  if (m_async)
+    {
+      NS_ABORT_MSG_IF (!m_buffer.empty (), "PcapFile::Init must be called before writing records in asynchronous mode");
+    }
+  else
+    {
+      m_file.seekp (0, std::ios::beg);
+    }
  
   //
   // We have the ability to write out the pcap file header in a foreign endian
@@ -234,13 +292,13 @@ PcapFile::WriteFileHeader (void)
   // Watch out for memory alignment differences between machines, so write
   // them all individually.
   //
-  m_file.write ((const char *)&headerOut->m_magicNumber, sizeof(headerOut->m_magicNumber));
-  m_file.write ((const char *)&headerOut->m_versionMajor, sizeof(headerOut->m_versionMajor));
-  m_file.write ((const char *)&headerOut->m_versionMinor, sizeof(headerOut->m_versionMinor));
-  m_file.write ((const char *)&headerOut->m_zone, sizeof(headerOut->m_zone));
-  m_file.write ((const char *)&headerOut->m_sigFigs, sizeof(headerOut->m_sigFigs));
-  m_file.write ((const char *)&headerOut->m_snapLen, sizeof(headerOut->m_snapLen));
-  m_file.write ((const char *)&headerOut->m_type, sizeof(headerOut->m_type));
+  WriteData (&headerOut->m_magicNumber, sizeof(headerOut->m_magicNumber));
+  WriteData (&headerOut->m_versionMajor, sizeof(headerOut->m_versionMajor));
+  WriteData (&headerOut->m_versionMinor, sizeof(headerOut->m_versionMinor));
+  WriteData (&headerOut->m_zone, sizeof(headerOut->m_zone));
+  WriteData (&headerOut->m_sigFigs, sizeof(headerOut->m_sigFigs));
+  WriteData (&headerOut->m_snapLen, sizeof(headerOut->m_snapLen));
+  WriteData (&headerOut->m_type, sizeof(headerOut->m_type));
 }
 
 void
@@ -326,13 +384,44 @@ PcapFile::Open (std::string const &filename, std::ios::openmode mode)
 {
   NS_LOG_FUNCTION (this << filename << mode);
   NS_ASSERT ((mode & std::ios::app) == 0);
-  NS_ASSERT (!m_file.fail ());
+  NS_ASSERT (!Fail ());
   //
   // All pcap files are binary files, so we just do this automatically.
   //
   mode |= std::ios::binary;
 
   m_filename=filename;
+  //
+  // Files whose name ends with ".gz" are gzip-compressed, by the background
+  // thread of the asynchronous writer.
+  //
+  bool compress = filename.size () > 3 && filename.compare (filename.size () - 3, 3, ".gz") == 0;
+  NS_ABORT_MSG_IF (compress && (mode & std::ios::in), "Compressed pcap files cannot be read: " << filename);
+#ifdef HAVE_PTHREAD_H
+  if (compress && m_asyncBufferSize == 0)
+    {
+      m_asyncBufferSize = ASYNC_BUFFER_SIZE_DEFAULT;
+    }
+  if (m_asyncBufferSize > 0 && (mode & std::ios::in) == 0)
+    {
+      //
+      // The file is created (or truncated) now and written by the background
+      // thread of the asynchronous writer afterwards.
+      //
+      m_async = PcapAsyncWriter::Get ()->Open (filename, m_asyncId, compress);
+      if (m_async)
+        {
+          m_buffer.reserve (m_asyncBufferSize);
+        }
+      else
+        {
+          m_file.setstate (std::ios::failbit);
+        }
+      return;
+    }
+#else
+  NS_ABORT_MSG_IF (compress, "Compressed pcap files require thread support: " << filename);
+#endif /* HAVE_PTHREAD_H */
   m_file.open (filename.c_str (), mode);
   if (mode & std::ios::in)
     {
@@ -422,11 +511,14 @@ PcapFile::WritePacketHeader (uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen)
   // Watch out for memory alignment differences between machines, so write
   // them all individually.
   //
-  m_file.write ((const char *)&header.m_tsSec, sizeof(header.m_tsSec));
-  m_file.write ((const char *)&header.m_tsUsec, sizeof(header.m_tsUsec));
-  m_file.write ((const char *)&header.m_inclLen, sizeof(header.m_inclLen));
-  m_file.write ((const char *)&header.m_origLen, sizeof(header.m_origLen));
-  NS_BUILD_DEBUG(m_file.flush());
+  WriteData (&header.m_tsSec, sizeof(header.m_tsSec));
+  WriteData (&header.m_tsUsec, sizeof(header.m_tsUsec));
+  WriteData (&header.m_inclLen, sizeof(header.m_inclLen));
+  WriteData (&header.m_origLen, sizeof(header.m_origLen));
+  if (!m_async)
+    {
+      NS_BUILD_DEBUG(m_file.flush());
+    }
   return inclLen;
 }
 
@@ -435,8 +527,15 @@ PcapFile::Write (uint32_t tsSec, uint32_t tsUsec, uint8_t const * const data, ui
 {
   NS_LOG_FUNCTION (this << tsSec << tsUsec << &data << totalLen);
   uint32_t inclLen = WritePacketHeader (tsSec, tsUsec, totalLen);
-  m_file.write ((const char *)data, inclLen);
-  NS_BUILD_DEBUG(m_file.flush());
+  WriteData (data, inclLen);
+  if (m_async)
+    {
+      FlushIfFull ();
+    }
+  else
+    {
+      NS_BUILD_DEBUG(m_file.flush());
+    }
 }
 
 void 
@@ -444,8 +543,17 @@ PcapFile::Write (uint32_t tsSec, uint32_t tsUsec, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (this << tsSec << tsUsec << p);
   uint32_t inclLen = WritePacketHeader (tsSec, tsUsec, p->GetSize ());
-  p->CopyData (&m_file, inclLen);
-  NS_BUILD_DEBUG(m_file.flush());
+  if (m_async)
+    {
+      // only the captured bytes are copied, straight into the buffer
+      p->CopyData (Reserve (inclLen), inclLen);
+      FlushIfFull ();
+    }
+  else
+    {
+      p->CopyData (&m_file, inclLen);
+      NS_BUILD_DEBUG(m_file.flush());
+    }
 }
 
 void 
@@ -460,11 +568,57 @@ PcapFile::Write (uint32_t tsSec, uint32_t tsUsec, const Header &header, Ptr<cons
   headerBuffer.AddAtStart (headerSize);
   header.Serialize (headerBuffer.Begin ());
   uint32_t toCopy = std::min (headerSize, inclLen);
+  if (m_async)
+    {
+      headerBuffer.CopyData (Reserve (toCopy), toCopy);
+      inclLen -= toCopy;
+      p->CopyData (Reserve (inclLen), inclLen);
+      FlushIfFull ();
+      return;
+    }
   headerBuffer.CopyData (&m_file, toCopy);
   inclLen -= toCopy;
   p->CopyData (&m_file, inclLen);
 }
 
+void
+PcapFile::WriteData (const void *data, uint32_t size)
+{
+  NS_LOG_FUNCTION (this << data << size);
+  if (m_async)
+    {
+      std::memcpy (Reserve (size), data, size);
+    }
+  else
+    {
+      m_file.write ((const char *)data, size);
+    }
+}
+
+uint8_t *
+PcapFile::Reserve (uint32_t size)
+{
+  NS_LOG_FUNCTION (this << size);
+  NS_ASSERT (m_async);
+  std::size_t offset = m_buffer.size ();
+  m_buffer.resize (offset + size);
+  return m_buffer.data () + offset;
+}
+
+void
+PcapFile::FlushIfFull (void)
+{
+  NS_LOG_FUNCTION (this);
+#ifdef HAVE_PTHREAD_H
+  NS_ASSERT (m_async);
+  if (m_buffer.size () >= m_asyncBufferSize)
+    {
+      PcapAsyncWriter::Get ()->Write (m_asyncId, m_buffer);
+      m_buffer.reserve (m_asyncBufferSize);
+    }
+#endif /* HAVE_PTHREAD_H */
+}
+
 void
 PcapFile::Read (
   uint8_t * const data, 
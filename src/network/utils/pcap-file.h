@@ -23,6 +23,7 @@
 
 #include <string>
 #include <fstream>
+#include <vector>
 #include <stdint.h>
 #include "ns3/ptr.h"
 
@@ -44,6 +45,7 @@ class PcapFile
 public:
   static const int32_t  ZONE_DEFAULT    = 0;           /**< Time zone offset for current location */
   static const uint32_t SNAPLEN_DEFAULT = 65535;       /**< Default value for maximum octets to save per packet */
+  static const uint32_t ASYNC_BUFFER_SIZE_DEFAULT = 1024 * 1024; /**< Default size of the write buffer of compressed files */
 
 public:
   PcapFile ();
@@ -74,12 +76,36 @@ public:
    * selected as a binary file (fstream::binary is automatically ored with the mode
    * field).
    *
+   * A file opened for writing whose name ends with ".gz" is written in gzip
+   * format (this requires zlib and thread support).
+   *
    * \param filename String containing the name of the file.
    *
    * \param mode the access mode for the file.
    */
   void Open (std::string const &filename, std::ios::openmode mode);
 
+  /**
+   * Enable or disable asynchronous writing for the next file opened for
+   * writing (only).
+   *
+   * When enabled, the records are accumulated into a memory buffer of the
+   * given size, which is handed to a background thread writing it to disk
+   * when full, so that the simulation does not block on file I/O.  The file
+   * content is complete only after the file is closed, and write errors may
+   * be reported by Fail () only some time after the failing write.  Records
+   * are truncated to the snapshot length before being buffered.
+   *
+   * Asynchronous writing requires thread support; if it is not available,
+   * the file is written synchronously.  Files whose name ends with ".gz"
+   * are always written asynchronously (with a default buffer size if none
+   * was set), since they are gzip-compressed by the background thread.
+   *
+   * \param bufferSize the size of the write buffer, in bytes, or zero to
+   * disable asynchronous writing.
+   */
+  void SetAsyncWrite (uint32_t bufferSize);
+
   /**
    * Close the underlying file.
    */
@@ -364,11 +390,34 @@ private:
    */
   void ReadAndVerifyFileHeader (void);
 
+  /**
+   * \brief Write data to the file, or to the buffer in asynchronous mode
+   * \param data the data
+   * \param size the size of the data
+   */
+  void WriteData (const void *data, uint32_t size);
+  /**
+   * \brief Make room at the end of the buffer (asynchronous mode only)
+   * \param size the number of bytes to append to the buffer
+   * \returns a pointer to the bytes appended to the buffer
+   */
+  uint8_t *Reserve (uint32_t size);
+  /**
+   * \brief Hand the buffer to the background thread if it is full
+   * (asynchronous mode only)
+   */
+  void FlushIfFull (void);
+
   std::string    m_filename;    //!< file name
   std::fstream   m_file;        //!< file stream
   PcapFileHeader m_fileHeader;  //!< file header
   bool m_swapMode;              //!< swap mode
   bool m_nanosecMode;           //!< nanosecond timestamp mode
+  uint32_t m_asyncBufferSize;   //!< size of the write buffer (0 for synchronous writes)
+  bool m_async;                 //!< whether the file is being written asynchronously
+  bool m_asyncFailed;           //!< whether an asynchronous write failed
+  uint32_t m_asyncId;           //!< identifier of the file in the asynchronous writer
+  std::vector<uint8_t> m_buffer; //!< write buffer (asynchronous mode only)
 };
 
 } // namespace ns3
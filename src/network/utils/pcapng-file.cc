@@ -0,0 +1,367 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cstring>
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ns3/packet.h"
+#include "ns3/header.h"
+#include "ns3/buffer.h"
+#include "ns3/abort.h"
+#include "ns3/core-config.h"
+#include "pcapng-file.h"
+#ifdef HAVE_PTHREAD_H
+#include "pcap-async-writer.h"
+#endif /* HAVE_PTHREAD_H */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("PcapNgFile");
+
+const uint32_t SECTION_HEADER_BLOCK = 0x0a0d0d0a;        /**< Section Header Block type */
+const uint32_t INTERFACE_DESCRIPTION_BLOCK = 0x00000001; /**< Interface Description Block type */
+const uint32_t ENHANCED_PACKET_BLOCK = 0x00000006;       /**< Enhanced Packet Block type */
+const uint32_t BYTE_ORDER_MAGIC = 0x1a2b3c4d;            /**< Identifies the byte order of the section */
+const uint16_t VERSION_MAJOR = 1;                        /**< Major version of the pcapng format */
+const uint16_t VERSION_MINOR = 0;                        /**< Minor version of the pcapng format */
+
+const uint16_t OPT_ENDOFOPT = 0;                         /**< End of options */
+const uint16_t SHB_USERAPPL = 4;                         /**< Application which wrote the section */
+const uint16_t IF_NAME = 2;                              /**< Name of the interface */
+const uint16_t IF_TSRESOL = 9;                           /**< Resolution of the timestamps of the interface */
+
+/**
+ * \param length a length in bytes
+ * \returns the given length rounded up to a multiple of 32 bits
+ */
+static uint32_t
+Pad32 (uint32_t length)
+{
+  return (length + 3) & ~3u;
+}
+
+PcapNgFile::PcapNgFile ()
+  : m_bufferSize (BUFFER_SIZE_DEFAULT),
+    m_async (false),
+    m_asyncFailed (false),
+    m_asyncId (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+PcapNgFile::~PcapNgFile ()
+{
+  NS_LOG_FUNCTION (this);
+  Close ();
+}
+
+bool
+PcapNgFile::Fail (void) const
+{
+  NS_LOG_FUNCTION (this);
+  if (m_asyncFailed)
+    {
+      return true;
+    }
+#ifdef HAVE_PTHREAD_H
+  if (m_async)
+    {
+      return PcapAsyncWriter::Get ()->Fail (m_asyncId);
+    }
+#endif /* HAVE_PTHREAD_H */
+  return m_file.fail ();
+}
+
+void
+PcapNgFile::Open (std::string const &filename, uint32_t bufferSize)
+{
+  NS_LOG_FUNCTION (this << filename << bufferSize);
+  NS_ASSERT (!m_file.is_open () && !m_async);
+
+  m_filename = filename;
+  m_bufferSize = bufferSize;
+  m_snapLen.clear ();
+  m_dataLinkType.clear ();
+  m_buffer.clear ();
+  m_buffer.reserve (bufferSize);
+  m_asyncFailed = false;
+
+  //
+  // Files whose name ends with ".gz" are gzip-compressed, by the background
+  // thread of the asynchronous writer.
+  //
+  bool compress = filename.size () > 3 && filename.compare (filename.size () - 3, 3, ".gz") == 0;
+  if (compress)
+    {
+#ifdef HAVE_PTHREAD_H
+      m_async = PcapAsyncWriter::Get ()->Open (filename, m_asyncId, true);
+      m_asyncFailed = !m_async;
+#else
+      NS_ABORT_MSG ("Compressed pcapng files require thread support: " << filename);
+#endif /* HAVE_PTHREAD_H */
+    }
+  else
+    {
+      m_file.open (filename.c_str (), std::ios::out | std::ios::trunc | std::ios::binary);
+    }
+  if (Fail ())
+    {
+      return;
+    }
+
+  //
+  // Section Header Block: block type, block length, byte-order magic,
+  // version, section length (unknown) and options, followed by the block
+  // length again.
+  //
+  std::size_t start = m_buffer.size ();
+  Append32 (SECTION_HEADER_BLOCK);
+  Append32 (0);
+  Append32 (BYTE_ORDER_MAGIC);
+  Append16 (VERSION_MAJOR);
+  Append16 (VERSION_MINOR);
+  Append32 (0xffffffff);
+  Append32 (0xffffffff);
+  AppendOption (SHB_USERAPPL, "ns-3", 4);
+  AppendOption (OPT_ENDOFOPT, 0, 0);
+  uint32_t length = m_buffer.size () - start + 4;
+  std::memcpy (&m_buffer[start + 4], &length, sizeof (length));
+  Append32 (length);
+}
+
+void
+PcapNgFile::Close (void)
+{
+  NS_LOG_FUNCTION (this);
+#ifdef HAVE_PTHREAD_H
+  if (m_async)
+    {
+      Flush ();
+      if (!PcapAsyncWriter::Get ()->Close (m_asyncId))
+        {
+          m_asyncFailed = true;
+        }
+      m_async = false;
+      return;
+    }
+#endif /* HAVE_PTHREAD_H */
+  if (m_file.is_open ())
+    {
+      Flush ();
+      m_file.close ();
+    }
+}
+
+uint32_t
+PcapNgFile::AddInterface (uint32_t dataLinkType, uint32_t snapLen, std::string const &name)
+{
+  NS_LOG_FUNCTION (this << dataLinkType << snapLen << name);
+  NS_ASSERT (m_file.is_open () || m_async);
+
+  //
+  // Interface Description Block: block type, block length, link type,
+  // reserved field, snapshot length and options, followed by the block
+  // length again.  Timestamps are in nanoseconds (if_tsresol = 9).
+  //
+  std::size_t start = m_buffer.size ();
+  Append32 (INTERFACE_DESCRIPTION_BLOCK);
+  Append32 (0);
+  Append16 (dataLinkType);
+  Append16 (0);
+  Append32 (snapLen);
+  AppendOption (IF_NAME, name.data (), name.size ());
+  uint8_t tsresol = 9;
+  AppendOption (IF_TSRESOL, &tsresol, 1);
+  AppendOption (OPT_ENDOFOPT, 0, 0);
+  uint32_t length = m_buffer.size () - start + 4;
+  std::memcpy (&m_buffer[start + 4], &length, sizeof (length));
+  Append32 (length);
+  FlushIfFull ();
+
+  m_snapLen.push_back (snapLen);
+  m_dataLinkType.push_back (dataLinkType);
+  return m_snapLen.size () - 1;
+}
+
+uint32_t
+PcapNgFile::GetNInterfaces (void) const
+{
+  return m_snapLen.size ();
+}
+
+uint32_t
+PcapNgFile::GetMagic (void) const
+{
+  return BYTE_ORDER_MAGIC;
+}
+
+uint16_t
+PcapNgFile::GetVersionMajor (void) const
+{
+  return VERSION_MAJOR;
+}
+
+uint16_t
+PcapNgFile::GetVersionMinor (void) const
+{
+  return VERSION_MINOR;
+}
+
+uint32_t
+PcapNgFile::GetSnapLen (uint32_t interface) const
+{
+  NS_ASSERT_MSG (interface < m_snapLen.size (), "Unknown interface " << interface);
+  return m_snapLen[interface];
+}
+
+uint32_t
+PcapNgFile::GetDataLinkType (uint32_t interface) const
+{
+  NS_ASSERT_MSG (interface < m_dataLinkType.size (), "Unknown interface " << interface);
+  return m_dataLinkType[interface];
+}
+
+uint32_t
+PcapNgFile::WritePacketBlockHeader (uint32_t interface, uint64_t timestamp, uint32_t totalLen)
+{
+  NS_LOG_FUNCTION (this << interface << timestamp << totalLen);
+  NS_ASSERT (m_file.is_open () || m_async);
+  NS_ASSERT_MSG (interface < m_snapLen.size (), "Unknown interface " << interface);
+
+  uint32_t snapLen = m_snapLen[interface];
+  uint32_t inclLen = totalLen > snapLen ? snapLen : totalLen;
+
+  //
+  // Enhanced Packet Block: block type, block length, interface, timestamp
+  // (high and low 32 bits), captured and original packet lengths and packet
+  // data, padded to 32 bits, followed by the block length again.
+  //
+  Append32 (ENHANCED_PACKET_BLOCK);
+  Append32 (32 + Pad32 (inclLen));
+  Append32 (interface);
+  Append32 (timestamp >> 32);
+  Append32 (timestamp & 0xffffffff);
+  Append32 (inclLen);
+  Append32 (totalLen);
+  return inclLen;
+}
+
+void
+PcapNgFile::WritePacketBlockTrailer (uint32_t inclLen)
+{
+  NS_LOG_FUNCTION (this << inclLen);
+  std::memset (Reserve (Pad32 (inclLen) - inclLen), 0, Pad32 (inclLen) - inclLen);
+  Append32 (32 + Pad32 (inclLen));
+  FlushIfFull ();
+}
+
+void
+PcapNgFile::Write (uint32_t interface, uint64_t timestamp, uint8_t const * const data, uint32_t totalLen)
+{
+  NS_LOG_FUNCTION (this << interface << timestamp << &data << totalLen);
+  uint32_t inclLen = WritePacketBlockHeader (interface, timestamp, totalLen);
+  std::memcpy (Reserve (inclLen), data, inclLen);
+  WritePacketBlockTrailer (inclLen);
+}
+
+void
+PcapNgFile::Write (uint32_t interface, uint64_t timestamp, Ptr<const Packet> p)
+{
+  NS_LOG_FUNCTION (this << interface << timestamp << p);
+  uint32_t inclLen = WritePacketBlockHeader (interface, timestamp, p->GetSize ());
+  p->CopyData (Reserve (inclLen), inclLen);
+  WritePacketBlockTrailer (inclLen);
+}
+
+void
+PcapNgFile::Write (uint32_t interface, uint64_t timestamp, const Header &header, Ptr<const Packet> p)
+{
+  NS_LOG_FUNCTION (this << interface << timestamp << &header << p);
+  uint32_t headerSize = header.GetSerializedSize ();
+  uint32_t totalSize = headerSize + p->GetSize ();
+  uint32_t inclLen = WritePacketBlockHeader (interface, timestamp, totalSize);
+
+  Buffer headerBuffer;
+  headerBuffer.AddAtStart (headerSize);
+  header.Serialize (headerBuffer.Begin ());
+  uint32_t toCopy = std::min (headerSize, inclLen);
+  headerBuffer.CopyData (Reserve (toCopy), toCopy);
+  p->CopyData (Reserve (inclLen - toCopy), inclLen - toCopy);
+  WritePacketBlockTrailer (inclLen);
+}
+
+uint8_t *
+PcapNgFile::Reserve (uint32_t size)
+{
+  std::size_t offset = m_buffer.size ();
+  m_buffer.resize (offset + size);
+  return m_buffer.data () + offset;
+}
+
+void
+PcapNgFile::Append16 (uint16_t value)
+{
+  std::memcpy (Reserve (sizeof (value)), &value, sizeof (value));
+}
+
+void
+PcapNgFile::Append32 (uint32_t value)
+{
+  std::memcpy (Reserve (sizeof (value)), &value, sizeof (value));
+}
+
+void
+PcapNgFile::AppendOption (uint16_t code, const void *value, uint16_t length)
+{
+  Append16 (code);
+  Append16 (length);
+  uint8_t *data = Reserve (Pad32 (length));
+  std::memset (data, 0, Pad32 (length));
+  if (length > 0)
+    {
+      std::memcpy (data, value, length);
+    }
+}
+
+void
+PcapNgFile::FlushIfFull (void)
+{
+  if (m_buffer.size () >= m_bufferSize)
+    {
+      Flush ();
+    }
+}
+
+void
+PcapNgFile::Flush (void)
+{
+  NS_LOG_FUNCTION (this << m_buffer.size ());
+#ifdef HAVE_PTHREAD_H
+  if (m_async)
+    {
+      if (!m_buffer.empty ())
+        {
+          PcapAsyncWriter::Get ()->Write (m_asyncId, m_buffer);
+          m_buffer.reserve (m_bufferSize);
+        }
+      return;
+    }
+#endif /* HAVE_PTHREAD_H */
+  m_file.write (reinterpret_cast<const char *> (m_buffer.data ()), m_buffer.size ());
+  m_buffer.clear ();
+}
+
+} // namespace ns3
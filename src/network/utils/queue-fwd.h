@@ -0,0 +1,38 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2007 University of Washington
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef QUEUE_FWD_H
+#define QUEUE_FWD_H
+
+#include "ns3/ptr.h"
+#include <deque>
+
+namespace ns3 {
+
+/**
+ * \ingroup queue
+ * Forward declaration of template class Queue, providing the default
+ * container used to store the items (a std::deque, which grows and shrinks
+ * by blocks of items rather than allocating one node per item).
+ */
+template <typename Item, typename Container = std::deque<Ptr<Item> > >
+class Queue;
+
+} // namespace ns3
+
+#endif /* QUEUE_FWD_H */
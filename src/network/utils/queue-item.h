@@ -22,6 +22,7 @@
 
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
+#include "ns3/arena-allocator.h"
 #include <ns3/address.h>
 #include "ns3/nstime.h"
 
@@ -41,9 +42,10 @@ class Packet;
  * An item stored in an ns-3 packet Queue contains a packet and possibly other
  * information. An item of the base class only contains a packet. Subclasses
  * can be derived from this base class to allow items to contain additional
- * information.
+ * information.  The items, including the QueueDiscItems, are allocated by
+ * ns3::ArenaAllocator.
  */
-class QueueItem : public SimpleRefCount<QueueItem>
+class QueueItem : public SimpleRefCount<QueueItem>, public ArenaAllocated
 {
 public:
   /**
@@ -29,10 +29,10 @@
 #include "ns3/event-id.h"
 
 #include "mac48-address.h"
+#include "queue-fwd.h"
 
 namespace ns3 {
 
-template <typename Item> class Queue;
 class SimpleChannel;
 class Node;
 class ErrorModel;
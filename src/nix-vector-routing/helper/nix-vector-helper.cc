@@ -69,6 +69,18 @@ NixVectorHelper<T>::PrintRoutingPathAt (Time printTime, Ptr<Node> source, IpAddr
   Simulator::Schedule (printTime, &NixVectorHelper<T>::PrintRoute, source, dest, stream, unit);
 }
 
+template <typename T>
+void
+NixVectorHelper<T>::PrecomputeRoutes (NodeContainer nodes) const
+{
+  for (NodeContainer::Iterator i = nodes.Begin (); i != nodes.End (); ++i)
+    {
+      Ptr<NixVectorRouting<IpRoutingProtocol>> rp = T::template GetRouting <NixVectorRouting<IpRoutingProtocol>> ((*i)->GetObject<Ip> ()->GetRoutingProtocol ());
+      NS_ASSERT_MSG (rp, "Node " << (*i)->GetId () << " does not use Nix-vector routing");
+      rp->PrecomputeRoutes ();
+    }
+}
+
 template <typename T>
 void
 NixVectorHelper<T>::PrintRoute (Ptr<Node> source, IpAddress dest, Ptr<OutputStreamWrapper> stream, Time::Unit unit)
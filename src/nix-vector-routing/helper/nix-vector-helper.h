@@ -29,6 +29,7 @@
 #include "ns3/object-factory.h"
 #include "ns3/ipv4-routing-helper.h"
 #include "ns3/ipv6-routing-helper.h"
+#include "ns3/node-container.h"
 
 namespace ns3 {
 
@@ -104,6 +105,19 @@ public:
    */
   void PrintRoutingPathAt (Time printTime, Ptr<Node> source, IpAddress dest, Ptr<OutputStreamWrapper> stream, Time::Unit unit = Time::S);
 
+  /**
+   * \brief computes the routes from the given nodes to every destination
+   * ahead of time.
+   * \param nodes the source nodes
+   *
+   * This method calls the PrecomputeRoutes() method of the
+   * NixVectorRouting of each node, one after the other.  It must be
+   * called after the IP addresses have been assigned.  Each node takes
+   * 4 bytes per node of the topology, so only the nodes which send
+   * packets should be given.
+   */
+  void PrecomputeRoutes (NodeContainer nodes) const;
+
 private:
   /**
    * \brief Assignment operator declared private and not implemented to disallow
@@ -24,6 +24,7 @@
  */
 
 #include <queue>
+#include <set>
 #include <iomanip>
 
 #include "ns3/log.h"
@@ -50,6 +51,9 @@ typename NixVectorRouting<T>::IpAddressToNodeMap NixVectorRouting<T>::g_ipAddres
 template <typename T>
 typename NixVectorRouting<T>::NetDeviceToIpInterfaceMap NixVectorRouting<T>::g_netdeviceToIpInterfaceMap;
 
+template <typename T>
+typename NixVectorRouting<T>::ShortestPathTreeMap NixVectorRouting<T>::g_shortestPathTrees;
+
 template <typename T>
 TypeId 
 NixVectorRouting<T>::GetTypeId (void)
@@ -66,7 +70,8 @@ NixVectorRouting<T>::GetTypeId (void)
 
 template <typename T>
 NixVectorRouting<T>::NixVectorRouting ()
-  : m_totalNeighbors (0)
+  : m_nixCacheHasOif (false),
+    m_totalNeighbors (0)
 {
   NS_LOG_FUNCTION_NOARGS ();
 }
@@ -157,7 +162,119 @@ NixVectorRouting<T>::FlushGlobalNixRoutingCache (void) const
 
   // IP address to node mapping is potentially invalid so clear it.
   // Will be repopulated in lazy evaluation when mapping is needed.
+  // The interfaces of the net devices are found along with the addresses,
+  // and the trees precomputed before any address lookup depend on them.
   g_ipAddressToNodeMap.clear ();
+  g_netdeviceToIpInterfaceMap.clear ();
+
+  g_shortestPathTrees.clear ();
+}
+
+template <typename T>
+void
+NixVectorRouting<T>::PrecomputeRoutes (void) const
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT_MSG (m_node, "PrecomputeRoutes called before SetNode");
+
+  CheckCacheStateAndFlush ();
+  GetShortestPathTree (m_node);
+}
+
+template <typename T>
+const std::vector<uint32_t> &
+NixVectorRouting<T>::GetShortestPathTree (Ptr<Node> source) const
+{
+  NS_LOG_FUNCTION (this << source);
+
+  typename ShortestPathTreeMap::iterator iter = g_shortestPathTrees.find (source->GetId ());
+  if (iter == g_shortestPathTrees.end ())
+    {
+      NS_LOG_LOGIC ("Building shortest path tree rooted at node " << source->GetId ());
+      iter = g_shortestPathTrees.insert (typename ShortestPathTreeMap::value_type (source->GetId (), std::vector<uint32_t> ())).first;
+      BFS (NodeList::GetNNodes (), source, 0, iter->second, 0);
+    }
+  return iter->second;
+}
+
+template <typename T>
+bool
+NixVectorRouting<T>::InvalidateCachesOnInterfaceDown (uint32_t interface) const
+{
+  NS_LOG_FUNCTION (this << interface);
+
+  if (!m_node || !m_ip)
+    {
+      return false;
+    }
+
+  // Find the nodes whose neighbors change: this one, and the ones
+  // across the channel.  Their neighbor indexes are shifted, so any
+  // nix-vector that goes through them is not valid anymore.
+  Ptr<NetDevice> netDevice = m_ip->GetNetDevice (interface);
+  Ptr<Channel> channel = netDevice->GetChannel ();
+  if (channel == 0)
+    {
+      NS_LOG_LOGIC ("Interface has no channel, no route goes through it");
+      return true;
+    }
+  std::set<uint32_t> affectedNodes;
+  affectedNodes.insert (m_node->GetId ());
+  for (std::size_t i = 0; i < channel->GetNDevices (); i++)
+    {
+      Ptr<NetDevice> remoteDevice = channel->GetDevice (i);
+      if (NetDeviceIsBridged (remoteDevice))
+        {
+          NS_LOG_LOGIC ("Bridged devices, can not determine the affected routes");
+          return false;
+        }
+      affectedNodes.insert (remoteDevice->GetNode ()->GetId ());
+    }
+
+  // A tree is invalid if any affected node forwards packets in it,
+  // i.e., if it is the parent of another node.
+  std::set<uint32_t> invalidTrees;
+  for (typename ShortestPathTreeMap::iterator iter = g_shortestPathTrees.begin (); iter != g_shortestPathTrees.end (); )
+    {
+      const std::vector<uint32_t> &tree = iter->second;
+      bool valid = true;
+      for (uint32_t node = 0; node < tree.size () && valid; node++)
+        {
+          valid = (node == iter->first || tree[node] == NO_PARENT || affectedNodes.count (tree[node]) == 0);
+        }
+      if (valid)
+        {
+          ++iter;
+        }
+      else
+        {
+          NS_LOG_LOGIC ("Invalidating shortest path tree rooted at node " << iter->first);
+          invalidTrees.insert (iter->first);
+          iter = g_shortestPathTrees.erase (iter);
+        }
+    }
+
+  NodeList::Iterator listEnd = NodeList::End ();
+  for (NodeList::Iterator i = NodeList::Begin (); i != listEnd; i++)
+    {
+      Ptr<Node> node = *i;
+      Ptr<NixVectorRouting<T> > rp = node->GetObject<NixVectorRouting> ();
+      if (!rp)
+        {
+          continue;
+        }
+      // Nix-vectors of a node are built from the tree rooted at it, unless
+      // a specific output interface was requested
+      if (rp->m_nixCacheHasOif || invalidTrees.count (node->GetId ())
+          || g_shortestPathTrees.find (node->GetId ()) == g_shortestPathTrees.end ())
+        {
+          rp->FlushNixCache ();
+        }
+      // IpRoutes are cheap to rebuild and do not depend on the source
+      rp->FlushIpRouteCache ();
+      rp->m_totalNeighbors = 0;
+    }
+  return true;
 }
 
 template <typename T>
@@ -166,6 +283,7 @@ NixVectorRouting<T>::FlushNixCache (void) const
 {
   NS_LOG_FUNCTION_NOARGS ();
   m_nixCache.clear ();
+  m_nixCacheHasOif = false;
 }
 
 template <typename T>
@@ -206,9 +324,23 @@ NixVectorRouting<T>::GetNixVector (Ptr<Node> source, IpAddress dest, Ptr<NetDevi
     {
       // otherwise proceed as normal 
       // and build the nix vector
-      std::vector< Ptr<Node> > parentVector;
+      std::vector<uint32_t> parentVector;
 
-      if (BFS (NodeList::GetNNodes (), source, destNode, parentVector, oif))
+      if (!oif)
+        {
+          // The shortest path tree rooted at the source holds the
+          // routes to every destination
+          if (BuildNixVector (GetShortestPathTree (source), source->GetId (), destNode->GetId (), nixVector))
+            {
+              return nixVector;
+            }
+          else
+            {
+              NS_LOG_ERROR ("No routing path exists");
+              return 0;
+            }
+        }
+      else if (BFS (NodeList::GetNNodes (), source, destNode, parentVector, oif))
         {
           if (BuildNixVector (parentVector, source->GetId (), destNode->GetId (), nixVector))
             {
@@ -271,7 +403,7 @@ NixVectorRouting<T>::GetIpRouteInCache (IpAddress address)
 
 template <typename T>
 bool
-NixVectorRouting<T>::BuildNixVector (const std::vector< Ptr<Node> > & parentVector, uint32_t source, uint32_t dest, Ptr<NixVector> nixVector) const
+NixVectorRouting<T>::BuildNixVector (const std::vector<uint32_t> & parentVector, uint32_t source, uint32_t dest, Ptr<NixVector> nixVector) const
 {
   NS_LOG_FUNCTION (this << parentVector << source << dest << nixVector);
 
@@ -280,12 +412,12 @@ NixVectorRouting<T>::BuildNixVector (const std::vector< Ptr<Node> > & parentVect
       return true;
     }
 
-  if (parentVector.at (dest) == 0)
+  if (dest >= parentVector.size () || parentVector[dest] == NO_PARENT)
     {
       return false;
     }
 
-  Ptr<Node> parentNode = parentVector.at (dest);
+  Ptr<Node> parentNode = NodeList::GetNode (parentVector[dest]);
 
   uint32_t numberOfDevices = parentNode->GetNDevices ();
   uint32_t destId = 0;
@@ -339,7 +471,7 @@ NixVectorRouting<T>::BuildNixVector (const std::vector< Ptr<Node> > & parentVect
 
   // recurse through T vector, grabbing the path
   // and building the nix vector
-  BuildNixVector (parentVector, source, (parentVector.at (dest))->GetId (), nixVector);
+  BuildNixVector (parentVector, source, parentVector[dest], nixVector);
   return true;
 }
 
@@ -727,6 +859,10 @@ NixVectorRouting<T>::RouteOutput (Ptr<Packet> p, const IpHeader &header, Ptr<Net
 
       // cache it
       m_nixCache.insert (typename NixMap_t::value_type (destAddress, nixVectorInCache));
+      if (oif)
+        {
+          m_nixCacheHasOif = true;
+        }
     }
 
   // path exists
@@ -1024,7 +1160,11 @@ template <typename T>
 void
 NixVectorRouting<T>::NotifyInterfaceDown (uint32_t i)
 {
-  g_isCacheDirty = true;
+  // Nothing to do if all the caches are going to be flushed anyway
+  if (!g_isCacheDirty && !InvalidateCachesOnInterfaceDown (i))
+    {
+      g_isCacheDirty = true;
+    }
 }
 template <typename T>
 void
@@ -1054,20 +1194,20 @@ NixVectorRouting<T>::NotifyRemoveRoute (IpAddress dst, Ipv6Prefix mask, IpAddres
 template <typename T>
 bool
 NixVectorRouting<T>::BFS (uint32_t numberOfNodes, Ptr<Node> source,
-                           Ptr<Node> dest, std::vector< Ptr<Node> > & parentVector,
+                           Ptr<Node> dest, std::vector<uint32_t> & parentVector,
                            Ptr<NetDevice> oif) const
 {
   NS_LOG_FUNCTION (this << numberOfNodes << source << dest << parentVector << oif);
 
-  NS_LOG_LOGIC ("Going from Node " << source->GetId () << " to Node " << dest->GetId ());
+  NS_LOG_LOGIC ("Going from Node " << source->GetId () << " to Node " << (dest ? dest->GetId () : NO_PARENT));
   std::queue< Ptr<Node> > greyNodeList;  // discovered nodes with unexplored children
 
   // reset the parent vector
-  parentVector.assign (numberOfNodes, 0); // initialize to 0
+  parentVector.assign (numberOfNodes, NO_PARENT);
 
   // Add the source node to the queue, set its parent to itself
   greyNodeList.push (source);
-  parentVector.at (source->GetId ()) = source;
+  parentVector.at (source->GetId ()) = source->GetId ();
 
   // BFS loop
   while (greyNodeList.size () != 0)
@@ -1075,7 +1215,7 @@ NixVectorRouting<T>::BFS (uint32_t numberOfNodes, Ptr<Node> source,
       Ptr<Node> currNode = greyNodeList.front ();
       Ptr<IpL3Protocol> ip = currNode->GetObject<IpL3Protocol> ();
  
-      if (currNode == dest) 
+      if (dest && currNode == dest) 
         {
           NS_LOG_LOGIC ("Made it to Node " << currNode->GetId ());
           return true;
@@ -1130,9 +1270,9 @@ NixVectorRouting<T>::BFS (uint32_t numberOfNodes, Ptr<Node> source,
               // by checking to see if it has a parent
               // if it doesn't (null or 0), then set its parent and
               // push to the queue
-              if (parentVector.at (remoteNode->GetId ()) == 0)
+              if (parentVector.at (remoteNode->GetId ()) == NO_PARENT)
                 {
-                  parentVector.at (remoteNode->GetId ()) = currNode;
+                  parentVector.at (remoteNode->GetId ()) = currNode->GetId ();
                   greyNodeList.push (remoteNode);
                 }
             }
@@ -1192,9 +1332,9 @@ NixVectorRouting<T>::BFS (uint32_t numberOfNodes, Ptr<Node> source,
                   // by checking to see if it has a parent
                   // if it doesn't (null or 0), then set its parent and
                   // push to the queue
-                  if (parentVector.at (remoteNode->GetId ()) == 0)
+                  if (parentVector.at (remoteNode->GetId ()) == NO_PARENT)
                     {
-                      parentVector.at (remoteNode->GetId ()) = currNode;
+                      parentVector.at (remoteNode->GetId ()) = currNode->GetId ();
                       greyNodeList.push (remoteNode);
                     }
                 }
@@ -1206,8 +1346,8 @@ NixVectorRouting<T>::BFS (uint32_t numberOfNodes, Ptr<Node> source,
       greyNodeList.pop ();
     }
 
-  // Didn't find the dest...
-  return false;
+  // Didn't find the dest... unless the whole tree was requested
+  return (dest == 0);
 }
 
 template <typename T>
@@ -1358,6 +1498,8 @@ template void NixVectorRouting<Ipv4RoutingProtocol>::SetNode (Ptr<Node> node);
 template void NixVectorRouting<Ipv6RoutingProtocol>::SetNode (Ptr<Node> node);
 template void NixVectorRouting<Ipv4RoutingProtocol>::FlushGlobalNixRoutingCache (void) const;
 template void NixVectorRouting<Ipv6RoutingProtocol>::FlushGlobalNixRoutingCache (void) const;
+template void NixVectorRouting<Ipv4RoutingProtocol>::PrecomputeRoutes (void) const;
+template void NixVectorRouting<Ipv6RoutingProtocol>::PrecomputeRoutes (void) const;
 template void NixVectorRouting<Ipv4RoutingProtocol>::PrintRoutingPath (Ptr<Node> source, IpAddress dest,
                                                                        Ptr<OutputStreamWrapper> stream, Time::Unit unit) const;
 template void NixVectorRouting<Ipv6RoutingProtocol>::PrintRoutingPath (Ptr<Node> source, IpAddress dest,
@@ -52,6 +52,7 @@ using namespace ns3;
    \endverbatim
  *
  * Following are the tests in this test case:
+ * (Precompute the routes from nSrc.)
  * - Test the routing from nSrc to nDst.
  * - Test if the path taken is the shortest path.
  * (Set down the interface of nA on nA-nC channel.)
@@ -251,6 +252,10 @@ NixVectorRoutingTest::DoRun (void)
   Ipv6InterfaceContainer iCiDstv6 = aCaDstv6.Assign (dCdDst);
   Ipv6InterfaceContainer iAiCv6 = aAaCv6.Assign (dAdC);
 
+  // Build the routes from nSrc ahead of time
+  ipv4NixRouting.PrecomputeRoutes (nSrcnA.Get (0));
+  ipv6NixRouting.PrecomputeRoutes (nSrcnA.Get (0));
+
   // Create the UDP sockets
   Ptr<SocketFactory> rxSocketFactory = nCnDst.Get (1)->GetObject<UdpSocketFactory> ();
   Ptr<Socket> rxSocketv4 = rxSocketFactory->CreateSocket ();
@@ -364,6 +369,133 @@ NixVectorRoutingTest::DoRun (void)
   Simulator::Destroy ();
 }
 
+/**
+ * \ingroup nix-vector-routing-test
+ * \ingroup tests
+ *
+ * The topology is of the form:
+ * \verbatim
+                  ____________
+                 /            \
+    nA -- nB -- nC -- nD      |
+           \__________________/
+   \endverbatim
+ * where nB is linked to nD.
+ *
+ * Following are the tests in this test case:
+ * (Precompute the routes from nA and nD, and build the routes to nC.)
+ * - Test that the route from nD to nC is direct.
+ * (Set down the interface of nC on nC-nD channel.)
+ * - Test that the tree rooted at nA, in which neither nC nor nD forwards
+ *   packets, is kept along with the nix-vectors built from it.
+ * - Test that the tree rooted at nD is invalidated along with its
+ *   nix-vectors, and that the route from nD to nC now goes through nB.
+ *
+ * \brief Nix-Vector Routing cache invalidation Test
+ */
+class NixVectorRoutingInvalidationTest : public TestCase
+{
+public:
+  virtual void DoRun (void);
+  NixVectorRoutingInvalidationTest ();
+
+private:
+  /**
+   * \brief Get the nix-vector cache printed in a routing table
+   * \param table The printed routing table.
+   * \returns The lines of the nix-vector cache.
+   */
+  static std::string GetNixCache (const std::string &table);
+};
+
+NixVectorRoutingInvalidationTest::NixVectorRoutingInvalidationTest ()
+  : TestCase ("invalidation of the routes through a link going down")
+{
+}
+
+std::string
+NixVectorRoutingInvalidationTest::GetNixCache (const std::string &table)
+{
+  std::string::size_type begin = table.find ("NixCache:\n");
+  std::string::size_type end = table.find ("IpRouteCache:");
+  if (begin == std::string::npos || end == std::string::npos)
+    {
+      return "";
+    }
+  begin += std::string ("NixCache:\n").size ();
+  return table.substr (begin, end - begin);
+}
+
+void
+NixVectorRoutingInvalidationTest::DoRun (void)
+{
+  NodeContainer nodes;
+  nodes.Create (4);
+
+  SimpleNetDeviceHelper devHelper;
+  devHelper.SetNetDevicePointToPointMode (true);
+
+  Ipv4NixVectorHelper nixRouting;
+  InternetStackHelper stack;
+  stack.SetRoutingHelper (nixRouting);
+  stack.SetIpv6StackInstall (false);
+  stack.Install (nodes);
+
+  NetDeviceContainer dAdB = devHelper.Install (NodeContainer (nodes.Get (0), nodes.Get (1)));
+  NetDeviceContainer dBdC = devHelper.Install (NodeContainer (nodes.Get (1), nodes.Get (2)));
+  NetDeviceContainer dCdD = devHelper.Install (NodeContainer (nodes.Get (2), nodes.Get (3)));
+  NetDeviceContainer dBdD = devHelper.Install (NodeContainer (nodes.Get (1), nodes.Get (3)));
+
+  Ipv4AddressHelper address;
+  address.SetBase ("10.2.0.0", "255.255.255.0");
+  address.Assign (dAdB);
+  address.NewNetwork ();
+  Ipv4InterfaceContainer iBiC = address.Assign (dBdC);
+  address.NewNetwork ();
+  address.Assign (dCdD);
+  address.NewNetwork ();
+  address.Assign (dBdD);
+  Ipv4Address addressC = iBiC.GetAddress (1);
+
+  nixRouting.PrecomputeRoutes (NodeContainer (nodes.Get (0), nodes.Get (3)));
+
+  std::ostringstream pathA1;
+  std::ostringstream pathD1;
+  std::ostringstream tableA;
+  std::ostringstream tableD;
+  std::ostringstream pathD2;
+  nixRouting.PrintRoutingPathAt (Seconds (1), nodes.Get (0), addressC, Create<OutputStreamWrapper> (&pathA1));
+  nixRouting.PrintRoutingPathAt (Seconds (1), nodes.Get (3), addressC, Create<OutputStreamWrapper> (&pathD1));
+
+  Ptr<Ipv4> ipv4 = nodes.Get (2)->GetObject<Ipv4> ();
+  Simulator::Schedule (Seconds (2), &Ipv4::SetDown, ipv4, ipv4->GetInterfaceForDevice (dCdD.Get (0)));
+
+  nixRouting.PrintRoutingTableAt (Seconds (3), nodes.Get (0), Create<OutputStreamWrapper> (&tableA));
+  nixRouting.PrintRoutingTableAt (Seconds (3), nodes.Get (3), Create<OutputStreamWrapper> (&tableD));
+  nixRouting.PrintRoutingPathAt (Seconds (4), nodes.Get (3), addressC, Create<OutputStreamWrapper> (&pathD2));
+
+  Simulator::Run ();
+
+  NS_TEST_EXPECT_MSG_NE (pathA1.str ().find ("(Node 1)  ---->"), std::string::npos,
+                         "The route from nA to nC should go through nB.");
+  NS_TEST_EXPECT_MSG_NE (pathD1.str ().find ("(Node 3)  ---->   10.2.1.2"), std::string::npos,
+                         "The route from nD to nC should be direct.");
+  NS_TEST_EXPECT_MSG_EQ (pathD1.str ().find ("(Node 1)"), std::string::npos,
+                         "The route from nD to nC should not go through nB.");
+
+  NS_TEST_EXPECT_MSG_NE (GetNixCache (tableA.str ()).find ("10.2.1.2"),
+                         std::string::npos, "The route from nA to nC should have been kept.");
+  NS_TEST_EXPECT_MSG_EQ (GetNixCache (tableD.str ()), "",
+                         "The route from nD to nC should have been invalidated.");
+
+  NS_TEST_EXPECT_MSG_NE (pathD2.str ().find ("(Node 3)  ---->   10.2.3.1"), std::string::npos,
+                         "The route from nD to nC should now go through nB.");
+  NS_TEST_EXPECT_MSG_NE (pathD2.str ().find ("(Node 1)  ---->   10.2.1.2"), std::string::npos,
+                         "The route from nD to nC should now go through nB.");
+
+  Simulator::Destroy ();
+}
+
 /**
  * \ingroup nix-vector-routing-test
  * \ingroup tests
@@ -376,6 +508,7 @@ public:
   NixVectorRoutingTestSuite () : TestSuite ("nix-vector-routing", UNIT)
   {
     AddTestCase (new NixVectorRoutingTest (), TestCase::QUICK);
+    AddTestCase (new NixVectorRoutingInvalidationTest (), TestCase::QUICK);
   }
 };
 
@@ -230,15 +230,17 @@ PointToPointHelper::Install (Ptr<Node> a, Ptr<Node> b)
 {
   NetDeviceContainer container;
 
-  Ptr<PointToPointNetDevice> devA = m_deviceFactory.Create<PointToPointNetDevice> ();
+  std::vector<Ptr<PointToPointNetDevice> > devices = m_deviceFactory.Create<PointToPointNetDevice> (2);
+  std::vector<Ptr<Queue<Packet> > > queues = m_queueFactory.Create<Queue<Packet> > (2);
+  Ptr<PointToPointNetDevice> devA = devices[0];
   devA->SetAddress (Mac48Address::Allocate ());
   a->AddDevice (devA);
-  Ptr<Queue<Packet> > queueA = m_queueFactory.Create<Queue<Packet> > ();
+  Ptr<Queue<Packet> > queueA = queues[0];
   devA->SetQueue (queueA);
-  Ptr<PointToPointNetDevice> devB = m_deviceFactory.Create<PointToPointNetDevice> ();
+  Ptr<PointToPointNetDevice> devB = devices[1];
   devB->SetAddress (Mac48Address::Allocate ());
   b->AddDevice (devB);
-  Ptr<Queue<Packet> > queueB = m_queueFactory.Create<Queue<Packet> > ();
+  Ptr<Queue<Packet> > queueB = queues[1];
   devB->SetQueue (queueB);
   // Aggregate NetDeviceQueueInterface objects
   Ptr<NetDeviceQueueInterface> ndqiA = CreateObject<NetDeviceQueueInterface> ();
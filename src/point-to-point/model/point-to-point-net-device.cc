@@ -67,6 +67,15 @@ PointToPointNetDevice::GetTypeId (void)
                    TimeValue (Seconds (0.0)),
                    MakeTimeAccessor (&PointToPointNetDevice::m_tInterframeGap),
                    MakeTimeChecker ())
+    .AddAttribute ("TxBurstSize",
+                   "The maximum number of packets taken at once from the transmit "
+                   "queue and serialized back-to-back, with a single transmit "
+                   "complete event. The trace sources of the packets of a burst "
+                   "(including pcap and ascii traces) are fired at the start and "
+                   "at the end of the whole burst.",
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&PointToPointNetDevice::m_txBurstSize),
+                   MakeUintegerChecker<uint32_t> (1))
 
     //
     // Transmit queueing discipline for the device which includes its own set
@@ -214,6 +223,7 @@ PointToPointNetDevice::DoDispose ()
   m_channel = 0;
   m_receiveErrorModel = 0;
   m_currentPkt = 0;
+  m_txBurst.clear ();
   m_queue = 0;
   NetDevice::DoDispose ();
 }
@@ -251,6 +261,28 @@ PointToPointNetDevice::TransmitStart (Ptr<Packet> p)
   Time txTime = m_bps.CalculateBytesTxTime (p->GetSize ());
   Time txCompleteTime = txTime + m_tInterframeGap;
 
+  //
+  // Pull the packets waiting behind this one, if bursts are enabled. They are
+  // serialized back-to-back and each of them reaches the other end of the
+  // channel at the end of its own serialization.
+  //
+  std::vector<Time> burstTxTime;
+  while (m_txBurst.size () + 1 < m_txBurstSize)
+    {
+      Ptr<Packet> next = m_queue->Dequeue ();
+      if (next == 0)
+        {
+          break;
+        }
+      m_snifferTrace (next);
+      m_promiscSnifferTrace (next);
+      m_phyTxBeginTrace (next);
+      m_txBurst.push_back (next);
+      Time nextTxTime = m_bps.CalculateBytesTxTime (next->GetSize ());
+      burstTxTime.push_back (txCompleteTime + nextTxTime);
+      txCompleteTime += nextTxTime + m_tInterframeGap;
+    }
+
   NS_LOG_LOGIC ("Schedule TransmitCompleteEvent in " << txCompleteTime.As (Time::S));
   Simulator::Schedule (txCompleteTime, &PointToPointNetDevice::TransmitComplete, this);
 
@@ -259,6 +291,13 @@ PointToPointNetDevice::TransmitStart (Ptr<Packet> p)
     {
       m_phyTxDropTrace (p);
     }
+  for (uint32_t i = 0; i < m_txBurst.size (); i++)
+    {
+      if (m_channel->TransmitStart (m_txBurst[i], this, burstTxTime[i]) == false)
+        {
+          m_phyTxDropTrace (m_txBurst[i]);
+        }
+    }
   return result;
 }
 
@@ -280,6 +319,11 @@ PointToPointNetDevice::TransmitComplete (void)
 
   m_phyTxEndTrace (m_currentPkt);
   m_currentPkt = 0;
+  for (uint32_t i = 0; i < m_txBurst.size (); i++)
+    {
+      m_phyTxEndTrace (m_txBurst[i]);
+    }
+  m_txBurst.clear ();
 
   Ptr<Packet> p = m_queue->Dequeue ();
   if (p == 0)
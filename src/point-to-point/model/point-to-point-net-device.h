@@ -20,6 +20,7 @@
 #define POINT_TO_POINT_NET_DEVICE_H
 
 #include <cstring>
+#include <vector>
 #include "ns3/address.h"
 #include "ns3/node.h"
 #include "ns3/net-device.h"
@@ -30,10 +31,10 @@
 #include "ns3/data-rate.h"
 #include "ns3/ptr.h"
 #include "ns3/mac48-address.h"
+#include "ns3/queue-fwd.h"
 
 namespace ns3 {
 
-template <typename Item> class Queue;
 class PointToPointChannel;
 class ErrorModel;
 
@@ -260,6 +261,11 @@ private:
    * started sending signals.  An event is scheduled for the time at which
    * the bits have been completely transmitted.
    *
+   * If the TxBurstSize attribute is greater than one, the packets waiting in
+   * the transmit queue are also taken (up to TxBurstSize packets in total)
+   * and serialized back-to-back after this one, and the event is scheduled
+   * at the end of the whole burst.
+   *
    * \see PointToPointChannel::TransmitStart ()
    * \see TransmitComplete()
    * \param p a reference to the packet to send
@@ -456,6 +462,8 @@ private:
   uint32_t m_mtu;
 
   Ptr<Packet> m_currentPkt; //!< Current packet processed
+  uint32_t m_txBurstSize;   //!< Maximum number of packets serialized back-to-back
+  std::vector<Ptr<Packet> > m_txBurst; //!< Packets serialized after m_currentPkt in the current burst
 
   /**
    * \brief PPP to Ethernet protocol number mapping
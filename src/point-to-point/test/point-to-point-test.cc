@@ -24,8 +24,11 @@
 #include "ns3/point-to-point-net-device.h"
 #include "ns3/point-to-point-channel.h"
 #include "ns3/net-device-queue-interface.h"
+#include "ns3/uinteger.h"
+#include "ns3/data-rate.h"
 
 #include <string>
+#include <vector>
 
 using namespace ns3;
 
@@ -130,6 +133,126 @@ PointToPointTest::DoRun (void)
   Simulator::Destroy ();
 }
 
+/**
+ * \brief Test the transmission of bursts of packets
+ *
+ * It sends a few packets at once with different values of the TxBurstSize
+ * attribute, and checks that they are received at the same times as when
+ * they are transmitted one by one.
+ */
+class PointToPointBurstTest : public TestCase
+{
+public:
+  /**
+   * \brief Create the test
+   */
+  PointToPointBurstTest ();
+
+  /**
+   * \brief Run the test
+   */
+  virtual void DoRun (void);
+
+private:
+  std::vector<Time> m_rxTimes; //!< reception times of the packets
+
+  /**
+   * \brief Send a few packets of different sizes, all at once
+   *
+   * \param device NetDevice to send to.
+   */
+  void SendPackets (Ptr<PointToPointNetDevice> device);
+  /**
+   * \brief Callback function which records the reception time
+   *
+   * \param dev The receiving device.
+   * \param pkt The received packet.
+   * \param mode The protocol mode used.
+   * \param sender The sender address.
+   *
+   * \return A boolean indicating packet handled properly.
+   */
+  bool RxPacket (Ptr<NetDevice> dev, Ptr<const Packet> pkt, uint16_t mode, const Address &sender);
+  /**
+   * \brief Run a simulation with the given burst size
+   *
+   * \param burstSize The value of the TxBurstSize attribute.
+   * \return The reception times of the packets.
+   */
+  std::vector<Time> RunWithBurstSize (uint32_t burstSize);
+};
+
+PointToPointBurstTest::PointToPointBurstTest ()
+  : TestCase ("PointToPoint bursts")
+{
+}
+
+void
+PointToPointBurstTest::SendPackets (Ptr<PointToPointNetDevice> device)
+{
+  for (uint32_t i = 0; i < 7; i++)
+    {
+      device->Send (Create<Packet> (100 + 200 * i), device->GetBroadcast (), 0x800);
+    }
+}
+
+bool
+PointToPointBurstTest::RxPacket (Ptr<NetDevice> dev, Ptr<const Packet> pkt, uint16_t mode, const Address &sender)
+{
+  m_rxTimes.push_back (Simulator::Now ());
+  return true;
+}
+
+std::vector<Time>
+PointToPointBurstTest::RunWithBurstSize (uint32_t burstSize)
+{
+  Ptr<Node> a = CreateObject<Node> ();
+  Ptr<Node> b = CreateObject<Node> ();
+  Ptr<PointToPointNetDevice> devA = CreateObject<PointToPointNetDevice> ();
+  Ptr<PointToPointNetDevice> devB = CreateObject<PointToPointNetDevice> ();
+  Ptr<PointToPointChannel> channel = CreateObject<PointToPointChannel> ();
+  channel->SetAttribute ("Delay", TimeValue (MilliSeconds (2)));
+
+  devA->Attach (channel);
+  devA->SetAddress (Mac48Address::Allocate ());
+  devA->SetQueue (CreateObject<DropTailQueue<Packet> > ());
+  devA->SetDataRate (DataRate ("10Mbps"));
+  devA->SetInterframeGap (MicroSeconds (3));
+  devA->SetAttribute ("TxBurstSize", UintegerValue (burstSize));
+  devB->Attach (channel);
+  devB->SetAddress (Mac48Address::Allocate ());
+  devB->SetQueue (CreateObject<DropTailQueue<Packet> > ());
+
+  a->AddDevice (devA);
+  b->AddDevice (devB);
+
+  devB->SetReceiveCallback (MakeCallback (&PointToPointBurstTest::RxPacket, this));
+
+  m_rxTimes.clear ();
+  Simulator::Schedule (Seconds (1.0), &PointToPointBurstTest::SendPackets, this, devA);
+  Simulator::Schedule (Seconds (2.0), &PointToPointBurstTest::SendPackets, this, devA);
+  Simulator::Run ();
+  Simulator::Destroy ();
+  return m_rxTimes;
+}
+
+void
+PointToPointBurstTest::DoRun (void)
+{
+  std::vector<Time> expected = RunWithBurstSize (1);
+  NS_TEST_ASSERT_MSG_EQ (expected.size (), 14, "All the packets should have been received");
+
+  for (uint32_t burstSize = 2; burstSize <= 8; burstSize += 3)
+    {
+      std::vector<Time> rxTimes = RunWithBurstSize (burstSize);
+      NS_TEST_ASSERT_MSG_EQ (rxTimes.size (), expected.size (), "Wrong number of packets received with burst size " << burstSize);
+      for (uint32_t i = 0; i < rxTimes.size (); i++)
+        {
+          NS_TEST_EXPECT_MSG_EQ (rxTimes[i], expected[i], "Wrong reception time of packet " << i << " with burst size " << burstSize);
+        }
+    }
+}
+
 /**
  * \brief TestSuite for PointToPoint module
  */
@@ -146,6 +269,7 @@ PointToPointTestSuite::PointToPointTestSuite ()
   : TestSuite ("devices-point-to-point", UNIT)
 {
   AddTestCase (new PointToPointTest, TestCase::QUICK);
+  AddTestCase (new PointToPointBurstTest, TestCase::QUICK);
 }
 
 static PointToPointTestSuite g_pointToPointTestSuite; //!< The testsuite
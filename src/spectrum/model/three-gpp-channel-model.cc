@@ -1081,10 +1081,8 @@ ThreeGppChannelModel::GetNewChannel (Vector locUT, Ptr<const ChannelCondition> c
       paramNum = 6;
     }
   //Generate paramNum independent LSPs.
-  for (uint8_t iter = 0; iter < paramNum; iter++)
-    {
-      LSPsIndep.push_back (m_normalRv->GetValue ());
-    }
+  LSPsIndep.resize (paramNum);
+  m_normalRv->GetValues (LSPsIndep.data (), paramNum);
   for (uint8_t row = 0; row < paramNum; row++)
     {
       double temp = 0;
@@ -1127,16 +1125,17 @@ ThreeGppChannelModel::GetNewChannel (Vector locUT, Ptr<const ChannelCondition> c
   NS_LOG_INFO ("K-factor=" << K_factor << ",DS=" << DS << ", ASD=" << ASD << ", ASA=" << ASA << ", ZSD=" << ZSD << ", ZSA=" << ZSA);
 
   //Step 5: Generate Delays.
-  DoubleVector clusterDelay;
+  DoubleVector clusterDelay (numOfCluster);
+  m_uniformRv->GetValues (0, 1, clusterDelay.data (), numOfCluster);
   double minTau = 100.0;
   for (uint8_t cIndex = 0; cIndex < numOfCluster; cIndex++)
     {
-      double tau = -1 * table3gpp->m_rTau * DS * log (m_uniformRv->GetValue (0,1)); //(7.5-1)
+      double tau = -1 * table3gpp->m_rTau * DS * log (clusterDelay[cIndex]); //(7.5-1)
       if (minTau > tau)
         {
           minTau = tau;
         }
-      clusterDelay.push_back (tau);
+      clusterDelay[cIndex] = tau;
     }
 
   for (uint8_t cIndex = 0; cIndex < numOfCluster; cIndex++)
@@ -1149,14 +1148,15 @@ ThreeGppChannelModel::GetNewChannel (Vector locUT, Ptr<const ChannelCondition> c
    * we will generate cluster power first and resume to compute Los cluster delay later.*/
 
   //Step 6: Generate cluster powers.
-  DoubleVector clusterPower;
+  DoubleVector clusterPower (numOfCluster);
+  m_normalRv->GetValues (clusterPower.data (), numOfCluster);
   double powerSum = 0;
   for (uint8_t cIndex = 0; cIndex < numOfCluster; cIndex++)
     {
       double power = exp (-1 * clusterDelay[cIndex] * (table3gpp->m_rTau - 1) / table3gpp->m_rTau / DS) *
-        pow (10,-1 * m_normalRv->GetValue () * table3gpp->m_perClusterShadowingStd / 10);                       //(7.5-5)
+        pow (10,-1 * clusterPower[cIndex] * table3gpp->m_perClusterShadowingStd / 10);                       //(7.5-5)
       powerSum += power;
-      clusterPower.push_back (power);
+      clusterPower[cIndex] = power;
     }
   double powerMax = 0;
 
@@ -1330,24 +1330,30 @@ ThreeGppChannelModel::GetNewChannel (Vector locUT, Ptr<const ChannelCondition> c
       clusterZod.push_back (angle);
     }
 
+  // draw the random signs and the four angle offsets of all the clusters at once
+  DoubleVector signs (numReducedCluster);
+  DoubleVector offsets (4 * numReducedCluster);
+  m_uniformRv->GetValues (0, 1, signs.data (), signs.size ());
+  m_normalRv->GetValues (offsets.data (), offsets.size ());
   for (uint8_t cIndex = 0; cIndex < numReducedCluster; cIndex++)
     {
       int Xn = 1;
-      if (m_uniformRv->GetValue (0,1) < 0.5)
+      if (signs[cIndex] < 0.5)
         {
           Xn = -1;
         }
-      clusterAoa[cIndex] = clusterAoa[cIndex] * Xn + (m_normalRv->GetValue () * ASA / 7) + RadiansToDegrees (uAngle.GetAzimuth ());        //(7.5-11)
-      clusterAod[cIndex] = clusterAod[cIndex] * Xn + (m_normalRv->GetValue () * ASD / 7) + RadiansToDegrees (sAngle.GetAzimuth ());
+      const double *offset = &offsets[4 * cIndex];
+      clusterAoa[cIndex] = clusterAoa[cIndex] * Xn + (offset[0] * ASA / 7) + RadiansToDegrees (uAngle.GetAzimuth ());        //(7.5-11)
+      clusterAod[cIndex] = clusterAod[cIndex] * Xn + (offset[1] * ASD / 7) + RadiansToDegrees (sAngle.GetAzimuth ());
       if (o2i)
         {
-          clusterZoa[cIndex] = clusterZoa[cIndex] * Xn + (m_normalRv->GetValue () * ZSA / 7) + 90;            //(7.5-16)
+          clusterZoa[cIndex] = clusterZoa[cIndex] * Xn + (offset[2] * ZSA / 7) + 90;            //(7.5-16)
         }
       else
         {
-          clusterZoa[cIndex] = clusterZoa[cIndex] * Xn + (m_normalRv->GetValue () * ZSA / 7) + RadiansToDegrees (uAngle.GetInclination ());            //(7.5-16)
+          clusterZoa[cIndex] = clusterZoa[cIndex] * Xn + (offset[2] * ZSA / 7) + RadiansToDegrees (uAngle.GetInclination ());            //(7.5-16)
         }
-      clusterZod[cIndex] = clusterZod[cIndex] * Xn + (m_normalRv->GetValue () * ZSD / 7) + RadiansToDegrees (sAngle.GetInclination ()) + table3gpp->m_offsetZOD;        //(7.5-19)
+      clusterZod[cIndex] = clusterZod[cIndex] * Xn + (offset[3] * ZSD / 7) + RadiansToDegrees (sAngle.GetInclination ()) + table3gpp->m_offsetZOD;        //(7.5-19)
 
     }
 
@@ -1477,6 +1483,13 @@ ThreeGppChannelModel::GetNewChannel (Vector locUT, Ptr<const ChannelCondition> c
   //Step 10: Draw initial phases
   Double2DVector crossPolarizationPowerRatios; // vector containing the cross polarization power ratios, as defined by 7.5-21
   Double3DVector clusterPhase; //rayAoa_radian[n][m], where n is cluster index, m is ray index
+  // draw the XPR values and the phases of all the rays at once
+  DoubleVector xprs (numReducedCluster * raysPerCluster);
+  DoubleVector phases (4 * xprs.size ());
+  m_normalRv->GetValues (xprs.data (), xprs.size ());
+  m_uniformRv->GetValues (-1 * M_PI, M_PI, phases.data (), phases.size ());
+  const double *xpr = xprs.data ();
+  const double *phase = phases.data ();
   for (uint8_t nInd = 0; nInd < numReducedCluster; nInd++)
     {
       DoubleVector temp; // used to store the XPR values
@@ -1486,12 +1499,9 @@ ThreeGppChannelModel::GetNewChannel (Vector locUT, Ptr<const ChannelCondition> c
           double uXprLinear = pow (10, table3gpp->m_uXpr / 10); // convert to linear
           double sigXprLinear = pow (10, table3gpp->m_sigXpr / 10); // convert to linear
 
-          temp.push_back (std::pow (10, (m_normalRv->GetValue () * sigXprLinear + uXprLinear) / 10));
-          DoubleVector temp3; // used to store the PHI valuse
-          for (uint8_t pInd = 0; pInd < 4; pInd++)
-            {
-              temp3.push_back (m_uniformRv->GetValue (-1 * M_PI, M_PI));
-            }
+          temp.push_back (std::pow (10, (*xpr++ * sigXprLinear + uXprLinear) / 10));
+          DoubleVector temp3 (phase, phase + 4); // used to store the PHI valuse
+          phase += 4;
           temp2.push_back (temp3);
         }
       crossPolarizationPowerRatios.push_back (temp);
@@ -0,0 +1,501 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the simulator cost of the queue
+// discs, as opposed to their effect on the network. Each queue disc is
+// driven standalone: packets of a number of UDP flows are enqueued according
+// to a synthetic arrival process and dequeued by a simple link model
+// transmitting at a given rate. For each queue disc, the program reports:
+//
+// - the average wall clock time spent in QueueDisc::Enqueue and
+//   QueueDisc::Dequeue;
+// - the number of heap allocations performed by these calls, per enqueued
+//   packet;
+// - the heap memory allocated by the queue disc per queued packet, measured
+//   by filling a separate instance of the queue disc without dequeuing.
+//
+// Heap allocations are accounted for by replacing the global operator new
+// and operator delete in this program. Build in optimized mode to get
+// meaningful timings.
+//
+// Sample usage:
+//   ./waf --run 'bench-queue-discs --n=100000 --arrivals=poisson --flows=64'
+//   ./waf --run 'bench-queue-discs --queueDiscs=FqCoDel,FqPie --flows=1024'
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/traffic-control-module.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("BenchQueueDiscs");
+
+/// Number of calls to the global operator new
+static uint64_t g_nAllocations = 0;
+/// Number of bytes currently allocated through the global operator new
+static int64_t g_allocatedBytes = 0;
+/// Room reserved in front of each allocation to store its size
+static const std::size_t ALLOCATION_HEADER = 16;
+
+void *
+operator new (std::size_t size)
+{
+  char *ptr = static_cast<char *> (std::malloc (size + ALLOCATION_HEADER));
+  if (ptr == 0)
+    {
+      throw std::bad_alloc ();
+    }
+  *reinterpret_cast<std::size_t *> (ptr) = size;
+  g_nAllocations++;
+  g_allocatedBytes += size;
+  return ptr + ALLOCATION_HEADER;
+}
+
+void
+operator delete (void *ptr) noexcept
+{
+  if (ptr == 0)
+    {
+      return;
+    }
+  char *base = static_cast<char *> (ptr) - ALLOCATION_HEADER;
+  g_allocatedBytes -= *reinterpret_cast<std::size_t *> (base);
+  std::free (base);
+}
+
+/**
+ * \return the current wall clock time, in nanoseconds
+ */
+static uint64_t
+GetWallClockNs (void)
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>
+           (std::chrono::steady_clock::now ().time_since_epoch ()).count ();
+}
+
+/**
+ * \return the average cost of a pair of GetWallClockNs calls, in nanoseconds
+ */
+static double
+GetTimerOverheadNs (void)
+{
+  const uint32_t n = 100000;
+  uint64_t sum = 0;
+  for (uint32_t i = 0; i < n; i++)
+    {
+      uint64_t start = GetWallClockNs ();
+      sum += GetWallClockNs () - start;
+    }
+  return static_cast<double> (sum) / n;
+}
+
+/// Configuration shared by all the benchmarks
+struct BenchConfig
+{
+  uint32_t n;             //!< Number of packets offered to each queue disc
+  uint32_t nFlows;        //!< Number of flows
+  uint32_t packetSize;    //!< Size of the UDP payload of the packets
+  DataRate linkRate;      //!< Rate of the link draining the queue disc
+  double load;            //!< Offered load, relative to the link rate
+  std::string arrivals;   //!< Arrival process (cbr, poisson or bursty)
+  uint32_t burstSize;     //!< Number of back-to-back packets per burst (bursty arrivals)
+  uint32_t fillPackets;   //!< Number of packets used to measure the memory per queued packet
+};
+
+/**
+ * Create and initialize a queue disc of the given type.
+ *
+ * \param name the type of the queue disc, without the ns3:: prefix and the
+ *        QueueDisc suffix (e.g., "FqCoDel")
+ * \param config the benchmark configuration
+ * \param maxPackets the maximum size of the queue disc, in packets, or zero
+ *        to keep the default maximum size
+ * \return the queue disc
+ */
+static Ptr<QueueDisc>
+CreateQueueDisc (const std::string &name, const BenchConfig &config, uint32_t maxPackets)
+{
+  TypeId tid;
+  NS_ABORT_MSG_UNLESS (TypeId::LookupByNameFailSafe ("ns3::" + name + "QueueDisc", &tid),
+                       "Unknown queue disc " << name);
+  ObjectFactory factory;
+  factory.SetTypeId (tid);
+  Ptr<QueueDisc> qdisc = factory.Create<QueueDisc> ();
+
+  if (name == "Prio")
+    {
+      // the default priomap uses three bands
+      for (uint32_t i = 0; i < 3; i++)
+        {
+          Ptr<QueueDisc> child = CreateObject<FifoQueueDisc> ();
+          if (maxPackets)
+            {
+              child->SetMaxSize (QueueSize (QueueSizeUnit::PACKETS, maxPackets));
+            }
+          child->Initialize ();
+          Ptr<QueueDiscClass> c = CreateObject<QueueDiscClass> ();
+          c->SetQueueDisc (child);
+          qdisc->AddQueueDiscClass (c);
+        }
+    }
+  else if (maxPackets)
+    {
+      qdisc->SetMaxSize (QueueSize (QueueSizeUnit::PACKETS, maxPackets));
+    }
+
+  uint32_t ipPacketSize = config.packetSize + 28;
+  if (name == "Tbf")
+    {
+      qdisc->SetAttribute ("Rate", DataRateValue (config.linkRate));
+      qdisc->SetAttribute ("Mtu", UintegerValue (ipPacketSize));
+    }
+  else if (name == "FqCoDel")
+    {
+      DynamicCast<FqCoDelQueueDisc> (qdisc)->SetQuantum (ipPacketSize);
+    }
+  else if (name == "FqPie")
+    {
+      DynamicCast<FqPieQueueDisc> (qdisc)->SetQuantum (ipPacketSize);
+    }
+  else if (name == "FqCobalt")
+    {
+      DynamicCast<FqCobaltQueueDisc> (qdisc)->SetQuantum (ipPacketSize);
+    }
+
+  qdisc->Initialize ();
+  return qdisc;
+}
+
+/**
+ * Benchmark of a single queue disc type
+ */
+class QueueDiscBench
+{
+public:
+  /**
+   * Constructor
+   * \param name the type of the queue disc (see CreateQueueDisc)
+   * \param config the benchmark configuration
+   * \param timerOverheadNs the cost of measuring a time interval
+   */
+  QueueDiscBench (std::string name, const BenchConfig &config, double timerOverheadNs);
+
+  /**
+   * Run the benchmark and print the results on a row of the output table
+   */
+  void Run (void);
+
+private:
+  /// Measure the per-call cost of enqueue and dequeue in steady state
+  void RunSteadyState (void);
+  /// Measure the memory used by the queue disc per queued packet
+  void RunFill (void);
+  /**
+   * \return a new packet of a randomly chosen flow
+   */
+  Ptr<QueueDiscItem> CreateItem (void);
+  /// Enqueue a packet and schedule the next arrival
+  void Arrival (void);
+  /// Start transmitting a packet, if one is available
+  void StartTransmission (void);
+  /// The transmission of a packet is complete
+  void TransmitComplete (void);
+  /**
+   * Receive a packet sent by the queue disc (e.g., when a TbfQueueDisc
+   * wakes up after having been throttled)
+   * \param item the packet
+   */
+  void Send (Ptr<QueueDiscItem> item);
+
+  std::string m_name;                 //!< Type of the queue disc
+  BenchConfig m_config;               //!< Benchmark configuration
+  double m_timerOverheadNs;           //!< Cost of measuring a time interval
+  Ptr<QueueDisc> m_qdisc;             //!< Queue disc under test
+  Ptr<UniformRandomVariable> m_flow;  //!< Flow of the next packet
+  Ptr<ExponentialRandomVariable> m_interArrival;  //!< Poisson inter-arrival times
+  Time m_meanInterArrival;            //!< Mean inter-arrival time
+  std::deque<Ptr<QueueDiscItem> > m_deviceQueue;  //!< Packets sent by the queue disc while the link was busy
+  bool m_linkBusy;                    //!< Whether the link is transmitting
+  uint32_t m_nArrivals;               //!< Number of packets offered so far
+  uint32_t m_nEnqueueCalls;           //!< Number of timed enqueue calls
+  uint32_t m_nDequeueCalls;           //!< Number of timed dequeue calls
+  uint64_t m_enqueueNs;               //!< Time spent in enqueue calls
+  uint64_t m_dequeueNs;               //!< Time spent in dequeue calls
+  uint64_t m_nAllocations;            //!< Allocations performed by enqueue and dequeue calls
+  double m_bytesPerPacket;            //!< Memory used per queued packet
+};
+
+QueueDiscBench::QueueDiscBench (std::string name, const BenchConfig &config, double timerOverheadNs)
+  : m_name (name),
+    m_config (config),
+    m_timerOverheadNs (timerOverheadNs),
+    m_linkBusy (false),
+    m_nArrivals (0),
+    m_nEnqueueCalls (0),
+    m_nDequeueCalls (0),
+    m_enqueueNs (0),
+    m_dequeueNs (0),
+    m_nAllocations (0),
+    m_bytesPerPacket (0)
+{
+  m_flow = CreateObject<UniformRandomVariable> ();
+  m_interArrival = CreateObject<ExponentialRandomVariable> ();
+  Time txTime = m_config.linkRate.CalculateBytesTxTime (m_config.packetSize + 28);
+  m_meanInterArrival = Seconds (txTime.GetSeconds () / m_config.load);
+  m_interArrival->SetAttribute ("Mean", DoubleValue (m_meanInterArrival.GetSeconds ()));
+}
+
+Ptr<QueueDiscItem>
+QueueDiscBench::CreateItem (void)
+{
+  uint32_t flow = m_flow->GetInteger (0, m_config.nFlows - 1);
+
+  Ptr<Packet> p = Create<Packet> (m_config.packetSize);
+  UdpHeader udpHeader;
+  udpHeader.SetSourcePort (1000 + flow % 60000);
+  udpHeader.SetDestinationPort (9);
+  p->AddHeader (udpHeader);
+  SocketPriorityTag priorityTag;
+  priorityTag.SetPriority (flow % 16);
+  p->AddPacketTag (priorityTag);
+
+  Ipv4Header ipHeader;
+  ipHeader.SetSource (Ipv4Address (0x0a000000 + 1 + flow / 60000));
+  ipHeader.SetDestination (Ipv4Address ("10.1.0.1"));
+  ipHeader.SetProtocol (17);
+  ipHeader.SetPayloadSize (p->GetSize ());
+  ipHeader.SetTtl (64);
+  return Create<Ipv4QueueDiscItem> (p, Address (), Ipv4L3Protocol::PROT_NUMBER, ipHeader);
+}
+
+void
+QueueDiscBench::Arrival (void)
+{
+  Ptr<QueueDiscItem> item = CreateItem ();
+
+  uint64_t nAllocations = g_nAllocations;
+  uint64_t start = GetWallClockNs ();
+  m_qdisc->Enqueue (item);
+  m_enqueueNs += GetWallClockNs () - start;
+  m_nAllocations += g_nAllocations - nAllocations;
+  m_nEnqueueCalls++;
+
+  if (!m_linkBusy)
+    {
+      StartTransmission ();
+    }
+
+  if (++m_nArrivals == m_config.n)
+    {
+      return;
+    }
+
+  Time next;
+  if (m_config.arrivals == "cbr")
+    {
+      next = m_meanInterArrival;
+    }
+  else if (m_config.arrivals == "poisson")
+    {
+      next = Seconds (m_interArrival->GetValue ());
+    }
+  else
+    {
+      // bursts of back-to-back packets, with the same average rate
+      next = (m_nArrivals % m_config.burstSize == 0)
+        ? Seconds (m_interArrival->GetValue () * m_config.burstSize) : Seconds (0);
+    }
+  Simulator::Schedule (next, &QueueDiscBench::Arrival, this);
+}
+
+void
+QueueDiscBench::StartTransmission (void)
+{
+  Ptr<QueueDiscItem> item;
+  if (!m_deviceQueue.empty ())
+    {
+      item = m_deviceQueue.front ();
+      m_deviceQueue.pop_front ();
+    }
+  else
+    {
+      uint64_t nAllocations = g_nAllocations;
+      uint64_t start = GetWallClockNs ();
+      item = m_qdisc->Dequeue ();
+      m_dequeueNs += GetWallClockNs () - start;
+      m_nAllocations += g_nAllocations - nAllocations;
+      m_nDequeueCalls++;
+    }
+
+  if (item)
+    {
+      m_linkBusy = true;
+      Simulator::Schedule (m_config.linkRate.CalculateBytesTxTime (item->GetSize ()),
+                           &QueueDiscBench::TransmitComplete, this);
+    }
+}
+
+void
+QueueDiscBench::TransmitComplete (void)
+{
+  m_linkBusy = false;
+  StartTransmission ();
+
+  if (!m_linkBusy && m_nArrivals == m_config.n && m_qdisc->GetNPackets () == 0)
+    {
+      // some queue discs (e.g., PIE) periodically schedule events
+      Simulator::Stop ();
+    }
+}
+
+void
+QueueDiscBench::Send (Ptr<QueueDiscItem> item)
+{
+  m_deviceQueue.push_back (item);
+  if (!m_linkBusy)
+    {
+      StartTransmission ();
+    }
+}
+
+void
+QueueDiscBench::RunSteadyState (void)
+{
+  m_qdisc = CreateQueueDisc (m_name, m_config, 0);
+  m_qdisc->SetSendCallback ([this] (Ptr<QueueDiscItem> item) { Send (item); });
+
+  Simulator::Schedule (Seconds (0), &QueueDiscBench::Arrival, this);
+  Simulator::Run ();
+
+  m_qdisc->Dispose ();
+  Simulator::Destroy ();
+}
+
+void
+QueueDiscBench::RunFill (void)
+{
+  Ptr<QueueDisc> qdisc = CreateQueueDisc (m_name, m_config, m_config.fillPackets);
+
+  // create the packets beforehand, so that only the memory allocated by the
+  // queue disc is accounted for
+  std::vector<Ptr<QueueDiscItem> > items;
+  items.reserve (m_config.fillPackets);
+  for (uint32_t i = 0; i < m_config.fillPackets; i++)
+    {
+      items.push_back (CreateItem ());
+    }
+
+  int64_t allocatedBytes = g_allocatedBytes;
+  for (auto &item : items)
+    {
+      qdisc->Enqueue (item);
+    }
+  if (qdisc->GetNPackets () > 0)
+    {
+      m_bytesPerPacket = static_cast<double> (g_allocatedBytes - allocatedBytes) / qdisc->GetNPackets ();
+    }
+
+  qdisc->Dispose ();
+  Simulator::Destroy ();
+}
+
+void
+QueueDiscBench::Run (void)
+{
+  RunSteadyState ();
+  RunFill ();
+
+  double enqueueNs = m_nEnqueueCalls
+    ? std::max (0.0, static_cast<double> (m_enqueueNs) / m_nEnqueueCalls - m_timerOverheadNs) : 0;
+  double dequeueNs = m_nDequeueCalls
+    ? std::max (0.0, static_cast<double> (m_dequeueNs) / m_nDequeueCalls - m_timerOverheadNs) : 0;
+
+  std::cout << std::left << std::setw (12) << m_name << std::right << std::fixed
+            << std::setprecision (1)
+            << std::setw (12) << enqueueNs
+            << std::setw (12) << dequeueNs
+            << std::setprecision (2)
+            << std::setw (12) << static_cast<double> (m_nAllocations) / m_config.n
+            << std::setprecision (1)
+            << std::setw (14) << m_bytesPerPacket
+            << std::setw (10) << m_qdisc->GetStats ().nTotalDroppedPackets
+            << std::endl;
+  m_qdisc = 0;
+}
+
+int main (int argc, char *argv[])
+{
+  BenchConfig config;
+  config.n = 100000;
+  config.nFlows = 16;
+  config.packetSize = 1000;
+  config.linkRate = DataRate ("100Mbps");
+  config.load = 1.2;
+  config.arrivals = "poisson";
+  config.burstSize = 16;
+  config.fillPackets = 10000;
+  std::string queueDiscs = "Red,Pie,CoDel,Cobalt,FqCoDel,Tbf,Prio";
+
+  CommandLine cmd (__FILE__);
+  cmd.Usage ("Benchmark the simulator cost of the queue discs");
+  cmd.AddValue ("n", "number of packets offered to each queue disc", config.n);
+  cmd.AddValue ("flows", "number of flows", config.nFlows);
+  cmd.AddValue ("packetSize", "size of the UDP payload of the packets", config.packetSize);
+  cmd.AddValue ("linkRate", "rate of the link draining the queue disc", config.linkRate);
+  cmd.AddValue ("load", "offered load, relative to the link rate", config.load);
+  cmd.AddValue ("arrivals", "arrival process (cbr, poisson or bursty)", config.arrivals);
+  cmd.AddValue ("burstSize", "number of back-to-back packets per burst (bursty arrivals)", config.burstSize);
+  cmd.AddValue ("fillPackets", "number of packets used to measure the memory per queued packet", config.fillPackets);
+  cmd.AddValue ("queueDiscs", "comma separated list of queue discs (e.g., FqCoDel for ns3::FqCoDelQueueDisc)", queueDiscs);
+  cmd.Parse (argc, argv);
+
+  NS_ABORT_MSG_IF (config.n == 0 || config.nFlows == 0 || config.load <= 0 || config.burstSize == 0,
+                   "The number of packets and flows, the load and the burst size must be positive");
+  NS_ABORT_MSG_IF (config.arrivals != "cbr" && config.arrivals != "poisson" && config.arrivals != "bursty",
+                   "Unknown arrival process " << config.arrivals);
+
+  double timerOverheadNs = GetTimerOverheadNs ();
+
+  std::cout << "Running bench-queue-discs with n=" << config.n << ", " << config.nFlows
+            << " flows, " << config.arrivals << " arrivals, load " << config.load << std::endl;
+  std::cout << std::left << std::setw (12) << "QueueDisc" << std::right
+            << std::setw (12) << "ns/enqueue"
+            << std::setw (12) << "ns/dequeue"
+            << std::setw (12) << "allocs/pkt"
+            << std::setw (14) << "bytes/queued"
+            << std::setw (10) << "drops"
+            << std::endl;
+
+  std::istringstream iss (queueDiscs);
+  std::string name;
+  while (std::getline (iss, name, ','))
+    {
+      QueueDiscBench bench (name, config, timerOverheadNs);
+      bench.Run ();
+    }
+
+  return 0;
+}
@@ -197,35 +197,6 @@ FqCoDelQueueDisc::GetQuantum (void) const
   return m_quantum;
 }
 
-uint32_t
-FqCoDelQueueDisc::SetAssociativeHash (uint32_t flowHash)
-{
-  NS_LOG_FUNCTION (this << flowHash);
-
-  uint32_t h = (flowHash % m_flows);
-  uint32_t innerHash = h % m_setWays;
-  uint32_t outerHash = h - innerHash;
-
-  for (uint32_t i = outerHash; i < outerHash + m_setWays; i++)
-    {
-      auto it = m_flowsIndices.find (i);
-
-      if (it == m_flowsIndices.end ()
-          || (m_tags.find (i) != m_tags.end () && m_tags[i] == flowHash)
-          || StaticCast<FqCoDelFlow> (GetQueueDiscClass (it->second))->GetStatus () == FqCoDelFlow::INACTIVE)
-        {
-          // this queue has not been created yet or is associated with this flow
-          // or is inactive, hence we can use it
-          m_tags[i] = flowHash;
-          return i;
-        }
-    }
-
-  // all the queues of the set are used. Use the first queue of the set
-  m_tags[outerHash] = flowHash;
-  return outerHash;
-}
-
 bool
 FqCoDelQueueDisc::DoEnqueue (Ptr<QueueDiscItem> item)
 {
@@ -253,17 +224,10 @@ FqCoDelQueueDisc::DoEnqueue (Ptr<QueueDiscItem> item)
         }
     }
 
-  if (m_enableSetAssociativeHash)
-    {
-      h = SetAssociativeHash (flowHash);
-    }
-  else
-    {
-      h = flowHash % m_flows;
-    }
+  h = m_flowTable.GetSlot (flowHash);
 
   Ptr<FqCoDelFlow> flow;
-  if (m_flowsIndices.find (h) == m_flowsIndices.end ())
+  if (m_flowTable.GetClassIndex (h) == FqFlowTable::NO_CLASS)
     {
       NS_LOG_DEBUG ("Creating a new flow queue with index " << h);
       flow = m_flowFactory.Create<FqCoDelFlow> ();
@@ -281,23 +245,23 @@ FqCoDelQueueDisc::DoEnqueue (Ptr<QueueDiscItem> item)
       flow->SetIndex (h);
       AddQueueDiscClass (flow);
 
-      m_flowsIndices[h] = GetNQueueDiscClasses () - 1;
+      m_flowTable.SetClassIndex (h, GetNQueueDiscClasses () - 1);
     }
   else
     {
-      flow = StaticCast<FqCoDelFlow> (GetQueueDiscClass (m_flowsIndices[h]));
+      flow = StaticCast<FqCoDelFlow> (GetQueueDiscClass (m_flowTable.GetClassIndex (h)));
     }
 
   if (flow->GetStatus () == FqCoDelFlow::INACTIVE)
     {
       flow->SetStatus (FqCoDelFlow::NEW_FLOW);
       flow->SetDeficit (m_quantum);
-      m_newFlows.push_back (flow);
+      m_flowTable.PushBack (FqFlowTable::NEW_FLOWS, h);
     }
 
   flow->GetQueueDisc ()->Enqueue (item);
 
-  NS_LOG_DEBUG ("Packet enqueued into flow " << h << "; flow index " << m_flowsIndices[h]);
+  NS_LOG_DEBUG ("Packet enqueued into flow " << h << "; flow index " << m_flowTable.GetClassIndex (h));
 
   if (GetCurrentSize () > GetMaxSize ())
     {
@@ -320,17 +284,16 @@ FqCoDelQueueDisc::DoDequeue (void)
     {
       bool found = false;
 
-      while (!found && !m_newFlows.empty ())
+      while (!found && !m_flowTable.IsEmpty (FqFlowTable::NEW_FLOWS))
         {
-          flow = m_newFlows.front ();
+          flow = StaticCast<FqCoDelFlow> (GetQueueDiscClass (m_flowTable.GetClassIndex (m_flowTable.GetFront (FqFlowTable::NEW_FLOWS))));
 
           if (flow->GetDeficit () <= 0)
             {
               NS_LOG_DEBUG ("Increase deficit for new flow index " << flow->GetIndex ());
               flow->IncreaseDeficit (m_quantum);
               flow->SetStatus (FqCoDelFlow::OLD_FLOW);
-              m_oldFlows.push_back (flow);
-              m_newFlows.pop_front ();
+              m_flowTable.MoveFront (FqFlowTable::NEW_FLOWS, FqFlowTable::OLD_FLOWS);
             }
           else
             {
@@ -339,16 +302,15 @@ FqCoDelQueueDisc::DoDequeue (void)
             }
         }
 
-      while (!found && !m_oldFlows.empty ())
+      while (!found && !m_flowTable.IsEmpty (FqFlowTable::OLD_FLOWS))
         {
-          flow = m_oldFlows.front ();
+          flow = StaticCast<FqCoDelFlow> (GetQueueDiscClass (m_flowTable.GetClassIndex (m_flowTable.GetFront (FqFlowTable::OLD_FLOWS))));
 
           if (flow->GetDeficit () <= 0)
             {
               NS_LOG_DEBUG ("Increase deficit for old flow index " << flow->GetIndex ());
               flow->IncreaseDeficit (m_quantum);
-              m_oldFlows.push_back (flow);
-              m_oldFlows.pop_front ();
+              m_flowTable.MoveFront (FqFlowTable::OLD_FLOWS, FqFlowTable::OLD_FLOWS);
             }
           else
             {
@@ -368,16 +330,15 @@ FqCoDelQueueDisc::DoDequeue (void)
       if (!item)
         {
           NS_LOG_DEBUG ("Could not get a packet from the selected flow queue");
-          if (!m_newFlows.empty ())
+          if (!m_flowTable.IsEmpty (FqFlowTable::NEW_FLOWS))
             {
               flow->SetStatus (FqCoDelFlow::OLD_FLOW);
-              m_oldFlows.push_back (flow);
-              m_newFlows.pop_front ();
+              m_flowTable.MoveFront (FqFlowTable::NEW_FLOWS, FqFlowTable::OLD_FLOWS);
             }
           else
             {
               flow->SetStatus (FqCoDelFlow::INACTIVE);
-              m_oldFlows.pop_front ();
+              m_flowTable.PopFront (FqFlowTable::OLD_FLOWS);
             }
         }
       else
@@ -451,6 +412,8 @@ FqCoDelQueueDisc::InitializeParams (void)
 {
   NS_LOG_FUNCTION (this);
 
+  m_flowTable.Initialize (m_flows, m_enableSetAssociativeHash ? m_setWays : 0);
+
   m_flowFactory.SetTypeId ("ns3::FqCoDelFlow");
 
   m_queueDiscFactory.SetTypeId ("ns3::CoDelQueueDisc");
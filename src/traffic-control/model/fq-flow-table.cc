@@ -0,0 +1,163 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Universita' degli Studi di Napoli Federico II
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "fq-flow-table.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("FqFlowTable");
+
+const uint32_t FqFlowTable::NO_CLASS;
+const uint32_t FqFlowTable::NONE;
+const uint32_t FqFlowTable::LAST;
+
+FqFlowTable::FqFlowTable ()
+  : m_nSlots (0),
+    m_setWays (0)
+{
+  NS_LOG_FUNCTION (this);
+  m_head[NEW_FLOWS] = m_head[OLD_FLOWS] = NONE;
+  m_tail[NEW_FLOWS] = m_tail[OLD_FLOWS] = NONE;
+}
+
+void
+FqFlowTable::Initialize (uint32_t nSlots, uint32_t setWays)
+{
+  NS_LOG_FUNCTION (this << nSlots << setWays);
+  NS_ASSERT (nSlots > 0);
+  NS_ASSERT (setWays == 0 || nSlots % setWays == 0);
+
+  m_nSlots = nSlots;
+  m_setWays = setWays;
+  m_classIndex.assign (nSlots, NO_CLASS);
+  m_tags.assign (nSlots, 0);
+  m_next.assign (nSlots, NONE);
+  m_head[NEW_FLOWS] = m_head[OLD_FLOWS] = NONE;
+  m_tail[NEW_FLOWS] = m_tail[OLD_FLOWS] = NONE;
+}
+
+uint32_t
+FqFlowTable::GetSlot (uint32_t flowHash)
+{
+  NS_LOG_FUNCTION (this << flowHash);
+  NS_ASSERT (m_nSlots > 0);
+
+  uint32_t h = flowHash % m_nSlots;
+
+  if (m_setWays == 0)
+    {
+      return h;
+    }
+
+  uint32_t outerHash = h - h % m_setWays;
+
+  for (uint32_t i = outerHash; i < outerHash + m_setWays; i++)
+    {
+      // a tag is only set on slots which have a queue disc class, hence the
+      // tag of a slot whose class has not been created yet is meaningless
+      if (m_classIndex[i] == NO_CLASS || m_tags[i] == flowHash || m_next[i] == NONE)
+        {
+          // this queue has not been created yet or is associated with this flow
+          // or is inactive, hence we can use it
+          m_tags[i] = flowHash;
+          return i;
+        }
+    }
+
+  // all the queues of the set are used. Use the first queue of the set
+  m_tags[outerHash] = flowHash;
+  return outerHash;
+}
+
+uint32_t
+FqFlowTable::GetClassIndex (uint32_t slot) const
+{
+  NS_ASSERT (slot < m_nSlots);
+  return m_classIndex[slot];
+}
+
+void
+FqFlowTable::SetClassIndex (uint32_t slot, uint32_t index)
+{
+  NS_LOG_FUNCTION (this << slot << index);
+  NS_ASSERT (slot < m_nSlots);
+  m_classIndex[slot] = index;
+}
+
+bool
+FqFlowTable::IsEmpty (FlowList list) const
+{
+  return m_head[list] == NONE;
+}
+
+uint32_t
+FqFlowTable::GetFront (FlowList list) const
+{
+  NS_ASSERT (m_head[list] != NONE);
+  return m_head[list];
+}
+
+void
+FqFlowTable::PushBack (FlowList list, uint32_t slot)
+{
+  NS_LOG_FUNCTION (this << list << slot);
+  NS_ASSERT (slot < m_nSlots && m_next[slot] == NONE);
+
+  m_next[slot] = LAST;
+  if (m_head[list] == NONE)
+    {
+      m_head[list] = slot;
+    }
+  else
+    {
+      m_next[m_tail[list]] = slot;
+    }
+  m_tail[list] = slot;
+}
+
+void
+FqFlowTable::PopFront (FlowList list)
+{
+  NS_LOG_FUNCTION (this << list);
+  NS_ASSERT (m_head[list] != NONE);
+
+  uint32_t slot = m_head[list];
+  uint32_t next = m_next[slot];
+  m_next[slot] = NONE;
+  if (next == LAST)
+    {
+      m_head[list] = m_tail[list] = NONE;
+    }
+  else
+    {
+      m_head[list] = next;
+    }
+}
+
+void
+FqFlowTable::MoveFront (FlowList from, FlowList to)
+{
+  NS_LOG_FUNCTION (this << from << to);
+  uint32_t slot = GetFront (from);
+  PopFront (from);
+  PushBack (to, slot);
+}
+
+} // namespace ns3
@@ -29,8 +29,7 @@
 
 #include "ns3/queue-disc.h"
 #include "ns3/object-factory.h"
-#include <list>
-#include <map>
+#include "fq-flow-table.h"
 
 namespace ns3 {
 
@@ -160,15 +159,6 @@ private:
    */
   uint32_t FqPieDrop (void);
 
-  /**
-   * Compute the index of the queue for the flow having the given flowHash,
-   * according to the set associative hash approach.
-   *
-   * \param flowHash the hash of the flow 5-tuple
-   * \return the index of the queue for the given flow
-   */
-  uint32_t SetAssociativeHash (uint32_t flowHash);
-
   // PIE queue disc parameter
   bool m_useEcn;             //!< True if ECN is used (packets are marked instead of being dropped)
   double m_markEcnTh;        //!< ECN marking threshold (default 10% as suggested in RFC 8033)
@@ -194,11 +184,7 @@ private:
   uint32_t m_perturbation;   //!< hash perturbation value
   bool m_enableSetAssociativeHash; //!< whether to enable set associative hash
 
-  std::list<Ptr<FqPieFlow> > m_newFlows;    //!< The list of new flows
-  std::list<Ptr<FqPieFlow> > m_oldFlows;    //!< The list of old flows
-
-  std::map<uint32_t, uint32_t> m_flowsIndices;    //!< Map with the index of class for each flow
-  std::map<uint32_t, uint32_t> m_tags;            //!< Tags used by set associative hash
+  FqFlowTable m_flowTable;    //!< Flow queue slots and lists of new and old flows
 
   ObjectFactory m_flowFactory;         //!< Factory to create a new flow
   ObjectFactory m_queueDiscFactory;    //!< Factory to create a new queue
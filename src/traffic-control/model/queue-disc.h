@@ -30,11 +30,11 @@
 #include <functional>
 #include <string>
 #include "packet-filter.h"
+#include "ns3/queue-fwd.h"
 
 namespace ns3 {
 
 class QueueDisc;
-template <typename Item> class Queue;
 class NetDeviceQueueInterface;
 
 /**
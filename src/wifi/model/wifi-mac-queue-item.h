@@ -25,6 +25,7 @@
 #define WIFI_MAC_QUEUE_ITEM_H
 
 #include "ns3/nstime.h"
+#include "ns3/arena-allocator.h"
 #include "wifi-mac-header.h"
 #include "amsdu-subframe-header.h"
 #include "qos-utils.h"
@@ -39,9 +40,10 @@ class Packet;
  * \ingroup wifi
  *
  * WifiMacQueueItem stores (const) packets along with their Wifi MAC headers
- * and the time when they were enqueued.
+ * and the time when they were enqueued.  The items are allocated by
+ * ns3::ArenaAllocator.
  */
-class WifiMacQueueItem : public SimpleRefCount<WifiMacQueueItem>
+class WifiMacQueueItem : public SimpleRefCount<WifiMacQueueItem>, public ArenaAllocated
 {
 public:
   /**
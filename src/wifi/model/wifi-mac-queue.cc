@@ -31,13 +31,13 @@ namespace ns3 {
 NS_LOG_COMPONENT_DEFINE ("WifiMacQueue");
 
 NS_OBJECT_ENSURE_REGISTERED (WifiMacQueue);
-NS_OBJECT_TEMPLATE_CLASS_DEFINE (Queue, WifiMacQueueItem);
+NS_OBJECT_TEMPLATE_CLASS_TWO_DEFINE (Queue, WifiMacQueueItem, WifiMacQueueContainer);
 
 TypeId
 WifiMacQueue::GetTypeId (void)
 {
   static TypeId tid = TypeId ("ns3::WifiMacQueue")
-    .SetParent<Queue<WifiMacQueueItem> > ()
+    .SetParent<Queue<WifiMacQueueItem, WifiMacQueueContainer> > ()
     .SetGroupName ("Wifi")
     .AddConstructor<WifiMacQueue> ()
     .AddAttribute ("MaxSize",
@@ -522,7 +522,7 @@ bool
 WifiMacQueue::DoEnqueue (ConstIterator pos, Ptr<WifiMacQueueItem> item)
 {
   Iterator ret;
-  if (Queue<WifiMacQueueItem>::DoEnqueue (pos, item, ret))
+  if (Queue<WifiMacQueueItem, WifiMacQueueContainer>::DoEnqueue (pos, item, ret))
     {
       // update statistics about queued packets
       if (item->GetHeader ().IsQosData ())
@@ -550,7 +550,7 @@ WifiMacQueue::DoDequeue (ConstIterator pos)
 {
   NS_LOG_FUNCTION (this);
 
-  Ptr<WifiMacQueueItem> item = Queue<WifiMacQueueItem>::DoDequeue (pos);
+  Ptr<WifiMacQueueItem> item = Queue<WifiMacQueueItem, WifiMacQueueContainer>::DoDequeue (pos);
 
   if (item != 0 && item->GetHeader ().IsQosData ())
     {
@@ -575,7 +575,7 @@ WifiMacQueue::DoDequeue (ConstIterator pos)
 Ptr<WifiMacQueueItem>
 WifiMacQueue::DoRemove (ConstIterator pos)
 {
-  Ptr<WifiMacQueueItem> item = Queue<WifiMacQueueItem>::DoRemove (pos);
+  Ptr<WifiMacQueueItem> item = Queue<WifiMacQueueItem, WifiMacQueueContainer>::DoRemove (pos);
 
   if (item != 0 && item->GetHeader ().IsQosData ())
     {
@@ -26,6 +26,7 @@
 
 #include "wifi-mac-queue-item.h"
 #include "ns3/queue.h"
+#include <list>
 #include <unordered_map>
 #include "qos-utils.h"
 #include <functional>
@@ -34,12 +35,20 @@ namespace ns3 {
 
 class QosBlockedDestinations;
 
+/**
+ * \ingroup wifi
+ * The container of the MPDUs stored in a WifiMacQueue. MPDUs keep an iterator
+ * pointing to themselves while queued, hence the container must not invalidate
+ * iterators when other MPDUs are inserted or removed.
+ */
+typedef std::list<Ptr<WifiMacQueueItem> > WifiMacQueueContainer;
+
 // The following explicit template instantiation declaration prevents modules
-// including this header file from implicitly instantiating Queue<WifiMacQueueItem>.
-// This would cause python examples using wifi to crash at runtime with the
-// following error message: "Trying to allocate twice the same UID:
+// including this header file from implicitly instantiating Queue<WifiMacQueueItem,
+// WifiMacQueueContainer>. This would cause python examples using wifi to crash at
+// runtime with the following error message: "Trying to allocate twice the same UID:
 // ns3::Queue<WifiMacQueueItem>"
-extern template class Queue<WifiMacQueueItem>;
+extern template class Queue<WifiMacQueueItem, WifiMacQueueContainer>;
 
 
 /**
@@ -57,7 +66,7 @@ extern template class Queue<WifiMacQueueItem>;
  * dot11EDCATableMSDULifetime has elapsed, it is dropped.
  * Otherwise, it is returned to the caller.
  */
-class WifiMacQueue : public Queue<WifiMacQueueItem>
+class WifiMacQueue : public Queue<WifiMacQueueItem, WifiMacQueueContainer>
 {
 public:
   /**
@@ -83,10 +92,10 @@ public:
   };
 
   /// allow the usage of iterators and const iterators
-  using Queue<WifiMacQueueItem>::ConstIterator;
-  using Queue<WifiMacQueueItem>::Iterator;
-  using Queue<WifiMacQueueItem>::begin;
-  using Queue<WifiMacQueueItem>::end;
+  using Queue<WifiMacQueueItem, WifiMacQueueContainer>::ConstIterator;
+  using Queue<WifiMacQueueItem, WifiMacQueueContainer>::Iterator;
+  using Queue<WifiMacQueueItem, WifiMacQueueContainer>::begin;
+  using Queue<WifiMacQueueItem, WifiMacQueueContainer>::end;
 
   /**
    * Set the maximum delay before the packet is discarded.
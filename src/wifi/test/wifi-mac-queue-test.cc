@@ -54,6 +54,9 @@ void
 WifiMacQueueDropOldestTest::DoRun ()
 {
   auto wifiMacQueue = CreateObject<WifiMacQueue> (AC_BE);
+  NS_TEST_EXPECT_MSG_EQ (WifiMacQueue::GetTypeId ().GetParent ().GetName (),
+                         "ns3::Queue<WifiMacQueueItem>",
+                         "The container must not appear in the name of the parent TypeId");
   wifiMacQueue->SetMaxSize (QueueSize ("5p"));
   wifiMacQueue->SetAttribute ("DropPolicy", EnumValue (WifiMacQueue::DROP_OLDEST));
 
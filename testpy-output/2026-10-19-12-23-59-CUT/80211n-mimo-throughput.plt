@@ -0,0 +1,425 @@
+set terminal postscript eps color enh "Times-BoldItalic"
+set output "80211n-mimo-throughput.eps"
+set xlabel "Distance (Meters)"
+set ylabel "Throughput (Mbit/s)"
+set xrange [0:100]
+set yrange [0:600]
+set ytics 0,50,600
+set style line 1 dashtype 1 linewidth 5
+set style line 2 dashtype 1 linewidth 5
+set style line 3 dashtype 1 linewidth 5
+set style line 4 dashtype 1 linewidth 5
+set style line 5 dashtype 1 linewidth 5
+set style line 6 dashtype 1 linewidth 5
+set style line 7 dashtype 1 linewidth 5
+set style line 8 dashtype 1 linewidth 5
+set style line 9 dashtype 2 linewidth 5
+set style line 10 dashtype 2 linewidth 5
+set style line 11 dashtype 2 linewidth 5
+set style line 12 dashtype 2 linewidth 5
+set style line 13 dashtype 2 linewidth 5
+set style line 14 dashtype 2 linewidth 5
+set style line 15 dashtype 2 linewidth 5
+set style line 16 dashtype 2 linewidth 5
+set style line 17 dashtype 3 linewidth 5
+set style line 18 dashtype 3 linewidth 5
+set style line 19 dashtype 3 linewidth 5
+set style line 20 dashtype 3 linewidth 5
+set style line 21 dashtype 3 linewidth 5
+set style line 22 dashtype 3 linewidth 5
+set style line 23 dashtype 3 linewidth 5
+set style line 24 dashtype 3 linewidth 5
+set style line 25 dashtype 4 linewidth 5
+set style line 26 dashtype 4 linewidth 5
+set style line 27 dashtype 4 linewidth 5
+set style line 28 dashtype 4 linewidth 5
+set style line 29 dashtype 4 linewidth 5
+set style line 30 dashtype 4 linewidth 5
+set style line 31 dashtype 4 linewidth 5
+set style line 32 dashtype 4 linewidth 5
+set style increment user
+plot "-"  title "HtMcs0" with lines, "-"  title "HtMcs1" with lines, "-"  title "HtMcs2" with lines, "-"  title "HtMcs3" with lines, "-"  title "HtMcs4" with lines, "-"  title "HtMcs5" with lines, "-"  title "HtMcs6" with lines, "-"  title "HtMcs7" with lines, "-"  title "HtMcs8" with lines, "-"  title "HtMcs9" with lines, "-"  title "HtMcs10" with lines, "-"  title "HtMcs11" with lines, "-"  title "HtMcs12" with lines, "-"  title "HtMcs13" with lines, "-"  title "HtMcs14" with lines, "-"  title "HtMcs15" with lines, "-"  title "HtMcs16" with lines, "-"  title "HtMcs17" with lines, "-"  title "HtMcs18" with lines, "-"  title "HtMcs19" with lines, "-"  title "HtMcs20" with lines, "-"  title "HtMcs21" with lines, "-"  title "HtMcs22" with lines, "-"  title "HtMcs23" with lines, "-"  title "HtMcs24" with lines, "-"  title "HtMcs25" with lines, "-"  title "HtMcs26" with lines, "-"  title "HtMcs27" with lines, "-"  title "HtMcs28" with lines, "-"  title "HtMcs29" with lines, "-"  title "HtMcs30" with lines, "-"  title "HtMcs31" with lines
+0 5.18144
+10 5.18144
+20 5.2992
+30 5.65248
+40 5.53472
+50 5.41696
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 11.5405
+10 11.776
+20 11.5405
+30 10.8339
+40 11.305
+50 11.305
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 16.4864
+10 16.9574
+20 17.664
+30 17.0752
+40 16.8397
+50 16.2509
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 23.552
+10 22.0211
+20 22.2566
+30 22.3744
+40 23.1987
+50 21.6678
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 34.857
+10 34.6214
+20 34.0326
+30 35.4458
+40 35.0925
+50 19.5482
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 47.2218
+10 44.2778
+20 46.2797
+30 43.4534
+40 0.11776
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 48.1638
+10 49.4592
+20 50.519
+30 51.3434
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 58.409
+10 54.1696
+20 57.9379
+30 36.6234
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 10.7162
+10 11.6582
+20 10.7162
+30 10.8339
+40 11.5405
+50 11.1872
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 23.081
+10 22.8454
+20 21.4323
+30 23.3165
+40 21.9034
+50 23.3165
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 33.4438
+10 34.2682
+20 33.5616
+30 34.6214
+40 32.384
+50 34.0326
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 46.2797
+10 46.1619
+20 47.2218
+30 45.4554
+40 45.1021
+50 44.0422
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 65.1213
+10 69.4784
+20 65.8278
+30 68.7718
+40 70.8915
+50 56.0538
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 87.6134
+10 87.6134
+20 86.9069
+30 94.4435
+40 8.12544
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 97.0342
+10 98.0941
+20 97.623
+30 99.0362
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 112.108
+10 109.517
+20 115.994
+30 83.0208
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 16.8397
+10 16.4864
+20 16.9574
+30 16.6042
+40 16.9574
+50 16.8397
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 32.384
+10 33.7971
+20 34.6214
+30 32.0307
+40 32.855
+50 33.4438
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 52.0499
+10 50.2835
+20 52.521
+30 50.6368
+40 50.2835
+50 48.1638
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 68.5363
+10 64.1792
+20 65.7101
+30 67.712
+40 70.185
+50 67.9475
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 96.7987
+10 104.1
+20 99.8605
+30 104.335
+40 103.864
+50 84.7872
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 132.951
+10 128.594
+20 137.426
+30 132.009
+40 29.44
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 153.324
+10 154.854
+20 145.434
+30 142.843
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 154.854
+10 166.277
+20 165.217
+30 132.833
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 22.6099
+10 22.7277
+20 23.3165
+30 23.1987
+40 21.7856
+50 23.1987
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 46.5152
+10 43.689
+20 44.16
+30 44.3955
+40 42.8646
+50 45.4554
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 66.4166
+10 64.8858
+20 68.0653
+30 67.9475
+40 64.5325
+50 69.8317
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 90.2042
+10 88.5555
+20 89.9686
+30 94.208
+40 92.4416
+50 91.4995
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 128.005
+10 132.833
+20 135.66
+30 135.66
+40 127.299
+50 119.88
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 177.582
+10 170.988
+20 168.868
+30 168.161
+40 31.2064
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 190.3
+10 196.424
+20 187.945
+30 185.943
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 215.854
+10 219.034
+20 220.447
+30 164.982
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
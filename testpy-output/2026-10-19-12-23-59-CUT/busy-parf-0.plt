@@ -0,0 +1,12 @@
+set terminal post eps color enhanced
+set output "busy-parf-0.eps"
+set title "Percentage time AP0 in Busy state vs time"
+set xlabel "Time (seconds)"
+set ylabel "Percent"
+plot "-"  title "Busy Time" with lines
+0 0
+1 0.0032
+2 3.3296
+3 3.2512
+4 3.2832
+e
@@ -0,0 +1,12 @@
+set terminal post eps color enhanced
+set output "idle-parf-0.eps"
+set title "Percentage time AP0 in Idle state vs time"
+set xlabel "Time (seconds)"
+set ylabel "Percent"
+plot "-"  title "Idle Time" with lines
+0 0
+1 99.3221
+2 35.6575
+3 35.5373
+4 35.1644
+e
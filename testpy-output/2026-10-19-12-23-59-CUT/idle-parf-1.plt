@@ -0,0 +1,12 @@
+set terminal post eps color enhanced
+set output "idle-parf-1.eps"
+set title "Percentage time AP1 in Idle state vs time"
+set xlabel "Time (seconds)"
+set ylabel "Percent"
+plot "-"  title "Idle Time" with lines
+0 0
+1 96.2034
+2 38.6529
+3 35.9343
+4 35.2209
+e
@@ -0,0 +1,3 @@
+$node_(0) set X_ 10.0
+$node_(0) set Y_ 0.0
+$ns_ at 1.0 "$node_(0) setdest 10  0       1"
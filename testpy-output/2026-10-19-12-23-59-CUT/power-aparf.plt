@@ -0,0 +1,12 @@
+set terminal post eps color enhanced
+set output "power-aparf.eps"
+set title "Average transmit power (AP to STA) vs time"
+set xlabel "Time (seconds)"
+set ylabel "Power (mW)"
+plot "-"  title "Average Transmit Power" with lines
+5 0.735352
+15 3.35221
+25 16.0365
+35 17.7204
+45 24.9041
+e
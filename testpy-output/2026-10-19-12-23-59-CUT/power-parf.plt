@@ -0,0 +1,12 @@
+set terminal post eps color enhanced
+set output "power-parf.eps"
+set title "Average transmit power (AP to STA) vs time"
+set xlabel "Time (seconds)"
+set ylabel "Power (mW)"
+plot "-"  title "Average Transmit Power" with lines
+5 1.09559
+15 3.24795
+25 15.1531
+35 30.9943
+45 37.1306
+e
@@ -0,0 +1,12 @@
+set terminal post eps color enhanced
+set output "power-rrpaa.eps"
+set title "Average transmit power (AP to STA) vs time"
+set xlabel "Time (seconds)"
+set ylabel "Power (mW)"
+plot "-"  title "Average Transmit Power" with lines
+5 7.27628
+15 3.4112
+25 17.5943
+35 31.9633
+45 34.5677
+e
@@ -0,0 +1,12 @@
+set terminal post eps color enhanced
+set output "rx-parf-0.eps"
+set title "Percentage time AP0 in RX state vs time"
+set xlabel "Time (seconds)"
+set ylabel "Percent"
+plot "-"  title "RX Time" with lines
+0 0
+1 0.0092
+2 1.6732
+3 1.6256
+4 1.6416
+e
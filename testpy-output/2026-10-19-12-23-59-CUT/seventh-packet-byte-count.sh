@@ -0,0 +1,3 @@
+#!/bin/sh
+
+gnuplot seventh-packet-byte-count.plt